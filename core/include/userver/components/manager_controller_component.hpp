@@ -33,7 +33,11 @@ class Manager;
 /// coro_pool.initial_size | amount of coroutines to preallocate on startup | -
 /// coro_pool.max_size | max amount of coroutines to keep preallocated | -
 /// coro_pool.stack_size | size of a single coroutine | 256 * 1024
+/// coro_pool.max_dirty_idle_size | amount of idle coroutines that keep the touched pages of their stacks, stacks of other idle coroutines are given back to the OS | initial_size
 /// event_thread_pool.threads | number of threads to process low level IO system calls (number of ev loops to start in libev) | -
+/// event_thread_pool.io_backend | how to wait for readiness of sockets: 'libev' starts an ev_io watcher for each wait, 'io-uring' submits an io_uring poll and falls back to 'libev' if io_uring is not available | libev
+/// event_thread_pool.cpu_affinity | list of CPUs to pin the ev-threads to, e.g. '0-3,8' | not pinned
+/// event_thread_pool.numa_aware | distribute ev-threads over NUMA nodes round-robin and pin each of them to the CPUs of its node | false
 /// components | dictionary of "component name": "options" | -
 /// default_task_processor | name of the default task processor to use in components | -
 /// task_processors.*NAME*.*OPTIONS* | dictionary of task processors to create and their options. See description below | -
@@ -45,6 +49,12 @@ class Manager;
 /// thread_name | set OS thread name to this value | -
 /// worker_threads | threads count for the task processor | -
 /// os-scheduling | OS scheduling mode for the task processor threads. 'idle' sets the lowest pririty. 'low-priority' sets the priority below 'normal' but higher than 'idle'. | normal
+/// task-processor-queue | Task queue mode for the task processor. 'global-task-queue' shares a single queue between all the workers. 'work-stealing-task-queue' gives each worker a LIFO slot and a local queue, idle workers steal tasks from others. | global-task-queue
+/// normal-priority-weight | how many normal priority tasks a worker dequeues per one engine::Task::Priority::kBackground task while both are pending | 8
+/// min-worker-threads | enables the elastic mode: starts this many workers and adds more, up to worker_threads, while the tasks wait in the queue for longer than the sensor_time_limit_us of USERVER_TASK_PROCESSOR_QOS or the workers are stuck in blocking calls. Requires global-task-queue | worker_threads
+/// worker-idle-timeout | in the elastic mode, a worker above min-worker-threads exits after being idle for this long | 10s
+/// cpu-affinity | list of CPUs to pin the worker threads to, e.g. '0-3,8'. Can not be used with numa-node | not pinned
+/// numa-node | pin the worker threads to the CPUs of this NUMA node and prefer the ev-threads of the same node (see event_thread_pool.numa_aware). Can not be used with cpu-affinity | not pinned
 /// task-trace | optional dictionary of tracing options | empty (disabled)
 /// task-trace.every | set N to trace each Nth task | 1000
 /// task-trace.max-context-switch-count | set upper limit of context switches to trace for a single task | 1000
@@ -0,0 +1,788 @@
+#pragma once
+
+/// @file userver/concurrent/hash_map.hpp
+/// @brief @copybrief concurrent::HashMap
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <userver/engine/mutex.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/rcu/rcu_map.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/impl/thread_shard.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent {
+
+namespace impl {
+
+// Holds the reclamation epoch of rcu::ReclamationPolicy::kEpoch, nodes and
+// tables retired after it was locked are not destroyed until it is unlocked
+class HashMapEpochLock final {
+ public:
+  HashMapEpochLock() noexcept
+      : counter_(rcu::impl::LockReclamationEpoch()) {}
+
+  HashMapEpochLock(const HashMapEpochLock&) = delete;
+  HashMapEpochLock& operator=(const HashMapEpochLock&) = delete;
+
+  ~HashMapEpochLock() { rcu::impl::UnlockReclamationEpoch(counter_); }
+
+ private:
+  rcu::impl::EpochReadersCounter& counter_;
+};
+
+}  // namespace impl
+
+/// @ingroup userver_concurrency userver_containers
+///
+/// @brief Concurrent hash map with lock-free reads, for maps with frequent
+/// keyset changes.
+///
+/// Unlike rcu::RcuMap, a keyset change does not copy the map: it locks one of
+/// the few mutexes that guard the buckets and changes a single bucket. Readers
+/// take no locks and are protected from the concurrent changes by the
+/// epoch-based reclamation of rcu::ReclamationPolicy::kEpoch. The table grows
+/// incrementally: once the map is full, each subsequent change moves a few
+/// buckets to the new twice bigger table, while the readers look up the keys
+/// of the moved buckets in the new table.
+///
+/// The interface mimics rcu::RcuMap. Values are stored in `shared_ptr`s and
+/// are not copied on keyset changes.
+/// @note No synchronization is provided for value access, it must be
+/// implemented by Value when necessary.
+/// @note Removed keys are destroyed by the subsequent changes of the map once
+/// the readers that might see them are gone, so their values may live a bit
+/// longer than in rcu::RcuMap.
+///
+/// ## Example usage:
+///
+/// @snippet concurrent/hash_map_test.cpp  Sample concurrent::HashMap usage
+///
+/// @see @ref md_en_userver_synchronization
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Equal = std::equal_to<Key>>
+class HashMap final {
+  static_assert(!std::is_reference_v<Key>);
+  static_assert(!std::is_reference_v<Value>);
+  static_assert(!std::is_const_v<Key>);
+
+ public:
+  using ValuePtr = std::shared_ptr<Value>;
+  using ConstValuePtr = std::shared_ptr<const Value>;
+  using Snapshot = std::unordered_map<Key, ConstValuePtr, Hash, Equal>;
+
+  struct InsertReturnType {
+    ValuePtr value;
+    bool inserted;
+  };
+
+  explicit HashMap(const Hash& hash = Hash{}, const Equal& equal = Equal{});
+  ~HashMap();
+
+  HashMap(const HashMap&) = delete;
+  HashMap(HashMap&&) = delete;
+  HashMap& operator=(const HashMap&) = delete;
+  HashMap& operator=(HashMap&&) = delete;
+
+  /// Returns an estimated size of the map at some point in time
+  std::size_t SizeApprox() const;
+
+  /// @brief Returns a readonly value pointer by its key if exists
+  /// @throws rcu::MissingKeyException if the key is not present
+  const ConstValuePtr operator[](const Key&) const;
+
+  /// @brief Returns a modifiable value pointer by key if exists or
+  /// default-creates one
+  const ValuePtr operator[](const Key&);
+
+  /// @brief Inserts a new element into the container if there is no element
+  /// with the key in the container.
+  /// Returns a pair consisting of a pointer to the inserted element, or the
+  /// already-existing element if no insertion happened, and a bool denoting
+  /// whether the insertion took place.
+  InsertReturnType Insert(const Key& key, ValuePtr value);
+
+  /// @brief Inserts a new element into the container constructed in-place with
+  /// the given args if there is no element with the key in the container.
+  /// The value is constructed only if the insertion takes place.
+  template <typename... Args>
+  InsertReturnType Emplace(const Key& key, Args&&... args);
+
+  /// @brief Same as Emplace, for compatibility with rcu::RcuMap
+  template <typename... Args>
+  InsertReturnType TryEmplace(const Key& key, Args&&... args);
+
+  /// @brief If a key equivalent to `key` already exists in the container,
+  /// replaces the associated value. Otherwise, inserts a new pair into the map.
+  void InsertOrAssign(const Key& key, ValuePtr value);
+
+  /// @brief Returns a readonly value pointer by its key or an empty pointer
+  const ConstValuePtr Get(const Key&) const;
+
+  /// @brief Returns a modifiable value pointer by key or an empty pointer
+  const ValuePtr Get(const Key&);
+
+  /// @brief Removes a key from the map
+  /// @returns whether the key was present
+  bool Erase(const Key&);
+
+  /// @brief Removes a key from the map returning its value
+  /// @returns a value if the key was present, empty pointer otherwise
+  ValuePtr Pop(const Key&);
+
+  /// Resets the map to an empty state
+  void Clear();
+
+  /// @brief Calls `func(const Key&, const Value&)` for each element.
+  /// @details Keys that are inserted or erased concurrently may be either
+  /// visited or not, each key is visited at most once. The map can't destroy
+  /// the removed keys while `func` is running, so don't block in it.
+  template <typename Func>
+  void VisitAll(Func&& func) const;
+
+  /// @brief Returns a readonly copy of the map
+  /// @note The copy is consistent for each key, but not for the whole map
+  Snapshot GetSnapshot() const;
+
+ private:
+  struct Node final {
+    Node(std::size_t hash, const Key& key, ValuePtr value)
+        : hash(hash), key(key), value(std::move(value)) {}
+
+    const std::size_t hash;
+    const Key key;
+    const ValuePtr value;
+    std::atomic<Node*> next{nullptr};
+  };
+
+  struct Table final {
+    explicit Table(std::size_t size) : buckets(size, nullptr) {}
+
+    std::atomic<Node*>& GetBucket(std::size_t hash) {
+      return buckets[hash & (buckets.size() - 1)];
+    }
+
+    const std::atomic<Node*>& GetBucket(std::size_t hash) const {
+      return buckets[hash & (buckets.size() - 1)];
+    }
+
+    utils::FixedArray<std::atomic<Node*>> buckets;
+    // The table the buckets are being moved to
+    std::atomic<Table*> next{nullptr};
+    std::atomic<std::size_t> migration_cursor{0};
+    std::atomic<std::size_t> migrated_count{0};
+  };
+
+  struct alignas(utils::impl::kInterferenceSize) Stripe final {
+    engine::Mutex mutex;
+    // Ordered by epoch
+    std::vector<rcu::impl::EpochRetiredValue<Node>> retired;
+  };
+
+  using EpochLock = impl::HashMapEpochLock;
+
+  // Bucket `i` of any table is guarded by the stripe `i % kStripesCount`, so
+  // a bucket and the two buckets it is moved to are guarded by the same stripe
+  static constexpr std::size_t kStripesCount = 32;
+  static constexpr std::size_t kInitialBucketsCount = kStripesCount;
+  // Buckets moved to the new table by each change during the resize
+  static constexpr std::size_t kMigrationChunk = 8;
+
+  // Marks a bucket that was moved to the next table
+  static inline Node* const kMigrated = reinterpret_cast<Node*>(1);
+
+  Stripe& GetStripe(std::size_t hash) {
+    return stripes_[hash & (kStripesCount - 1)];
+  }
+
+  // The epoch must be locked
+  Node* FindNode(std::size_t hash, const Key& key) const;
+  ValuePtr FindValue(std::size_t hash, const Key& key) const;
+  std::atomic<Node*>* FindLink(std::atomic<Node*>& head, std::size_t hash,
+                               const Key& key) const;
+
+  template <typename Factory>
+  InsertReturnType DoInsert(const Key& key, Factory&& factory);
+
+  // Calls `func(bucket, stripe)` with the stripe of the key locked
+  template <typename Func>
+  auto Modify(std::size_t hash, Func&& func);
+  void FinishModify(std::unique_lock<engine::Mutex>& lock, Stripe& stripe,
+                    Table* migrated_table);
+  // Finishes the migration if the last bucket of the table was moved under
+  // the lock
+  void UnlockStripe(std::unique_lock<engine::Mutex>& lock,
+                    Table* migrated_table);
+
+  std::atomic<Node*>& GetBucketForWrite(std::size_t hash, Stripe& stripe,
+                                        Table*& migrated_table);
+  // Returns true if it was the last bucket of the table to move
+  bool MigrateBucket(Table& table, std::size_t index, Stripe& stripe);
+  void HelpMigration();
+  void FinishMigration(Table& table);
+  void MaybeStartResize();
+
+  void Retire(Stripe& stripe, Node* node);
+  // The stripe must be locked
+  void Reclaim(Stripe& stripe, std::uint64_t safe_epoch);
+  void ReclaimOtherStripes(const Stripe& reclaimed_stripe,
+                           std::uint64_t safe_epoch);
+  void ReclaimTables();
+
+  template <typename Func>
+  void VisitBucket(const Table& table, std::size_t index, Func& func) const;
+
+  static void DeleteChain(Node* node);
+
+  const Hash hash_;
+  const Equal equal_;
+  utils::FixedArray<Stripe> stripes_;
+  std::atomic<std::size_t> size_{0};
+  // The safe epoch of the last pass over all the stripes
+  std::atomic<std::uint64_t> reclaimed_epoch_{0};
+  // The oldest table, its `next` is set while the table is being moved
+  std::atomic<Table*> table_;
+
+  engine::Mutex resize_mutex_;  // for table_ changes and retired_tables_
+  std::vector<rcu::impl::EpochRetiredValue<Table>> retired_tables_;
+};
+
+template <typename K, typename V, typename H, typename E>
+HashMap<K, V, H, E>::HashMap(const H& hash, const E& equal)
+    : hash_(hash),
+      equal_(equal),
+      stripes_(kStripesCount),
+      table_(new Table(kInitialBucketsCount)) {}
+
+template <typename K, typename V, typename H, typename E>
+HashMap<K, V, H, E>::~HashMap() {
+  Table* table = table_.load();
+  while (table) {
+    for (auto& bucket : table->buckets) {
+      auto* node = bucket.load();
+      if (node != kMigrated) DeleteChain(node);
+    }
+    auto* next = table->next.load();
+    delete table;
+    table = next;
+  }
+}
+
+template <typename K, typename V, typename H, typename E>
+std::size_t HashMap<K, V, H, E>::SizeApprox() const {
+  return size_.load();
+}
+
+template <typename K, typename V, typename H, typename E>
+// Protects from assignment to map[key]
+// NOLINTNEXTLINE(readability-const-return-type)
+const typename HashMap<K, V, H, E>::ConstValuePtr
+HashMap<K, V, H, E>::operator[](const K& key) const {
+  if (auto value = Get(key)) {
+    return value;
+  }
+  throw rcu::MissingKeyException("Key ") << key << " is missing";
+}
+
+template <typename K, typename V, typename H, typename E>
+// Protects from assignment to map[key]
+// NOLINTNEXTLINE(readability-const-return-type)
+const typename HashMap<K, V, H, E>::ValuePtr HashMap<K, V, H, E>::operator[](
+    const K& key) {
+  return DoInsert(key, [] { return std::make_shared<V>(); }).value;
+}
+
+template <typename K, typename V, typename H, typename E>
+typename HashMap<K, V, H, E>::InsertReturnType HashMap<K, V, H, E>::Insert(
+    const K& key, ValuePtr value) {
+  UASSERT(value);
+  return DoInsert(key, [&value] { return std::move(value); });
+}
+
+template <typename K, typename V, typename H, typename E>
+template <typename... Args>
+typename HashMap<K, V, H, E>::InsertReturnType HashMap<K, V, H, E>::Emplace(
+    const K& key, Args&&... args) {
+  return DoInsert(key, [&] {
+    return std::make_shared<V>(std::forward<Args>(args)...);
+  });
+}
+
+template <typename K, typename V, typename H, typename E>
+template <typename... Args>
+typename HashMap<K, V, H, E>::InsertReturnType
+HashMap<K, V, H, E>::TryEmplace(const K& key, Args&&... args) {
+  return Emplace(key, std::forward<Args>(args)...);
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::InsertOrAssign(const K& key, ValuePtr value) {
+  UASSERT(value);
+  const auto hash = hash_(key);
+  Modify(hash, [&](std::atomic<Node*>& head, Stripe& stripe) {
+    auto* node = new Node(hash, key, std::move(value));
+    if (auto* link = FindLink(head, hash, key)) {
+      auto* old_node = link->load();
+      node->next.store(old_node->next.load());
+      link->store(node);
+      Retire(stripe, old_node);
+    } else {
+      node->next.store(head.load());
+      head.store(node);
+      size_.fetch_add(1);
+    }
+  });
+}
+
+template <typename K, typename V, typename H, typename E>
+// Protects from assignment to map[key]
+// NOLINTNEXTLINE(readability-const-return-type)
+const typename HashMap<K, V, H, E>::ConstValuePtr HashMap<K, V, H, E>::Get(
+    const K& key) const {
+  const auto hash = hash_(key);
+  EpochLock epoch_lock;
+  return FindValue(hash, key);
+}
+
+template <typename K, typename V, typename H, typename E>
+// Protects from assignment to map[key]
+// NOLINTNEXTLINE(readability-const-return-type)
+const typename HashMap<K, V, H, E>::ValuePtr HashMap<K, V, H, E>::Get(
+    const K& key) {
+  const auto hash = hash_(key);
+  EpochLock epoch_lock;
+  return FindValue(hash, key);
+}
+
+template <typename K, typename V, typename H, typename E>
+bool HashMap<K, V, H, E>::Erase(const K& key) {
+  return Pop(key) != nullptr;
+}
+
+template <typename K, typename V, typename H, typename E>
+typename HashMap<K, V, H, E>::ValuePtr HashMap<K, V, H, E>::Pop(
+    const K& key) {
+  const auto hash = hash_(key);
+  if (!Get(key)) return {};
+
+  return Modify(hash, [&](std::atomic<Node*>& head, Stripe& stripe) {
+    auto* link = FindLink(head, hash, key);
+    if (!link) return ValuePtr{};
+
+    auto* node = link->load();
+    link->store(node->next.load());
+    size_.fetch_sub(1);
+    auto value = node->value;
+    Retire(stripe, node);
+    return value;
+  });
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::Clear() {
+  // Nothing can be destroyed concurrently with all the locks held, so the
+  // epoch is not locked: that would only hold back the reclamation
+  std::lock_guard resize_lock(resize_mutex_);
+  std::vector<std::unique_lock<engine::Mutex>> locks;
+  locks.reserve(kStripesCount);
+  for (auto& stripe : stripes_) locks.emplace_back(stripe.mutex);
+
+  Table* const table = table_.load();
+  for (Table* current = table; current; current = current->next.load()) {
+    const bool is_moving = current->next.load() != nullptr;
+    for (std::size_t i = 0; i < current->buckets.size(); ++i) {
+      auto& bucket = current->buckets[i];
+      auto* node = bucket.load();
+      if (node == kMigrated) continue;
+
+      auto& stripe = GetStripe(i);
+      std::size_t chain_length = 0;
+      for (auto* it = node; it; it = it->next.load()) ++chain_length;
+      stripe.retired.reserve(stripe.retired.size() + chain_length);
+
+      bucket.store(is_moving ? kMigrated : nullptr);
+      while (node) {
+        auto* next = node->next.load();
+        Retire(stripe, node);
+        node = next;
+      }
+    }
+  }
+  size_.store(0);
+
+  if (auto* next = table->next.load()) {
+    table_.store(next);
+    retired_tables_.push_back(
+        {rcu::impl::GetReclamationEpoch(), std::unique_ptr<Table>(table)});
+  }
+  const auto safe_epoch = rcu::impl::TryAdvanceReclamationEpoch();
+  for (auto& stripe : stripes_) Reclaim(stripe, safe_epoch);
+  ReclaimTables();
+}
+
+template <typename K, typename V, typename H, typename E>
+template <typename Func>
+void HashMap<K, V, H, E>::VisitAll(Func&& func) const {
+  auto visitor = [&func](const Node& node) {
+    func(node.key, std::as_const(*node.value));
+  };
+
+  EpochLock epoch_lock;
+  const Table& table = *table_.load();
+  for (std::size_t i = 0; i < table.buckets.size(); ++i) {
+    VisitBucket(table, i, visitor);
+  }
+}
+
+template <typename K, typename V, typename H, typename E>
+typename HashMap<K, V, H, E>::Snapshot HashMap<K, V, H, E>::GetSnapshot()
+    const {
+  Snapshot snapshot;
+  snapshot.reserve(SizeApprox());
+
+  EpochLock epoch_lock;
+  const Table& table = *table_.load();
+  auto visitor = [&snapshot](const Node& node) {
+    snapshot.emplace(node.key, node.value);
+  };
+  for (std::size_t i = 0; i < table.buckets.size(); ++i) {
+    VisitBucket(table, i, visitor);
+  }
+  return snapshot;
+}
+
+template <typename K, typename V, typename H, typename E>
+typename HashMap<K, V, H, E>::Node* HashMap<K, V, H, E>::FindNode(
+    std::size_t hash, const K& key) const {
+  const Table* table = table_.load();
+  while (true) {
+    auto* node = table->GetBucket(hash).load();
+    if (node == kMigrated) {
+      // `next` is set before the first bucket is moved
+      table = table->next.load();
+      continue;
+    }
+
+    for (; node; node = node->next.load()) {
+      if (node->hash == hash && equal_(node->key, key)) return node;
+    }
+    return nullptr;
+  }
+}
+
+template <typename K, typename V, typename H, typename E>
+typename HashMap<K, V, H, E>::ValuePtr HashMap<K, V, H, E>::FindValue(
+    std::size_t hash, const K& key) const {
+  const auto* node = FindNode(hash, key);
+  return node ? node->value : nullptr;
+}
+
+template <typename K, typename V, typename H, typename E>
+std::atomic<typename HashMap<K, V, H, E>::Node*>*
+HashMap<K, V, H, E>::FindLink(std::atomic<Node*>& head, std::size_t hash,
+                              const K& key) const {
+  for (auto* link = &head; auto* node = link->load(); link = &node->next) {
+    if (node->hash == hash && equal_(node->key, key)) return link;
+  }
+  return nullptr;
+}
+
+template <typename K, typename V, typename H, typename E>
+template <typename Factory>
+typename HashMap<K, V, H, E>::InsertReturnType HashMap<K, V, H, E>::DoInsert(
+    const K& key, Factory&& factory) {
+  const auto hash = hash_(key);
+  {
+    EpochLock epoch_lock;
+    if (auto value = FindValue(hash, key)) return {std::move(value), false};
+  }
+
+  return Modify(hash, [&](std::atomic<Node*>& head, Stripe&) {
+    if (auto* link = FindLink(head, hash, key)) {
+      return InsertReturnType{link->load()->value, false};
+    }
+
+    auto* node = new Node(hash, key, factory());
+    node->next.store(head.load());
+    head.store(node);
+    size_.fetch_add(1);
+    return InsertReturnType{node->value, true};
+  });
+}
+
+template <typename K, typename V, typename H, typename E>
+template <typename Func>
+auto HashMap<K, V, H, E>::Modify(std::size_t hash, Func&& func) {
+  HelpMigration();
+
+  Table* migrated_table = nullptr;
+  auto& stripe = GetStripe(hash);
+  std::unique_lock lock(stripe.mutex);
+  std::atomic<Node*>* head = nullptr;
+  {
+    // Only the walk over the tables needs the epoch: the table of the found
+    // bucket can't be retired while the stripe is locked, as the bucket is
+    // still there. The chain of the bucket is retired under the same lock.
+    EpochLock epoch_lock;
+    head = &GetBucketForWrite(hash, stripe, migrated_table);
+  }
+
+  const auto modify = [&] {
+    try {
+      // Retire() must not throw after a node is unlinked
+      stripe.retired.reserve(stripe.retired.size() + 1);
+      return func(*head, stripe);
+    } catch (...) {
+      // The bucket moved above may be the last one of the table, nobody else
+      // would switch the tables then
+      UnlockStripe(lock, migrated_table);
+      throw;
+    }
+  };
+
+  if constexpr (std::is_void_v<decltype(func(*head, stripe))>) {
+    modify();
+    FinishModify(lock, stripe, migrated_table);
+  } else {
+    auto result = modify();
+    FinishModify(lock, stripe, migrated_table);
+    return result;
+  }
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::FinishModify(std::unique_lock<engine::Mutex>& lock,
+                                       Stripe& stripe, Table* migrated_table) {
+  const auto safe_epoch = rcu::impl::TryAdvanceReclamationEpoch();
+  Reclaim(stripe, safe_epoch);
+  UnlockStripe(lock, migrated_table);
+  MaybeStartResize();
+  ReclaimOtherStripes(stripe, safe_epoch);
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::UnlockStripe(std::unique_lock<engine::Mutex>& lock,
+                                       Table* migrated_table) {
+  // Clear() may retire the moved table as soon as the stripe is unlocked,
+  // the table must stay alive until it is switched
+  std::optional<EpochLock> epoch_lock;
+  if (migrated_table) epoch_lock.emplace();
+  lock.unlock();
+  if (migrated_table) FinishMigration(*migrated_table);
+}
+
+template <typename K, typename V, typename H, typename E>
+std::atomic<typename HashMap<K, V, H, E>::Node*>&
+HashMap<K, V, H, E>::GetBucketForWrite(std::size_t hash, Stripe& stripe,
+                                       Table*& migrated_table) {
+  Table* table = table_.load();
+  while (true) {
+    auto* next = table->next.load();
+    if (!next) {
+      auto& bucket = table->GetBucket(hash);
+      UASSERT(bucket.load() != kMigrated);
+      return bucket;
+    }
+
+    // All the changes go to the newest table, so the bucket has to be moved
+    // there first
+    const auto index = hash & (table->buckets.size() - 1);
+    if (MigrateBucket(*table, index, stripe)) migrated_table = table;
+    table = next;
+  }
+}
+
+template <typename K, typename V, typename H, typename E>
+bool HashMap<K, V, H, E>::MigrateBucket(Table& table, std::size_t index,
+                                        Stripe& stripe) {
+  auto& bucket = table.buckets[index];
+  auto* const head = bucket.load();
+  if (head == kMigrated) return false;
+
+  // Readers may traverse the chain right now, so the nodes are copied rather
+  // than relinked
+  Table& next = *table.next.load();
+  Node* low_head = nullptr;
+  Node* high_head = nullptr;
+  std::size_t chain_length = 0;
+  try {
+    for (auto* node = head; node; node = node->next.load()) {
+      auto* copy = new Node(node->hash, node->key, node->value);
+      auto*& new_head =
+          (node->hash & table.buckets.size()) ? high_head : low_head;
+      copy->next.store(new_head);
+      new_head = copy;
+      ++chain_length;
+    }
+    stripe.retired.reserve(stripe.retired.size() + chain_length);
+  } catch (...) {
+    DeleteChain(low_head);
+    DeleteChain(high_head);
+    throw;
+  }
+
+  // Nobody changes these buckets before the source bucket is moved
+  next.buckets[index].store(low_head);
+  next.buckets[index + table.buckets.size()].store(high_head);
+  bucket.store(kMigrated);
+
+  for (auto* node = head; node;) {
+    auto* next_node = node->next.load();
+    Retire(stripe, node);
+    node = next_node;
+  }
+  return table.migrated_count.fetch_add(1) + 1 == table.buckets.size();
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::HelpMigration() {
+  // The epoch keeps the table alive. Waiting for a stripe with the epoch
+  // locked would hold back the reclamation, so a busy stripe is left to a
+  // later change of the map. The cursor moves only under the stripe lock, so
+  // no bucket is skipped.
+  EpochLock epoch_lock;
+  Table* table = table_.load();
+  if (!table->next.load()) return;
+
+  for (std::size_t i = 0; i < kMigrationChunk; ++i) {
+    auto index = table->migration_cursor.load();
+    if (index >= table->buckets.size()) return;
+
+    auto& stripe = GetStripe(index);
+    bool is_last = false;
+    {
+      std::unique_lock lock(stripe.mutex, std::try_to_lock);
+      if (!lock.owns_lock()) return;
+      if (!table->migration_cursor.compare_exchange_strong(index, index + 1)) {
+        continue;
+      }
+      is_last = MigrateBucket(*table, index, stripe);
+    }
+    if (is_last) {
+      FinishMigration(*table);
+      return;
+    }
+  }
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::FinishMigration(Table& table) {
+  std::lock_guard lock(resize_mutex_);
+  // Clear() might have already switched the tables
+  if (table_.load() != &table) return;
+
+  table_.store(table.next.load());
+  retired_tables_.push_back(
+      {rcu::impl::GetReclamationEpoch(), std::unique_ptr<Table>(&table)});
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::MaybeStartResize() {
+  auto is_resize_needed = [this](const Table& table) {
+    return !table.next.load() && size_.load() > table.buckets.size();
+  };
+  {
+    EpochLock epoch_lock;
+    if (!is_resize_needed(*table_.load())) return;
+  }
+
+  // The tables are retired and destroyed under the lock
+  std::unique_lock lock(resize_mutex_, std::try_to_lock);
+  if (!lock.owns_lock()) return;
+
+  Table* table = table_.load();
+  if (!is_resize_needed(*table)) return;
+
+  ReclaimTables();
+  table->next.store(new Table(table->buckets.size() * 2));
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::Retire(Stripe& stripe, Node* node) {
+  // The node is already unlinked, so readers of the later epochs can't get it
+  UASSERT(stripe.retired.size() < stripe.retired.capacity());
+  stripe.retired.push_back(
+      {rcu::impl::GetReclamationEpoch(), std::unique_ptr<Node>(node)});
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::Reclaim(Stripe& stripe, std::uint64_t safe_epoch) {
+  const auto it = std::find_if(stripe.retired.begin(), stripe.retired.end(),
+                               [safe_epoch](const auto& retired) {
+                                 return retired.epoch >= safe_epoch;
+                               });
+  stripe.retired.erase(stripe.retired.begin(), it);
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::ReclaimOtherStripes(
+    const Stripe& reclaimed_stripe, std::uint64_t safe_epoch) {
+  // Once per epoch advance, so that the nodes of the stripes that are not
+  // changed anymore are destroyed too. Busy stripes reclaim by themselves.
+  auto reclaimed_epoch = reclaimed_epoch_.load();
+  if (reclaimed_epoch >= safe_epoch ||
+      !reclaimed_epoch_.compare_exchange_strong(reclaimed_epoch, safe_epoch)) {
+    return;
+  }
+
+  for (auto& stripe : stripes_) {
+    if (&stripe == &reclaimed_stripe) continue;
+    std::unique_lock lock(stripe.mutex, std::try_to_lock);
+    if (lock.owns_lock()) Reclaim(stripe, safe_epoch);
+  }
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::ReclaimTables() {
+  if (retired_tables_.empty()) return;
+
+  const auto safe_epoch = rcu::impl::TryAdvanceReclamationEpoch();
+  const auto it = std::find_if(retired_tables_.begin(), retired_tables_.end(),
+                               [safe_epoch](const auto& retired) {
+                                 return retired.epoch >= safe_epoch;
+                               });
+  retired_tables_.erase(retired_tables_.begin(), it);
+}
+
+template <typename K, typename V, typename H, typename E>
+template <typename Func>
+void HashMap<K, V, H, E>::VisitBucket(const Table& table, std::size_t index,
+                                      Func& func) const {
+  const auto* node = table.buckets[index].load();
+  if (node == kMigrated) {
+    // The keys of the bucket are now in these two buckets of the next table
+    const Table& next = *table.next.load();
+    VisitBucket(next, index, func);
+    VisitBucket(next, index + table.buckets.size(), func);
+    return;
+  }
+
+  for (; node; node = node->next.load()) func(*node);
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::DeleteChain(Node* node) {
+  while (node) {
+    auto* next = node->next.load();
+    delete node;
+    node = next;
+  }
+}
+
+}  // namespace concurrent
+
+USERVER_NAMESPACE_END
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 #include <userver/engine/deadline.hpp>
+#include <userver/engine/impl/context_accessor.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -46,6 +49,17 @@ class Producer final {
     return queue_->PushNoblock(token_, std::move(value));
   }
 
+  /// Push elements into queue in order, consumers are woken up once per
+  /// pushed batch rather than once per element. May wait asynchronously if
+  /// the queue is full.
+  /// @returns whether all the elements were pushed before the deadline.
+  /// The pushed elements are removed from `values`, the ones that were not
+  /// pushed are left there.
+  bool PushMany(std::vector<ValueType>& values,
+                engine::Deadline deadline = {}) const {
+    return queue_->PushMany(token_, values, deadline);
+  }
+
   /// Const access to source queue.
   std::shared_ptr<const QueueType> Queue() const { return {queue_}; }
 
@@ -92,10 +106,25 @@ class Consumer final {
     return queue_->PopNoblock(token_, value);
   }
 
+  /// Pop up to `max_count` elements from queue and append them to `values`.
+  /// May wait asynchronously for the first element if the queue is empty,
+  /// but the producer is alive, the rest are taken without waiting.
+  /// @returns whether something was popped before the deadline.
+  bool PopMany(std::vector<ValueType>& values, std::size_t max_count,
+               engine::Deadline deadline = {}) const {
+    return queue_->PopMany(token_, values, max_count, deadline);
+  }
+
   /// Const access to source queue.
   std::shared_ptr<const QueueType> Queue() const { return {queue_}; }
 
   /// @cond
+  // Internal helper for WaitAny, the consumer is ready if the queue is
+  // non-empty or all the producers are dead
+  engine::impl::ContextAccessor* TryGetContextAccessor() noexcept {
+    return queue_ ? queue_->GetConsumerContextAccessor() : nullptr;
+  }
+
   // For internal use only
   Consumer(std::shared_ptr<QueueType> queue, EmplaceEnabler /*unused*/)
       : queue_(std::move(queue)), token_(queue_->queue_) {}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/impl/thread_shard.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent::impl {
+
+// Bounded lock-free ring buffer with preallocated slots, an element is
+// constructed right in its slot, so pushes and pops never allocate.
+//
+// Each slot carries a sequence number that tells whether the slot is free for
+// the producer at position `pos` (sequence == pos) or holds the element for
+// the consumer at `pos` (sequence == pos + 1). Multiple producers claim
+// positions with a CAS, a single producer just bumps the position. Only a
+// single consumer is supported, so slots are released strictly in order.
+template <typename T, bool MultipleProducer>
+class RingBuffer final {
+ public:
+  explicit RingBuffer(std::size_t capacity)
+      : mask_(RoundUpToPowerOfTwo(capacity) - 1),
+        slots_(std::make_unique<Slot[]>(mask_ + 1)) {
+    for (std::size_t i = 0; i <= mask_; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  RingBuffer(RingBuffer&&) = delete;
+  RingBuffer& operator=(RingBuffer&&) = delete;
+
+  ~RingBuffer() {
+    // No concurrent pushes or pops by now, the remaining elements are the
+    // ones between the positions
+    const auto end = enqueue_pos_.load(std::memory_order_acquire);
+    for (auto pos = dequeue_pos_.load(std::memory_order_relaxed); pos != end;
+         ++pos) {
+      Slot& slot = slots_[pos & mask_];
+      if (slot.sequence.load(std::memory_order_acquire) == pos + 1) {
+        GetElement(slot).~T();
+      }
+    }
+  }
+
+  std::size_t GetCapacity() const noexcept { return mask_ + 1; }
+
+  // Returns false if the buffer is full
+  [[nodiscard]] bool TryPush(T&& value) {
+    std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    while (true) {
+      slot = &slots_[pos & mask_];
+      const auto sequence = slot->sequence.load(std::memory_order_acquire);
+      if (sequence != pos) {
+        if (!MultipleProducer || sequence < pos) return false;
+        // Another producer took the position
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      } else if constexpr (MultipleProducer) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else {
+        enqueue_pos_.store(pos + 1, std::memory_order_relaxed);
+        break;
+      }
+    }
+
+    new (&slot->storage) T(std::move(value));
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Returns false if the buffer is empty or the next element is still being
+  // pushed. Must be called by a single consumer at a time.
+  [[nodiscard]] bool TryPop(T& value) {
+    return TryConsume([&value](T&& element) { value = std::move(element); });
+  }
+
+  // Appends up to `max_count` elements to `values`, returns their number.
+  // Must be called by a single consumer at a time.
+  std::size_t PopMany(std::vector<T>& values, std::size_t max_count) {
+    std::size_t popped = 0;
+    while (popped < max_count &&
+           TryConsume([&values](T&& element) {
+             values.push_back(std::move(element));
+           })) {
+      ++popped;
+    }
+    return popped;
+  }
+
+ private:
+  struct Slot final {
+    std::atomic<std::size_t> sequence{0};
+    alignas(T) std::byte storage[sizeof(T)];
+  };
+
+  static T& GetElement(Slot& slot) noexcept {
+    return *std::launder(reinterpret_cast<T*>(&slot.storage));
+  }
+
+  // Passes the next element to `consumer` and releases its slot
+  template <typename Consumer>
+  bool TryConsume(Consumer consumer) {
+    const std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[pos & mask_];
+    if (slot.sequence.load(std::memory_order_acquire) != pos + 1) return false;
+
+    T& element = GetElement(slot);
+    consumer(std::move(element));
+    element.~T();
+    slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+    dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  static std::size_t RoundUpToPowerOfTwo(std::size_t value) {
+    UINVARIANT(value <= (std::size_t{1} << 40), "Ring buffer is too big");
+    std::size_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+  }
+
+  const std::size_t mask_;
+  const std::unique_ptr<Slot[]> slots_;
+  alignas(utils::impl::kInterferenceSize)
+      std::atomic<std::size_t> enqueue_pos_{0};
+  alignas(utils::impl::kInterferenceSize)
+      std::atomic<std::size_t> dequeue_pos_{0};
+};
+
+}  // namespace concurrent::impl
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <limits>
 #include <memory>
+#include <vector>
 
 #include <boost/lockfree/queue.hpp>
 
@@ -70,7 +71,8 @@ struct QueueHelper<std::unique_ptr<T>> {
 ///
 /// @see @ref md_en_userver_synchronization
 template <typename T>
-class MpscQueue final : public std::enable_shared_from_this<MpscQueue<T>> {
+class MpscQueue final : public std::enable_shared_from_this<MpscQueue<T>>,
+                        private engine::impl::ContextAccessor {
   using QueueHelper = impl::QueueHelper<T>;
 
   using ProducerToken = impl::NoToken;
@@ -152,14 +154,35 @@ class MpscQueue final : public std::enable_shared_from_this<MpscQueue<T>> {
   bool Push(ProducerToken&, T&&, engine::Deadline);
   bool PushNoblock(ProducerToken&, T&&);
   bool DoPush(ProducerToken&, T&&);
+  bool PushMany(ProducerToken&, std::vector<T>&, engine::Deadline);
 
   bool Pop(ConsumerToken&, T&, engine::Deadline);
   bool PopNoblock(ConsumerToken&, T&);
   bool DoPop(ConsumerToken&, T&);
+  bool PopMany(ConsumerToken&, std::vector<T>&, std::size_t, engine::Deadline);
 
   void MarkConsumerIsDead();
   void MarkProducerIsDead();
 
+  engine::impl::ContextAccessor* GetConsumerContextAccessor() noexcept {
+    return this;
+  }
+
+  // Pop would not block
+  bool IsReady() const noexcept override {
+    return size_.load() != 0 || producer_is_created_and_dead_.load();
+  }
+
+  void AppendWaiter(engine::impl::TaskContext& context) noexcept override {
+    nonempty_event_.TryGetContextAccessor()->AppendWaiter(context);
+  }
+
+  void RemoveWaiter(engine::impl::TaskContext& context) noexcept override {
+    nonempty_event_.TryGetContextAccessor()->RemoveWaiter(context);
+  }
+
+  void RethrowErrorResult() const override {}
+
   // Resolves to boost::lockfree::queue<T> except for std::unique_ptr<T>
   // specialization. In that case, resolves to boost::lockfree::queue<T*>
   typename QueueHelper::LockFreeQueue queue_{1};
@@ -265,6 +288,40 @@ bool MpscQueue<T>::DoPush(ProducerToken& /*unused*/, T&& value) {
   return true;
 }
 
+template <typename T>
+bool MpscQueue<T>::PushMany(ProducerToken& /*unused*/, std::vector<T>& values,
+                            engine::Deadline deadline) {
+  std::size_t pushed = 0;
+  while (pushed < values.size()) {
+    if (engine::current_task::ShouldCancel() ||
+        !remaining_capacity_.try_lock_shared_until(deadline)) {
+      break;
+    }
+
+    // Takes as much of the remaining capacity as is available without waiting
+    std::size_t acquired = 1;
+    while (pushed + acquired < values.size() &&
+           remaining_capacity_.try_lock_shared()) {
+      ++acquired;
+    }
+
+    if (consumer_is_created_and_dead_) {
+      remaining_capacity_.unlock_shared_count(acquired);
+      break;
+    }
+
+    for (std::size_t i = 0; i < acquired; ++i) {
+      QueueHelper::Push(queue_, std::move(values[pushed + i]));
+    }
+    pushed += acquired;
+    size_ += acquired;
+    nonempty_event_.Send();
+  }
+
+  values.erase(values.begin(), values.begin() + pushed);
+  return values.empty();
+}
+
 template <typename T>
 bool MpscQueue<T>::Pop(ConsumerToken& token, T& value,
                        engine::Deadline deadline) {
@@ -296,6 +353,28 @@ bool MpscQueue<T>::DoPop(ConsumerToken& /*unused*/, T& value) {
   return false;
 }
 
+template <typename T>
+bool MpscQueue<T>::PopMany(ConsumerToken& token, std::vector<T>& values,
+                           std::size_t max_count, engine::Deadline deadline) {
+  if (max_count == 0) return false;
+
+  T value;
+  if (!Pop(token, value, deadline)) return false;
+  values.push_back(std::move(value));
+
+  std::size_t popped = 0;
+  while (popped + 1 < max_count && QueueHelper::Pop(queue_, value)) {
+    values.push_back(std::move(value));
+    ++popped;
+  }
+  if (popped != 0) {
+    size_ -= popped;
+    remaining_capacity_.unlock_shared_count(popped);
+    nonempty_event_.Reset();
+  }
+  return true;
+}
+
 template <typename T>
 void MpscQueue<T>::MarkConsumerIsDead() {
   consumer_is_created_and_dead_ = true;
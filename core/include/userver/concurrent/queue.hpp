@@ -1,12 +1,16 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <iterator>
 #include <limits>
 #include <memory>
+#include <vector>
 
 #include <moodycamel/concurrentqueue.h>
 
 #include <userver/concurrent/impl/queue_helpers.hpp>
+#include <userver/concurrent/impl/ring_buffer.hpp>
 #include <userver/concurrent/impl/semaphore_capacity_control.hpp>
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/semaphore.hpp>
@@ -23,30 +27,43 @@ namespace impl {
 
 class MultiProducerToken final {
  public:
-  template <typename T, typename Traits>
-  explicit MultiProducerToken(moodycamel::ConcurrentQueue<T, Traits>&) {}
+  template <typename LockFreeQueue>
+  explicit MultiProducerToken(LockFreeQueue&) {}
 };
 
 }  // namespace impl
 
 /// Queue with single and multi producer/consumer options
 ///
+/// With `UseRingBuffer` the elements are stored in a preallocated ring buffer
+/// of `max_size` rounded up to a power of two slots instead of a growing
+/// lock-free queue, so pushes and pops never allocate. Only a single consumer
+/// is supported in this mode.
+///
 /// @see @ref md_en_userver_synchronization
-template <typename T, bool MultipleProducer, bool MultipleConsumer>
+template <typename T, bool MultipleProducer, bool MultipleConsumer,
+          bool UseRingBuffer = false>
 class GenericQueue final
     : public std::enable_shared_from_this<
-          GenericQueue<T, MultipleProducer, MultipleConsumer>> {
+          GenericQueue<T, MultipleProducer, MultipleConsumer, UseRingBuffer>> {
+  static_assert(!UseRingBuffer || !MultipleConsumer,
+                "Ring buffer queue supports only a single consumer");
+
+  using LockFreeQueue =
+      std::conditional_t<UseRingBuffer, impl::RingBuffer<T, MultipleProducer>,
+                         moodycamel::ConcurrentQueue<T>>;
+
   using ProducerToken =
-      std::conditional_t<MultipleProducer, moodycamel::ProducerToken,
-                         impl::NoToken>;
+      std::conditional_t<MultipleProducer && !UseRingBuffer,
+                         moodycamel::ProducerToken, impl::NoToken>;
   using ConsumerToken =
-      std::conditional_t<MultipleProducer, moodycamel::ConsumerToken,
-                         impl::NoToken>;
+      std::conditional_t<MultipleProducer && !UseRingBuffer,
+                         moodycamel::ConsumerToken, impl::NoToken>;
   using MultiProducerToken = impl::MultiProducerToken;
 
   using SingleProducerToken =
-      std::conditional_t<!MultipleProducer, moodycamel::ProducerToken,
-                         impl::NoToken>;
+      std::conditional_t<!MultipleProducer && !UseRingBuffer,
+                         moodycamel::ProducerToken, impl::NoToken>;
 
   friend class impl::Producer<GenericQueue, ProducerToken>;
   friend class impl::Producer<GenericQueue, MultiProducerToken>;
@@ -65,7 +82,7 @@ class GenericQueue final
   /// @cond
   // For internal use only
   explicit GenericQueue(std::size_t max_size, impl::EmplaceEnabler /*unused*/)
-      : queue_(),
+      : queue_(GetLockFreeQueueSize(max_size)),
         single_producer_token_(queue_),
         producer_side_(*this, std::min(max_size, kUnbounded)),
         consumer_side_(*this) {}
@@ -79,10 +96,13 @@ class GenericQueue final
       consumer_side_.ResumeBlockingOnPop();
     }
 
-    // Clear remaining items in queue
-    T value;
-    ConsumerToken token{queue_};
-    while (consumer_side_.PopNoblock(token, value)) {
+    // Clear remaining items in queue. The ring buffer destroys them in place
+    // by itself, so T is not required to be default constructible.
+    if constexpr (!UseRingBuffer) {
+      T value;
+      ConsumerToken token{queue_};
+      while (consumer_side_.PopNoblock(token, value)) {
+      }
     }
   }
 
@@ -93,6 +113,7 @@ class GenericQueue final
   /// @endcond
 
   /// Create a new queue
+  /// @note A ring buffer queue requires a finite `max_size`
   static std::shared_ptr<GenericQueue> Create(
       std::size_t max_size = kUnbounded) {
     return std::make_shared<GenericQueue>(max_size, impl::EmplaceEnabler{});
@@ -147,8 +168,9 @@ class GenericQueue final
 
   /// @brief Sets the limit on the queue size, pushes over this limit will block
   /// @note This is a soft limit and may be slightly overrun under load.
+  /// @note For a ring buffer queue the limit is capped by the buffer size.
   void SetSoftMaxSize(std::size_t max_size) {
-    producer_side_.SetSoftMaxSize(std::min(max_size, kUnbounded));
+    producer_side_.SetSoftMaxSize(std::min(max_size, GetMaxSizeLimit()));
   }
 
   /// @brief Gets the limit on the queue size
@@ -183,6 +205,15 @@ class GenericQueue final
     return producer_side_.PushNoblock(token, std::move(value));
   }
 
+  template <typename Token>
+  [[nodiscard]] bool PushMany(Token& token, std::vector<T>& values,
+                              engine::Deadline deadline) {
+    const auto pushed =
+        producer_side_.PushMany(token, values.data(), values.size(), deadline);
+    values.erase(values.begin(), values.begin() + pushed);
+    return values.empty();
+  }
+
   [[nodiscard]] bool Pop(ConsumerToken& token, T& value,
                          engine::Deadline deadline) {
     return consumer_side_.Pop(token, value, deadline);
@@ -192,6 +223,37 @@ class GenericQueue final
     return consumer_side_.PopNoblock(token, value);
   }
 
+  [[nodiscard]] bool PopMany(ConsumerToken& token, std::vector<T>& values,
+                             std::size_t max_count, engine::Deadline deadline) {
+    if (max_count == 0) return false;
+    return consumer_side_.PopMany(token, values, max_count, deadline) != 0;
+  }
+
+  engine::impl::ContextAccessor* GetConsumerContextAccessor() noexcept {
+    static_assert(!MultipleConsumer,
+                  "WaitAny is supported only for single-consumer queues, "
+                  "a wakeup of a multi-consumer queue could be stolen");
+    return consumer_side_.GetContextAccessor();
+  }
+
+  static std::size_t GetLockFreeQueueSize(std::size_t max_size) {
+    if constexpr (UseRingBuffer) {
+      UINVARIANT(max_size < kUnbounded,
+                 "Ring buffer queue must be created with a finite max_size");
+      return max_size;
+    } else {
+      return 1;
+    }
+  }
+
+  std::size_t GetMaxSizeLimit() const noexcept {
+    if constexpr (UseRingBuffer) {
+      return queue_.GetCapacity();
+    } else {
+      return kUnbounded;
+    }
+  }
+
   void PrepareProducer() {
     std::size_t old_producers_count{};
     utils::AtomicUpdate(producers_count_, [&](auto old_value) {
@@ -229,9 +291,12 @@ class GenericQueue final
 
   bool NoMoreProducers() const { return producers_count_ == kCreatedAndDead; }
 
+  // May only fail in ring buffer mode if the ring is full
   template <typename Token>
-  void DoPush(Token& token, T&& value) {
-    if constexpr (std::is_same_v<Token, moodycamel::ProducerToken>) {
+  [[nodiscard]] bool DoPush(Token& token, T&& value) {
+    if constexpr (UseRingBuffer) {
+      if (!queue_.TryPush(std::move(value))) return false;
+    } else if constexpr (std::is_same_v<Token, moodycamel::ProducerToken>) {
       static_assert(MultipleProducer);
       queue_.enqueue(token, std::move(value));
     } else if constexpr (std::is_same_v<Token, MultiProducerToken>) {
@@ -244,11 +309,43 @@ class GenericQueue final
     }
 
     consumer_side_.OnElementPushed();
+    return true;
+  }
+
+  // Pushes all the elements, except in ring buffer mode where it stops at the
+  // first element that does not fit. Returns the number of pushed elements.
+  template <typename Token>
+  [[nodiscard]] std::size_t DoPushMany(Token& token, T* values,
+                                       std::size_t count) {
+    std::size_t pushed = count;
+    if constexpr (UseRingBuffer) {
+      pushed = 0;
+      while (pushed < count && queue_.TryPush(std::move(values[pushed]))) {
+        ++pushed;
+      }
+      if (pushed == 0) return 0;
+    } else if constexpr (std::is_same_v<Token, moodycamel::ProducerToken>) {
+      static_assert(MultipleProducer);
+      queue_.enqueue_bulk(token, std::make_move_iterator(values), count);
+    } else if constexpr (std::is_same_v<Token, MultiProducerToken>) {
+      static_assert(MultipleProducer);
+      queue_.enqueue_bulk(std::make_move_iterator(values), count);
+    } else {
+      static_assert(std::is_same_v<Token, impl::NoToken>);
+      static_assert(!MultipleProducer);
+      queue_.enqueue_bulk(single_producer_token_,
+                          std::make_move_iterator(values), count);
+    }
+
+    consumer_side_.OnElementsPushed(pushed);
+    return pushed;
   }
 
   [[nodiscard]] bool DoPop(ConsumerToken& token, T& value) {
     bool success = false;
-    if constexpr (MultipleProducer) {
+    if constexpr (UseRingBuffer) {
+      success = queue_.TryPop(value);
+    } else if constexpr (MultipleProducer) {
       success = queue_.try_dequeue(token, value);
     } else {
       // Substitute with our single producer token
@@ -263,7 +360,26 @@ class GenericQueue final
     return false;
   }
 
-  moodycamel::ConcurrentQueue<T> queue_{1};
+  // Returns the number of elements appended to `values`
+  [[nodiscard]] std::size_t DoPopMany(ConsumerToken& token,
+                                      std::vector<T>& values,
+                                      std::size_t max_count) {
+    std::size_t popped = 0;
+    if constexpr (UseRingBuffer) {
+      popped = queue_.PopMany(values, max_count);
+    } else if constexpr (MultipleProducer) {
+      popped =
+          queue_.try_dequeue_bulk(token, std::back_inserter(values), max_count);
+    } else {
+      popped = queue_.try_dequeue_bulk_from_producer(
+          single_producer_token_, std::back_inserter(values), max_count);
+    }
+
+    if (popped != 0) producer_side_.OnElementsPopped(popped);
+    return popped;
+  }
+
+  LockFreeQueue queue_;
   std::atomic<std::size_t> consumers_count_{0};
   std::atomic<std::size_t> producers_count_{0};
 
@@ -279,8 +395,8 @@ class GenericQueue final
 };
 
 // Single-producer ProducerSide implementation
-template <typename T, bool MP, bool MC>
-class GenericQueue<T, MP, MC>::SingleProducerSide final {
+template <typename T, bool MP, bool MC, bool RB>
+class GenericQueue<T, MP, MC, RB>::SingleProducerSide final {
  public:
   explicit SingleProducerSide(GenericQueue& queue, std::size_t capacity)
       : queue_(queue), used_capacity_(0), total_capacity_(capacity) {}
@@ -303,11 +419,35 @@ class GenericQueue<T, MP, MC>::SingleProducerSide final {
     return DoPush(token, std::move(value));
   }
 
+  // Pushes as many elements as fit at once, then waits for space for the rest
+  template <typename Token>
+  [[nodiscard]] std::size_t PushMany(Token& token, T* values,
+                                     std::size_t count,
+                                     engine::Deadline deadline) {
+    std::size_t pushed = 0;
+    while (pushed < count) {
+      const auto pushed_now =
+          DoPushMany(token, values + pushed, count - pushed);
+      pushed += pushed_now;
+      if (pushed_now == 0 &&
+          (queue_.NoMoreConsumers() ||
+           !non_full_event_.WaitForEventUntil(deadline))) {
+        break;
+      }
+    }
+    return pushed;
+  }
+
   void OnElementPopped() {
     --used_capacity_;
     non_full_event_.Send();
   }
 
+  void OnElementsPopped(std::size_t count) {
+    used_capacity_ -= count;
+    non_full_event_.Send();
+  }
+
   void StopBlockingOnPush() {
     total_capacity_ += kSemaphoreUnlockValue;
     non_full_event_.Send();
@@ -331,11 +471,31 @@ class GenericQueue<T, MP, MC>::SingleProducerSide final {
     }
 
     ++used_capacity_;
-    queue_.DoPush(token, std::move(value));
+    if (!queue_.DoPush(token, std::move(value))) {
+      --used_capacity_;
+      return false;
+    }
     non_full_event_.Reset();
     return true;
   }
 
+  template <typename Token>
+  [[nodiscard]] std::size_t DoPushMany(Token& token, T* values,
+                                       std::size_t count) {
+    const auto used_capacity = used_capacity_.load();
+    const auto total_capacity = total_capacity_.load();
+    if (queue_.NoMoreConsumers() || used_capacity >= total_capacity) {
+      return 0;
+    }
+
+    const auto acquired = std::min(count, total_capacity - used_capacity);
+    used_capacity_ += acquired;
+    const auto pushed = queue_.DoPushMany(token, values, acquired);
+    used_capacity_ -= acquired - pushed;
+    if (pushed != 0) non_full_event_.Reset();
+    return pushed;
+  }
+
   GenericQueue& queue_;
   engine::SingleConsumerEvent non_full_event_;
   std::atomic<std::size_t> used_capacity_;
@@ -343,8 +503,8 @@ class GenericQueue<T, MP, MC>::SingleProducerSide final {
 };
 
 // Multi producer ProducerSide implementation
-template <typename T, bool MP, bool MC>
-class GenericQueue<T, MP, MC>::MultiProducerSide final {
+template <typename T, bool MP, bool MC, bool RB>
+class GenericQueue<T, MP, MC, RB>::MultiProducerSide final {
  public:
   explicit MultiProducerSide(GenericQueue& queue, std::size_t capacity)
       : queue_(queue),
@@ -366,8 +526,46 @@ class GenericQueue<T, MP, MC>::MultiProducerSide final {
            DoPush(token, std::move(value));
   }
 
+  // Waits for space for at least one element, then takes as much of the
+  // remaining capacity as is available without waiting, in one acquisition
+  template <typename Token>
+  [[nodiscard]] std::size_t PushMany(Token& token, T* values,
+                                     std::size_t count,
+                                     engine::Deadline deadline) {
+    std::size_t pushed = 0;
+    while (pushed < count) {
+      if (engine::current_task::ShouldCancel() ||
+          !remaining_capacity_.try_lock_shared_until(deadline)) {
+        break;
+      }
+
+      const auto remaining = count - pushed;
+      std::size_t acquired = 1;
+      if (remaining > 1 &&
+          remaining_capacity_.try_lock_shared_count(remaining - 1)) {
+        acquired = remaining;
+      } else {
+        const auto available =
+            std::min(remaining - 1, remaining_capacity_.RemainingApprox());
+        if (available != 0 &&
+            remaining_capacity_.try_lock_shared_count(available)) {
+          acquired += available;
+        }
+      }
+
+      const auto pushed_now = DoPushMany(token, values + pushed, acquired);
+      if (pushed_now == 0) break;
+      pushed += pushed_now;
+    }
+    return pushed;
+  }
+
   void OnElementPopped() { remaining_capacity_.unlock_shared(); }
 
+  void OnElementsPopped(std::size_t count) {
+    remaining_capacity_.unlock_shared_count(count);
+  }
+
   void StopBlockingOnPush() {
     remaining_capacity_control_.SetCapacityOverride(0);
   }
@@ -387,23 +585,35 @@ class GenericQueue<T, MP, MC>::MultiProducerSide final {
  private:
   template <typename Token>
   [[nodiscard]] bool DoPush(Token& token, T&& value) {
-    if (queue_.NoMoreConsumers()) {
+    if (queue_.NoMoreConsumers() || !queue_.DoPush(token, std::move(value))) {
       remaining_capacity_.unlock_shared();
       return false;
     }
-
-    queue_.DoPush(token, std::move(value));
     return true;
   }
 
+  template <typename Token>
+  [[nodiscard]] std::size_t DoPushMany(Token& token, T* values,
+                                       std::size_t acquired) {
+    std::size_t pushed = 0;
+    if (!queue_.NoMoreConsumers()) {
+      pushed = queue_.DoPushMany(token, values, acquired);
+    }
+    if (pushed != acquired) {
+      remaining_capacity_.unlock_shared_count(acquired - pushed);
+    }
+    return pushed;
+  }
+
   GenericQueue& queue_;
   engine::Semaphore remaining_capacity_;
   concurrent::impl::SemaphoreCapacityControl remaining_capacity_control_;
 };
 
 // Single consumer ConsumerSide implementation
-template <typename T, bool MP, bool MC>
-class GenericQueue<T, MP, MC>::SingleConsumerSide final {
+template <typename T, bool MP, bool MC, bool RB>
+class GenericQueue<T, MP, MC, RB>::SingleConsumerSide final
+    : private engine::impl::ContextAccessor {
  public:
   explicit SingleConsumerSide(GenericQueue& queue) : queue_(queue), size_(0) {}
 
@@ -426,18 +636,57 @@ class GenericQueue<T, MP, MC>::SingleConsumerSide final {
     return DoPop(token, value);
   }
 
+  // Blocks only if queue is empty
+  [[nodiscard]] std::size_t PopMany(ConsumerToken& token,
+                                    std::vector<T>& values,
+                                    std::size_t max_count,
+                                    engine::Deadline deadline) {
+    while (true) {
+      const auto popped = DoPopMany(token, values, max_count);
+      if (popped != 0) return popped;
+
+      if (queue_.NoMoreProducers() ||
+          !nonempty_event_.WaitForEventUntil(deadline)) {
+        // Same TOCTOU as in Pop()
+        return DoPopMany(token, values, max_count);
+      }
+    }
+  }
+
   void OnElementPushed() {
     ++size_;
     nonempty_event_.Send();
   }
 
+  void OnElementsPushed(std::size_t count) {
+    size_ += count;
+    nonempty_event_.Send();
+  }
+
   void StopBlockingOnPop() { nonempty_event_.Send(); }
 
   void ResumeBlockingOnPop() {}
 
   std::size_t GetSize() const { return size_; }
 
+  engine::impl::ContextAccessor* GetContextAccessor() noexcept { return this; }
+
  private:
+  // Pop would not block
+  bool IsReady() const noexcept override {
+    return size_.load() != 0 || queue_.NoMoreProducers();
+  }
+
+  void AppendWaiter(engine::impl::TaskContext& context) noexcept override {
+    nonempty_event_.TryGetContextAccessor()->AppendWaiter(context);
+  }
+
+  void RemoveWaiter(engine::impl::TaskContext& context) noexcept override {
+    nonempty_event_.TryGetContextAccessor()->RemoveWaiter(context);
+  }
+
+  void RethrowErrorResult() const override {}
+
   [[nodiscard]] bool DoPop(ConsumerToken& token, T& value) {
     if (queue_.DoPop(token, value)) {
       --size_;
@@ -447,14 +696,25 @@ class GenericQueue<T, MP, MC>::SingleConsumerSide final {
     return false;
   }
 
+  [[nodiscard]] std::size_t DoPopMany(ConsumerToken& token,
+                                      std::vector<T>& values,
+                                      std::size_t max_count) {
+    const auto popped = queue_.DoPopMany(token, values, max_count);
+    if (popped != 0) {
+      size_ -= popped;
+      nonempty_event_.Reset();
+    }
+    return popped;
+  }
+
   GenericQueue& queue_;
   engine::SingleConsumerEvent nonempty_event_;
   std::atomic<std::size_t> size_;
 };
 
 // Multi consumer ConsumerSide implementation
-template <typename T, bool MP, bool MC>
-class GenericQueue<T, MP, MC>::MultiConsumerSide final {
+template <typename T, bool MP, bool MC, bool RB>
+class GenericQueue<T, MP, MC, RB>::MultiConsumerSide final {
  public:
   explicit MultiConsumerSide(GenericQueue& queue)
       : queue_(queue), size_(kUnbounded), size_control_(size_) {
@@ -474,8 +734,36 @@ class GenericQueue<T, MP, MC>::MultiConsumerSide final {
     return size_.try_lock_shared() && DoPop(token, value);
   }
 
+  // Blocks only if queue is empty
+  [[nodiscard]] std::size_t PopMany(ConsumerToken& token,
+                                    std::vector<T>& values,
+                                    std::size_t max_count,
+                                    engine::Deadline deadline) {
+    if (!size_.try_lock_shared_until(deadline)) return 0;
+
+    // Takes the rest of the batch at once, or as many elements as the queue
+    // seems to hold if it has less
+    std::size_t acquired = 1;
+    if (max_count > 1) {
+      if (size_.try_lock_shared_count(max_count - 1)) {
+        acquired = max_count;
+      } else {
+        const auto available = std::min(max_count - 1, GetSize());
+        if (available != 0 && size_.try_lock_shared_count(available)) {
+          acquired += available;
+        }
+      }
+    }
+
+    const auto popped = queue_.DoPopMany(token, values, acquired);
+    if (popped != acquired) size_.unlock_shared_count(acquired - popped);
+    return popped;
+  }
+
   void OnElementPushed() { size_.unlock_shared(); }
 
+  void OnElementsPushed(std::size_t count) { size_.unlock_shared_count(count); }
+
   void StopBlockingOnPop() {
     size_control_.SetCapacityOverride(kUnbounded + kSemaphoreUnlockValue);
   }
@@ -548,6 +836,30 @@ using SpmcQueue = GenericQueue<T, false, true>;
 template <typename T>
 using SpscQueue = GenericQueue<T, false, false>;
 
+/// @ingroup userver_concurrency
+///
+/// @brief Bounded multiple producers single consumer queue on top of a
+/// preallocated ring buffer.
+///
+/// Unlike concurrent::NonFifoMpscQueue, items are delivered in the order in
+/// which producers claimed the slots, and neither Push nor Pop allocate.
+/// `max_size` passed to Create() is mandatory and is rounded up to a power of
+/// two to get the ring buffer size.
+///
+/// @see @ref md_en_userver_synchronization
+template <typename T>
+using BoundedMpscQueue = GenericQueue<T, true, false, true>;
+
+/// @ingroup userver_concurrency
+///
+/// @brief Bounded single producer single consumer queue on top of a
+/// preallocated ring buffer.
+///
+/// @see concurrent::BoundedMpscQueue
+/// @see @ref md_en_userver_synchronization
+template <typename T>
+using BoundedSpscQueue = GenericQueue<T, false, false, true>;
+
 }  // namespace concurrent
 
 USERVER_NAMESPACE_END
@@ -4,6 +4,7 @@
 /// @brief Common definitions and base classes for stream like objects
 
 #include <cstddef>
+#include <initializer_list>
 #include <memory>
 
 #include <userver/engine/deadline.hpp>
@@ -15,6 +16,12 @@ namespace engine::io {
 /// File descriptor of an invalid pipe end.
 static constexpr int kInvalidFd = -1;
 
+/// IoData for vector send
+struct IoData final {
+  const void* data;
+  size_t len;
+};
+
 /// @ingroup userver_base_classes
 ///
 /// Interface for readable streams
@@ -52,6 +59,11 @@ class WritableBase {
   /// @note Can return less than len if stream is closed by peer.
   [[nodiscard]] virtual size_t WriteAll(const void* buf, size_t len,
                                         Deadline deadline) = 0;
+
+  /// @brief Sends the buffers one after another.
+  /// @note Can return less than the total size if stream is closed by peer.
+  [[nodiscard]] virtual size_t WriteAll(std::initializer_list<IoData> list,
+                                        Deadline deadline);
 };
 
 /// @ingroup userver_base_classes
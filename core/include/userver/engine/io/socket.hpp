@@ -5,6 +5,7 @@
 
 #include <sys/socket.h>
 
+#include <cstdint>
 #include <initializer_list>
 
 #include <userver/engine/deadline.hpp>
@@ -27,10 +28,29 @@ enum class SocketType {
   kUdp = kDgram,
 };
 
-/// IoData for vector send
-struct IoData final {
-  const void* data;
-  size_t len;
+/// @brief A datagram for batched Socket::RecvMany and Socket::SendMany
+///
+/// For RecvMany `data` and `len` describe the buffer to receive to, `addr`,
+/// `bytes_received` and `segment_size` are filled on return. For SendMany
+/// `data` and `len` describe the payload to send to `addr`.
+struct Datagram final {
+  void* data{nullptr};
+  size_t len{0};
+
+  /// Source address for RecvMany. Destination address for SendMany, the
+  /// connected peer is used if the domain is AddrDomain::kUnspecified.
+  Sockaddr addr;
+
+  /// Received bytes count, set by RecvMany
+  size_t bytes_received{0};
+
+  /// @brief UDP segment size, 0 if the payload is a single datagram
+  ///
+  /// For SendMany the kernel splits the payload into datagrams of this size
+  /// (UDP GSO). RecvMany sets it if the kernel coalesced several datagrams
+  /// of this size into the buffer, which requires UDP_GRO option to be set on
+  /// the socket. Linux only.
+  std::uint16_t segment_size{0};
 };
 
 /// @brief Socket representation.
@@ -122,6 +142,27 @@ class USERVER_NODISCARD Socket final : public RwBase {
   [[nodiscard]] size_t SendAllTo(const Sockaddr& dest_addr, const void* buf,
                                  size_t len, Deadline deadline);
 
+  /// @brief Receives up to `count` datagrams with a single system call.
+  ///
+  /// Waits for at least one datagram and receives as many of the already
+  /// available ones as fit into `datagrams`. Datagrams that do not fit into
+  /// their buffers are truncated.
+  /// @returns number of received datagrams, `bytes_received`, `addr` and
+  /// `segment_size` of them are set.
+  /// @note Not for SocketType::kStream connections, see `man recvmmsg`.
+  /// @snippet src/engine/io/socket_test.cpp send receive many
+  [[nodiscard]] size_t RecvMany(Datagram* datagrams, size_t count,
+                                Deadline deadline);
+
+  /// @brief Sends `count` datagrams, batching them into as few system calls
+  /// as possible.
+  /// @returns number of sent datagrams, less than `count` only if an error
+  /// occurred after some of the datagrams were sent.
+  /// @note Sockaddr domains must match the socket's domain.
+  /// @note Not for SocketType::kStream connections, see `man sendmmsg`.
+  [[nodiscard]] size_t SendMany(const Datagram* datagrams, size_t count,
+                                Deadline deadline);
+
   /// File descriptor corresponding to this socket.
   int Fd() const;
 
@@ -167,6 +208,13 @@ class USERVER_NODISCARD Socket final : public RwBase {
     return SendAll(buf, len, deadline);
   }
 
+  /// @brief Writes a buffer vector to the socket.
+  /// @note Can return less than the total size if socket is closed by peer.
+  [[nodiscard]] size_t WriteAll(std::initializer_list<IoData> list,
+                                Deadline deadline) override {
+    return SendAll(list, deadline);
+  }
+
  private:
   AddrDomain domain_{AddrDomain::kUnspecified};
 
@@ -3,6 +3,11 @@
 /// @file userver/engine/io/tls_wrapper.hpp
 /// @brief TLS socket wrappers
 
+#include <chrono>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -18,6 +23,56 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::io {
 
+/// @brief Server side TLS context shared by the connections
+///
+/// Keeps the server certificate and key along with the TLS session cache and
+/// the session ticket keys, so the clients may resume their sessions on new
+/// connections without a full handshake.
+///
+/// Thread safe, cheap to copy.
+class TlsServerContext final {
+ public:
+  struct Settings {
+    /// Max sessions count in the server side session cache, 0 disables the
+    /// cache
+    std::size_t session_cache_size{20 * 1024};
+
+    /// Lifetime of the cached sessions and of the session tickets
+    std::chrono::seconds session_timeout{300};
+
+    /// Whether to issue session tickets, that allow resumption without
+    /// the server side session cache
+    bool session_tickets{true};
+
+    /// Protocols to select from the client ALPN list, in the order of
+    /// preference
+    std::vector<std::string> alpn_protocols;
+  };
+
+  /// @throws TlsException if the certificate does not match the key
+  TlsServerContext(
+      const crypto::Certificate& cert, const crypto::PrivateKey& key,
+      const Settings& settings,
+      const std::vector<crypto::Certificate>& cert_authorities = {});
+
+  /// @brief Creates a context with the same settings and another certificate
+  ///
+  /// Session tickets issued by this context remain valid in the new one,
+  /// the session cache is not carried over.
+  /// @throws TlsException if the certificate does not match the key
+  TlsServerContext WithCertificate(
+      const crypto::Certificate& cert, const crypto::PrivateKey& key,
+      const std::vector<crypto::Certificate>& cert_authorities = {}) const;
+
+ private:
+  friend class TlsWrapper;
+
+  class Impl;
+  explicit TlsServerContext(std::shared_ptr<const Impl> impl);
+
+  std::shared_ptr<const Impl> impl_;
+};
+
 /// Class for TLS communications over a Socket.
 ///
 /// Not thread safe.
@@ -37,6 +92,14 @@ class USERVER_NODISCARD TlsWrapper final : public RwBase {
       const crypto::PrivateKey& key, Deadline deadline,
       const std::vector<crypto::Certificate>& cert_authorities = {});
 
+  /// @brief Starts a TLS server on an opened socket with a shared context
+  ///
+  /// Unlike the overload above, allows the clients to resume the sessions
+  /// established on other connections with the same context.
+  static TlsWrapper StartTlsServer(Socket&& socket,
+                                   const TlsServerContext& context,
+                                   Deadline deadline);
+
   ~TlsWrapper() override;
 
   TlsWrapper(const TlsWrapper&) = delete;
@@ -67,6 +130,42 @@ class USERVER_NODISCARD TlsWrapper final : public RwBase {
   /// @note Can return less than len if socket is closed by peer.
   [[nodiscard]] size_t SendAll(const void* buf, size_t len, Deadline deadline);
 
+  /// @brief Sends a buffer vector to the socket.
+  ///
+  /// Small buffers are coalesced to be sent in a single TLS record.
+  /// @note Can return less than the total size if socket is closed by peer.
+  [[nodiscard]] size_t SendAll(std::initializer_list<IoData> list,
+                               Deadline deadline);
+
+  /// @brief Sends the data that the socket accepts without waiting for it.
+  ///
+  /// Unlike SendAll() does not break the session if the socket is full, but
+  /// the call must be repeated with the same arguments after
+  /// WaitSocketWriteable() then, the following sends fail otherwise.
+  /// @returns sent bytes count, 0 if socket is closed by peer, std::nullopt
+  /// if nothing could be sent without waiting.
+  [[nodiscard]] std::optional<size_t> TrySendSome(const void* buf, size_t len);
+
+  /// Whether the session was resumed from the session cache or a ticket
+  bool IsSessionReused() const;
+
+  /// The protocol selected by ALPN, empty if none
+  std::string GetAlpnProtocol() const;
+
+  /// @brief Suspends current task until the underlying socket has data
+  /// available.
+  ///
+  /// Unlike WaitReadable() does not use the TLS session and ignores the
+  /// data that is already read and buffered by it.
+  [[nodiscard]] bool WaitSocketReadable(Deadline deadline);
+
+  /// @brief Suspends current task until the underlying socket can accept
+  /// more data.
+  ///
+  /// Unlike WaitWriteable() does not check the TLS session, so it may be
+  /// called concurrently with the session calls of another task.
+  [[nodiscard]] bool WaitSocketWriteable(Deadline deadline);
+
   /// @brief Finishes TLS session and returns the socket.
   /// @warning Wrapper becomes invalid on entry and can only be used to retry
   ///   socket extraction if interrupted.
@@ -94,6 +193,13 @@ class USERVER_NODISCARD TlsWrapper final : public RwBase {
     return SendAll(buf, len, deadline);
   }
 
+  /// @brief Writes a buffer vector to the socket.
+  /// @note Can return less than the total size if socket is closed by peer.
+  [[nodiscard]] size_t WriteAll(std::initializer_list<IoData> list,
+                                Deadline deadline) override {
+    return SendAll(list, deadline);
+  }
+
  private:
   explicit TlsWrapper(Socket&&);
 
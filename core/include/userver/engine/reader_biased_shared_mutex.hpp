@@ -0,0 +1,124 @@
+#pragma once
+
+/// @file userver/engine/reader_biased_shared_mutex.hpp
+/// @brief @copybrief engine::ReaderBiasedSharedMutex
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/shared_mutex.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/impl/thread_shard.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+/// @ingroup userver_concurrency
+///
+/// @brief std::shared_mutex replacement for asynchronous tasks, that is
+/// optimized for read-mostly data
+///
+/// Readers are counted in per-thread shards, each on its own cache line, so
+/// that concurrent readers do not contend with each other while there is no
+/// writer. A writer revokes the reader bias and waits for the shards to drain.
+/// If writes are frequent, the bias is not restored for some time after a
+/// revocation, and readers go through an engine::SharedMutex.
+///
+/// Writes are slower than the ones of engine::SharedMutex and each mutex
+/// takes a cache line per hardware thread, so use it only for data that is
+/// read far more often than written and only after benchmarking.
+///
+/// ## Example usage:
+///
+/// @snippet engine/reader_biased_shared_mutex_test.cpp  Sample engine::ReaderBiasedSharedMutex usage
+///
+/// @see @ref md_en_userver_synchronization
+class ReaderBiasedSharedMutex final {
+ public:
+  ReaderBiasedSharedMutex();
+  ~ReaderBiasedSharedMutex();
+
+  ReaderBiasedSharedMutex(const ReaderBiasedSharedMutex&) = delete;
+  ReaderBiasedSharedMutex(ReaderBiasedSharedMutex&&) = delete;
+  ReaderBiasedSharedMutex& operator=(const ReaderBiasedSharedMutex&) = delete;
+  ReaderBiasedSharedMutex& operator=(ReaderBiasedSharedMutex&&) = delete;
+
+  void lock();
+  void unlock();
+
+  bool try_lock();
+
+  template <typename Rep, typename Period>
+  bool try_lock_for(const std::chrono::duration<Rep, Period>&);
+
+  template <typename Clock, typename Duration>
+  bool try_lock_until(const std::chrono::time_point<Clock, Duration>&);
+
+  bool try_lock_until(Deadline deadline);
+
+  void lock_shared();
+  void unlock_shared();
+  bool try_lock_shared();
+
+  template <typename Rep, typename Period>
+  bool try_lock_shared_for(const std::chrono::duration<Rep, Period>&);
+
+  template <typename Clock, typename Duration>
+  bool try_lock_shared_until(const std::chrono::time_point<Clock, Duration>&);
+
+  bool try_lock_shared_until(Deadline deadline);
+
+ private:
+  struct alignas(utils::impl::kInterferenceSize) ReadersShard final {
+    std::atomic<std::int64_t> count{0};
+  };
+
+  std::atomic<std::int64_t>& GetCurrentShard() noexcept;
+  std::int64_t GetReadersCount() const noexcept;
+  bool TryLockSharedBiased() noexcept;
+  void LockSharedUnderUnderlyingLock() noexcept;
+  bool WaitForReadersToDrain(Deadline deadline);
+
+  // Readers are counted in the shards in both biased and unbiased modes, a
+  // reader may unlock on a different thread, so only the sum makes sense
+  utils::FixedArray<ReadersShard> readers_;
+
+  alignas(utils::impl::kInterferenceSize) std::atomic<bool> read_bias_{true};
+  std::atomic<std::chrono::steady_clock::rep> inhibit_bias_until_{0};
+
+  // Serializes writers and parks readers while the bias is revoked
+  SharedMutex underlying_;
+  SingleConsumerEvent readers_drained_;
+};
+
+template <typename Rep, typename Period>
+bool ReaderBiasedSharedMutex::try_lock_for(
+    const std::chrono::duration<Rep, Period>& duration) {
+  return try_lock_until(Deadline::FromDuration(duration));
+}
+
+template <typename Rep, typename Period>
+bool ReaderBiasedSharedMutex::try_lock_shared_for(
+    const std::chrono::duration<Rep, Period>& duration) {
+  return try_lock_shared_until(Deadline::FromDuration(duration));
+}
+
+template <typename Clock, typename Duration>
+bool ReaderBiasedSharedMutex::try_lock_until(
+    const std::chrono::time_point<Clock, Duration>& until) {
+  return try_lock_until(Deadline::FromTimePoint(until));
+}
+
+template <typename Clock, typename Duration>
+bool ReaderBiasedSharedMutex::try_lock_shared_until(
+    const std::chrono::time_point<Clock, Duration>& until) {
+  return try_lock_shared_until(Deadline::FromTimePoint(until));
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
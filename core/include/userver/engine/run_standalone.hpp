@@ -20,6 +20,7 @@ struct TaskProcessorPoolsConfig final {
   std::string ev_thread_name = "ev";
   bool ev_default_loop_disabled = false;
   bool defer_events = true;
+  bool ev_io_uring_enabled = false;
 };
 
 /// @brief Runs a payload in a temporary coroutine engine instance.
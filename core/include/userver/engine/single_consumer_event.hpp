@@ -7,6 +7,7 @@
 #include <chrono>
 
 #include <userver/engine/deadline.hpp>
+#include <userver/engine/impl/context_accessor.hpp>
 #include <userver/engine/impl/wait_list_fwd.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -16,7 +17,11 @@ namespace engine {
 /// @ingroup userver_concurrency
 ///
 /// @brief A multiple-producers, single-consumer event
-class SingleConsumerEvent final {
+///
+/// The event can be waited for along with tasks, futures and queues in
+/// engine::WaitAny. It is not reset by engine::WaitAny, the signal is consumed
+/// by the following WaitForEvent* call.
+class SingleConsumerEvent final : private impl::ContextAccessor {
  public:
   struct NoAutoReset final {};
 
@@ -67,11 +72,20 @@ class SingleConsumerEvent final {
   void Send();
 
   /// Returns `true` iff already signaled. Never resets the signal.
-  bool IsReady() const noexcept;
+  bool IsReady() const noexcept override;
+
+  /// @cond
+  // Internal helper for WaitAny
+  impl::ContextAccessor* TryGetContextAccessor() noexcept { return this; }
+  /// @endcond
 
  private:
   class EventWaitStrategy;
 
+  void AppendWaiter(impl::TaskContext& context) noexcept override;
+  void RemoveWaiter(impl::TaskContext& context) noexcept override;
+  void RethrowErrorResult() const override;
+
   bool GetIsSignaled() noexcept;
 
   impl::FastPimplWaitListLight waiters_;
@@ -47,6 +47,17 @@ class USERVER_NODISCARD Task {
     kCritical,
   };
 
+  /// Task scheduling priority within its TaskProcessor
+  enum class Priority {
+    /// Latency-sensitive work, e.g. request handling
+    kNormal,
+
+    /// Background work, e.g. periodic updates. Such tasks are dequeued less
+    /// often than kNormal ones while both are pending, so that they do not
+    /// delay latency-sensitive tasks on a busy TaskProcessor.
+    kBackground,
+  };
+
   /// Task state
   enum class State {
     kInvalid,    ///< Unusable
@@ -203,6 +214,14 @@ void AccountSpuriousWakeup();
 /// Returns task coroutine stack size
 size_t GetStackSize();
 
+/// Returns scheduling priority of the current task
+Task::Priority GetPriority();
+
+/// @brief Changes scheduling priority of the current task.
+///
+/// Tasks started from the current task afterwards inherit the new priority.
+void SetPriority(Task::Priority priority);
+
 }  // namespace current_task
 
 template <typename Rep, typename Period>
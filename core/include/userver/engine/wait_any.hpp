@@ -26,7 +26,14 @@ namespace engine {
 /// Works with different types of tasks and futures:
 /// @snippet src/engine/wait_any_test.cpp sample waitany
 ///
-/// @param tasks either a single container, or a pack of future-like elements.
+/// Also works with engine::SingleConsumerEvent and consumers of
+/// single-consumer queues, e.g. concurrent::SpscQueue, so that a single task
+/// could multiplex several channels without helper tasks. A consumer is
+/// ready if a Pop would not block. Waiting does not consume anything:
+/// @snippet src/engine/wait_any_test.cpp sample waitany channels
+///
+/// @param tasks either a single container, or a pack of future-like elements,
+/// events and queue consumers.
 /// @returns the index of the completed task, or `std::nullopt` if there are no
 /// completed tasks (possible if current task was cancelled).
 template <typename... Tasks>
@@ -0,0 +1,100 @@
+#pragma once
+
+/// @file userver/fs/file_descriptor.hpp
+/// @brief @copybrief fs::FileDescriptor
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/fs/blocking/open_mode.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+class IoUring;
+}  // namespace engine::ev
+
+namespace fs {
+
+/// @ingroup userver_containers
+///
+/// @brief A file descriptor wrapper for reading and writing files in chunks
+/// from coroutines
+///
+/// If the event threads use io_uring (`event_thread_pool.io_backend:
+/// io-uring`) and the kernel supports file reads and writes in io_uring, the
+/// reads, writes and FSync() are done by the kernel asynchronously and the
+/// task waits for them without occupying any thread. Otherwise each
+/// operation is done on `async_tp` like in the other fs:: functions.
+///
+/// Opening the file is always done on `async_tp`. Closing is done in the
+/// current thread, as closing a file that was read or synced is cheap.
+///
+/// @note The operations on the file are not thread-safe. Once started, a
+/// read or a write is not interrupted by the task cancellation.
+class FileDescriptor final {
+ public:
+  /// @brief Open a file
+  /// @param async_tp TaskProcessor for synchronous waiting
+  /// @throws std::runtime_error
+  static FileDescriptor Open(
+      engine::TaskProcessor& async_tp, const std::string& path,
+      blocking::OpenMode flags,
+      boost::filesystem::perms perms = boost::filesystem::perms::owner_read |
+                                       boost::filesystem::perms::owner_write);
+
+  FileDescriptor() = delete;
+  FileDescriptor(FileDescriptor&& other) noexcept;
+  FileDescriptor& operator=(FileDescriptor&& other) noexcept;
+  ~FileDescriptor();
+
+  /// @brief Checks if the file is open
+  bool IsOpen() const;
+
+  /// @brief Closes the file manually
+  /// @throws std::runtime_error
+  void Close() &&;
+
+  /// @brief Writes data to the file after the previously written or read data
+  /// @warning Unless `FSync` is called, there is no guarantee the data
+  /// is stored on disk safely.
+  /// @throws std::runtime_error
+  void Write(std::string_view contents);
+
+  /// @brief Reads the next chunk of data from the file
+  /// @returns The amount of bytes actually acquired, which can be equal
+  /// to `max_size`, or less on end-of-file
+  /// @throws std::runtime_error
+  std::size_t Read(char* buffer, std::size_t max_size);
+
+  /// @brief Makes sure the written data is actually stored on disk
+  /// @throws std::runtime_error
+  void FSync();
+
+  /// @brief Fetches the file size
+  /// @throws std::runtime_error
+  std::size_t GetSize() const;
+
+ private:
+  FileDescriptor(engine::TaskProcessor& async_tp, blocking::FileDescriptor fd,
+                 engine::ev::IoUring* io_uring);
+
+  std::size_t ReadSome(char* buffer, std::size_t max_size);
+  std::size_t WriteSome(std::string_view contents);
+
+  engine::TaskProcessor* async_tp_;
+  blocking::FileDescriptor fd_;
+  // nullptr unless the file I/O goes through io_uring
+  engine::ev::IoUring* io_uring_;
+  std::uint64_t offset_{0};
+};
+
+}  // namespace fs
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,41 @@
+#pragma once
+
+/// @file userver/rcu/fwd.hpp
+/// @brief Forward declarations for rcu::Variable and rcu::RcuMap
+
+USERVER_NAMESPACE_BEGIN
+
+namespace rcu {
+
+/// @brief Can be passed to `rcu::Variable` as the second template argument to
+/// choose how the old values are protected from being destroyed while in use.
+enum class ReclamationPolicy {
+  /// Each reader publishes the pointer it reads in a per-Variable hazard
+  /// pointer, writers scan the hazard pointers to find unused old values.
+  kHazardPointers,
+  /// Each reader increments a per-thread counter of the current global epoch,
+  /// old values are destroyed in batches once all the readers of the epochs
+  /// they were retired in are gone. Reads are cheaper than with hazard
+  /// pointers, but a long-living reader of any epoch-protected Variable delays
+  /// destruction of the old values of all such Variables.
+  kEpoch,
+};
+
+template <typename T,
+          ReclamationPolicy Policy = ReclamationPolicy::kHazardPointers>
+class Variable;
+
+template <typename T,
+          ReclamationPolicy Policy = ReclamationPolicy::kHazardPointers>
+class ReadablePtr;
+
+template <typename T,
+          ReclamationPolicy Policy = ReclamationPolicy::kHazardPointers>
+class WritablePtr;
+
+template <typename Key, typename Value>
+class RcuMap;
+
+}  // namespace rcu
+
+USERVER_NAMESPACE_END
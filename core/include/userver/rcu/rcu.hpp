@@ -4,13 +4,18 @@
 /// @brief Implementation of hazard pointer
 
 #include <atomic>
+#include <cstdint>
 #include <cstdlib>
 #include <list>
+#include <type_traits>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/mutex.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/rcu/fwd.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/clang_format_workarounds.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
@@ -24,9 +29,6 @@ USERVER_NAMESPACE_BEGIN
 /// with modified API
 namespace rcu {
 
-template <typename T>
-class Variable;
-
 namespace impl {
 
 // Hazard pointer implementation. Pointers form a linked list. \p ptr points
@@ -69,6 +71,45 @@ thread_local CachedData<T> cache;
 
 uint64_t GetNextEpoch() noexcept;
 
+// Epoch-based reclamation, shared by all the Variables with
+// ReclamationPolicy::kEpoch. A reader increments a counter in the slot of its
+// thread that corresponds to the parity of the current global epoch, and
+// decrements the very same counter on release, so a coroutine may migrate to
+// another thread while reading. The epoch is advanced only after all the
+// readers of the previous epoch are gone, so a value retired in epoch N is not
+// reachable by any reader once the epoch N + 2 is reached.
+using EpochReadersCounter = std::atomic<std::int64_t>;
+
+// Returns the incremented counter, that must be passed to
+// UnlockReclamationEpoch() once the read is over
+EpochReadersCounter& LockReclamationEpoch() noexcept;
+
+inline void UnlockReclamationEpoch(EpochReadersCounter& counter) noexcept {
+  counter.fetch_sub(1);
+}
+
+std::uint64_t GetReclamationEpoch() noexcept;
+
+// Advances the global epoch if there are no readers of the previous one.
+// Returns the epoch, values retired before which may be destroyed.
+std::uint64_t TryAdvanceReclamationEpoch() noexcept;
+
+template <typename T, ReclamationPolicy Policy>
+using ReaderRecord = std::conditional_t<Policy == ReclamationPolicy::kEpoch,
+                                        EpochReadersCounter,
+                                        HazardPointerRecord<T>>;
+
+template <typename T>
+struct EpochRetiredValue final {
+  std::uint64_t epoch;
+  std::unique_ptr<T> value;
+};
+
+template <typename T, ReclamationPolicy Policy>
+using RetiredValue = std::conditional_t<Policy == ReclamationPolicy::kEpoch,
+                                        EpochRetiredValue<T>,
+                                        std::unique_ptr<T>>;
+
 }  // namespace impl
 
 /// Reader smart pointer for rcu::Variable<T>. You may use operator*() or
@@ -76,29 +117,35 @@ uint64_t GetNextEpoch() noexcept;
 /// ReadablePtr references the same immutable value: if Variable's value is
 /// changed during ReadablePtr lifetime, it will not affect value referenced by
 /// ReadablePtr.
-template <typename T>
+template <typename T, ReclamationPolicy Policy>
 class USERVER_NODISCARD ReadablePtr final {
  public:
-  explicit ReadablePtr(const Variable<T>& ptr)
-      : hp_record_(&ptr.MakeHazardPointer()) {
-    // This cycle guarantees that at the end of it both t_ptr_ and
-    // hp_record_->ptr will both be set to
-    // 1. something meaningful
-    // 2. and that this meaningful value was not removed between assigning to
-    //    t_ptr_ and storing  it in a hazard pointer
-    do {
+  explicit ReadablePtr(const Variable<T, Policy>& ptr) {
+    if constexpr (Policy == ReclamationPolicy::kEpoch) {
+      // The value can't be retired before the epoch we have locked is over
+      record_ = &impl::LockReclamationEpoch();
       t_ptr_ = ptr.GetCurrent();
-
-      hp_record_->ptr.store(t_ptr_);
-    } while (t_ptr_ != ptr.GetCurrent());
+    } else {
+      record_ = &ptr.MakeHazardPointer();
+      // This cycle guarantees that at the end of it both t_ptr_ and
+      // record_->ptr will both be set to
+      // 1. something meaningful
+      // 2. and that this meaningful value was not removed between assigning
+      //    to t_ptr_ and storing  it in a hazard pointer
+      do {
+        t_ptr_ = ptr.GetCurrent();
+
+        record_->ptr.store(t_ptr_);
+      } while (t_ptr_ != ptr.GetCurrent());
+    }
   }
 
-  ReadablePtr(ReadablePtr<T>&& other) noexcept
-      : t_ptr_(other.t_ptr_), hp_record_(other.hp_record_) {
+  ReadablePtr(ReadablePtr&& other) noexcept
+      : t_ptr_(other.t_ptr_), record_(other.record_) {
     other.t_ptr_ = nullptr;
   }
 
-  ReadablePtr& operator=(ReadablePtr<T>&& other) noexcept {
+  ReadablePtr& operator=(ReadablePtr&& other) noexcept {
     // What do we have here?
     // 1. 'other' may point to the same variable - or to a different one.
     // 2. therefore, its hazard pointer may belong to the same list,
@@ -120,39 +167,47 @@ class USERVER_NODISCARD ReadablePtr final {
       return *this;
     }
 
-    // Get rid of our current hp_record_
+    // Get rid of our current record_
     if (t_ptr_) {
-      hp_record_->Release();
+      Release();
     }
-    // After that moment, the content of our hp_record_ can't be used -
-    // no more hp_record_->xyz calls, because it is probably already reused in
+    // After that moment, the content of our record_ can't be used -
+    // no more record_->xyz calls, because it is probably already reused in
     // some other ReadablePtr. Also, don't call t_ptr_, it is probably already
     // freed. Just take values from 'other'.
-    hp_record_ = other.hp_record_;
+    record_ = other.record_;
     t_ptr_ = other.t_ptr_;
 
     // Now, it won't do us any good if there were two glorified things having
-    // pointer to same hp_record_. Kill the other one.
+    // pointer to same record_. Kill the other one.
     other.t_ptr_ = nullptr;
-    // We don't need to clean other.hp_record_, because other.t_ptr_ acts
+    // We don't need to clean other.record_, because other.t_ptr_ acts
     // like a guard to it. As long as other.t_ptr_ is nullptr, nobody will
-    // use other.hp_record_
+    // use other.record_
 
     return *this;
   }
 
-  ReadablePtr(const ReadablePtr<T>& other)
-      : ReadablePtr(other.hp_record_->owner) {}
+  ReadablePtr(const ReadablePtr& other) {
+    if constexpr (Policy == ReclamationPolicy::kEpoch) {
+      // 'other' keeps the epoch locked, so the copy may share it
+      t_ptr_ = other.t_ptr_;
+      record_ = other.record_;
+      if (t_ptr_) record_->fetch_add(1);
+    } else {
+      *this = ReadablePtr(other.record_->owner);
+    }
+  }
 
-  ReadablePtr& operator=(const ReadablePtr<T>& other) {
-    if (this != &other) *this = ReadablePtr<T>{other};
+  ReadablePtr& operator=(const ReadablePtr& other) {
+    if (this != &other) *this = ReadablePtr{other};
     return *this;
   }
 
   ~ReadablePtr() {
     if (!t_ptr_) return;
-    UASSERT(hp_record_ != nullptr);
-    hp_record_->Release();
+    UASSERT(record_ != nullptr);
+    Release();
   }
 
   const T* Get() const& {
@@ -175,15 +230,25 @@ class USERVER_NODISCARD ReadablePtr final {
     std::abort();
   }
 
+  void Release() noexcept {
+    if constexpr (Policy == ReclamationPolicy::kEpoch) {
+      impl::UnlockReclamationEpoch(*record_);
+    } else {
+      record_->Release();
+    }
+  }
+
   // This is a pointer to actual data. If it is null, then we treat it as
   // an indicator that this ReadablePtr is cleared and won't call
-  // any logic associated with hp_record_
-  T* t_ptr_;
-  // Our hazard pointer. It can be nullptr in some circumstances.
-  // Invariant is this: if t_ptr_ is not nullptr, then hp_record_ is also
-  // not nullptr and points to hazard pointer containing same T*.
-  // Thus, if t_ptr_ is nullptr, then hp_record_ is undefined.
-  impl::HazardPointerRecord<T>* hp_record_;
+  // any logic associated with record_
+  T* t_ptr_{nullptr};
+  // Our hazard pointer or the counter of the locked epoch. It can be nullptr
+  // in some circumstances.
+  // Invariant is this: if t_ptr_ is not nullptr, then record_ is also
+  // not nullptr and either points to hazard pointer containing same T* or
+  // to a counter that keeps the value from being destroyed.
+  // Thus, if t_ptr_ is nullptr, then record_ is undefined.
+  impl::ReaderRecord<T, Policy>* record_{nullptr};
 };
 
 /// Smart pointer for rcu::Variable<T> for changing RCU value. It stores a
@@ -196,11 +261,11 @@ class USERVER_NODISCARD ReadablePtr final {
 /// @note you may not pass WritablePtr between coroutines as it owns
 /// engine::Mutex, which must be unlocked in the same coroutine that was used to
 /// lock the mutex.
-template <typename T>
+template <typename T, ReclamationPolicy Policy>
 class USERVER_NODISCARD WritablePtr final {
  public:
   /// For internal use only. Use `var.StartWrite()` instead
-  explicit WritablePtr(Variable<T>& var)
+  explicit WritablePtr(Variable<T, Policy>& var)
       : var_(var),
         lock_(var.mutex_),
         ptr_(std::make_unique<T>(*var_.GetCurrent())) {
@@ -209,7 +274,8 @@ class USERVER_NODISCARD WritablePtr final {
 
   /// For internal use only. Use `var.Emplace(args...)` instead
   template <typename... Args>
-  WritablePtr(Variable<T>& var, std::in_place_t, Args&&... initial_value_args)
+  WritablePtr(Variable<T, Policy>& var, std::in_place_t,
+              Args&&... initial_value_args)
       : var_(var),
         lock_(var.mutex_),
         ptr_(std::make_unique<T>(std::forward<Args>(initial_value_args)...)) {
@@ -217,7 +283,7 @@ class USERVER_NODISCARD WritablePtr final {
                 << " with custom initial value";
   }
 
-  WritablePtr(WritablePtr<T>&& other) noexcept
+  WritablePtr(WritablePtr&& other) noexcept
       : var_(other.var_),
         lock_(std::move(other.lock_)),
         ptr_(std::move(other.ptr_)) {
@@ -262,7 +328,7 @@ class USERVER_NODISCARD WritablePtr final {
     std::abort();
   }
 
-  Variable<T>& var_;
+  Variable<T, Policy>& var_;
   std::unique_lock<engine::Mutex> lock_;
   std::unique_ptr<T> ptr_;
 };
@@ -288,14 +354,23 @@ enum class DestructionType { kSync, kAsync };
 /// be eventually freed when a subsequent writer identifies that nobody works
 /// with this version.
 ///
+/// By default the readers are tracked with hazard pointers. Pass
+/// rcu::ReclamationPolicy::kEpoch as the second template argument to make
+/// reads cheaper for the price of destroying old values later, see
+/// rcu::ReclamationPolicy for details.
+///
 /// @note There is no way to create a "null" `Variable`.
 ///
 /// ## Example usage:
 ///
 /// @snippet rcu/rcu_test.cpp  Sample rcu::Variable usage
 ///
+/// ## Example usage with epoch-based reclamation:
+///
+/// @snippet rcu/rcu_test.cpp  Sample rcu::Variable epoch reclamation
+///
 /// @see @ref md_en_userver_synchronization
-template <typename T>
+template <typename T, ReclamationPolicy Policy>
 class Variable final {
  public:
   /// Create a new `Variable` with an in-place constructed initial value.
@@ -346,7 +421,7 @@ class Variable final {
   }
 
   /// Obtain a smart pointer which can be used to read the current value.
-  ReadablePtr<T> Read() const { return ReadablePtr<T>(*this); }
+  ReadablePtr<T, Policy> Read() const { return ReadablePtr<T, Policy>(*this); }
 
   /// Obtain a copy of contained value.
   T ReadCopy() const {
@@ -357,24 +432,27 @@ class Variable final {
   /// Obtain a smart pointer that will *copy* the current value. The pointer can
   /// be used to make changes to the value and to set the `Variable` to the
   /// changed value.
-  WritablePtr<T> StartWrite() { return WritablePtr<T>(*this); }
+  WritablePtr<T, Policy> StartWrite() { return WritablePtr<T, Policy>(*this); }
 
   /// Obtain a smart pointer to a newly in-place constructed value, but does
   /// not replace the current one yet (in contrast with regular `Emplace`).
   template <typename... Args>
-  WritablePtr<T> StartWriteEmplace(Args&&... args) {
-    return WritablePtr<T>(*this, std::in_place, std::forward<Args>(args)...);
+  WritablePtr<T, Policy> StartWriteEmplace(Args&&... args) {
+    return WritablePtr<T, Policy>(*this, std::in_place,
+                                  std::forward<Args>(args)...);
   }
 
   /// Replaces the `Variable`'s value with the provided one.
   void Assign(T new_value) {
-    WritablePtr<T>(*this, std::in_place, std::move(new_value)).Commit();
+    WritablePtr<T, Policy>(*this, std::in_place, std::move(new_value))
+        .Commit();
   }
 
   /// Replaces the `Variable`'s value with an in-place constructed one.
   template <typename... Args>
   void Emplace(Args&&... args) {
-    WritablePtr<T>(*this, std::in_place, std::forward<Args>(args)...).Commit();
+    WritablePtr<T, Policy>(*this, std::in_place, std::forward<Args>(args)...)
+        .Commit();
   }
 
   void Cleanup() {
@@ -385,7 +463,11 @@ class Variable final {
       return;
     }
 
-    ScanRetiredList(CollectHazardPtrs(lock));
+    if constexpr (Policy == ReclamationPolicy::kEpoch) {
+      ReclaimEpochRetired();
+    } else {
+      ScanRetiredList(CollectHazardPtrs(lock));
+    }
   }
 
  private:
@@ -453,18 +535,26 @@ class Variable final {
   void Retire(std::unique_ptr<T> old_ptr,
               std::unique_lock<engine::Mutex>& lock) {
     LOG_TRACE() << "Retiring ptr=" << old_ptr.get();
-    auto hazard_ptrs = CollectHazardPtrs(lock);
-
-    if (hazard_ptrs.count(old_ptr.get()) > 0) {
-      // old_ptr is being used now, we may not delete it, delay deletion
-      LOG_TRACE() << "Not retire, still used ptr=" << old_ptr.get();
-      retire_list_head_.push_back(std::move(old_ptr));
+    if constexpr (Policy == ReclamationPolicy::kEpoch) {
+      // current_ is already changed, so readers of the later epochs can't get
+      // old_ptr
+      retire_list_head_.push_back(
+          {impl::GetReclamationEpoch(), std::move(old_ptr)});
+      ReclaimEpochRetired();
     } else {
-      LOG_TRACE() << "Retire, not used ptr=" << old_ptr.get();
-      DeleteAsync(std::move(old_ptr));
-    }
+      auto hazard_ptrs = CollectHazardPtrs(lock);
+
+      if (hazard_ptrs.count(old_ptr.get()) > 0) {
+        // old_ptr is being used now, we may not delete it, delay deletion
+        LOG_TRACE() << "Not retire, still used ptr=" << old_ptr.get();
+        retire_list_head_.push_back(std::move(old_ptr));
+      } else {
+        LOG_TRACE() << "Retire, not used ptr=" << old_ptr.get();
+        DeleteAsync(std::move(old_ptr));
+      }
 
-    ScanRetiredList(hazard_ptrs);
+      ScanRetiredList(hazard_ptrs);
+    }
   }
 
   // Scan retired list and for every object that has no more hazard_ptrs
@@ -493,17 +583,40 @@ class Variable final {
     return hazard_ptrs;
   }
 
-  void DeleteAsync(std::unique_ptr<T> ptr) {
+  // Destroy (asynchronously) a batch of the values that were retired in the
+  // epochs that have no more readers
+  void ReclaimEpochRetired() {
+    // If there are no readers at all, two advancements make the value
+    // retired in the current epoch unreachable
+    for (int i = 0; i < 2 && !retire_list_head_.empty(); ++i) {
+      const auto safe_epoch = impl::TryAdvanceReclamationEpoch();
+
+      std::vector<std::unique_ptr<T>> batch;
+      while (!retire_list_head_.empty() &&
+             retire_list_head_.front().epoch < safe_epoch) {
+        batch.push_back(std::move(retire_list_head_.front().value));
+        retire_list_head_.pop_front();
+      }
+      if (batch.empty()) break;
+
+      LOG_TRACE() << "Retire " << batch.size() << " values of epochs before "
+                  << safe_epoch;
+      DeleteAsync(std::move(batch));
+    }
+  }
+
+  template <typename Ptr>
+  void DeleteAsync(Ptr ptr) {
     switch (destruction_type_) {
       case DestructionType::kSync:
-        ptr.reset();
+        ptr = Ptr{};
         break;
       case DestructionType::kAsync:
         engine::CriticalAsyncNoSpan([ptr = std::move(ptr),
                                      token = wait_token_storage_
                                                  .GetToken()]() mutable {
           // Make sure *ptr is deleted before token is destroyed
-          ptr.reset();
+          ptr = Ptr{};
         }).Detach();
         break;
     }
@@ -517,11 +630,12 @@ class Variable final {
   engine::Mutex mutex_;  // for current_ changes and retire_list_head_ access
   // may be read without mutex_ locked, but must be changed with held mutex_
   std::atomic<T*> current_;
-  std::list<std::unique_ptr<T>> retire_list_head_;
+  // with ReclamationPolicy::kEpoch the values are ordered by epoch
+  std::list<impl::RetiredValue<T, Policy>> retire_list_head_;
   utils::impl::WaitTokenStorage wait_token_storage_;
 
-  friend class ReadablePtr<T>;
-  friend class WritablePtr<T>;
+  friend class ReadablePtr<T, Policy>;
+  friend class WritablePtr<T, Policy>;
 };
 
 }  // namespace rcu
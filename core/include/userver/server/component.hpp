@@ -66,8 +66,18 @@ namespace components {
 /// handler-defaults.max_headers_size | max request headers size | 65536
 /// handler-defaults.parse_args_from_body | optional field to parse request according to x-www-form-urlencoded rules and make parameters accessible as query parameters | false
 /// connection.in_buffer_size | size of the buffer to preallocate for request receive: bigger values use more RAM and less CPU | 32 * 1024
-/// connection.requests_queue_size_threshold | drop requests from handlers that allow trottling if there's more pending requests than allowed by this value | 100
+/// connection.requests_queue_size_threshold | drop requests from handlers that allow trottling if there's more pending requests than allowed by this value; also limits the pipelined HTTP/1.1 requests processed concurrently | 100
 /// connection.keepalive_timeout | timeout in seconds to drop connection if there's not data received from it | 600
+/// connection.http2_enabled | accept HTTP/2 connections with prior knowledge (h2c) or negotiated by ALPN over TLS in addition to HTTP/1.x | false
+/// connection.http2_max_concurrent_streams | max concurrent HTTP/2 streams per connection | `requests_queue_size_threshold`
+/// connection.pipeline_max_buffered_bytes | stop reading pipelined HTTP/1.1 requests while the ready responses waiting to be sent in order take more bytes than this value | 1024 * 1024
+/// tls.cert | path to the PEM file with the server certificate followed by the intermediate certificates; TLS is not used if the `tls` section is missing | -
+/// tls.private_key | path to the PEM file with the private key | -
+/// tls.session_cache_size | max TLS sessions count in the server side session cache, 0 disables the cache | 20480
+/// tls.session_timeout | lifetime of the cached TLS sessions and of the session tickets | 300s
+/// tls.session_tickets | whether to issue TLS session tickets | true
+/// tls.reload_interval | how often to check the certificate and the key files for changes, 0 disables the reload; session tickets survive the reload | 1m
+/// tls.fs_task_processor | task processor to read the certificate and the key files on reload | fs-task-processor
 /// shards | how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing | -
 
 // clang-format on
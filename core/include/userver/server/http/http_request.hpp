@@ -4,6 +4,7 @@
 /// @brief @copybrief server::http::HttpRequest
 
 #include <chrono>
+#include <memory_resource>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -176,6 +177,15 @@ class HttpRequest final {
   /// @return true if the body of the request was compressed
   bool IsBodyCompressed() const;
 
+  /// @brief Memory resource for the scratch data of the handler, e.g. for
+  /// std::pmr containers.
+  ///
+  /// Deallocation is a no-op, all the memory is released at once when the
+  /// request is destroyed, so the allocated data must not outlive the request.
+  /// Must not be used concurrently, including from the subtasks of the
+  /// handler.
+  std::pmr::memory_resource& GetMemoryResource() const;
+
  private:
   HttpRequestImpl& impl_;
 };
@@ -5,7 +5,10 @@
 
 #include <chrono>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <userver/concurrent/queue.hpp>
 #include <userver/engine/single_consumer_event.hpp>
@@ -26,6 +29,14 @@ namespace impl {
 void OutputHeader(std::string& header, std::string_view key,
                   std::string_view val);
 
+// Response in the form suitable for an HTTP/2 stream
+struct Http2ResponseData {
+  // ":status" pseudo-header and the headers with lowercase names
+  std::vector<std::pair<std::string, std::string>> headers;
+  // Points to the response data, empty if no body should be sent
+  std::string_view body;
+};
+
 }
 
 class HttpRequestImpl;
@@ -50,6 +61,10 @@ class HttpResponse final : public request::ResponseBase {
 
   void SetSendFailed(
       std::chrono::steady_clock::time_point failure_time) override;
+
+  // For HTTP/2 connections. Waits for the streamed body to be completed.
+  impl::Http2ResponseData PrepareHttp2Response();
+  void SetHttp2Sent(size_t bytes_sent);
   /// @endcond
 
   /// @brief Add a new response header or rewrite an existing one.
@@ -96,7 +111,7 @@ class HttpResponse final : public request::ResponseBase {
 
   /// @cond
   // TODO: server internals. remove from public interface
-  void SendResponse(engine::io::Socket& socket) override;
+  void SendResponse(engine::io::RwBase& socket) override;
   /// @endcond
 
   void SetStatusServiceUnavailable() override {
@@ -116,8 +131,8 @@ class HttpResponse final : public request::ResponseBase {
   Queue::Producer GetBodyProducer();
 
  private:
-  void SetBodyStreamed(engine::io::Socket& socket, std::string& header);
-  void SetBodyNotstreamed(engine::io::Socket& socket, std::string& header);
+  void SetBodyStreamed(engine::io::RwBase& socket, std::string& header);
+  void SetBodyNotstreamed(engine::io::RwBase& socket, std::string& header);
 
   const HttpRequestImpl& request_;
   HttpStatus status_ = HttpStatus::kOk;
@@ -3,6 +3,7 @@
 /// @file userver/server/request/request_context.hpp
 /// @brief @copybrief server::request::RequestContext
 
+#include <memory_resource>
 #include <string>
 
 #include <userver/compiler/select.hpp>
@@ -20,6 +21,11 @@ namespace server::request {
 class RequestContext final {
  public:
   RequestContext();
+
+  /// @brief Allocates the bookkeeping of the named data from the `resource`,
+  /// that must outlive the RequestContext.
+  explicit RequestContext(std::pmr::memory_resource& resource);
+
   RequestContext(RequestContext&&) = delete;
   RequestContext(const RequestContext&) = delete;
 
@@ -102,10 +108,10 @@ class RequestContext final {
   class Impl;
 
   static constexpr std::size_t kPimplSize = compiler::SelectSize()  //
-                                                .ForLibCpp32(24)
-                                                .ForLibCpp64(48)
-                                                .ForLibStdCpp64(64)
-                                                .ForLibStdCpp32(32);
+                                                .ForLibCpp32(32)
+                                                .ForLibCpp64(64)
+                                                .ForLibStdCpp64(72)
+                                                .ForLibStdCpp32(36);
 
   utils::AnyMovable& SetUserAnyData(utils::AnyMovable&& data);
   utils::AnyMovable& GetUserAnyData();
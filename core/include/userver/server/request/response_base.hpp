@@ -11,13 +11,18 @@
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::io {
-class Socket;
+class RwBase;
 }  // namespace engine::io
 
 namespace server::request {
 
 class ResponseDataAccounter final {
  public:
+  ResponseDataAccounter() = default;
+
+  /// Accounts the data both in this accounter and in the parent one
+  explicit ResponseDataAccounter(ResponseDataAccounter& parent);
+
   void StartRequest(size_t size,
                     std::chrono::steady_clock::time_point create_time);
 
@@ -30,6 +35,10 @@ class ResponseDataAccounter final {
 
   void SetMaxLevel(size_t size) { max_ = size; }
 
+  /// Whether the level of this accounter or of any of its parents has
+  /// reached the max level
+  bool IsLimitReached() const;
+
   std::chrono::milliseconds GetAvgRequestTime() const;
 
  private:
@@ -37,6 +46,7 @@ class ResponseDataAccounter final {
   std::atomic<size_t> max_{std::numeric_limits<size_t>::max()};
   std::atomic<size_t> count_{0};
   std::atomic<size_t> time_sum_{0};
+  ResponseDataAccounter* const parent_{nullptr};
 };
 
 /// @brief Base class for all the server responses.
@@ -70,7 +80,7 @@ class ResponseBase {
   }
   std::chrono::steady_clock::time_point SentTime() const { return sent_time_; }
 
-  virtual void SendResponse(engine::io::Socket& socket) = 0;
+  virtual void SendResponse(engine::io::RwBase& socket) = 0;
 
   virtual void SetStatusServiceUnavailable() = 0;
   virtual void SetStatusOk() = 0;
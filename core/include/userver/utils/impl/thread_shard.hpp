@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+// Minimum offset between two objects to avoid false sharing
+inline constexpr std::size_t kInterferenceSize = 64;
+
+// Index of the current thread, assigned sequentially on the first call from
+// the thread. Used to pick a per-thread shard of a contended object: threads
+// that are alive at the same time mostly get distinct shards.
+std::size_t GetCurrentThreadIndex() noexcept;
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <new>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace utils::impl {
@@ -18,6 +21,16 @@ class WrappedCallBase {
   /// Rethrow the stored exception result of the call, if any
   virtual void RethrowErrorResult() const = 0;
 
+  /// Payloads are short-lived and small, take them from a thread-local pool.
+  /// The virtual destructor makes `delete` pass the size of the most derived
+  /// type.
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr, std::size_t size) noexcept;
+
+  static void* operator new(std::size_t size, std::align_val_t alignment);
+  static void operator delete(void* ptr, std::size_t size,
+                              std::align_val_t alignment) noexcept;
+
  protected:
   WrappedCallBase() noexcept;
 };
@@ -40,6 +40,11 @@ class PeriodicTask final {
     /// Subtasks that may be spawned in the callback
     /// are not critical by default and may be cancelled as usual.
     kCritical = 1 << 4,
+
+    /// Use `engine::Task::Priority::kBackground`, so that the task does not
+    /// delay latency-sensitive tasks of the same TaskProcessor.
+    /// Subtasks spawned in the callback inherit the priority.
+    kBackground = 1 << 5,
   };
 
   struct Settings {
@@ -0,0 +1,107 @@
+#pragma once
+
+/// @file userver/utils/statistics/sharded_counter.hpp
+/// @brief @copybrief utils::statistics::ShardedCounter
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/impl/thread_shard.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace impl {
+
+std::size_t GetShardsCount() noexcept;
+
+}  // namespace impl
+
+/// @brief Counter of type T that is cheap to update from many threads
+///
+/// Each thread updates its own shard, that lives on a separate cache line, so
+/// concurrent updates do not contend with each other. The shards are summed up
+/// on Load(), which is expected to happen only on metrics collection.
+///
+/// Unlike utils::statistics::RelaxedCounter each counter takes a cache line
+/// per CPU, so use it only for the counters that are updated on hot paths
+/// by many threads at once.
+template <class T>
+class ShardedCounter final {
+  static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>,
+                "only integral value types are supported in ShardedCounter");
+  static_assert(std::atomic<T>::is_always_lock_free,
+                "refusing to use locking atomics");
+
+ public:
+  using ValueType = T;
+
+  ShardedCounter() : shards_(impl::GetShardsCount()) {}
+
+  ShardedCounter(T initial) : ShardedCounter() {
+    shards_[0].value.store(initial, std::memory_order_relaxed);
+  }
+
+  ShardedCounter(const ShardedCounter& other) : ShardedCounter(other.Load()) {}
+
+  ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+  /// Sum of the shards, the concurrent updates may or may not be visible
+  T Load() const noexcept {
+    T result{0};
+    for (const auto& shard : shards_) {
+      // Unsigned wraparound is well-defined, so a decrement in one shard
+      // compensates an increment in another one
+      result = static_cast<T>(result +
+                              shard.value.load(std::memory_order_relaxed));
+    }
+    return result;
+  }
+
+  operator T() const noexcept { return Load(); }
+
+  ShardedCounter& operator++() noexcept {
+    GetCurrentShard().fetch_add(1, std::memory_order_relaxed);
+    return *this;
+  }
+
+  ShardedCounter& operator--() noexcept {
+    GetCurrentShard().fetch_sub(1, std::memory_order_relaxed);
+    return *this;
+  }
+
+  ShardedCounter& operator+=(T arg) noexcept {
+    GetCurrentShard().fetch_add(arg, std::memory_order_relaxed);
+    return *this;
+  }
+
+  ShardedCounter& operator-=(T arg) noexcept {
+    GetCurrentShard().fetch_sub(arg, std::memory_order_relaxed);
+    return *this;
+  }
+
+ private:
+  struct alignas(utils::impl::kInterferenceSize) Shard final {
+    std::atomic<T> value{0};
+  };
+
+  std::atomic<T>& GetCurrentShard() noexcept {
+    return shards_[utils::impl::GetCurrentThreadIndex() % shards_.size()]
+        .value;
+  }
+
+  utils::FixedArray<Shard> shards_;
+};
+
+template <typename T>
+void DumpMetric(Writer& writer, const ShardedCounter<T>& value) {
+  writer = value.Load();
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
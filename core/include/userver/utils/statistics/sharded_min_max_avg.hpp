@@ -0,0 +1,79 @@
+#pragma once
+
+/// @file userver/utils/statistics/sharded_min_max_avg.hpp
+/// @brief @copybrief utils::statistics::ShardedMinMaxAvg
+
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/impl/thread_shard.hpp>
+#include <userver/utils/statistics/min_max_avg.hpp>
+#include <userver/utils/statistics/sharded_counter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/// @brief utils::statistics::MinMaxAvg that is cheap to update from many
+/// threads
+///
+/// Each thread accounts the values in its own shard, the shards are merged
+/// on GetCurrent() and Load(), which are expected to happen only on metrics
+/// collection. Could be used as a Counter of utils::statistics::RecentPeriod
+/// with utils::statistics::MinMaxAvg as the Result.
+///
+/// See utils::statistics::ShardedCounter for the memory usage considerations.
+template <typename ValueType, typename AverageType = ValueType>
+class ShardedMinMaxAvg final {
+ public:
+  using Current = typename MinMaxAvg<ValueType, AverageType>::Current;
+
+  ShardedMinMaxAvg() : shards_(impl::GetShardsCount()) {}
+
+  ShardedMinMaxAvg(const ShardedMinMaxAvg& other) : ShardedMinMaxAvg() {
+    shards_[0].mma = other.Load();
+  }
+
+  ShardedMinMaxAvg& operator=(const ShardedMinMaxAvg&) = delete;
+
+  /// Merged values of all the shards
+  MinMaxAvg<ValueType, AverageType> Load() const {
+    MinMaxAvg<ValueType, AverageType> result;
+    for (const auto& shard : shards_) result.Add(shard.mma);
+    return result;
+  }
+
+  Current GetCurrent() const { return Load().GetCurrent(); }
+
+  void Account(ValueType value) {
+    shards_[utils::impl::GetCurrentThreadIndex() % shards_.size()]
+        .mma.Account(value);
+  }
+
+  void Reset() {
+    for (auto& shard : shards_) shard.mma.Reset();
+  }
+
+ private:
+  struct alignas(utils::impl::kInterferenceSize) Shard final {
+    MinMaxAvg<ValueType, AverageType> mma;
+  };
+
+  utils::FixedArray<Shard> shards_;
+};
+
+template <typename ValueType, typename AverageType>
+MinMaxAvg<ValueType, AverageType>& operator+=(
+    MinMaxAvg<ValueType, AverageType>& lhs,
+    const ShardedMinMaxAvg<ValueType, AverageType>& rhs) {
+  lhs.Add(rhs.Load());
+  return lhs;
+}
+
+template <typename ValueType, typename AverageType>
+auto Serialize(const ShardedMinMaxAvg<ValueType, AverageType>& mma,
+               formats::serialize::To<formats::json::Value> to) {
+  return Serialize(mma.Load(), to);
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
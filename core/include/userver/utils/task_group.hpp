@@ -0,0 +1,169 @@
+#pragma once
+
+/// @file userver/utils/task_group.hpp
+/// @brief @copybrief utils::TaskGroup
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fixed_array.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+namespace impl {
+
+class TaskGroupBase {
+ public:
+  TaskGroupBase(const TaskGroupBase&) = delete;
+  TaskGroupBase& operator=(const TaskGroupBase&) = delete;
+
+ protected:
+  explicit TaskGroupBase(std::size_t count);
+  ~TaskGroupBase();
+
+  // Starts min(count, max_concurrency) tasks that call RunJob()
+  void Start(std::string name, std::size_t max_concurrency);
+
+  // Returns the index of the next completed job, std::nullopt if all the jobs
+  // are completed. Rethrows the first exception of the jobs.
+  std::optional<std::size_t> WaitNextCompleted();
+
+  // Must be called by the derived class destructor
+  void CancelAndWait() noexcept;
+
+  std::size_t GetCount() const noexcept { return completed_.size(); }
+
+ private:
+  virtual void RunJob(std::size_t index) = 0;
+
+  void Work() noexcept;
+  [[noreturn]] void Fail();
+
+  static constexpr std::size_t kNotCompleted = -1;
+
+  // Indices of the jobs in completion order
+  utils::FixedArray<std::atomic<std::size_t>> completed_;
+  std::atomic<std::size_t> completed_count_{0};
+  std::size_t read_count_{0};
+
+  std::atomic<std::size_t> next_index_{0};
+  std::atomic<bool> is_failed_{false};
+  std::exception_ptr exception_;
+
+  engine::SingleConsumerEvent event_;
+  std::vector<engine::TaskWithResult<void>> tasks_;
+};
+
+}  // namespace impl
+
+/// @ingroup userver_concurrency
+///
+/// @brief Runs `func(index)` for each index in `[0, count)` in at most
+/// `max_concurrency` tasks and gives out the results in completion order.
+///
+/// Only `min(count, max_concurrency)` tasks are started, each of them takes the
+/// next index once it is done with the previous one. All the results are
+/// stored in a single preallocated buffer.
+///
+/// On the first exception thrown by `func` the remaining indices are skipped,
+/// the running tasks are cancelled and the exception is rethrown from Next()
+/// or GetAll(). Destruction of the group cancels and waits for the tasks.
+///
+/// Must be used from a single task.
+///
+/// ## Example usage:
+///
+/// @snippet utils/task_group_test.cpp  Sample TaskGroup
+///
+/// @see utils::ParallelFor
+template <typename T>
+class TaskGroup final : private impl::TaskGroupBase {
+  static_assert(!std::is_void_v<T>, "Use utils::ParallelFor for void results");
+
+ public:
+  /// @param name Name for the tracing::Span of each task
+  /// @param count Number of the calls of `func`
+  /// @param max_concurrency Max number of concurrently running tasks
+  /// @param func Function that takes an index and returns a result
+  TaskGroup(std::string name, std::size_t count, std::size_t max_concurrency,
+            std::function<T(std::size_t)> func)
+      : impl::TaskGroupBase(count), results_(count), func_(std::move(func)) {
+    Start(std::move(name), max_concurrency);
+  }
+
+  ~TaskGroup() { CancelAndWait(); }
+
+  /// @brief Waits for the next completed call.
+  /// @returns index and result of the call, or std::nullopt if all the
+  /// results were already given out
+  /// @throws the first exception of `func`, or engine::WaitInterruptedException
+  /// if the current task is cancelled
+  std::optional<std::pair<std::size_t, T>> Next() {
+    const auto index = WaitNextCompleted();
+    if (!index) return std::nullopt;
+    return std::pair<std::size_t, T>{*index, ExtractResult(*index)};
+  }
+
+  /// @brief Waits for all the calls, must not be mixed with Next().
+  /// @returns results ordered by index
+  /// @throws the first exception of `func`, or engine::WaitInterruptedException
+  /// if the current task is cancelled
+  std::vector<T> GetAll() {
+    while (WaitNextCompleted()) {
+    }
+
+    std::vector<T> results;
+    results.reserve(GetCount());
+    for (std::size_t i = 0; i < GetCount(); ++i) {
+      results.push_back(ExtractResult(i));
+    }
+    return results;
+  }
+
+ private:
+  void RunJob(std::size_t index) override {
+    results_[index].emplace(func_(index));
+  }
+
+  T ExtractResult(std::size_t index) {
+    UINVARIANT(results_[index], "The result was already retrieved");
+    T result = std::move(*results_[index]);
+    results_[index].reset();
+    return result;
+  }
+
+  utils::FixedArray<std::optional<T>> results_;
+  const std::function<T(std::size_t)> func_;
+};
+
+/// @ingroup userver_concurrency
+///
+/// @brief Calls `func(index)` for each index in `[0, count)` in at most
+/// `max_concurrency` tasks and waits for all of them.
+///
+/// On the first exception thrown by `func` the remaining indices are skipped,
+/// the running tasks are cancelled and the exception is rethrown.
+///
+/// @param name Name for the tracing::Span of each task
+/// @param count Number of the calls of `func`
+/// @param max_concurrency Max number of concurrently running tasks
+/// @param func Function that takes an index
+void ParallelFor(std::string name, std::size_t count,
+                 std::size_t max_concurrency,
+                 std::function<void(std::size_t)> func);
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
@@ -63,7 +63,8 @@ CacheUpdateTrait::Impl::Impl(CacheDependencies&& dependencies,
           dependencies.cache_control.IsPeriodicUpdateEnabled(static_config_,
                                                              name_)),
       periodic_task_flags_{utils::PeriodicTask::Flags::kChaotic,
-                           utils::PeriodicTask::Flags::kCritical},
+                           utils::PeriodicTask::Flags::kCritical,
+                           utils::PeriodicTask::Flags::kBackground},
       dumpable_(customized_trait_),
       dumper_(dependencies.dump_config
                   ? std::optional<dump::Dumper>(
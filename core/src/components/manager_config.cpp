@@ -92,6 +92,13 @@ properties:
                 type: integer
                 description: size of a single coroutine, bytes
                 defaultDescription: 256 * 1024
+            max_dirty_idle_size:
+                type: integer
+                description: >
+                    amount of idle coroutines that keep the touched pages of
+                    their stacks, stacks of other idle coroutines are given
+                    back to the OS
+                defaultDescription: initial_size
     event_thread_pool:
         type: object
         description: event thread pool options
@@ -107,6 +114,27 @@ properties:
                 description: >
                     Whether to defer timer events to a per-thread periodic timer
                     or notify ev-loop right away
+            io_backend:
+                type: string
+                description: >
+                    How to wait for readiness of sockets: start a libev watcher
+                    for each wait or submit an io_uring poll. Falls back to
+                    libev if io_uring is not available
+                defaultDescription: libev
+                enum:
+                  - libev
+                  - io-uring
+            cpu_affinity:
+                type: string
+                description: >
+                    List of CPUs to pin the ev-threads to, e.g. '0-3,8'
+                defaultDescription: not pinned
+            numa_aware:
+                type: boolean
+                description: >
+                    Distribute ev-threads over NUMA nodes round-robin and pin
+                    each thread to the CPUs of its node
+                defaultDescription: false
     components:
         type: object
         description: 'dictionary of "component name": "options"'
@@ -142,6 +170,53 @@ properties:
                       - normal
                       - low-priority
                       - idle
+                task-processor-queue:
+                    type: string
+                    description: |
+                        Task queue mode for the task processor.
+                        `global-task-queue` shares a single queue between
+                        all the workers.
+                        `work-stealing-task-queue` gives each worker its own
+                        queue and lets idle workers steal tasks from others.
+                    defaultDescription: global-task-queue
+                    enum:
+                      - global-task-queue
+                      - work-stealing-task-queue
+                normal-priority-weight:
+                    type: integer
+                    description: |
+                        How many normal priority tasks a worker dequeues per
+                        one background priority task while both are pending.
+                    defaultDescription: 8
+                    minimum: 1
+                min-worker-threads:
+                    type: integer
+                    description: |
+                        Enables the elastic mode: starts this many workers and
+                        adds more, up to worker_threads, while the tasks wait
+                        in the queue for too long. Requires global-task-queue.
+                    defaultDescription: worker_threads
+                    minimum: 1
+                worker-idle-timeout:
+                    type: string
+                    description: |
+                        In the elastic mode, a worker above min-worker-threads
+                        exits after being idle for this long.
+                    defaultDescription: 10s
+                cpu-affinity:
+                    type: string
+                    description: |
+                        List of CPUs to pin the worker threads to, e.g.
+                        '0-3,8'. Can not be used with numa-node.
+                    defaultDescription: not pinned
+                numa-node:
+                    type: integer
+                    description: |
+                        Pin the worker threads to the CPUs of this NUMA node and
+                        prefer the ev-threads of the same node. Can not be used
+                        with cpu-affinity.
+                    defaultDescription: not pinned
+                    minimum: 0
                 task-trace:
                     type: object
                     description: .
@@ -54,7 +54,24 @@ formats::json::ValueBuilder GetTaskProcessorStats(
 
   json_task_processor["context_switch"] = std::move(json_context_switch);
 
+  formats::json::ValueBuilder json_queue_wait(formats::json::Type::kObject);
+  for (const auto& [priority, priority_name] :
+       {std::pair{engine::Task::Priority::kNormal, "normal"},
+        std::pair{engine::Task::Priority::kBackground, "background"}}) {
+    formats::json::ValueBuilder json_priority(formats::json::Type::kObject);
+    json_priority["overloaded"] = counter.GetTasksOverloadSensor(priority);
+    json_priority["no_overloaded"] = counter.GetTasksNoOverloadSensor(priority);
+    json_queue_wait[priority_name] = std::move(json_priority);
+  }
+  utils::statistics::SolomonChildrenAreLabelValues(json_queue_wait,
+                                                   "task_priority");
+  json_task_processor["queue-wait"] = std::move(json_queue_wait);
+
   json_task_processor["worker-threads"] = task_processor.GetWorkerCount();
+  json_task_processor["worker-threads-min"] =
+      task_processor.GetMinWorkerCount();
+  json_task_processor["worker-threads-max"] =
+      task_processor.GetMaxWorkerCount();
 
   return json_task_processor;
 }
@@ -115,21 +132,35 @@ formats::json::Value ManagerControllerComponent::ExtendStatistics(
   // ev-threads
   {
     formats::json::ValueBuilder json_ev_threads{formats::json::Type::kObject};
+    formats::json::ValueBuilder json_payloads{formats::json::Type::kObject};
+    formats::json::ValueBuilder json_wakeups{formats::json::Type::kObject};
 
     const auto& pools_ptr = components_manager_.GetTaskProcessorPools();
     auto& ev_thread_pool = pools_ptr->EventThreadPool();
     for (auto* thread : ev_thread_pool.NextThreads(ev_thread_pool.GetSize())) {
       json_ev_threads[thread->GetName()] = thread->GetCurrentLoadPercent();
+
+      const auto async_stats = thread->GetAsyncPayloadStatistics();
+      json_payloads[thread->GetName()] = async_stats.payloads;
+      json_wakeups[thread->GetName()] = async_stats.wakeups;
     }
     utils::statistics::SolomonChildrenAreLabelValues(json_ev_threads,
                                                      "ev_thread_name");
+    utils::statistics::SolomonChildrenAreLabelValues(json_payloads,
+                                                     "ev_thread_name");
+    utils::statistics::SolomonChildrenAreLabelValues(json_wakeups,
+                                                     "ev_thread_name");
     engine_data["ev-threads"]["cpu-load-percent"] = std::move(json_ev_threads);
+    // wakeups / payloads shows how well the wakeups are coalesced
+    engine_data["ev-threads"]["async-payloads"] = std::move(json_payloads);
+    engine_data["ev-threads"]["async-wakeups"] = std::move(json_wakeups);
   }
 
   // coroutines
   {
-    auto coro_stats =
-        components_manager_.GetTaskProcessorPools()->GetCoroPool().GetStats();
+    const auto& coro_pool =
+        components_manager_.GetTaskProcessorPools()->GetCoroPool();
+    auto coro_stats = coro_pool.GetStats();
     formats::json::ValueBuilder json_coro_pool(formats::json::Type::kObject);
 
     formats::json::ValueBuilder json_coro_stats(formats::json::Type::kObject);
@@ -137,6 +168,12 @@ formats::json::Value ManagerControllerComponent::ExtendStatistics(
     json_coro_stats["total"] = coro_stats.total_coroutines;
     json_coro_pool["coroutines"] = std::move(json_coro_stats);
 
+    formats::json::ValueBuilder json_stack_stats(formats::json::Type::kObject);
+    json_stack_stats["max-usage-percent"] =
+        coro_stats.max_stack_usage * 100 / coro_pool.GetStackSize();
+    json_stack_stats["released-idle-stacks"] = coro_stats.released_idle_stacks;
+    json_coro_pool["stack-usage"] = std::move(json_stack_stats);
+
     engine_data["coro-pool"] = std::move(json_coro_pool);
   }
 
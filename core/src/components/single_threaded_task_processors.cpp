@@ -42,6 +42,38 @@ properties:
           - normal
           - low-priority
           - idle
+    task-processor-queue:
+        type: string
+        description: |
+            Task queue mode for the task processor.
+            `global-task-queue` shares a single queue between all the workers.
+            `work-stealing-task-queue` gives each worker its own queue and
+            lets idle workers steal tasks from others.
+        defaultDescription: global-task-queue
+        enum:
+          - global-task-queue
+          - work-stealing-task-queue
+    normal-priority-weight:
+        type: integer
+        description: |
+            How many normal priority tasks a worker dequeues per
+            one background priority task while both are pending.
+        defaultDescription: 8
+        minimum: 1
+    cpu-affinity:
+        type: string
+        description: |
+            List of CPUs to pin the worker threads to, e.g.
+            '0-3,8'. Can not be used with numa-node.
+        defaultDescription: not pinned
+    numa-node:
+        type: integer
+        description: |
+            Pin the worker threads to the CPUs of this NUMA node and
+            prefer the ev-threads of the same node. Can not be used
+            with cpu-affinity.
+        defaultDescription: not pinned
+        minimum: 0
     task-trace:
         type: object
         description: .
@@ -0,0 +1,87 @@
+#include <userver/concurrent/hash_map.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/rcu/rcu_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using ConcurrentHashMap = concurrent::HashMap<std::uint64_t, std::uint64_t>;
+using RcuMap = rcu::RcuMap<std::uint64_t, std::uint64_t>;
+
+template <typename Map>
+void Fill(Map& map, std::uint64_t size) {
+  for (std::uint64_t i = 0; i < size; ++i) map.Emplace(i, i);
+}
+
+}  // namespace
+
+// Inserts and erases a key in a map of state.range(0) keys
+template <typename Map>
+void hash_map_key_churn(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const std::uint64_t size = state.range(0);
+    Map map;
+    Fill(map, size);
+
+    std::uint64_t i = size;
+    for (auto _ : state) {
+      map.Emplace(i, i);
+      map.Erase(i - size);
+      ++i;
+    }
+  });
+}
+BENCHMARK_TEMPLATE(hash_map_key_churn, ConcurrentHashMap)
+    ->RangeMultiplier(10)
+    ->Range(100, 100'000);
+BENCHMARK_TEMPLATE(hash_map_key_churn, RcuMap)
+    ->RangeMultiplier(10)
+    ->Range(100, 100'000);
+
+// Reads existing keys while other threads change the keyset
+template <typename Map>
+void hash_map_read_with_churn(benchmark::State& state) {
+  const std::size_t writers_count = state.range(0);
+  constexpr std::uint64_t kSize = 100'000;
+
+  engine::RunStandalone(writers_count + 1, [&] {
+    Map map;
+    Fill(map, kSize);
+    std::atomic<bool> keep_running{true};
+
+    std::vector<engine::TaskWithResult<void>> writers;
+    for (std::size_t writer = 0; writer < writers_count; ++writer) {
+      writers.push_back(engine::AsyncNoSpan([&, writer] {
+        std::uint64_t key = kSize * (writer + 1);
+        while (keep_running) {
+          map.Emplace(key, key);
+          map.Erase(key);
+          ++key;
+        }
+      }));
+    }
+
+    std::uint64_t i = 0;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(map.Get(i++ % kSize));
+    }
+
+    keep_running = false;
+    for (auto& writer : writers) writer.Get();
+  });
+}
+BENCHMARK_TEMPLATE(hash_map_read_with_churn, ConcurrentHashMap)
+    ->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(hash_map_read_with_churn, RcuMap)->DenseRange(0, 2);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,253 @@
+#include <userver/concurrent/hash_map.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST(ConcurrentHashMap, Empty) {
+  concurrent::HashMap<std::string, int> map;
+
+  EXPECT_EQ(0, map.SizeApprox());
+  EXPECT_TRUE(map.GetSnapshot().empty());
+  map.Clear();
+  EXPECT_TRUE(map.GetSnapshot().empty());
+}
+
+UTEST(ConcurrentHashMap, Modify) {
+  concurrent::HashMap<std::string, int> map;
+  const auto& cmap = map;
+
+  UEXPECT_THROW(cmap["any"], rcu::MissingKeyException);
+  EXPECT_FALSE(map.Get("any"));
+  EXPECT_FALSE(cmap.Get("any"));
+  EXPECT_FALSE(map.Erase("any"));
+  EXPECT_FALSE(map.Pop("any"));
+
+  UEXPECT_NO_THROW(*map["any"] = 1);
+  EXPECT_EQ(1, *cmap["any"]);
+  EXPECT_EQ(1, *map.Get("any"));
+  EXPECT_TRUE(map.Erase("any"));
+  EXPECT_FALSE(map.Erase("any"));
+
+  EXPECT_TRUE(map.Insert("any", std::make_shared<int>(3)).inserted);
+  EXPECT_FALSE(map.Insert("any", std::make_shared<int>(0)).inserted);
+  EXPECT_EQ(*map.Insert("any", std::make_shared<int>(0)).value, 3);
+  EXPECT_EQ(*map.Pop("any"), 3);
+
+  EXPECT_TRUE(map.Emplace("any", 4).inserted);
+  EXPECT_FALSE(map.Emplace("any", 0).inserted);
+  EXPECT_EQ(*map.TryEmplace("any", 0).value, 4);
+  EXPECT_EQ(*map.Pop("any"), 4);
+
+  map.InsertOrAssign("any", std::make_shared<int>(5));
+  map.InsertOrAssign("any", std::make_shared<int>(6));
+  EXPECT_EQ(*cmap["any"], 6);
+  EXPECT_EQ(1, map.SizeApprox());
+  EXPECT_EQ(*map.Pop("any"), 6);
+  EXPECT_EQ(0, map.SizeApprox());
+}
+
+UTEST(ConcurrentHashMap, ReclaimWithoutChangesOfTheStripe) {
+  concurrent::HashMap<int, int> map;
+  // The keys are in different stripes with the identity std::hash
+  map.Emplace(0, 0);
+  const std::weak_ptr<int> removed = map.Get(0);
+  EXPECT_TRUE(map.Erase(0));
+
+  for (int i = 0; i < 10 && !removed.expired(); ++i) {
+    map.InsertOrAssign(1, std::make_shared<int>(i));
+  }
+  EXPECT_TRUE(removed.expired());
+}
+
+UTEST(ConcurrentHashMap, Resize) {
+  constexpr int kKeys = 10000;
+  concurrent::HashMap<int, int> map;
+
+  for (int i = 0; i < kKeys; ++i) {
+    ASSERT_TRUE(map.Emplace(i, i).inserted);
+  }
+  EXPECT_EQ(kKeys, map.SizeApprox());
+  for (int i = 0; i < kKeys; ++i) {
+    ASSERT_EQ(i, *map.Get(i));
+  }
+
+  int visited = 0;
+  map.VisitAll([&visited](int key, int value) {
+    EXPECT_EQ(key, value);
+    ++visited;
+  });
+  EXPECT_EQ(kKeys, visited);
+
+  for (int i = 0; i < kKeys; i += 2) {
+    ASSERT_TRUE(map.Erase(i));
+  }
+  const auto snapshot = map.GetSnapshot();
+  EXPECT_EQ(kKeys / 2, snapshot.size());
+  for (const auto& [key, value] : snapshot) {
+    EXPECT_EQ(1, key % 2);
+    EXPECT_EQ(key, *value);
+  }
+
+  map.Clear();
+  EXPECT_EQ(0, map.SizeApprox());
+  EXPECT_FALSE(map.Get(1));
+  EXPECT_TRUE(map.Emplace(1, 1).inserted);
+}
+
+namespace {
+
+std::size_t key_copies = 0;
+
+struct CountedKey {
+  explicit CountedKey(int value) : value(value) {}
+  CountedKey(const CountedKey& other) : value(other.value) { ++key_copies; }
+
+  bool operator==(const CountedKey& other) const {
+    return value == other.value;
+  }
+
+  int value;
+};
+
+struct CountedKeyHash {
+  std::size_t operator()(const CountedKey& key) const { return key.value; }
+};
+
+struct ThrowingValue {
+  explicit ThrowingValue(bool should_throw) {
+    if (should_throw) throw std::runtime_error("construction failed");
+  }
+};
+
+}  // namespace
+
+UTEST(ConcurrentHashMap, ResizeAfterThrowingInsert) {
+  concurrent::HashMap<CountedKey, ThrowingValue, CountedKeyHash> map;
+
+  // The table grows to 128 buckets, the move to 256 buckets starts
+  constexpr int kInitialKeys = 129;
+  for (int i = 0; i < kInitialKeys; ++i) {
+    ASSERT_TRUE(map.Emplace(CountedKey{i}, false).inserted);
+  }
+
+  // Every change moves a chunk of 8 buckets in order and the bucket of the
+  // changed key. The last 8 buckets but 120 are moved out of order, so that
+  // bucket 120 is the last one to move and it is moved by a failing insert.
+  for (int i = 121; i < 128; ++i) {
+    map.InsertOrAssign(CountedKey{i}, std::make_shared<ThrowingValue>(false));
+  }
+  for (int i = 0; i < 7; ++i) {
+    map.InsertOrAssign(CountedKey{0}, std::make_shared<ThrowingValue>(false));
+  }
+  UEXPECT_THROW(map.Emplace(CountedKey{120 + 256}, true), std::runtime_error);
+  EXPECT_EQ(kInitialKeys, map.SizeApprox());
+
+  // Each key is copied once on insertion and once per move to a new table
+  constexpr int kNewKeys = 2000;
+  key_copies = 0;
+  for (int i = 0; i < kNewKeys; ++i) {
+    ASSERT_TRUE(map.Emplace(CountedKey{1000 + i}, false).inserted);
+  }
+  EXPECT_GT(key_copies, kNewKeys + kNewKeys / 2) << "The map stopped growing";
+  EXPECT_FALSE(map.Get(CountedKey{120 + 256}));
+}
+
+UTEST_MT(ConcurrentHashMap, KeyChurn, 4) {
+  constexpr int kWriters = 3;
+  constexpr int kKeysPerWriter = 1000;
+
+  concurrent::HashMap<int, std::atomic<int>> map;
+  std::atomic<bool> keep_running{true};
+
+  // Readers see either no key or its only possible value
+  auto reader = engine::AsyncNoSpan([&] {
+    while (keep_running) {
+      for (int i = 0; i < kWriters * kKeysPerWriter; i += 7) {
+        if (const auto value = map.Get(i)) {
+          ASSERT_EQ(i / kKeysPerWriter, value->load());
+        }
+      }
+      map.VisitAll([&](int key, const std::atomic<int>& value) {
+        ASSERT_EQ(key / kKeysPerWriter, value.load());
+      });
+      engine::Yield();
+    }
+  });
+
+  std::vector<engine::TaskWithResult<void>> writers;
+  for (int writer = 0; writer < kWriters; ++writer) {
+    writers.push_back(engine::AsyncNoSpan([&map, writer] {
+      const int first_key = writer * kKeysPerWriter;
+      for (int round = 0; round < 10; ++round) {
+        for (int i = first_key; i < first_key + kKeysPerWriter; ++i) {
+          ASSERT_TRUE(map.Emplace(i, writer).inserted);
+        }
+        for (int i = first_key; i < first_key + kKeysPerWriter; ++i) {
+          ASSERT_TRUE(map.Get(i));
+          ASSERT_TRUE(map.Erase(i));
+        }
+      }
+    }));
+  }
+  for (auto& writer : writers) writer.Get();
+
+  keep_running = false;
+  reader.Get();
+  EXPECT_EQ(0, map.SizeApprox());
+}
+
+UTEST_MT(ConcurrentHashMap, ConcurrentTryEmplace, 8) {
+  constexpr std::size_t kTasks = 8;
+
+  concurrent::HashMap<std::string, std::size_t> map;
+  std::atomic<std::size_t> insertions = 0;
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::size_t i = 0; i < kTasks; i++) {
+    tasks.push_back(engine::AsyncNoSpan([&map, &insertions, i] {
+      const auto key = std::string(20 + i / 2, 'x');
+      const auto res = map.TryEmplace(key, i);
+      if (res.inserted) ++insertions;
+      EXPECT_EQ(*res.value / 2, i / 2);
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_EQ(insertions, kTasks / 2);
+}
+
+UTEST(ConcurrentHashMap, Sample) {
+  /// [Sample concurrent::HashMap usage]
+  struct ClientStats {
+    // Access to the values must be synchronized via std::atomic
+    // or other synchronization primitives
+    std::atomic<std::uint64_t> requests{0};
+  };
+  concurrent::HashMap<std::string, ClientStats> stats;
+
+  // Adding and removing keys does not copy the map
+  stats["client-1"]->requests++;
+  stats["client-2"]->requests++;
+  stats["client-1"]->requests++;
+  stats.Erase("client-2");
+
+  std::uint64_t total_requests = 0;
+  stats.VisitAll([&total_requests](const std::string&, const ClientStats& s) {
+    total_requests += s.requests.load();
+  });
+  EXPECT_EQ(total_requests, 2);
+  /// [Sample concurrent::HashMap usage]
+}
+
+USERVER_NAMESPACE_END
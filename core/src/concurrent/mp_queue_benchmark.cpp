@@ -31,6 +31,36 @@ auto GetConsumerTask(std::shared_ptr<QueueType> queue,
     }
   });
 }
+template <typename QueueType>
+auto GetBatchProducerTask(std::shared_ptr<QueueType> queue,
+                          std::size_t batch_size, std::atomic<bool>& run) {
+  return utils::Async(
+      "producer", [producer = queue->GetProducer(), batch_size, &run] {
+        std::vector<std::size_t> batch;
+        std::size_t message = 0;
+        while (run) {
+          while (batch.size() < batch_size) batch.push_back(message++);
+          bool res = producer.PushMany(batch);
+          benchmark::DoNotOptimize(res);
+        }
+      });
+}
+
+template <typename QueueType>
+auto GetBatchConsumerTask(std::shared_ptr<QueueType> queue,
+                          std::size_t batch_size,
+                          const std::atomic<bool>& run) {
+  return utils::Async(
+      "consumer", [consumer = queue->GetConsumer(), batch_size, &run]() {
+        std::vector<std::size_t> values;
+        values.reserve(batch_size);
+        while (run) {
+          bool res = consumer.PopMany(values, batch_size);
+          benchmark::DoNotOptimize(res);
+          values.clear();
+        }
+      });
+}
 }  // namespace
 
 template <typename QueueType>
@@ -67,6 +97,78 @@ void producer_consumer(benchmark::State& state) {
   });
 }
 
+// Same as producer_consumer, but elements are pushed and popped in batches of
+// state.range(3) elements, each iteration pushes a batch
+template <typename QueueType>
+void producer_consumer_batch(benchmark::State& state) {
+  engine::RunStandalone(state.range(0) + state.range(1), [&] {
+    std::size_t ProducersCount = state.range(0);
+    std::size_t ConsumersCount = state.range(1);
+    std::size_t QueueSize = state.range(2);
+    std::size_t BatchSize = state.range(3);
+
+    std::atomic<bool> run{true};
+    auto queue = QueueType::Create(QueueSize);
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(ProducersCount + ConsumersCount - 1);
+    for (std::size_t i = 0; i < ProducersCount - 1; ++i) {
+      tasks.push_back(GetBatchProducerTask(queue, BatchSize, run));
+    }
+
+    for (std::size_t i = 0; i < ConsumersCount; ++i) {
+      tasks.push_back(GetBatchConsumerTask(queue, BatchSize, run));
+    }
+
+    // Current thread work
+    {
+      std::vector<std::size_t> batch;
+      std::size_t message = 0;
+      auto producer = queue->GetProducer();
+      for (auto _ : state) {
+        while (batch.size() < BatchSize) batch.push_back(message++);
+        bool res = producer.PushMany(batch);
+        benchmark::DoNotOptimize(res);
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * BatchSize);
+
+    run = false;
+  });
+}
+
+// Round trip through a pair of queues, the echo task and the current task
+// wake each other up on every message
+template <typename QueueType>
+void ping_pong(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    auto requests = QueueType::Create(1);
+    auto responses = QueueType::Create(1);
+
+    auto echo = utils::Async("echo", [consumer = requests->GetConsumer(),
+                                      producer = responses->GetProducer()] {
+      std::size_t value{};
+      while (consumer.Pop(value)) {
+        if (!producer.Push(std::size_t{value})) return;
+      }
+    });
+
+    {
+      auto producer = requests->GetProducer();
+      auto consumer = responses->GetConsumer();
+      std::size_t message = 0;
+      std::size_t value{};
+      for (auto _ : state) {
+        bool res = producer.Push(std::size_t{message++});
+        res = res && consumer.Pop(value);
+        benchmark::DoNotOptimize(res);
+      }
+    }
+
+    echo.Get();
+  });
+}
+
 BENCHMARK_TEMPLATE(producer_consumer, concurrent::NonFifoMpmcQueue<std::size_t>)
     ->RangeMultiplier(2)
     ->Ranges({{1, 4}, {1, 4}, {128, 512}});
@@ -95,4 +197,49 @@ BENCHMARK_TEMPLATE(producer_consumer, concurrent::MpscQueue<std::size_t>)
     ->RangeMultiplier(2)
     ->Ranges({{1, 4}, {1, 1}, {1'000'000'000, 1'000'000'000}});
 
+BENCHMARK_TEMPLATE(producer_consumer, concurrent::BoundedMpscQueue<std::size_t>)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 4}, {1, 1}, {128, 512}});
+
+BENCHMARK_TEMPLATE(producer_consumer, concurrent::BoundedSpscQueue<std::size_t>)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 1}, {1, 1}, {128, 512}});
+
+BENCHMARK_TEMPLATE(producer_consumer_batch,
+                   concurrent::NonFifoMpscQueue<std::size_t>)
+    ->RangeMultiplier(4)
+    ->Ranges({{1, 4}, {1, 1}, {1024, 1024}, {1, 64}});
+
+BENCHMARK_TEMPLATE(producer_consumer_batch,
+                   concurrent::NonFifoMpmcQueue<std::size_t>)
+    ->RangeMultiplier(4)
+    ->Ranges({{1, 4}, {1, 4}, {1024, 1024}, {1, 64}});
+
+BENCHMARK_TEMPLATE(producer_consumer_batch,
+                   concurrent::SpscQueue<std::size_t>)
+    ->RangeMultiplier(4)
+    ->Ranges({{1, 1}, {1, 1}, {1024, 1024}, {1, 64}});
+
+BENCHMARK_TEMPLATE(producer_consumer_batch,
+                   concurrent::BoundedMpscQueue<std::size_t>)
+    ->RangeMultiplier(4)
+    ->Ranges({{1, 4}, {1, 1}, {1024, 1024}, {1, 64}});
+
+BENCHMARK_TEMPLATE(producer_consumer_batch,
+                   concurrent::BoundedSpscQueue<std::size_t>)
+    ->RangeMultiplier(4)
+    ->Ranges({{1, 1}, {1, 1}, {1024, 1024}, {1, 64}});
+
+BENCHMARK_TEMPLATE(ping_pong, concurrent::SpscQueue<std::size_t>)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
+
+BENCHMARK_TEMPLATE(ping_pong, concurrent::MpscQueue<std::size_t>)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
+
+BENCHMARK_TEMPLATE(ping_pong, concurrent::BoundedSpscQueue<std::size_t>)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
+
 USERVER_NAMESPACE_END
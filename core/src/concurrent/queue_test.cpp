@@ -33,8 +33,28 @@ using TestMpscTypes =
     testing::Types<concurrent::NonFifoMpscQueue<int>,
                    concurrent::NonFifoMpscQueue<std::unique_ptr<int>>,
                    concurrent::NonFifoMpscQueue<std::unique_ptr<RefCountData>>>;
+
+template <typename T>
+class BatchQueue : public ::testing::Test {};
+
+using TestBatchTypes =
+    testing::Types<concurrent::NonFifoMpmcQueue<std::size_t>,
+                   concurrent::NonFifoMpscQueue<std::size_t>,
+                   concurrent::SpmcQueue<std::size_t>,
+                   concurrent::SpscQueue<std::size_t>,
+                   concurrent::BoundedMpscQueue<std::size_t>,
+                   concurrent::BoundedSpscQueue<std::size_t>,
+                   concurrent::MpscQueue<std::size_t>>;
+
+std::vector<std::size_t> MakeBatch(std::size_t begin, std::size_t end) {
+  std::vector<std::size_t> batch;
+  for (std::size_t i = begin; i < end; ++i) batch.push_back(i);
+  return batch;
+}
 }  // namespace
 
+TYPED_UTEST_SUITE(BatchQueue, TestBatchTypes);
+
 INSTANTIATE_TYPED_UTEST_SUITE_P(NonFifoMpmcQueue, QueueFixture,
                                 concurrent::NonFifoMpmcQueue<int>);
 
@@ -271,4 +291,183 @@ UTEST_MT(NonFifoSpscQueue, Spsc, 1 + 1) {
                           [](int item) { return item == 1; }));
 }
 
+TYPED_UTEST(BatchQueue, PushManyPopMany) {
+  auto queue = TypeParam::Create(16);
+  auto consumer = queue->GetConsumer();
+  auto producer = queue->GetProducer();
+
+  auto batch = MakeBatch(0, 10);
+  EXPECT_TRUE(producer.PushMany(batch));
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(queue->GetSizeApproximate(), 10);
+
+  std::vector<std::size_t> values;
+  EXPECT_TRUE(consumer.PopMany(values, 4));
+  EXPECT_EQ(values, MakeBatch(0, 4));
+  EXPECT_TRUE(consumer.PopMany(values, 100));
+  EXPECT_EQ(values, MakeBatch(0, 10));
+  EXPECT_EQ(queue->GetSizeApproximate(), 0);
+
+  EXPECT_FALSE(consumer.PopMany(values, 100, engine::Deadline::Passed()));
+  EXPECT_EQ(values.size(), 10);
+}
+
+TYPED_UTEST(BatchQueue, PushManyOverCapacity) {
+  auto queue = TypeParam::Create(8);
+  auto consumer = queue->GetConsumer();
+  std::optional producer(queue->GetProducer());
+
+  // Only the elements that fit are pushed, the rest are left in the batch
+  auto batch = MakeBatch(0, 20);
+  EXPECT_FALSE(producer->PushMany(batch, engine::Deadline::Passed()));
+  EXPECT_EQ(batch, MakeBatch(8, 20));
+
+  auto consumer_task = utils::Async("consumer", [&consumer] {
+    std::vector<std::size_t> values;
+    while (consumer.PopMany(values, 3)) {
+    }
+    return values;
+  });
+
+  // Waits for the consumer to free up the space
+  EXPECT_TRUE(producer->PushMany(batch));
+  EXPECT_TRUE(batch.empty());
+  producer.reset();
+
+  EXPECT_EQ(consumer_task.Get(), MakeBatch(0, 20));
+}
+
+TYPED_UTEST(BatchQueue, PushManyNoConsumer) {
+  auto queue = TypeParam::Create(8);
+  auto producer = queue->GetProducer();
+  (void)queue->GetConsumer();
+
+  auto batch = MakeBatch(0, 4);
+  EXPECT_FALSE(producer.PushMany(batch));
+  EXPECT_EQ(batch.size(), 4);
+}
+
+UTEST(BoundedMpscQueue, Sample) {
+  /// [Sample concurrent::BoundedMpscQueue batching]
+  // Ring buffer of 64 preallocated slots
+  auto queue = concurrent::BoundedMpscQueue<int>::Create(64);
+  auto producer = queue->GetProducer();
+  auto consumer = queue->GetConsumer();
+
+  std::vector<int> batch{1, 2, 3};
+  ASSERT_TRUE(producer.PushMany(batch));
+
+  std::vector<int> values;
+  ASSERT_TRUE(consumer.PopMany(values, 64));
+  EXPECT_EQ(values, (std::vector<int>{1, 2, 3}));
+  /// [Sample concurrent::BoundedMpscQueue batching]
+}
+
+UTEST(BoundedSpscQueue, Capacity) {
+  auto queue = concurrent::BoundedSpscQueue<int>::Create(3);
+  auto producer = queue->GetProducer();
+  auto consumer = queue->GetConsumer();
+
+  EXPECT_EQ(queue->GetSoftMaxSize(), 3);
+  for (int i = 0; i < 3; ++i) EXPECT_TRUE(producer.PushNoblock(int{i}));
+  EXPECT_FALSE(producer.PushNoblock(3));
+
+  // Ring buffer size is rounded up to a power of two
+  queue->SetSoftMaxSize(100);
+  EXPECT_EQ(queue->GetSoftMaxSize(), 4);
+  EXPECT_TRUE(producer.PushNoblock(3));
+  EXPECT_FALSE(producer.PushNoblock(4));
+
+  // Slots are reused after the wraparound
+  for (int i = 0; i < 100; ++i) {
+    int value = -1;
+    EXPECT_TRUE(consumer.Pop(value));
+    EXPECT_EQ(value, i);
+    EXPECT_TRUE(producer.Push(i + 4));
+  }
+}
+
+UTEST(BoundedMpscQueue, QueueCleanUp) {
+  EXPECT_EQ(RefCountData::objects_count.load(), 0);
+  {
+    auto queue =
+        concurrent::BoundedMpscQueue<std::unique_ptr<RefCountData>>::Create(
+            8);
+    auto producer = queue->GetProducer();
+    EXPECT_TRUE(producer.Push(std::make_unique<RefCountData>(1)));
+    EXPECT_TRUE(producer.Push(std::make_unique<RefCountData>(2)));
+    EXPECT_EQ(RefCountData::objects_count.load(), 2);
+  }
+  EXPECT_EQ(RefCountData::objects_count.load(), 0);
+}
+
+UTEST(BoundedSpscQueue, NotDefaultConstructible) {
+  struct Element final {
+    explicit Element(std::unique_ptr<RefCountData> data)
+        : data(std::move(data)) {}
+
+    std::unique_ptr<RefCountData> data;
+  };
+
+  EXPECT_EQ(RefCountData::objects_count.load(), 0);
+  {
+    auto queue = concurrent::BoundedSpscQueue<Element>::Create(8);
+    auto producer = queue->GetProducer();
+    auto consumer = queue->GetConsumer();
+
+    std::vector<Element> values;
+    for (int i = 0; i < 3; ++i) {
+      values.emplace_back(std::make_unique<RefCountData>(i));
+    }
+    EXPECT_TRUE(producer.PushMany(values));
+
+    ASSERT_TRUE(consumer.PopMany(values, 2));
+    ASSERT_EQ(values.size(), 2);
+    EXPECT_EQ(values[0].data->val, 0);
+    EXPECT_EQ(values[1].data->val, 1);
+    values.clear();
+    // The remaining element is destroyed with the queue
+    EXPECT_EQ(RefCountData::objects_count.load(), 1);
+  }
+  EXPECT_EQ(RefCountData::objects_count.load(), 0);
+}
+
+UTEST_MT(BoundedMpscQueue, ManyProducersPushMany, kProducersCount + 1) {
+  constexpr std::size_t kBatchSize = 7;
+  auto queue = concurrent::BoundedMpscQueue<std::size_t>::Create(64);
+  auto consumer = queue->GetConsumer();
+
+  std::vector<engine::TaskWithResult<void>> producers_tasks;
+  producers_tasks.reserve(kProducersCount);
+  for (std::size_t i = 0; i < kProducersCount; ++i) {
+    producers_tasks.push_back(
+        utils::Async("producer", [producer = queue->GetProducer(), i] {
+          for (std::size_t begin = i * kMessageCount;
+               begin < (i + 1) * kMessageCount; begin += kBatchSize) {
+            auto batch = MakeBatch(
+                begin, std::min(begin + kBatchSize, (i + 1) * kMessageCount));
+            ASSERT_TRUE(producer.PushMany(batch));
+          }
+        }));
+  }
+
+  std::vector<int> consumed_messages(kMessageCount * kProducersCount, 0);
+  std::vector<std::size_t> last_from_producer(kProducersCount, 0);
+  std::vector<std::size_t> values;
+  while (consumer.PopMany(values, 16)) {
+    for (const auto value : values) {
+      // Each producer's elements come in order
+      const auto producer_index = value / kMessageCount;
+      EXPECT_LE(last_from_producer[producer_index], value);
+      last_from_producer[producer_index] = value;
+      ++consumed_messages[value];
+    }
+    values.clear();
+  }
+
+  for (auto& task : producers_tasks) task.Get();
+  ASSERT_TRUE(std::all_of(consumed_messages.begin(), consumed_messages.end(),
+                          [](int item) { return item == 1; }));
+}
+
 USERVER_NAMESPACE_END
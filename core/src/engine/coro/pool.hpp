@@ -3,17 +3,18 @@
 #include <algorithm>  // for std::max
 #include <atomic>
 #include <cerrno>
+#include <optional>
 #include <utility>
 
 #include <moodycamel/concurrentqueue.h>
 #include <uboost_coro/coroutine2/coroutine.hpp>
-#include <uboost_coro/coroutine2/protected_fixedsize_stack.hpp>
 
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
 #include "pool_config.hpp"
 #include "pool_stats.hpp"
+#include "stack.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
@@ -36,8 +37,14 @@ class Pool final {
   std::size_t GetStackSize() const;
 
  private:
-  Coroutine CreateCoroutine(bool quiet = false);
+  struct IdleCoroutine {
+    Coroutine coroutine;
+    StackMemory stack;
+  };
+
+  IdleCoroutine CreateCoroutine(bool quiet = false);
   void OnCoroutineDestruction() noexcept;
+  void UpdateMaxStackUsage(const StackMemory& stack) noexcept;
 
   template <typename Token>
   Token& GetToken();
@@ -45,17 +52,18 @@ class Pool final {
   const PoolConfig config_;
   const Executor executor_;
 
-  boost::coroutines2::protected_fixedsize_stack stack_allocator_;
-  moodycamel::ConcurrentQueue<Coroutine> coroutines_;
+  moodycamel::ConcurrentQueue<IdleCoroutine> coroutines_;
   std::atomic<std::size_t> idle_coroutines_num_;
   std::atomic<std::size_t> total_coroutines_num_;
+  std::atomic<std::size_t> max_stack_usage_{0};
+  std::atomic<std::size_t> released_idle_stacks_{0};
 };
 
 template <typename Task>
 class Pool<Task>::CoroutinePtr final {
  public:
-  CoroutinePtr(Coroutine&& coro, Pool<Task>& pool) noexcept
-      : coro_(std::move(coro)), pool_(&pool) {}
+  CoroutinePtr(Coroutine&& coro, StackMemory stack, Pool<Task>& pool) noexcept
+      : coro_(std::move(coro)), stack_(stack), pool_(&pool) {}
 
   CoroutinePtr(CoroutinePtr&&) noexcept = default;
   CoroutinePtr& operator=(CoroutinePtr&&) noexcept = default;
@@ -70,6 +78,8 @@ class Pool<Task>::CoroutinePtr final {
     return coro_;
   }
 
+  const StackMemory& GetStack() const noexcept { return stack_; }
+
   void ReturnToPool() && {
     UASSERT(coro_);
     pool_->PutCoroutine(std::move(*this));
@@ -77,6 +87,7 @@ class Pool<Task>::CoroutinePtr final {
 
  private:
   Coroutine coro_;
+  StackMemory stack_;
   Pool<Task>* pool_;
 };
 
@@ -84,7 +95,6 @@ template <typename Task>
 Pool<Task>::Pool(PoolConfig config, Executor executor)
     : config_(std::move(config)),
       executor_(executor),
-      stack_allocator_(config.stack_size),
       coroutines_(config_.max_size),
       idle_coroutines_num_(config_.initial_size),
       total_coroutines_num_(0) {
@@ -101,15 +111,15 @@ Pool<Task>::~Pool() = default;
 template <typename Task>
 typename Pool<Task>::CoroutinePtr Pool<Task>::GetCoroutine() {
   struct CoroutineMover {
-    std::optional<Coroutine>& result;
+    std::optional<IdleCoroutine>& result;
 
-    CoroutineMover& operator=(Coroutine&& coro) {
+    CoroutineMover& operator=(IdleCoroutine&& coro) {
       result.emplace(std::move(coro));
       return *this;
     }
   };
 
-  std::optional<Coroutine> coroutine;
+  std::optional<IdleCoroutine> coroutine;
   CoroutineMover mover{coroutine};
   auto& token = GetToken<moodycamel::ConsumerToken>();
   if (coroutines_.try_dequeue(token, mover)) {
@@ -117,14 +127,31 @@ typename Pool<Task>::CoroutinePtr Pool<Task>::GetCoroutine() {
   } else {
     coroutine.emplace(CreateCoroutine());
   }
-  return CoroutinePtr(std::move(*coroutine), *this);
+  return CoroutinePtr(std::move(coroutine->coroutine), coroutine->stack,
+                      *this);
 }
 
 template <typename Task>
 void Pool<Task>::PutCoroutine(CoroutinePtr&& coroutine_ptr) {
-  if (idle_coroutines_num_.load() >= config_.max_size) return;
+  // Measuring is a syscall, do not do that on every return
+  constexpr std::size_t kStackUsageSamplingPeriod = 64;
+  thread_local std::size_t returns_count = 0;
+
+  const auto idle_coroutines_num = idle_coroutines_num_.load();
+  if (idle_coroutines_num >= config_.max_size) return;
+
+  const auto& stack = coroutine_ptr.GetStack();
+  if (idle_coroutines_num >= config_.max_dirty_idle_size) {
+    UpdateMaxStackUsage(stack);
+    ReleaseStackPages(stack);
+    ++released_idle_stacks_;
+  } else if (++returns_count % kStackUsageSamplingPeriod == 0) {
+    UpdateMaxStackUsage(stack);
+  }
+
   auto& token = GetToken<moodycamel::ProducerToken>();
-  const bool ok = coroutines_.enqueue(token, std::move(coroutine_ptr.Get()));
+  const bool ok = coroutines_.enqueue(
+      token, IdleCoroutine{std::move(coroutine_ptr.Get()), stack});
   if (ok) ++idle_coroutines_num_;
 }
 
@@ -135,19 +162,22 @@ PoolStats Pool<Task>::GetStats() const {
       total_coroutines_num_.load() - coroutines_.size_approx();
   stats.total_coroutines =
       std::max(total_coroutines_num_.load(), stats.active_coroutines);
+  stats.max_stack_usage = max_stack_usage_.load();
+  stats.released_idle_stacks = released_idle_stacks_.load();
   return stats;
 }
 
 template <typename Task>
-typename Pool<Task>::Coroutine Pool<Task>::CreateCoroutine(bool quiet) {
+typename Pool<Task>::IdleCoroutine Pool<Task>::CreateCoroutine(bool quiet) {
   try {
-    Coroutine coroutine(stack_allocator_, executor_);
+    StackMemory stack;
+    Coroutine coroutine(StackAllocator(config_.stack_size, stack), executor_);
     const auto new_total = ++total_coroutines_num_;
     if (!quiet) {
       LOG_DEBUG() << "Created a coroutine #" << new_total << '/'
                   << config_.max_size;
     }
-    return coroutine;
+    return {std::move(coroutine), stack};
   } catch (const std::bad_alloc&) {
     if (errno == ENOMEM) {
       // It should be ok to allocate here (which LOG_ERROR might do),
@@ -170,6 +200,16 @@ void Pool<Task>::OnCoroutineDestruction() noexcept {
   --total_coroutines_num_;
 }
 
+template <typename Task>
+void Pool<Task>::UpdateMaxStackUsage(const StackMemory& stack) noexcept {
+  const auto usage = GetStackUsage(stack);
+  auto max_usage = max_stack_usage_.load(std::memory_order_relaxed);
+  while (usage > max_usage &&
+         !max_stack_usage_.compare_exchange_weak(max_usage, usage,
+                                                 std::memory_order_relaxed)) {
+  }
+}
+
 template <typename Task>
 std::size_t Pool<Task>::GetStackSize() const {
   return config_.stack_size;
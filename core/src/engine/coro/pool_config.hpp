@@ -13,6 +13,8 @@ struct PoolConfig {
   size_t initial_size = 1000;
   size_t max_size = 10000;
   size_t stack_size = 256 * 1024ULL;
+  // Idle coroutines above this amount give their stack pages back to the OS
+  size_t max_dirty_idle_size = 1000;
 };
 
 PoolConfig Parse(const yaml_config::YamlConfig& value,
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <utility>
 
@@ -10,11 +11,16 @@ namespace engine::coro {
 struct PoolStats {
   size_t active_coroutines = 0;
   size_t total_coroutines = 0;
+  // high-water mark of the stack usage over the sampled coroutines, bytes
+  size_t max_stack_usage = 0;
+  size_t released_idle_stacks = 0;
 };
 
 inline PoolStats& operator+=(PoolStats& lhs, const PoolStats& rhs) {
   lhs.active_coroutines += rhs.active_coroutines;
   lhs.total_coroutines += rhs.total_coroutines;
+  lhs.max_stack_usage = std::max(lhs.max_stack_usage, rhs.max_stack_usage);
+  lhs.released_idle_stacks += rhs.released_idle_stacks;
   return lhs;
 }
 
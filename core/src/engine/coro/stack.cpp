@@ -0,0 +1,80 @@
+#include "stack.hpp"
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <uboost_coro/context/stack_traits.hpp>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::coro {
+
+namespace {
+
+// An idle coroutine is suspended in TaskContext::CoroFunc, its frames and the
+// context record take a few hundred bytes at the top of the stack. Keep some
+// more just in case.
+constexpr std::size_t kIdleStackTopSize = 16 * 1024;
+
+std::size_t PageSize() noexcept {
+  return boost::context::stack_traits::page_size();
+}
+
+}  // namespace
+
+StackAllocator::StackAllocator(std::size_t stack_size,
+                               StackMemory& allocated) noexcept
+    : impl_(stack_size), allocated_(&allocated) {}
+
+boost::context::stack_context StackAllocator::allocate() {
+  auto sctx = impl_.allocate();
+  // protected_fixedsize_stack puts a guard page at the bottom
+  const auto page_size = PageSize();
+  allocated_->bottom = static_cast<char*>(sctx.sp) - sctx.size + page_size;
+  allocated_->size = sctx.size - page_size;
+  return sctx;
+}
+
+void StackAllocator::deallocate(boost::context::stack_context& sctx) noexcept {
+  impl_.deallocate(sctx);
+}
+
+std::size_t GetStackUsage(const StackMemory& stack) noexcept {
+  UASSERT(stack.bottom);
+  const auto page_size = PageSize();
+  const auto pages = stack.size / page_size;
+
+  thread_local std::vector<unsigned char> residency;
+  residency.resize(pages);
+  if (::mincore(stack.bottom, pages * page_size, residency.data()) != 0) {
+    return 0;
+  }
+
+  const auto lowest_touched =
+      std::find_if(residency.begin(), residency.end(),
+                   [](unsigned char page) { return page & 1; });
+  return (residency.end() - lowest_touched) * page_size;
+}
+
+void ReleaseStackPages(const StackMemory& stack) noexcept {
+  UASSERT(stack.bottom);
+  const auto page_size = PageSize();
+  const auto top_size =
+      (kIdleStackTopSize + page_size - 1) / page_size * page_size;
+  if (stack.size <= top_size) return;
+
+  // MADV_DONTNEED rather than MADV_FREE: the latter leaves the pages in RSS
+  // until there is memory pressure, and GetStackUsage() would not see them
+  // released.
+  [[maybe_unused]] const auto res =
+      ::madvise(stack.bottom, stack.size - top_size, MADV_DONTNEED);
+  UASSERT(res == 0);
+}
+
+}  // namespace engine::coro
+
+USERVER_NAMESPACE_END
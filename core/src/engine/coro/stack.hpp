@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+
+#include <uboost_coro/context/stack_context.hpp>
+#include <uboost_coro/coroutine2/protected_fixedsize_stack.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::coro {
+
+/// Usable memory of a coroutine stack, guard page excluded
+struct StackMemory {
+  char* bottom{nullptr};
+  std::size_t size{0};
+};
+
+/// protected_fixedsize_stack that reports the memory of the allocated stack,
+/// so that the pool could inspect and release the pages of idle coroutines.
+class StackAllocator final {
+ public:
+  StackAllocator(std::size_t stack_size, StackMemory& allocated) noexcept;
+
+  boost::context::stack_context allocate();
+  void deallocate(boost::context::stack_context& sctx) noexcept;
+
+ private:
+  boost::coroutines2::protected_fixedsize_stack impl_;
+  StackMemory* allocated_;
+};
+
+/// Returns the high-water mark of the stack usage in bytes with page
+/// granularity, i.e. the distance from the top of the stack to the lowest
+/// page touched since the stack allocation or the last ReleaseStackPages().
+std::size_t GetStackUsage(const StackMemory& stack) noexcept;
+
+/// Gives the pages of an idle coroutine stack back to the OS. The top of the
+/// stack is kept, it holds the frames of the suspended coroutine.
+void ReleaseStackPages(const StackMemory& stack) noexcept;
+
+}  // namespace engine::coro
+
+USERVER_NAMESPACE_END
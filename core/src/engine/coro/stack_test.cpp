@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include <engine/coro/stack.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kStackSize = 256 * 1024;
+
+}  // namespace
+
+TEST(CoroStack, UsageAndRelease) {
+  engine::coro::StackMemory stack;
+  engine::coro::StackAllocator allocator(kStackSize, stack);
+  auto sctx = allocator.allocate();
+  ASSERT_NE(stack.bottom, nullptr);
+  ASSERT_GE(stack.size, kStackSize);
+
+  EXPECT_EQ(engine::coro::GetStackUsage(stack), 0);
+
+  // Stack grows down, touch the upper half
+  std::memset(stack.bottom + stack.size / 2, 1, stack.size / 2);
+  EXPECT_EQ(engine::coro::GetStackUsage(stack), stack.size / 2);
+
+  std::memset(stack.bottom, 1, stack.size);
+  EXPECT_EQ(engine::coro::GetStackUsage(stack), stack.size);
+
+  engine::coro::ReleaseStackPages(stack);
+  const auto usage_after_release = engine::coro::GetStackUsage(stack);
+  EXPECT_GT(usage_after_release, 0);
+  EXPECT_LT(usage_after_release, stack.size / 2);
+  // The top of the stack is intact
+  EXPECT_EQ(stack.bottom[stack.size - 1], 1);
+
+  allocator.deallocate(sctx);
+}
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
 
 USERVER_NAMESPACE_BEGIN
@@ -39,6 +40,13 @@ using AsyncPayloadPtr =
 
 using OnAsyncPayload = void(AsyncPayloadPtr&& ptr);
 
+struct AsyncPayloadStatistics final {
+  // Payloads executed from the queue of an ev-thread, both async and deferred
+  std::uint64_t payloads{0};
+  // ev_async_send calls made to wake up the ev-thread for async payloads
+  std::uint64_t wakeups{0};
+};
+
 }  // namespace engine::ev
 
 USERVER_NAMESPACE_END
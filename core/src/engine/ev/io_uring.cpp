@@ -0,0 +1,387 @@
+#include <engine/ev/io_uring.hpp>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>) && \
+    defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#include <linux/io_uring.h>
+#define USERVER_IMPL_IO_URING_SUPPORTED 1
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+#ifdef USERVER_IMPL_IO_URING_SUPPORTED
+
+namespace {
+
+// Operations are at least 2-byte aligned, the low bit of user_data marks the
+// completion of a cancellation request.
+constexpr std::uint64_t kCancelTag = 1;
+
+std::uint32_t LoadAcquire(const std::uint32_t* ptr) noexcept {
+  // The ring memory is shared with the kernel, std::atomic is not applicable
+  return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+void StoreRelease(std::uint32_t* ptr, std::uint32_t value) noexcept {
+  __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+template <typename T>
+T* Offset(void* base, std::uint32_t offset) noexcept {
+  return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+std::uint64_t ToUserData(IoUring::OperationPtr&& operation) noexcept {
+  UASSERT(operation);
+  UASSERT(!operation->IsCompleted());
+  const auto user_data = reinterpret_cast<std::uint64_t>(operation.detach());
+  UASSERT(!(user_data & kCancelTag));
+  return user_data;
+}
+
+// IORING_OP_READ and IORING_OP_WRITE appeared in Linux 5.6 together with the
+// probing of the supported operations
+bool ProbeFileIo([[maybe_unused]] int ring_fd) {
+#if defined(IO_URING_OP_SUPPORTED) && defined(__NR_io_uring_register)
+  constexpr std::size_t kProbeOpsCount = 256;
+  std::vector<char> storage(sizeof(io_uring_probe) +
+                            kProbeOpsCount * sizeof(io_uring_probe_op));
+  auto* const probe = reinterpret_cast<io_uring_probe*>(storage.data());
+  if (::syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_PROBE, probe,
+                kProbeOpsCount) < 0) {
+    return false;
+  }
+
+  const auto is_supported = [probe](std::uint8_t opcode) {
+    return opcode <= probe->last_op &&
+           (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED);
+  };
+  return is_supported(IORING_OP_READ) && is_supported(IORING_OP_WRITE) &&
+         is_supported(IORING_OP_FSYNC);
+#else
+  return false;
+#endif
+}
+
+}  // namespace
+
+struct IoUring::Rings final {
+  ~Rings() {
+    if (sqes) ::munmap(sqes, sqes_size);
+    if (cq_ptr && cq_ptr != sq_ptr) ::munmap(cq_ptr, cq_size);
+    if (sq_ptr) ::munmap(sq_ptr, sq_size);
+  }
+
+  void* sq_ptr{nullptr};
+  std::size_t sq_size{0};
+  void* cq_ptr{nullptr};
+  std::size_t cq_size{0};
+  io_uring_sqe* sqes{nullptr};
+  std::size_t sqes_size{0};
+
+  std::uint32_t* sq_head{nullptr};
+  std::uint32_t* sq_tail{nullptr};
+  std::uint32_t* sq_flags{nullptr};
+  std::uint32_t sq_mask{0};
+  std::uint32_t sq_entries{0};
+
+  std::uint32_t* cq_head{nullptr};
+  std::uint32_t* cq_tail{nullptr};
+  std::uint32_t cq_mask{0};
+  io_uring_cqe* cqes{nullptr};
+};
+
+std::unique_ptr<IoUring> IoUring::TryCreate(std::uint32_t entries) {
+  io_uring_params params{};
+  const auto fd =
+      static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+  if (fd < 0) {
+    const std::error_code ec(errno, std::system_category());
+    LOG_WARNING() << "io_uring is not available: " << ec.message();
+    return nullptr;
+  }
+
+  // Without IORING_FEAT_NODROP completions may be lost on CQ overflow, and a
+  // lost completion is a task that never wakes up
+  if (!(params.features & IORING_FEAT_NODROP)) {
+    LOG_WARNING() << "io_uring is too old: IORING_FEAT_NODROP is missing";
+    ::close(fd);
+    return nullptr;
+  }
+
+  auto rings = std::make_unique<Rings>();
+  rings->sq_size =
+      params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+  rings->cq_size =
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (single_mmap) {
+    rings->sq_size = rings->cq_size = std::max(rings->sq_size, rings->cq_size);
+  }
+
+  const auto map = [fd](std::size_t size, off_t offset) -> void* {
+    void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, fd, offset);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+  };
+
+  rings->sq_ptr = map(rings->sq_size, IORING_OFF_SQ_RING);
+  rings->cq_ptr =
+      single_mmap ? rings->sq_ptr : map(rings->cq_size, IORING_OFF_CQ_RING);
+  rings->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+  rings->sqes =
+      static_cast<io_uring_sqe*>(map(rings->sqes_size, IORING_OFF_SQES));
+  if (!rings->sq_ptr || !rings->cq_ptr || !rings->sqes) {
+    const std::error_code ec(errno, std::system_category());
+    LOG_WARNING() << "Failed to map io_uring rings: " << ec.message();
+    rings.reset();
+    ::close(fd);
+    return nullptr;
+  }
+
+  rings->sq_head = Offset<std::uint32_t>(rings->sq_ptr, params.sq_off.head);
+  rings->sq_tail = Offset<std::uint32_t>(rings->sq_ptr, params.sq_off.tail);
+  rings->sq_flags = Offset<std::uint32_t>(rings->sq_ptr, params.sq_off.flags);
+  rings->sq_mask =
+      *Offset<std::uint32_t>(rings->sq_ptr, params.sq_off.ring_mask);
+  rings->sq_entries = params.sq_entries;
+
+  // Identity mapping of the SQ array to SQEs, set once
+  auto* const sq_array =
+      Offset<std::uint32_t>(rings->sq_ptr, params.sq_off.array);
+  for (std::uint32_t i = 0; i < params.sq_entries; ++i) sq_array[i] = i;
+
+  rings->cq_head = Offset<std::uint32_t>(rings->cq_ptr, params.cq_off.head);
+  rings->cq_tail = Offset<std::uint32_t>(rings->cq_ptr, params.cq_off.tail);
+  rings->cq_mask =
+      *Offset<std::uint32_t>(rings->cq_ptr, params.cq_off.ring_mask);
+  rings->cqes = Offset<io_uring_cqe>(rings->cq_ptr, params.cq_off.cqes);
+
+  const bool supports_file_io = ProbeFileIo(fd);
+  if (!supports_file_io) {
+    LOG_INFO() << "io_uring does not support file reads and writes, file I/O "
+                  "is done on the blocking task processors";
+  }
+
+  return std::unique_ptr<IoUring>(
+      new IoUring(fd, std::move(rings), supports_file_io));
+}
+
+IoUring::IoUring(int ring_fd, std::unique_ptr<Rings> rings,
+                 bool supports_file_io)
+    : ring_fd_(ring_fd),
+      rings_(std::move(rings)),
+      supports_file_io_(supports_file_io) {}
+
+IoUring::~IoUring() {
+  rings_.reset();
+  ::close(ring_fd_);
+}
+
+void IoUring::SubmitPoll(int fd, std::uint32_t poll_mask,
+                         OperationPtr operation) {
+  Submission submission;
+  submission.opcode = IORING_OP_POLL_ADD;
+  submission.fd = fd;
+  submission.poll_mask = poll_mask;
+  submission.user_data = ToUserData(std::move(operation));
+  Submit(submission);
+}
+
+void IoUring::SubmitPollCancel(OperationPtr operation) {
+  UASSERT(operation);
+  Submission submission;
+  submission.opcode = IORING_OP_POLL_REMOVE;
+  submission.addr = reinterpret_cast<std::uint64_t>(operation.get());
+  // The reference is released when the cancellation completes. Until then the
+  // address of the operation may not be reused by another poll.
+  submission.user_data =
+      reinterpret_cast<std::uint64_t>(operation.detach()) | kCancelTag;
+  Submit(submission);
+}
+
+void IoUring::SubmitRead(int fd, void* buffer, std::uint32_t size,
+                         std::uint64_t offset, OperationPtr operation) {
+  UASSERT(supports_file_io_);
+  Submission submission;
+  submission.opcode = IORING_OP_READ;
+  submission.fd = fd;
+  submission.addr = reinterpret_cast<std::uint64_t>(buffer);
+  submission.len = size;
+  submission.offset = offset;
+  submission.user_data = ToUserData(std::move(operation));
+  Submit(submission);
+}
+
+void IoUring::SubmitWrite(int fd, const void* buffer, std::uint32_t size,
+                          std::uint64_t offset, OperationPtr operation) {
+  UASSERT(supports_file_io_);
+  Submission submission;
+  submission.opcode = IORING_OP_WRITE;
+  submission.fd = fd;
+  submission.addr = reinterpret_cast<std::uint64_t>(buffer);
+  submission.len = size;
+  submission.offset = offset;
+  submission.user_data = ToUserData(std::move(operation));
+  Submit(submission);
+}
+
+void IoUring::SubmitFSync(int fd, OperationPtr operation) {
+  UASSERT(supports_file_io_);
+  Submission submission;
+  submission.opcode = IORING_OP_FSYNC;
+  submission.fd = fd;
+  submission.user_data = ToUserData(std::move(operation));
+  Submit(submission);
+}
+
+void IoUring::ProcessCompletions() noexcept {
+  auto& rings = *rings_;
+
+  // Only this thread moves the CQ head
+  std::uint32_t head = *rings.cq_head;
+  while (true) {
+    const auto tail = LoadAcquire(rings.cq_tail);
+    if (head == tail) break;
+
+    for (; head != tail; ++head) {
+      const auto& cqe = rings.cqes[head & rings.cq_mask];
+      const auto user_data = cqe.user_data;
+      const auto result = cqe.res;
+      if (!user_data) continue;
+
+      OperationPtr operation{
+          reinterpret_cast<Operation*>(user_data & ~kCancelTag),
+          /*add_ref=*/false};
+      if (user_data & kCancelTag) continue;
+
+      operation->is_completed_.store(true, std::memory_order_release);
+      operation->OnCompletion(result);
+    }
+    StoreRelease(rings.cq_head, head);
+
+    // With IORING_FEAT_NODROP completions that did not fit into the CQ are
+    // kept by the kernel until the next io_uring_enter()
+    if (LoadAcquire(rings.sq_flags) & IORING_SQ_CQ_OVERFLOW) {
+      ::syscall(__NR_io_uring_enter, ring_fd_, 0, 0, IORING_ENTER_GETEVENTS,
+                nullptr, 0);
+    }
+  }
+
+  // Submissions may have been postponed by a full completion queue
+  Flush();
+}
+
+void IoUring::Submit(const Submission& submission) {
+  {
+    const std::lock_guard lock(submit_mutex_);
+    auto& rings = *rings_;
+
+    // Only this critical section moves the SQ tail
+    const auto tail = *rings.sq_tail;
+    while (tail - LoadAcquire(rings.sq_head) >= rings.sq_entries) {
+      // The kernel consumes submitted entries synchronously, so the queue may
+      // be full only if other submitters have not called Flush() yet
+      Flush();
+      std::this_thread::yield();
+    }
+
+    auto& sqe = rings.sqes[tail & rings.sq_mask];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = submission.opcode;
+    sqe.fd = submission.fd;
+    sqe.addr = submission.addr;
+    sqe.len = submission.len;
+    sqe.off = submission.offset;
+    sqe.poll32_events = submission.poll_mask;
+    sqe.user_data = submission.user_data;
+
+    StoreRelease(rings.sq_tail, tail + 1);
+    unsubmitted_.fetch_add(1, std::memory_order_release);
+  }
+
+  // Entries added by concurrent submitters are flushed with a single syscall
+  Flush();
+}
+
+void IoUring::Flush() {
+  auto to_submit = unsubmitted_.exchange(0, std::memory_order_acquire);
+  while (to_submit != 0) {
+    const auto submitted = ::syscall(__NR_io_uring_enter, ring_fd_, to_submit,
+                                     0, 0, nullptr, 0);
+    if (submitted >= 0) {
+      to_submit -= static_cast<std::uint32_t>(submitted);
+      if (to_submit == 0) return;
+    } else if (errno != EINTR) {
+      const auto error_code = errno;
+      if (error_code != EAGAIN && error_code != EBUSY) {
+        const std::error_code ec(error_code, std::system_category());
+        LOG_LIMITED_ERROR() << "io_uring_enter failed: " << ec.message();
+      }
+      // Leave the rest to the next Flush(), at the latest in
+      // ProcessCompletions()
+      unsubmitted_.fetch_add(to_submit, std::memory_order_release);
+      return;
+    }
+  }
+}
+
+#else  // USERVER_IMPL_IO_URING_SUPPORTED
+
+struct IoUring::Rings final {};
+
+std::unique_ptr<IoUring> IoUring::TryCreate(std::uint32_t) {
+  LOG_WARNING() << "io_uring is not supported on this platform";
+  return nullptr;
+}
+
+IoUring::IoUring(int ring_fd, std::unique_ptr<Rings> rings,
+                 bool supports_file_io)
+    : ring_fd_(ring_fd),
+      rings_(std::move(rings)),
+      supports_file_io_(supports_file_io) {}
+
+IoUring::~IoUring() = default;
+
+void IoUring::SubmitPoll(int, std::uint32_t, OperationPtr) { UASSERT(false); }
+
+void IoUring::SubmitPollCancel(OperationPtr) { UASSERT(false); }
+
+void IoUring::SubmitRead(int, void*, std::uint32_t, std::uint64_t,
+                         OperationPtr) {
+  UASSERT(false);
+}
+
+void IoUring::SubmitWrite(int, const void*, std::uint32_t, std::uint64_t,
+                          OperationPtr) {
+  UASSERT(false);
+}
+
+void IoUring::SubmitFSync(int, OperationPtr) { UASSERT(false); }
+
+void IoUring::ProcessCompletions() noexcept { UASSERT(false); }
+
+void IoUring::Submit(const Submission&) { UASSERT(false); }
+
+void IoUring::Flush() {}
+
+#endif  // USERVER_IMPL_IO_URING_SUPPORTED
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
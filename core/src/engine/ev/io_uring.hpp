@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+#include <boost/smart_ptr/intrusive_ref_counter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+/// @brief Minimal io_uring instance driven by an ev::Thread.
+///
+/// Submissions may come from any thread: they are serialized by a short
+/// critical section and flushed to the kernel by a single io_uring_enter()
+/// call per batch of concurrently added operations. Completions are processed
+/// in the ev-loop thread, which watches the ring fd for readability.
+///
+/// Sockets are only polled for readiness, data transfer is still done by the
+/// usual non-blocking syscalls. Regular files are read and written by the
+/// ring itself if the kernel supports it, see SupportsFileIo().
+class IoUring final {
+ public:
+  /// Base for an operation in flight. The ring holds a reference to the
+  /// operation until its completion is processed, so the address of the
+  /// operation is never reused while the kernel may still refer to it.
+  class Operation
+      : public boost::intrusive_ref_counter<Operation,
+                                            boost::thread_safe_counter> {
+   public:
+    virtual ~Operation() = default;
+
+    /// Whether the completion of the operation has been processed
+    bool IsCompleted() const noexcept {
+      return is_completed_.load(std::memory_order_acquire);
+    }
+
+   protected:
+    /// Invoked in the ev-loop thread with the `res` field of the completion
+    virtual void OnCompletion(std::int32_t result) noexcept = 0;
+
+   private:
+    friend class IoUring;
+
+    std::atomic<bool> is_completed_{false};
+  };
+
+  using OperationPtr = boost::intrusive_ptr<Operation>;
+
+  /// Returns nullptr if io_uring is not supported by the kernel or is
+  /// forbidden (e.g. by seccomp)
+  static std::unique_ptr<IoUring> TryCreate(std::uint32_t entries);
+
+  ~IoUring();
+
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+
+  int Fd() const noexcept { return ring_fd_; }
+
+  /// Starts a one-shot poll of `fd` for `poll_mask` (POLLIN, POLLOUT, ...)
+  void SubmitPoll(int fd, std::uint32_t poll_mask, OperationPtr operation);
+
+  /// Requests cancellation of a poll previously started by SubmitPoll(). The
+  /// poll completes with -ECANCELED unless it has already fired.
+  void SubmitPollCancel(OperationPtr operation);
+
+  /// Whether the kernel supports SubmitRead(), SubmitWrite() and
+  /// SubmitFSync()
+  bool SupportsFileIo() const noexcept { return supports_file_io_; }
+
+  /// Starts a read of up to `size` bytes at `offset` of the file. The
+  /// operation completes with the number of bytes read or with -errno.
+  /// `buffer` must stay valid until the operation is completed.
+  void SubmitRead(int fd, void* buffer, std::uint32_t size,
+                  std::uint64_t offset, OperationPtr operation);
+
+  /// Starts a write of up to `size` bytes at `offset` of the file. The
+  /// operation completes with the number of bytes written or with -errno.
+  /// `buffer` must stay valid until the operation is completed.
+  void SubmitWrite(int fd, const void* buffer, std::uint32_t size,
+                   std::uint64_t offset, OperationPtr operation);
+
+  /// Starts an fsync of the file. The operation completes with 0 or -errno.
+  void SubmitFSync(int fd, OperationPtr operation);
+
+  /// Must be called from the thread that watches Fd()
+  void ProcessCompletions() noexcept;
+
+ private:
+  struct Rings;
+
+  // Fields of a submission queue entry that are used by the operations
+  struct Submission final {
+    std::uint8_t opcode{0};
+    int fd{-1};
+    std::uint64_t addr{0};
+    std::uint32_t len{0};
+    std::uint64_t offset{0};
+    std::uint32_t poll_mask{0};
+    std::uint64_t user_data{0};
+  };
+
+  IoUring(int ring_fd, std::unique_ptr<Rings> rings, bool supports_file_io);
+
+  void Submit(const Submission& submission);
+  void Flush();
+
+  const int ring_fd_;
+  std::unique_ptr<Rings> rings_;
+  const bool supports_file_io_;
+
+  std::mutex submit_mutex_;
+  std::atomic<std::uint32_t> unsubmitted_{0};
+};
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
@@ -13,6 +13,7 @@
 #include <utils/check_syscall.hpp>
 #include <utils/impl/assert_extra.hpp>
 #include <utils/statistics/thread_statistics.hpp>
+#include <utils/threads.hpp>
 
 #include "child_process_map.hpp"
 
@@ -58,20 +59,30 @@ void ReleaseEvDefaultLoop() {
 constexpr std::chrono::milliseconds kCpuStatsCollectInterval{1000};
 constexpr std::size_t kCpuStatsThrottle{16};
 
+// Each waiting socket direction takes a single submission, which is consumed
+// by the kernel right away, so the queue only has to fit a burst
+constexpr std::uint32_t kIoUringEntries{1024};
+
 }  // namespace
 
 Thread::Thread(const std::string& thread_name,
-               RegisterEventMode register_event_mode)
-    : Thread(thread_name, false, register_event_mode) {}
+               RegisterEventMode register_event_mode, IoBackend io_backend,
+               std::vector<std::size_t> cpu_affinity)
+    : Thread(thread_name, false, register_event_mode, io_backend,
+             std::move(cpu_affinity)) {}
 
 Thread::Thread(const std::string& thread_name, UseDefaultEvLoop,
-               RegisterEventMode register_event_mode)
-    : Thread(thread_name, true, register_event_mode) {}
+               RegisterEventMode register_event_mode, IoBackend io_backend,
+               std::vector<std::size_t> cpu_affinity)
+    : Thread(thread_name, true, register_event_mode, io_backend,
+             std::move(cpu_affinity)) {}
 
 Thread::Thread(const std::string& thread_name, bool use_ev_default_loop,
-               RegisterEventMode register_event_mode)
+               RegisterEventMode register_event_mode, IoBackend io_backend,
+               std::vector<std::size_t> cpu_affinity)
     : use_ev_default_loop_(use_ev_default_loop),
       register_event_mode_(register_event_mode),
+      cpu_affinity_(std::move(cpu_affinity)),
       func_queue_(kInitFuncQueueCapacity),
       loop_(nullptr),
       lock_(loop_mutex_, std::defer_lock),
@@ -79,6 +90,13 @@ Thread::Thread(const std::string& thread_name, bool use_ev_default_loop,
       cpu_stats_storage_{kCpuStatsCollectInterval, kCpuStatsThrottle},
       is_running_(false) {
   if (use_ev_default_loop_) AcquireEvDefaultLoop(name_);
+  if (io_backend == IoBackend::kIoUring) {
+    io_uring_ = IoUring::TryCreate(kIoUringEntries);
+    if (!io_uring_) {
+      LOG_WARNING() << "Falling back to libev io watchers for thread_name="
+                    << name_;
+    }
+  }
   Start();
 }
 
@@ -91,7 +109,8 @@ Thread::~Thread() {
 void Thread::RunInEvLoopAsync(OnAsyncPayload* func, AsyncPayloadPtr&& data) {
   RegisterInEvLoop(func, std::move(data));
 
-  if (!IsInEvThread()) {
+  if (!IsInEvThread() && !wakeup_pending_.exchange(true)) {
+    ++async_wakeups_;
     ev_async_send(loop_, &watch_update_);
   }
 }
@@ -141,6 +160,13 @@ std::uint8_t Thread::GetCurrentLoadPercent() const {
 
 const std::string& Thread::GetName() const { return name_; }
 
+AsyncPayloadStatistics Thread::GetAsyncPayloadStatistics() const noexcept {
+  AsyncPayloadStatistics stats;
+  stats.payloads = drained_payloads_.load(std::memory_order_relaxed);
+  stats.wakeups = async_wakeups_.Load();
+  return stats;
+}
+
 void Thread::Start() {
   loop_ = use_ev_default_loop_ ? ev_default_loop(EVFLAG_AUTO)
                                : ev_loop_new(EVFLAG_AUTO);
@@ -186,9 +212,21 @@ void Thread::Start() {
     ev_child_start(loop_, &watch_child_);
   }
 
+  if (io_uring_) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+    ev_io_init(&watch_io_uring_, IoUringWatcher, io_uring_->Fd(), EV_READ);
+    ev_io_start(loop_, &watch_io_uring_);
+  }
+
   is_running_ = true;
   thread_ = std::thread([this] {
     utils::SetCurrentThreadName(name_);
+    try {
+      utils::SetCurrentThreadAffinity(cpu_affinity_);
+    } catch (const std::exception& ex) {
+      // The CPU set may change after the config was checked
+      LOG_ERROR() << "Failed to pin the event thread " << name_ << ": " << ex;
+    }
     RunEvLoop();
   });
 }
@@ -222,6 +260,11 @@ void Thread::RunEvLoop() {
     ev_timer_stop(loop_, &stats_timer_);
   }
   if (use_ev_default_loop_) ev_child_stop(loop_, &watch_child_);
+  if (io_uring_) {
+    ev_io_stop(loop_, &watch_io_uring_);
+    // Release the operations of cancelled polls
+    io_uring_->ProcessCompletions();
+  }
 }
 
 void Thread::UpdateLoopWatcher(struct ev_loop* loop, ev_async*, int) noexcept {
@@ -238,8 +281,21 @@ void Thread::UpdateTimersWatcher(struct ev_loop* loop, ev_timer*,
 }
 
 void Thread::UpdateLoopWatcherImpl() {
+  // Producers that found wakeup_pending_ set have not sent a wakeup, so the
+  // queue is drained until no payloads were pushed under the flag. The
+  // exchange pairs with the one in RunInEvLoopAsync(): either we see the
+  // payload of a producer, or the producer sees the reset flag and sends a
+  // wakeup.
+  do {
+    DrainFuncQueue();
+  } while (wakeup_pending_.exchange(false));
+}
+
+void Thread::DrainFuncQueue() {
+  std::uint64_t drained = 0;
   QueueData queue_element{};
   while (func_queue_.pop(queue_element)) {
+    ++drained;
     AsyncPayloadPtr data(queue_element.data);
     LOG_TRACE() << "Thread::UpdateLoopWatcherImpl(), "
                 << compiler::GetTypeName(typeid(*queue_element.data));
@@ -249,6 +305,12 @@ void Thread::UpdateLoopWatcherImpl() {
       LOG_WARNING() << "exception in async thread func: " << ex;
     }
   }
+
+  if (drained != 0) {
+    drained_payloads_.store(
+        drained_payloads_.load(std::memory_order_relaxed) + drained,
+        std::memory_order_relaxed);
+  }
 }
 
 void Thread::BreakLoopWatcher(struct ev_loop* loop, ev_async*, int) noexcept {
@@ -263,6 +325,12 @@ void Thread::BreakLoopWatcherImpl() {
   ev_break(loop_, EVBREAK_ALL);
 }
 
+void Thread::IoUringWatcher(struct ev_loop* loop, ev_io*, int) noexcept {
+  auto* ev_thread = static_cast<Thread*>(ev_userdata(loop));
+  UASSERT(ev_thread != nullptr);
+  ev_thread->io_uring_->ProcessCompletions();
+}
+
 void Thread::ChildWatcher(struct ev_loop*, ev_child* w, int) noexcept {
   try {
     ChildWatcherImpl(w);
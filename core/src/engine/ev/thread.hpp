@@ -5,14 +5,18 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <ev.h>
 #include <boost/lockfree/queue.hpp>
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
 #include <userver/engine/deadline.hpp>
+#include <userver/utils/statistics/relaxed_counter.hpp>
 
 #include <engine/ev/async_payload_base.hpp>
+#include <engine/ev/io_uring.hpp>
+#include <engine/ev/thread_pool_config.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -35,8 +39,12 @@ class Thread final {
     kDeferred
   };
 
-  Thread(const std::string& thread_name, RegisterEventMode);
-  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode);
+  Thread(const std::string& thread_name, RegisterEventMode,
+         IoBackend io_backend = IoBackend::kLibEv,
+         std::vector<std::size_t> cpu_affinity = {});
+  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode,
+         IoBackend io_backend = IoBackend::kLibEv,
+         std::vector<std::size_t> cpu_affinity = {});
   ~Thread();
 
   struct ev_loop* GetEvLoop() const {
@@ -55,12 +63,19 @@ class Thread final {
 
   bool IsInEvThread() const;
 
+  // Returns nullptr if the thread was not configured to use io_uring or if
+  // io_uring is not available.
+  IoUring* GetIoUring() const noexcept { return io_uring_.get(); }
+
   std::uint8_t GetCurrentLoadPercent() const;
   const std::string& GetName() const;
 
+  AsyncPayloadStatistics GetAsyncPayloadStatistics() const noexcept;
+
  private:
   Thread(const std::string& thread_name, bool use_ev_default_loop,
-         RegisterEventMode register_event_mode);
+         RegisterEventMode register_event_mode, IoBackend io_backend,
+         std::vector<std::size_t> cpu_affinity);
 
   void RegisterInEvLoop(OnAsyncPayload* func, AsyncPayloadPtr&& data);
 
@@ -72,8 +87,10 @@ class Thread final {
   static void UpdateLoopWatcher(struct ev_loop*, ev_async* w, int) noexcept;
   static void UpdateTimersWatcher(struct ev_loop*, ev_timer* w, int) noexcept;
   void UpdateLoopWatcherImpl();
+  void DrainFuncQueue();
   static void BreakLoopWatcher(struct ev_loop*, ev_async* w, int) noexcept;
   void BreakLoopWatcherImpl();
+  static void IoUringWatcher(struct ev_loop*, ev_io* w, int) noexcept;
   static void ChildWatcher(struct ev_loop*, ev_child* w, int) noexcept;
   static void ChildWatcherImpl(ev_child* w);
 
@@ -84,6 +101,7 @@ class Thread final {
 
   bool use_ev_default_loop_;
   RegisterEventMode register_event_mode_;
+  const std::vector<std::size_t> cpu_affinity_;
 
   struct QueueData {
     OnAsyncPayload* func;
@@ -92,6 +110,15 @@ class Thread final {
 
   boost::lockfree::queue<QueueData> func_queue_;
 
+  // Set by the first producer that sends a wakeup, reset by the ev-thread
+  // after draining func_queue_. While it is set, producers rely on the pending
+  // wakeup or on the ongoing drain and do not call ev_async_send, so under
+  // load many payloads are drained per wakeup.
+  std::atomic<bool> wakeup_pending_{false};
+  utils::statistics::RelaxedCounter<std::uint64_t> async_wakeups_;
+  // Written only by the ev-thread
+  std::atomic<std::uint64_t> drained_payloads_{0};
+
   struct ev_loop* loop_;
   std::thread thread_;
   std::mutex loop_mutex_;
@@ -102,6 +129,9 @@ class Thread final {
   ev_async watch_update_{};
   ev_async watch_break_{};
   ev_child watch_child_{};
+  ev_io watch_io_uring_{};
+
+  std::unique_ptr<IoUring> io_uring_;
 
   const std::string name_;
   utils::statistics::ThreadCpuStatsStorage cpu_stats_storage_;
@@ -75,12 +75,21 @@ bool ThreadControl::IsInEvThread() const noexcept {
   return thread_.IsInEvThread();
 }
 
+IoUring* ThreadControl::GetIoUring() const noexcept {
+  return thread_.GetIoUring();
+}
+
 std::uint8_t ThreadControl::GetCurrentLoadPercent() const {
   return thread_.GetCurrentLoadPercent();
 }
 
 const std::string& ThreadControl::GetName() const { return thread_.GetName(); }
 
+AsyncPayloadStatistics ThreadControl::GetAsyncPayloadStatistics()
+    const noexcept {
+  return thread_.GetAsyncPayloadStatistics();
+}
+
 }  // namespace engine::ev
 
 USERVER_NAMESPACE_END
@@ -98,6 +98,7 @@ class CallerOwnedPayloadBlocking final : public AsyncPayloadBase {
 }  // namespace impl
 
 class Thread;
+class IoUring;
 
 class ThreadControl final {
  public:
@@ -147,9 +148,14 @@ class ThreadControl final {
 
   bool IsInEvThread() const noexcept;
 
+  /// Returns nullptr if the thread does not use io_uring
+  IoUring* GetIoUring() const noexcept;
+
   std::uint8_t GetCurrentLoadPercent() const;
   const std::string& GetName() const;
 
+  AsyncPayloadStatistics GetAsyncPayloadStatistics() const noexcept;
+
  private:
   Thread& thread_;
 };
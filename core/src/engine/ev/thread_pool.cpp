@@ -2,7 +2,9 @@
 
 #include <fmt/format.h>
 
+#include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <utils/threads.hpp>
 
 #include "thread.hpp"
 #include "thread_control.hpp"
@@ -31,12 +33,31 @@ ThreadPool::ThreadPool(ThreadPoolConfig config, bool use_ev_default_loop)
   const auto register_timer_event_mode =
       GetRegisterEventMode(config.defer_events);
 
+  std::vector<std::vector<std::size_t>> numa_node_cpus;
+  if (config.numa_aware) {
+    const auto numa_nodes_count = utils::GetNumaNodesCount();
+    for (std::size_t node = 0; node < numa_nodes_count; ++node) {
+      numa_node_cpus.push_back(utils::GetNumaNodeCpus(node));
+    }
+    for (std::size_t index = 0; index < config.threads; ++index) {
+      numa_nodes_.push_back(index % numa_nodes_count);
+    }
+    LOG_INFO() << "Spreading " << config.threads << " threads of "
+               << config.thread_name << " over " << numa_nodes_count
+               << " NUMA nodes";
+  }
+
   threads_ = utils::GenerateFixedArray(config.threads, [&](std::size_t index) {
     const auto thread_name = fmt::format("{}_{}", config.thread_name, index);
+    auto cpu_affinity = config.numa_aware
+                            ? numa_node_cpus[numa_nodes_[index]]
+                            : config.cpu_affinity;
     return (use_ev_default_loop && index == 0)
                ? Thread(thread_name, Thread::kUseDefaultEvLoop,
-                        register_timer_event_mode)
-               : Thread(thread_name, register_timer_event_mode);
+                        register_timer_event_mode, config.io_backend,
+                        std::move(cpu_affinity))
+               : Thread(thread_name, register_timer_event_mode,
+                        config.io_backend, std::move(cpu_affinity));
   });
 
   thread_controls_ = utils::GenerateFixedArray(
@@ -67,6 +88,20 @@ std::vector<ThreadControl*> ThreadPool::NextThreads(std::size_t count) {
   return res;
 }
 
+ThreadControl& ThreadPool::GetThread(std::size_t index) {
+  UASSERT(index < thread_controls_.size());
+  return thread_controls_[index];
+}
+
+std::vector<std::size_t> ThreadPool::GetNumaNodeThreads(
+    std::size_t numa_node) const {
+  std::vector<std::size_t> res;
+  for (std::size_t index = 0; index < numa_nodes_.size(); ++index) {
+    if (numa_nodes_[index] == numa_node) res.push_back(index);
+  }
+  return res;
+}
+
 ThreadControl& ThreadPool::GetEvDefaultLoopThread() {
   UINVARIANT(!thread_controls_.empty() && use_ev_default_loop_,
              "no ev_default_loop in current thread_pool");
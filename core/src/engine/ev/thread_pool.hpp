@@ -29,6 +29,12 @@ class ThreadPool final {
 
   std::vector<ThreadControl*> NextThreads(std::size_t count);
 
+  ThreadControl& GetThread(std::size_t index);
+
+  /// Indices of the threads pinned to the NUMA node, empty if the pool is not
+  /// NUMA-aware
+  std::vector<std::size_t> GetNumaNodeThreads(std::size_t numa_node) const;
+
   ThreadControl& GetEvDefaultLoopThread();
 
  private:
@@ -37,6 +43,8 @@ class ThreadPool final {
   bool use_ev_default_loop_;
   utils::FixedArray<Thread> threads_;
   utils::FixedArray<ThreadControl> thread_controls_;
+  // NUMA node of each thread, empty if the pool is not NUMA-aware
+  std::vector<std::size_t> numa_nodes_;
   std::atomic<std::size_t> next_thread_idx_{0};
 };
 
@@ -1,15 +1,34 @@
 #include "thread_pool_config.hpp"
 
+#include <userver/utils/assert.hpp>
+#include <utils/threads.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::ev {
 
+IoBackend Parse(const yaml_config::YamlConfig& value,
+                formats::parse::To<IoBackend>) {
+  const auto str = value.As<std::string>();
+  if (str == "libev") return IoBackend::kLibEv;
+  if (str == "io-uring") return IoBackend::kIoUring;
+  UINVARIANT(false, "Unknown event thread io backend: " + str);
+}
+
 ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ThreadPoolConfig>) {
   ThreadPoolConfig config;
   config.threads = value["threads"].As<size_t>(config.threads);
   config.thread_name = value["thread_name"].As<std::string>(config.thread_name);
   config.defer_events = value["defer_events"].As<bool>(config.defer_events);
+  config.io_backend = value["io_backend"].As<IoBackend>(config.io_backend);
+  const auto cpu_affinity =
+      value["cpu_affinity"].As<std::optional<std::string>>();
+  if (cpu_affinity) {
+    config.cpu_affinity = utils::ParseCpuList(*cpu_affinity);
+    utils::CheckCpusAllowed(config.cpu_affinity);
+  }
+  config.numa_aware = value["numa_aware"].As<bool>(config.numa_aware);
   return config;
 }
 
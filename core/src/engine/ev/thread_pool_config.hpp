@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include <userver/formats/yaml.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
@@ -9,13 +10,31 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::ev {
 
+/// How the ev-threads wait for readiness of the engine::io sockets
+enum class IoBackend {
+  /// An ev_io watcher is started and stopped for each wait
+  kLibEv,
+  /// A one-shot io_uring poll is submitted for each wait, falls back to
+  /// kLibEv if io_uring is not available
+  kIoUring,
+};
+
 struct ThreadPoolConfig {
   size_t threads = 2;
   std::string thread_name = "event-worker";
   bool ev_default_loop_disabled = false;
   bool defer_events = false;
+  IoBackend io_backend = IoBackend::kLibEv;
+  // CPUs to pin all the threads to, empty for no pinning
+  std::vector<std::size_t> cpu_affinity;
+  // Spread the threads round-robin over NUMA nodes, pinning each one to
+  // the CPUs of its node. Overrides cpu_affinity.
+  bool numa_aware = false;
 };
 
+IoBackend Parse(const yaml_config::YamlConfig& value,
+                formats::parse::To<IoBackend>);
+
 ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ThreadPoolConfig>);
 
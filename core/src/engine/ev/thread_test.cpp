@@ -0,0 +1,66 @@
+#include <engine/ev/thread.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <engine/ev/thread_control.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr auto kImmediateMode =
+    engine::ev::Thread::RegisterEventMode::kImmediate;
+
+}  // namespace
+
+UTEST(EvThread, AsyncPayloadsFromManyThreads) {
+  constexpr std::size_t kProducersCount = 4;
+  constexpr std::size_t kPayloadsPerProducer = 10000;
+  constexpr std::size_t kPayloadsCount = kProducersCount * kPayloadsPerProducer;
+
+  engine::ev::Thread thread("test_thread", kImmediateMode);
+  engine::ev::ThreadControl thread_control(thread);
+
+  std::size_t executed = 0;  // modified in the ev-thread only
+  std::vector<std::thread> producers;
+  for (std::size_t i = 0; i < kProducersCount; ++i) {
+    producers.emplace_back([&] {
+      for (std::size_t j = 0; j < kPayloadsPerProducer; ++j) {
+        thread_control.RunInEvLoopAsync([&] { ++executed; });
+      }
+    });
+  }
+  for (auto& producer : producers) producer.join();
+
+  // Callbacks are serialized, so the sync one runs after all the async ones
+  std::size_t executed_before_sync = 0;
+  thread_control.RunInEvLoopSync([&] { executed_before_sync = executed; });
+  EXPECT_EQ(executed_before_sync, kPayloadsCount);
+
+  const auto stats = thread_control.GetAsyncPayloadStatistics();
+  EXPECT_GE(stats.payloads, kPayloadsCount);
+  EXPECT_GE(stats.wakeups, 1U);
+  EXPECT_LE(stats.wakeups, stats.payloads);
+}
+
+UTEST(EvThread, WakeupAfterIdle) {
+  engine::ev::Thread thread("test_thread", kImmediateMode);
+  engine::ev::ThreadControl thread_control(thread);
+
+  // Each payload is submitted after the previous one is drained. Without a
+  // wakeup the payload is only run by the periodic stats timer, so a lost
+  // wakeup would make the test time out.
+  for (int i = 0; i < 100; ++i) {
+    std::atomic<bool> executed{false};
+    std::thread([&] {
+      thread_control.RunInEvLoopAsync([&] { executed = true; });
+    }).join();
+    while (!executed) engine::Yield();
+  }
+}
+
+USERVER_NAMESPACE_END
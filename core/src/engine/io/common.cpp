@@ -9,6 +9,17 @@ ReadableBase::~ReadableBase() = default;
 WritableBase::~WritableBase() = default;
 RwBase::~RwBase() = default;
 
+size_t WritableBase::WriteAll(std::initializer_list<IoData> list,
+                              Deadline deadline) {
+  size_t sent_bytes = 0;
+  for (const auto& io_data : list) {
+    const auto sent = WriteAll(io_data.data, io_data.len, deadline);
+    sent_bytes += sent;
+    if (sent != io_data.len) break;
+  }
+  return sent_bytes;
+}
+
 }  // namespace engine::io
 
 USERVER_NAMESPACE_END
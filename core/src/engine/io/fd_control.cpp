@@ -1,6 +1,7 @@
 #include "fd_control.hpp"
 
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/resource.h>
 #include <unistd.h>
 
@@ -11,6 +12,7 @@
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <engine/ev/thread_control.hpp>
 #include <engine/impl/wait_list_light.hpp>
 #include <engine/task/task_context.hpp>
 #include <utils/check_syscall.hpp>
@@ -104,6 +106,64 @@ class DirectionWaitStrategy final : public engine::impl::WaitStrategy {
   engine::impl::TaskContext& current_;
 };
 
+class DirectionPollOperation final : public ev::IoUring::Operation {
+ public:
+  explicit DirectionPollOperation(engine::impl::TaskContext& context)
+      : context_(&context), epoch_(context.GetEpoch()) {}
+
+ protected:
+  void OnCompletion(std::int32_t) noexcept override {
+    // Errors (e.g. POLLERR or -ECANCELED) are reported by the following
+    // syscall on the fd, or are not interesting if the wait is over
+    context_->Wakeup(engine::impl::TaskContext::WakeupSource::kWaitList,
+                     epoch_);
+  }
+
+ private:
+  const boost::intrusive_ptr<engine::impl::TaskContext> context_;
+  const engine::impl::SleepState::Epoch epoch_;
+};
+
+// Waits for readiness with a one-shot io_uring poll instead of an ev_io
+// watcher. A poll is submitted from the waiting thread without a round trip
+// to the ev-loop, and wakes up the task directly on completion.
+class IoUringDirectionWaitStrategy final : public engine::impl::WaitStrategy {
+ public:
+  IoUringDirectionWaitStrategy(Deadline deadline,
+                               engine::impl::WaitListLight& waiters,
+                               ev::IoUring& io_uring, int fd,
+                               std::uint32_t poll_mask,
+                               engine::impl::TaskContext& current)
+      : WaitStrategy(deadline),
+        waiters_(waiters),
+        io_uring_(io_uring),
+        fd_(fd),
+        poll_mask_(poll_mask),
+        current_(current) {}
+
+  void SetupWakeups() override {
+    // WaitList wakes up the task on FdControl::Close()
+    waiters_.Append(&current_);
+    operation_ = new DirectionPollOperation(current_);
+    io_uring_.SubmitPoll(fd_, poll_mask_, operation_);
+  }
+
+  void DisableWakeups() override {
+    waiters_.Remove(current_);
+    // Completion of a stale poll is ignored by the epoch check, but the poll
+    // holds a reference to the file until it is cancelled
+    if (!operation_->IsCompleted()) io_uring_.SubmitPollCancel(operation_);
+  }
+
+ private:
+  engine::impl::WaitListLight& waiters_;
+  ev::IoUring& io_uring_;
+  const int fd_;
+  const std::uint32_t poll_mask_;
+  engine::impl::TaskContext& current_;
+  ev::IoUring::OperationPtr operation_;
+};
+
 }  // namespace
 
 void FdControlDeleter::operator()(FdControl* ptr) const noexcept {
@@ -136,9 +196,13 @@ Direction::SingleUserGuard::~SingleUserGuard() {
 #endif  // #ifndef NDEBUG
 
 Direction::Direction(Kind kind)
+    : Direction(kind, current_task::GetEventThread()) {}
+
+Direction::Direction(Kind kind, ev::ThreadControl& thread_control)
     : kind_(kind),
       state_(State::kInvalid),
-      watcher_(current_task::GetEventThread(), this) {
+      watcher_(thread_control, this),
+      io_uring_(thread_control.GetIoUring()) {
   watcher_.Init(&IoWatcherCb);
 }
 
@@ -157,6 +221,13 @@ engine::impl::TaskContext::WakeupSource Direction::DoWait(Deadline deadline) {
     return engine::impl::TaskContext::WakeupSource::kCancelRequest;
   }
 
+  if (io_uring_) {
+    const std::uint32_t poll_mask = kind_ == Kind::kRead ? POLLIN : POLLOUT;
+    impl::IoUringDirectionWaitStrategy wait_manager(
+        deadline, *waiters_, *io_uring_, fd_, poll_mask, current);
+    return current.Sleep(wait_manager);
+  }
+
   impl::DirectionWaitStrategy wait_manager(deadline, *waiters_, watcher_,
                                            current);
   auto ret = current.Sleep(wait_manager);
@@ -12,6 +12,7 @@
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <engine/ev/io_uring.hpp>
 #include <engine/ev/watcher.hpp>
 #include <engine/task/task_context.hpp>
 #include <userver/engine/impl/wait_list_fwd.hpp>
@@ -95,6 +96,7 @@ class Direction final {
  private:
   friend class FdControl;
   explicit Direction(Kind kind);
+  Direction(Kind kind, ev::ThreadControl& thread_control);
 
   engine::impl::TaskContext::WakeupSource DoWait(Deadline);
 
@@ -117,6 +119,8 @@ class Direction final {
   std::atomic<State> state_;
   engine::impl::FastPimplWaitListLight waiters_;
   ev::Watcher<ev_io> watcher_;
+  // nullptr unless the event thread of the watcher_ uses io_uring
+  ev::IoUring* const io_uring_;
 };
 
 class FdControl final {
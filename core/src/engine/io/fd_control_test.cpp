@@ -6,6 +6,7 @@
 #include <cerrno>
 
 #include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/utest/utest.hpp>
 #include <utils/check_syscall.hpp>
@@ -224,4 +225,33 @@ UTEST_MT(FdControl, WholeTransfer, 2) {
                                "reading"));
 }
 
+TEST(FdControl, IoUringWait) {
+  engine::TaskProcessorPoolsConfig config;
+  config.ev_io_uring_enabled = true;
+
+  // Falls back to libev if io_uring is not available in the environment
+  engine::RunStandalone(2, config, [] {
+    Pipe pipe;
+    std::array<char, 16> buf{};
+
+    auto read_control = FdControl::Adopt(pipe.ExtractIn());
+    auto& read_dir = read_control->Read();
+    for (unsigned i = 0; i < kRepetitions; ++i) {
+      EXPECT_FALSE(read_dir.Wait(Deadline::Passed()));
+    }
+    EXPECT_FALSE(read_dir.Wait(Deadline::FromDuration(kReadTimeout)));
+
+    auto writer = engine::AsyncNoSpan([fd = pipe.Out(), &buf] {
+      engine::SleepFor(kReadTimeout);
+      CheckedWrite(fd, buf.data(), 1);
+    });
+    EXPECT_TRUE(
+        read_dir.Wait(Deadline::FromDuration(utest::kMaxTestWaitTime)));
+    writer.Get();
+
+    EXPECT_EQ(::read(read_dir.Fd(), buf.data(), buf.size()), 1);
+    EXPECT_FALSE(read_dir.Wait(Deadline::FromDuration(kReadTimeout)));
+  });
+}
+
 USERVER_NAMESPACE_END
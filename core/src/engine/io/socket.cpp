@@ -1,11 +1,15 @@
 #include <userver/engine/io/socket.hpp>
 
 #include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
 #include <sys/socket.h>
 #include <sys/uio.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cerrno>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -116,6 +120,90 @@ void FillIoSendData(const IoData* data, struct iovec* dst, std::size_t count) {
   }
 }
 
+// Handles errno of a failed recvmmsg/sendmmsg, waits for the socket readiness
+// on EAGAIN. Returns false if the operation should stop and report the
+// already processed datagrams.
+bool HandleBatchError(impl::Direction& dir, std::size_t processed,
+                      Deadline deadline, const char* context) {
+  const int error_code = errno;
+  switch (error_code) {
+    case EINTR:
+      return true;
+
+    case EAGAIN:
+#if EAGAIN != EWOULDBLOCK
+    case EWOULDBLOCK:
+#endif
+      if (!dir.Wait(deadline)) {
+        if (current_task::ShouldCancel()) {
+          throw IoCancelled(/*bytes_transferred =*/processed) << context;
+        }
+        throw IoTimeout(/*bytes_transferred =*/processed) << context;
+      }
+      if (!dir.IsValid()) {
+        throw IoException() << "Fd closed during " << context;
+      }
+      return true;
+
+    default: {
+      IoSystemError ex(error_code, "Socket");
+      ex << "Error while " << context << ", fd=" << dir.Fd();
+      if (processed == 0) throw std::move(ex);
+      LOG_WARNING() << ex << ", datagrams processed: " << processed;
+      return false;
+    }
+  }
+}
+
+#ifdef __linux__
+// MAC_COMPAT: no recvmmsg/sendmmsg, Datagrams are transferred one by one
+
+// Kernel structures for a batch of datagrams, kept on the stack
+struct DatagramBatch {
+  // UDP_GRO reports an int, UDP_SEGMENT takes an uint16_t
+  union Control {
+    char buf[CMSG_SPACE(sizeof(int))];
+    struct cmsghdr align;
+  };
+
+  std::array<struct mmsghdr, kMaxStackSizeVector> headers{};
+  std::array<struct iovec, kMaxStackSizeVector> iovecs{};
+  std::array<Control, kMaxStackSizeVector> controls{};
+};
+
+std::uint16_t GetGroSegmentSize([[maybe_unused]] const struct msghdr& hdr) {
+#ifdef UDP_GRO
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  auto* msg = const_cast<struct msghdr*>(&hdr);
+  for (auto* cmsg = CMSG_FIRSTHDR(msg); cmsg; cmsg = CMSG_NXTHDR(msg, cmsg)) {
+    if (cmsg->cmsg_level == IPPROTO_UDP && cmsg->cmsg_type == UDP_GRO) {
+      int segment_size = 0;
+      std::memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+      return static_cast<std::uint16_t>(segment_size);
+    }
+  }
+#endif
+  return 0;
+}
+
+void SetGsoSegmentSize(struct msghdr& hdr, DatagramBatch::Control& control,
+                       std::uint16_t segment_size) {
+  if (!segment_size) return;
+#ifdef UDP_SEGMENT
+  hdr.msg_control = control.buf;
+  hdr.msg_controllen = CMSG_SPACE(sizeof(segment_size));
+  auto* cmsg = CMSG_FIRSTHDR(&hdr);
+  cmsg->cmsg_level = IPPROTO_UDP;
+  cmsg->cmsg_type = UDP_SEGMENT;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(segment_size));
+  std::memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+#else
+  static_cast<void>(control);
+  throw IoException() << "UDP segmentation offload is not supported";
+#endif
+}
+#endif
+
 }  // namespace
 
 Socket::Socket(AddrDomain domain, SocketType type)
@@ -315,6 +403,137 @@ size_t Socket::SendAllTo(const Sockaddr& dest_addr, const void* buf, size_t len,
                        "SendAllTo to ", dest_addr);
 }
 
+size_t Socket::RecvMany(Datagram* datagrams, size_t count,
+                        Deadline deadline) {
+  if (!IsValid()) {
+    throw IoException("Attempt to RecvMany from closed socket");
+  }
+  UASSERT(datagrams);
+  UASSERT(count > 0);
+
+#ifdef __linux__
+  count = std::min(count, kMaxStackSizeVector);
+  DatagramBatch batch;
+  for (size_t i = 0; i < count; ++i) {
+    auto& datagram = datagrams[i];
+    batch.iovecs[i].iov_base = datagram.data;
+    batch.iovecs[i].iov_len = datagram.len;
+
+    auto& hdr = batch.headers[i].msg_hdr;
+    hdr.msg_name = datagram.addr.Data();
+    hdr.msg_namelen = datagram.addr.Capacity();
+    hdr.msg_iov = &batch.iovecs[i];
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = batch.controls[i].buf;
+    hdr.msg_controllen = sizeof(batch.controls[i].buf);
+  }
+
+  auto& dir = fd_control_->Read();
+  impl::Direction::SingleUserGuard guard(dir);
+  for (;;) {
+    const int received = ::recvmmsg(dir.Fd(), batch.headers.data(), count,
+                                    MSG_DONTWAIT, nullptr);
+    if (received >= 0) {
+      for (int i = 0; i < received; ++i) {
+        const auto& header = batch.headers[i];
+        auto& datagram = datagrams[i];
+        if (header.msg_hdr.msg_namelen > datagram.addr.Capacity()) {
+          throw IoException()
+              << "Peer address does not fit into AddrStorage, family="
+              << datagram.addr.Data()->sa_family
+              << ", addrlen=" << header.msg_hdr.msg_namelen;
+        }
+        datagram.bytes_received = header.msg_len;
+        datagram.segment_size = GetGroSegmentSize(header.msg_hdr);
+      }
+      return received;
+    }
+    [[maybe_unused]] const bool retry =
+        HandleBatchError(dir, 0, deadline, "RecvMany");
+    UASSERT(retry);
+  }
+#else
+  auto& datagram = datagrams[0];
+  auto result = RecvSomeFrom(datagram.data, datagram.len, deadline);
+  datagram.bytes_received = result.bytes_received;
+  datagram.addr = result.src_addr;
+  datagram.segment_size = 0;
+  return 1;
+#endif
+}
+
+size_t Socket::SendMany(const Datagram* datagrams, size_t count,
+                        Deadline deadline) {
+  if (!IsValid()) {
+    throw IoException("Attempt to SendMany to closed socket");
+  }
+  UASSERT(datagrams);
+  for (size_t i = 0; i < count; ++i) {
+    const auto domain = datagrams[i].addr.Domain();
+    if (domain != AddrDomain::kUnspecified && domain != domain_) {
+      throw AddrException(fmt::format(
+          "Socket address domain ({}) does not match address domain ({})",
+          static_cast<int>(domain_), static_cast<int>(domain)));
+    }
+  }
+
+#ifdef __linux__
+  auto& dir = fd_control_->Write();
+  impl::Direction::SingleUserGuard guard(dir);
+  size_t sent = 0;
+  while (sent < count) {
+    const auto batch_size = std::min(count - sent, kMaxStackSizeVector);
+    DatagramBatch batch;
+    for (size_t i = 0; i < batch_size; ++i) {
+      const auto& datagram = datagrams[sent + i];
+      batch.iovecs[i].iov_base = datagram.data;
+      batch.iovecs[i].iov_len = datagram.len;
+
+      auto& hdr = batch.headers[i].msg_hdr;
+      if (datagram.addr.Domain() != AddrDomain::kUnspecified) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        hdr.msg_name = const_cast<struct sockaddr*>(datagram.addr.Data());
+        hdr.msg_namelen = datagram.addr.Size();
+      }
+      hdr.msg_iov = &batch.iovecs[i];
+      hdr.msg_iovlen = 1;
+      SetGsoSegmentSize(hdr, batch.controls[i], datagram.segment_size);
+    }
+
+    // A partially sent batch is resent from the first unsent datagram
+    size_t batch_sent = 0;
+    while (batch_sent < batch_size) {
+      const int ret = ::sendmmsg(dir.Fd(), batch.headers.data() + batch_sent,
+                                 batch_size - batch_sent,
+                                 MSG_DONTWAIT | MSG_NOSIGNAL);
+      if (ret > 0) {
+        batch_sent += ret;
+      } else if (!ret || !HandleBatchError(dir, sent + batch_sent, deadline,
+                                           "SendMany")) {
+        return sent + batch_sent;
+      }
+    }
+    sent += batch_sent;
+  }
+  return sent;
+#else
+  for (size_t i = 0; i < count; ++i) {
+    const auto& datagram = datagrams[i];
+    if (datagram.segment_size) {
+      throw IoException() << "UDP segmentation offload is not supported";
+    }
+    if (datagram.addr.Domain() == AddrDomain::kUnspecified) {
+      [[maybe_unused]] auto ret =
+          SendAll(datagram.data, datagram.len, deadline);
+    } else {
+      [[maybe_unused]] auto ret =
+          SendAllTo(datagram.addr, datagram.data, datagram.len, deadline);
+    }
+  }
+  return count;
+#endif
+}
+
 Socket Socket::Accept(Deadline deadline) {
   if (!IsValid()) {
     throw IoException("Attempt to Accept from closed socket");
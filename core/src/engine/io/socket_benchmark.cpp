@@ -138,4 +138,31 @@ BENCHMARK(socket_send_all_v);
 // TODO(TAXICOMMON-5510) flaky, sometimes throws engine::io::IoTimeout
 // BENCHMARK(socket_send_all_range)->RangeMultiplier(10)->Range(10, 10000);
 
+void socket_ping_pong(benchmark::State& state, bool io_uring_enabled) {
+  engine::TaskProcessorPoolsConfig config;
+  config.ev_io_uring_enabled = io_uring_enabled;
+  engine::RunStandalone(2, config, [&]() {
+    const auto test_deadline = Deadline::FromDuration(kDeadlineMaxTime);
+    internal::net::TcpListener listener;
+    auto [server, client] = listener.MakeSocketPair(test_deadline);
+    auto task_ponger = engine::AsyncNoSpan(
+        [test_deadline](auto&& server) {
+          char c = 0;
+          while (server.RecvAll(&c, 1, test_deadline) == 1) {
+            server.SendAll(&c, 1, test_deadline);
+          }
+        },
+        std::move(server));
+    for (auto _ : state) {
+      char c = 'a';
+      client.SendAll(&c, 1, test_deadline);
+      benchmark::DoNotOptimize(client.RecvAll(&c, 1, test_deadline));
+    }
+    client.Close();
+    task_ponger.Get();
+  });
+}
+BENCHMARK_CAPTURE(socket_ping_pong, libev, false);
+BENCHMARK_CAPTURE(socket_ping_pong, io_uring, true);
+
 USERVER_NAMESPACE_END
@@ -2,13 +2,17 @@
 
 #include <arpa/inet.h>
 #include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
 #include <array>
 #include <cerrno>
 #include <cstdlib>
+#include <string>
 #include <string_view>
+#include <vector>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/condition_variable.hpp>
@@ -419,6 +423,117 @@ UTEST_MT(Socket, ConcurrentReadWriteUdp, 2) {
   /// [send self concurrent]
 }
 
+UTEST(Socket, DgramMany) {
+  const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+  // More than fits into a single recvmmsg/sendmmsg batch
+  constexpr std::size_t kDatagramsCount = 50;
+
+  UdpListener listener;
+  engine::io::Socket client{listener.addr.Domain(), UdpListener::type};
+
+  /// [send receive many]
+  std::vector<std::string> payloads;
+  std::vector<io::Datagram> to_send(kDatagramsCount);
+  for (std::size_t i = 0; i < kDatagramsCount; ++i) {
+    payloads.push_back("datagram " + std::to_string(i));
+    to_send[i].data = payloads.back().data();
+    to_send[i].len = payloads.back().size();
+    to_send[i].addr = listener.addr;
+  }
+  EXPECT_EQ(client.SendMany(to_send.data(), to_send.size(), deadline),
+            kDatagramsCount);
+
+  std::array<std::array<char, 64>, 8> buffers{};
+  std::array<io::Datagram, 8> received{};
+  for (std::size_t i = 0; i < received.size(); ++i) {
+    received[i].data = buffers[i].data();
+    received[i].len = buffers[i].size();
+  }
+
+  std::size_t received_count = 0;
+  while (received_count < kDatagramsCount) {
+    const auto count =
+        listener.socket.RecvMany(received.data(), received.size(), deadline);
+    ASSERT_GT(count, 0U);
+    ASSERT_LE(count, received.size());
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto& datagram = received[i];
+      EXPECT_EQ(std::string_view(buffers[i].data(), datagram.bytes_received),
+                payloads[received_count + i]);
+      EXPECT_EQ(datagram.addr.Port(), client.Getsockname().Port());
+      EXPECT_EQ(datagram.segment_size, 0);
+    }
+    received_count += count;
+  }
+  /// [send receive many]
+  EXPECT_EQ(received_count, kDatagramsCount);
+}
+
+UTEST(Socket, DgramManyConnected) {
+  const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  UdpListener listener;
+  engine::io::Socket client{listener.addr.Domain(), UdpListener::type};
+  client.Connect(listener.addr, deadline);
+
+  std::array<char, 3> payload{'a', 'b', 'c'};
+  std::array<io::Datagram, 3> to_send{};
+  for (std::size_t i = 0; i < to_send.size(); ++i) {
+    to_send[i].data = &payload[i];
+    to_send[i].len = 1;
+  }
+  EXPECT_EQ(client.SendMany(to_send.data(), to_send.size(), deadline), 3U);
+
+  for (char expected : payload) {
+    char c = 0;
+    io::Datagram datagram;
+    datagram.data = &c;
+    datagram.len = 1;
+    ASSERT_EQ(listener.socket.RecvMany(&datagram, 1, deadline), 1U);
+    EXPECT_EQ(datagram.bytes_received, 1U);
+    EXPECT_EQ(c, expected);
+  }
+
+  io::Datagram datagram;
+  datagram.data = payload.data();
+  datagram.len = payload.size();
+  const auto short_deadline =
+      Deadline::FromDuration(std::chrono::milliseconds(10));
+  UEXPECT_THROW([[maybe_unused]] auto ret =
+                    listener.socket.RecvMany(&datagram, 1, short_deadline),
+                io::IoTimeout);
+}
+
+#ifdef UDP_SEGMENT
+UTEST(Socket, DgramSegmentation) {
+  const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+  constexpr std::uint16_t kSegmentSize = 100;
+
+  UdpListener listener;
+  engine::io::Socket client{listener.addr.Domain(), UdpListener::type};
+
+  std::string payload(3 * kSegmentSize, 'x');
+  io::Datagram to_send;
+  to_send.data = payload.data();
+  to_send.len = payload.size();
+  to_send.addr = listener.addr;
+  to_send.segment_size = kSegmentSize;
+  EXPECT_EQ(client.SendMany(&to_send, 1, deadline), 1U);
+
+  // Without UDP_GRO the kernel delivers the segments as separate datagrams
+  std::array<char, 1024> buffer{};
+  std::size_t received_bytes = 0;
+  while (received_bytes < payload.size()) {
+    io::Datagram datagram;
+    datagram.data = buffer.data();
+    datagram.len = buffer.size();
+    ASSERT_EQ(listener.socket.RecvMany(&datagram, 1, deadline), 1U);
+    EXPECT_EQ(datagram.bytes_received, kSegmentSize);
+    received_bytes += datagram.bytes_received;
+  }
+}
+#endif
+
 UTEST(Socket, WriteALot) {
   const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
 
@@ -2,6 +2,7 @@
 
 #include <exception>
 #include <memory>
+#include <string_view>
 
 #include <fmt/format.h>
 #include <openssl/bio.h>
@@ -74,6 +75,12 @@ int SocketBioWriteEx(BIO* bio, const char* data, size_t len,
     if (*bytes_written) return 1;  // success
   } catch (const engine::io::IoInterrupted& ex) {
     *bytes_written = ex.BytesTransferred();
+    // The sent part must be reported, otherwise it is sent again on retry.
+    // The next write will be interrupted before sending anything.
+    if (*bytes_written) {
+      BIO_clear_retry_flags(bio);
+      return 1;
+    }
     BIO_set_retry_write(bio);
     bio_data->last_exception = std::current_exception();
   } catch (...) {
@@ -225,6 +232,65 @@ SslCtx MakeSslCtx() {
   return ssl_ctx;
 }
 
+SslCtx MakeServerSslCtx(
+    const crypto::Certificate& cert, const crypto::PrivateKey& key,
+    const std::vector<crypto::Certificate>& cert_authorities) {
+  auto ssl_ctx = MakeSslCtx();
+
+  if (!cert_authorities.empty()) {
+    auto* store = SSL_CTX_get_cert_store(ssl_ctx.get());
+    for (const auto& ca : cert_authorities) {
+      if (1 != X509_STORE_add_cert(store, ca.GetNative())) {
+        throw TlsException(crypto::FormatSslError(
+            "Failed to set up server TLS wrapper: X509_STORE_add_cert"));
+      }
+    }
+  }
+
+  if (1 != SSL_CTX_use_certificate(ssl_ctx.get(), cert.GetNative())) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to set up server TLS wrapper: SSL_CTX_use_certificate"));
+  }
+
+  if (1 != SSL_CTX_use_PrivateKey(ssl_ctx.get(), key.GetNative())) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to set up server TLS wrapper: SSL_CTX_use_PrivateKey"));
+  }
+  return ssl_ctx;
+}
+
+// ALPN protocols in the wire format, see RFC 7301
+std::string MakeAlpnProtocolList(const std::vector<std::string>& protocols) {
+  std::string result;
+  for (const auto& protocol : protocols) {
+    if (protocol.empty() || protocol.size() > 255) {
+      throw TlsException(
+          fmt::format("Invalid ALPN protocol name '{}'", protocol));
+    }
+    result += static_cast<char>(protocol.size());
+    result += protocol;
+  }
+  return result;
+}
+
+int SelectAlpnProtocol(SSL*, const unsigned char** out, unsigned char* outlen,
+                       const unsigned char* in, unsigned int inlen,
+                       void* arg) noexcept {
+  const auto* protocols = static_cast<const std::string*>(arg);
+  UASSERT(protocols);
+
+  unsigned char* selected = nullptr;
+  if (OPENSSL_NPN_NEGOTIATED !=
+      SSL_select_next_proto(
+          &selected, outlen,
+          reinterpret_cast<const unsigned char*>(protocols->data()),
+          protocols->size(), in, inlen)) {
+    return SSL_TLSEXT_ERR_NOACK;
+  }
+  *out = selected;
+  return SSL_TLSEXT_ERR_OK;
+}
+
 enum InterruptAction {
   kPass,
   kFail,
@@ -232,6 +298,87 @@ enum InterruptAction {
 
 }  // namespace
 
+class TlsServerContext::Impl {
+ public:
+  Impl(SslCtx&& ssl_ctx, const Settings& settings)
+      : ssl_ctx(std::move(ssl_ctx)),
+        settings(settings),
+        alpn_protocols(MakeAlpnProtocolList(settings.alpn_protocols)) {
+    SetUpSessionResumption();
+    if (!alpn_protocols.empty()) {
+      // The callback is only called during the handshake, while the caller
+      // holds the context. The protocols are not modified by the callback.
+      SSL_CTX_set_alpn_select_cb(
+          this->ssl_ctx.get(), &SelectAlpnProtocol,
+          // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+          const_cast<std::string*>(&alpn_protocols));
+    }
+  }
+
+  void CopySessionTicketKeys(SSL_CTX* from) const {
+    if (!settings.session_tickets) return;
+
+    const auto keys_size = SSL_CTX_get_tlsext_ticket_keys(from, nullptr, 0);
+    std::vector<unsigned char> keys(keys_size > 0 ? keys_size : 0);
+    if (keys.empty() ||
+        1 != SSL_CTX_get_tlsext_ticket_keys(from, keys.data(), keys.size()) ||
+        1 != SSL_CTX_set_tlsext_ticket_keys(ssl_ctx.get(), keys.data(),
+                                            keys.size())) {
+      throw TlsException(crypto::FormatSslError(
+          "Failed to copy the TLS session ticket keys"));
+    }
+  }
+
+  SslCtx ssl_ctx;
+  const Settings settings;
+  const std::string alpn_protocols;
+
+ private:
+  void SetUpSessionResumption() {
+    static constexpr std::string_view kSessionIdContext = "userver";
+    if (1 != SSL_CTX_set_session_id_context(
+                 ssl_ctx.get(),
+                 reinterpret_cast<const unsigned char*>(
+                     kSessionIdContext.data()),
+                 kSessionIdContext.size())) {
+      throw TlsException(crypto::FormatSslError(
+          "Failed to set up server TLS context: "
+          "SSL_CTX_set_session_id_context"));
+    }
+
+    if (settings.session_cache_size) {
+      SSL_CTX_set_session_cache_mode(ssl_ctx.get(), SSL_SESS_CACHE_SERVER);
+      SSL_CTX_sess_set_cache_size(ssl_ctx.get(), settings.session_cache_size);
+    } else {
+      SSL_CTX_set_session_cache_mode(ssl_ctx.get(), SSL_SESS_CACHE_OFF);
+    }
+    SSL_CTX_set_timeout(ssl_ctx.get(), settings.session_timeout.count());
+
+    if (!settings.session_tickets) {
+      SSL_CTX_set_options(ssl_ctx.get(), SSL_OP_NO_TICKET);
+    }
+  }
+};
+
+TlsServerContext::TlsServerContext(
+    const crypto::Certificate& cert, const crypto::PrivateKey& key,
+    const Settings& settings,
+    const std::vector<crypto::Certificate>& cert_authorities)
+    : impl_(std::make_shared<const Impl>(
+          MakeServerSslCtx(cert, key, cert_authorities), settings)) {}
+
+TlsServerContext::TlsServerContext(std::shared_ptr<const Impl> impl)
+    : impl_(std::move(impl)) {}
+
+TlsServerContext TlsServerContext::WithCertificate(
+    const crypto::Certificate& cert, const crypto::PrivateKey& key,
+    const std::vector<crypto::Certificate>& cert_authorities) const {
+  auto impl = std::make_shared<Impl>(
+      MakeServerSslCtx(cert, key, cert_authorities), impl_->settings);
+  impl->CopySessionTicketKeys(impl_->ssl_ctx.get());
+  return TlsServerContext{std::move(impl)};
+}
+
 class TlsWrapper::Impl {
  public:
   explicit Impl(Socket&& socket) : bio_data(std::move(socket)) {}
@@ -244,7 +391,7 @@ class TlsWrapper::Impl {
     SyncBioData(SSL_get_rbio(ssl.get()), &other.bio_data);
   }
 
-  void SetUp(SslCtx&& ssl_ctx) {
+  void SetUp(SSL_CTX* ssl_ctx) {
     Bio socket_bio{BIO_new(GetSocketBioMethod())};
     if (!socket_bio) {
       throw TlsException(
@@ -254,7 +401,7 @@ class TlsWrapper::Impl {
     SyncBioData(socket_bio.get(), nullptr);
     BIO_set_init(socket_bio.get(), 1);
 
-    ssl.reset(SSL_new(ssl_ctx.get()));
+    ssl.reset(SSL_new(ssl_ctx));
     if (!ssl) {
       throw TlsException(
           crypto::FormatSslError("Failed to set up TLS wrapper: SSL_new"));
@@ -327,6 +474,21 @@ class TlsWrapper::Impl {
     return pos - begin;
   }
 
+  void Accept(Deadline deadline) {
+    bio_data.current_deadline = deadline;
+
+    auto ret = SSL_accept(ssl.get());
+    if (1 != ret) {
+      if (bio_data.last_exception) {
+        std::rethrow_exception(bio_data.last_exception);
+      }
+
+      throw TlsException(crypto::FormatSslError(
+          fmt::format("Failed to set up server TLS wrapper ({})",
+                      SSL_get_error(ssl.get(), ret))));
+    }
+  }
+
   void CheckAlive() const {
     if (!ssl) {
       throw TlsException("SSL connection is broken");
@@ -367,7 +529,7 @@ TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
   }
 
   TlsWrapper wrapper{std::move(socket)};
-  wrapper.impl_->SetUp(std::move(ssl_ctx));
+  wrapper.impl_->SetUp(ssl_ctx.get());
   if (!server_name.empty()) {
     // cast in openssl1.0 macro expansion
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
@@ -397,50 +559,29 @@ TlsWrapper TlsWrapper::StartTlsServer(
     Socket&& socket, const crypto::Certificate& cert,
     const crypto::PrivateKey& key, Deadline deadline,
     const std::vector<crypto::Certificate>& cert_authorities) {
-  auto ssl_ctx = MakeSslCtx();
-
-  if (!cert_authorities.empty()) {
-    auto* store = SSL_CTX_get_cert_store(ssl_ctx.get());
-    for (const auto& ca : cert_authorities) {
-      if (1 != X509_STORE_add_cert(store, ca.GetNative())) {
-        throw TlsException(crypto::FormatSslError(
-            "Failed to set up server TLS wrapper: X509_STORE_add_cert"));
-      }
-    }
-  }
-
-  if (1 != SSL_CTX_use_certificate(ssl_ctx.get(), cert.GetNative())) {
-    throw TlsException(crypto::FormatSslError(
-        "Failed to set up server TLS wrapper: SSL_CTX_use_certificate"));
-  }
-
-  if (1 != SSL_CTX_use_PrivateKey(ssl_ctx.get(), key.GetNative())) {
-    throw TlsException(crypto::FormatSslError(
-        "Failed to set up server TLS wrapper: SSL_CTX_use_PrivateKey"));
-  }
+  auto ssl_ctx = MakeServerSslCtx(cert, key, cert_authorities);
 
   TlsWrapper wrapper{std::move(socket)};
-  wrapper.impl_->SetUp(std::move(ssl_ctx));
-  wrapper.impl_->bio_data.current_deadline = deadline;
-
-  auto ret = SSL_accept(wrapper.impl_->ssl.get());
-  if (1 != ret) {
-    if (wrapper.impl_->bio_data.last_exception) {
-      std::rethrow_exception(wrapper.impl_->bio_data.last_exception);
-    }
-
-    throw TlsException(crypto::FormatSslError(
-        fmt::format("Failed to set up server TLS wrapper ({})",
-                    SSL_get_error(wrapper.impl_->ssl.get(), ret))));
-  }
+  wrapper.impl_->SetUp(ssl_ctx.get());
+  wrapper.impl_->Accept(deadline);
+  return wrapper;
+}
 
+TlsWrapper TlsWrapper::StartTlsServer(Socket&& socket,
+                                      const TlsServerContext& context,
+                                      Deadline deadline) {
+  TlsWrapper wrapper{std::move(socket)};
+  wrapper.impl_->SetUp(context.impl_->ssl_ctx.get());
+  wrapper.impl_->Accept(deadline);
   return wrapper;
 }
 
 TlsWrapper::~TlsWrapper() {
   if (!IsValid()) return;
 
-  // socket will not be reused, attempt unidirectional shutdown
+  // socket will not be reused, attempt unidirectional shutdown without
+  // waiting for the peer to read the data
+  impl_->bio_data.current_deadline = Deadline::Passed();
   SSL_shutdown(impl_->ssl.get());
 }
 
@@ -482,6 +623,66 @@ size_t TlsWrapper::SendAll(const void* buf, size_t len, Deadline deadline) {
                              deadline, "SendAll");
 }
 
+std::optional<size_t> TlsWrapper::TrySendSome(const void* buf, size_t len) {
+  impl_->CheckAlive();
+  try {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    return impl_->PerformSslIo(&SSL_write_ex, const_cast<void*>(buf), len,
+                               impl::TransferMode::kOnce,
+                               InterruptAction::kPass, Deadline::Passed(),
+                               "TrySendSome");
+  } catch (const IoTimeout&) {
+    return std::nullopt;
+  }
+}
+
+size_t TlsWrapper::SendAll(std::initializer_list<IoData> list,
+                           Deadline deadline) {
+  size_t total_size = 0;
+  for (const auto& io_data : list) total_size += io_data.len;
+
+  // Each write produces at least one record, so small buffers are coalesced
+  // to avoid sending the extra records
+  if (list.size() > 1 && total_size <= SSL3_RT_MAX_PLAIN_LENGTH) {
+    std::string buffer;
+    buffer.reserve(total_size);
+    for (const auto& io_data : list) {
+      buffer.append(static_cast<const char*>(io_data.data), io_data.len);
+    }
+    return SendAll(buffer.data(), buffer.size(), deadline);
+  }
+
+  size_t sent_bytes = 0;
+  for (const auto& io_data : list) {
+    const auto sent = SendAll(io_data.data, io_data.len, deadline);
+    sent_bytes += sent;
+    if (sent != io_data.len) break;
+  }
+  return sent_bytes;
+}
+
+bool TlsWrapper::IsSessionReused() const {
+  impl_->CheckAlive();
+  return SSL_session_reused(impl_->ssl.get()) == 1;
+}
+
+std::string TlsWrapper::GetAlpnProtocol() const {
+  impl_->CheckAlive();
+  const unsigned char* data = nullptr;
+  unsigned int len = 0;
+  SSL_get0_alpn_selected(impl_->ssl.get(), &data, &len);
+  return data ? std::string(reinterpret_cast<const char*>(data), len)
+              : std::string{};
+}
+
+bool TlsWrapper::WaitSocketReadable(Deadline deadline) {
+  return impl_->bio_data.socket.WaitReadable(deadline);
+}
+
+bool TlsWrapper::WaitSocketWriteable(Deadline deadline) {
+  return impl_->bio_data.socket.WaitWriteable(deadline);
+}
+
 Socket TlsWrapper::StopTls(Deadline deadline) {
   if (impl_->ssl) {
     impl_->is_in_shutdown = true;
@@ -279,6 +279,27 @@ void single_waiting_task_mutex_contention_with_payload(
   });
 }
 
+// Two tasks wake each other up on unlock, while the worker count varies
+void mutex_coro_pair_contention(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    alignas(kInterferenceSize) std::atomic<bool> run{true};
+    alignas(kInterferenceSize) engine::Mutex m;
+
+    auto companion = engine::AsyncNoSpan([&] {
+      while (run) {
+        const std::lock_guard lock(m);
+      }
+    });
+
+    for (auto _ : state) {
+      const std::lock_guard lock(m);
+    }
+
+    run = false;
+    companion.Get();
+  });
+}
+
 }  // namespace
 
 BENCHMARK(mutex_coro_lock);
@@ -292,6 +313,7 @@ BENCHMARK(single_waiting_task_mutex_unlock);
 BENCHMARK(mutex_coro_contention)->RangeMultiplier(2)->Range(1, 32);
 BENCHMARK(mutex_std_contention)->RangeMultiplier(2)->Range(1, 32);
 BENCHMARK(single_waiting_task_mutex_contention)->Range(1, 2);
+BENCHMARK(mutex_coro_pair_contention)->RangeMultiplier(2)->Range(1, 8);
 
 BENCHMARK(mutex_coro_contention_with_payload)->RangeMultiplier(2)->Range(1, 32);
 BENCHMARK(mutex_std_contention_with_payload)->RangeMultiplier(2)->Range(1, 32);
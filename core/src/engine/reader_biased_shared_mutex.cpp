@@ -0,0 +1,145 @@
+#include <userver/engine/reader_biased_shared_mutex.hpp>
+
+#include <algorithm>
+#include <thread>
+
+#include <userver/engine/task/cancel.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/impl/thread_shard.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace {
+
+// After a revocation readers are not biased for kInhibitMultiplier times the
+// duration of the revocation, so that frequent writers do not pay for the
+// revocation on each lock
+constexpr std::int64_t kInhibitMultiplier = 9;
+
+std::size_t GetShardsCount() {
+  return std::max(std::thread::hardware_concurrency(), 1U);
+}
+
+std::chrono::steady_clock::rep Now() noexcept {
+  return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+}  // namespace
+
+ReaderBiasedSharedMutex::ReaderBiasedSharedMutex()
+    : readers_(GetShardsCount()) {}
+
+ReaderBiasedSharedMutex::~ReaderBiasedSharedMutex() {
+  UASSERT_MSG(GetReadersCount() == 0, "Mutex is destroyed while in use");
+}
+
+void ReaderBiasedSharedMutex::lock() {
+  underlying_.lock();
+  [[maybe_unused]] const bool drained = WaitForReadersToDrain(Deadline{});
+  UASSERT(drained);
+}
+
+void ReaderBiasedSharedMutex::unlock() { underlying_.unlock(); }
+
+bool ReaderBiasedSharedMutex::try_lock() {
+  return try_lock_until(Deadline::Passed());
+}
+
+bool ReaderBiasedSharedMutex::try_lock_until(Deadline deadline) {
+  if (!underlying_.try_lock_until(deadline)) return false;
+  if (!WaitForReadersToDrain(deadline)) {
+    underlying_.unlock();
+    return false;
+  }
+  return true;
+}
+
+void ReaderBiasedSharedMutex::lock_shared() {
+  if (TryLockSharedBiased()) return;
+
+  underlying_.lock_shared();
+  LockSharedUnderUnderlyingLock();
+}
+
+void ReaderBiasedSharedMutex::unlock_shared() {
+  GetCurrentShard().fetch_sub(1);
+  // A writer might wait for the readers to drain
+  if (!read_bias_.load()) readers_drained_.Send();
+}
+
+bool ReaderBiasedSharedMutex::try_lock_shared() {
+  if (TryLockSharedBiased()) return true;
+
+  if (!underlying_.try_lock_shared()) return false;
+  LockSharedUnderUnderlyingLock();
+  return true;
+}
+
+bool ReaderBiasedSharedMutex::try_lock_shared_until(Deadline deadline) {
+  if (TryLockSharedBiased()) return true;
+
+  if (!underlying_.try_lock_shared_until(deadline)) return false;
+  LockSharedUnderUnderlyingLock();
+  return true;
+}
+
+std::atomic<std::int64_t>&
+ReaderBiasedSharedMutex::GetCurrentShard() noexcept {
+  return readers_[utils::impl::GetCurrentThreadIndex() % readers_.size()].count;
+}
+
+std::int64_t ReaderBiasedSharedMutex::GetReadersCount() const noexcept {
+  std::int64_t readers = 0;
+  for (const auto& shard : readers_) readers += shard.count.load();
+  return readers;
+}
+
+bool ReaderBiasedSharedMutex::TryLockSharedBiased() noexcept {
+  if (!read_bias_.load()) return false;
+
+  auto& shard = GetCurrentShard();
+  shard.fetch_add(1);
+  // Pairs with the revocation in WaitForReadersToDrain(): either the writer
+  // sees our increment, or we see the revoked bias
+  if (read_bias_.load()) return true;
+
+  shard.fetch_sub(1);
+  readers_drained_.Send();
+  return false;
+}
+
+void ReaderBiasedSharedMutex::LockSharedUnderUnderlyingLock() noexcept {
+  // No writer may revoke the bias or scan the shards while we hold
+  // underlying_, so the increment is seen by the next writer
+  GetCurrentShard().fetch_add(1);
+  if (!read_bias_.load() && Now() >= inhibit_bias_until_.load()) {
+    read_bias_.store(true);
+  }
+  underlying_.unlock_shared();
+}
+
+bool ReaderBiasedSharedMutex::WaitForReadersToDrain(Deadline deadline) {
+  const auto revocation_start = Now();
+  const bool was_biased = read_bias_.exchange(false);
+
+  {
+    engine::TaskCancellationBlocker blocker;
+    while (GetReadersCount() != 0) {
+      if (!readers_drained_.WaitForEventUntil(deadline)) return false;
+    }
+  }
+
+  if (was_biased) {
+    const auto revocation_end = Now();
+    inhibit_bias_until_.store(
+        revocation_end +
+        (revocation_end - revocation_start) * kInhibitMultiplier);
+  }
+  return true;
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
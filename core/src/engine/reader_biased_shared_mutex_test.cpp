@@ -0,0 +1,170 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/reader_biased_shared_mutex.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using namespace std::chrono_literals;
+
+UTEST(ReaderBiasedSharedMutex, SharedLockUnlockDouble) {
+  engine::ReaderBiasedSharedMutex mutex;
+  mutex.lock_shared();
+  mutex.lock_shared();
+  mutex.unlock_shared();
+  mutex.unlock_shared();
+
+  mutex.lock();
+  mutex.unlock();
+}
+
+UTEST(ReaderBiasedSharedMutex, SharedAndUniqueLock) {
+  engine::ReaderBiasedSharedMutex mutex;
+
+  std::unique_lock lock(mutex);
+  auto reader = utils::Async("", [&mutex] { std::shared_lock lock(mutex); });
+
+  reader.WaitFor(50ms);
+  EXPECT_FALSE(reader.IsFinished());
+
+  lock.unlock();
+
+  reader.WaitFor(utest::kMaxTestWaitTime);
+  EXPECT_TRUE(reader.IsFinished());
+  UEXPECT_NO_THROW(reader.Get());
+}
+
+UTEST(ReaderBiasedSharedMutex, UniqueAndSharedLock) {
+  engine::ReaderBiasedSharedMutex mutex;
+
+  std::shared_lock lock(mutex);
+  auto writer = utils::Async("", [&mutex] { std::unique_lock lock(mutex); });
+
+  writer.WaitFor(50ms);
+  EXPECT_FALSE(writer.IsFinished());
+
+  lock.unlock();
+
+  writer.WaitFor(utest::kMaxTestWaitTime);
+  EXPECT_TRUE(writer.IsFinished());
+  UEXPECT_NO_THROW(writer.Get());
+}
+
+UTEST(ReaderBiasedSharedMutex, TryLock) {
+  engine::ReaderBiasedSharedMutex mutex;
+
+  for (int i = 0; i < 10; i++) {
+    ASSERT_TRUE(mutex.try_lock());
+    mutex.unlock();
+    ASSERT_TRUE(mutex.try_lock_shared());
+    mutex.unlock_shared();
+  }
+
+  {
+    std::shared_lock lock(mutex);
+    EXPECT_FALSE(mutex.try_lock());
+    EXPECT_FALSE(mutex.try_lock_for(10ms));
+    EXPECT_TRUE(mutex.try_lock_shared());
+    mutex.unlock_shared();
+  }
+
+  {
+    std::unique_lock lock(mutex);
+    auto task = utils::Async("", [&mutex] {
+      return std::pair{mutex.try_lock(), mutex.try_lock_shared_for(10ms)};
+    });
+    EXPECT_EQ(task.Get(), std::pair(false, false));
+  }
+
+  // The failed writer does not block the readers
+  std::shared_lock lock(mutex);
+}
+
+UTEST_MT(ReaderBiasedSharedMutex, UnlockOnAnotherThread, 4) {
+  engine::ReaderBiasedSharedMutex mutex;
+
+  // Tasks migrate between the threads while holding a shared lock
+  std::vector<engine::TaskWithResult<void>> readers;
+  for (int i = 0; i < 16; ++i) {
+    readers.push_back(engine::AsyncNoSpan([&mutex] {
+      for (int j = 0; j < 100; ++j) {
+        std::shared_lock lock(mutex);
+        engine::Yield();
+      }
+    }));
+  }
+  for (auto& reader : readers) reader.Get();
+
+  EXPECT_TRUE(mutex.try_lock());
+  mutex.unlock();
+}
+
+UTEST_MT(ReaderBiasedSharedMutex, ReadersAndWriters, 4) {
+  constexpr int kReadersCount = 8;
+  constexpr int kWritesCount = 200;
+
+  engine::ReaderBiasedSharedMutex mutex;
+  // Written under the unique lock only, values of the pair are always equal
+  // for a reader
+  std::pair<int, int> data{0, 0};
+  std::atomic<bool> is_running{true};
+  std::atomic<int> readers_inside{0};
+
+  std::vector<engine::TaskWithResult<void>> readers;
+  for (int i = 0; i < kReadersCount; ++i) {
+    readers.push_back(engine::AsyncNoSpan([&] {
+      while (is_running) {
+        std::shared_lock lock(mutex);
+        ++readers_inside;
+        const auto [first, second] = data;
+        EXPECT_EQ(first, second);
+        --readers_inside;
+      }
+    }));
+  }
+
+  for (int i = 0; i < kWritesCount; ++i) {
+    std::unique_lock lock(mutex);
+    EXPECT_EQ(readers_inside.load(), 0);
+    ++data.first;
+    engine::Yield();
+    ++data.second;
+  }
+
+  is_running = false;
+  for (auto& reader : readers) reader.Get();
+  EXPECT_EQ(data, std::pair(kWritesCount, kWritesCount));
+}
+
+UTEST(ReaderBiasedSharedMutex, Sample) {
+  /// [Sample engine::ReaderBiasedSharedMutex usage]
+  constexpr auto kTestString = "123";
+
+  engine::ReaderBiasedSharedMutex mutex;
+  std::string data;
+  {
+    std::lock_guard lock(mutex);
+    // rare write, revokes the reader bias
+    data = kTestString;
+  }
+
+  {
+    std::shared_lock lock(mutex);
+    // frequent reads do not contend with each other
+    ASSERT_EQ(data, kTestString);
+  }
+  /// [Sample engine::ReaderBiasedSharedMutex usage]
+}
+
+USERVER_NAMESPACE_END
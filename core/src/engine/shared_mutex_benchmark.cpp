@@ -3,16 +3,21 @@
 #include <vector>
 
 #include <userver/engine/async.hpp>
+#include <userver/engine/reader_biased_shared_mutex.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/engine/shared_mutex.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/engine/task/task_with_result.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
+// state.range(0) threads read in a loop, if state.range(1) is not zero, one
+// more task writes every state.range(1) microseconds
+template <typename Mutex>
 void shared_mutex_benchmark(benchmark::State& state) {
   engine::RunStandalone(state.range(0), [&] {
     int variable = 0;
-    engine::SharedMutex mutex;
+    Mutex mutex;
     std::atomic<bool> is_running(true);
 
     std::vector<engine::TaskWithResult<void>> tasks;
@@ -25,6 +30,16 @@ void shared_mutex_benchmark(benchmark::State& state) {
       }));
     }
 
+    if (state.range(1) != 0) {
+      tasks.push_back(engine::AsyncNoSpan([&] {
+        while (is_running) {
+          engine::SleepFor(std::chrono::microseconds{state.range(1)});
+          std::unique_lock lock(mutex);
+          ++variable;
+        }
+      }));
+    }
+
     {
       // ensure the locks are actually needed
       std::unique_lock lock(mutex);
@@ -43,6 +58,9 @@ void shared_mutex_benchmark(benchmark::State& state) {
     }
   });
 }
-BENCHMARK(shared_mutex_benchmark)->DenseRange(1, 6);
+BENCHMARK_TEMPLATE(shared_mutex_benchmark, engine::SharedMutex)
+    ->ArgsProduct({{1, 2, 4, 8, 16, 32, 64}, {0, 1000}});
+BENCHMARK_TEMPLATE(shared_mutex_benchmark, engine::ReaderBiasedSharedMutex)
+    ->ArgsProduct({{1, 2, 4, 8, 16, 32, 64}, {0, 1000}});
 
 USERVER_NAMESPACE_END
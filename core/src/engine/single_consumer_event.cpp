@@ -78,6 +78,16 @@ bool SingleConsumerEvent::IsReady() const noexcept {
   return is_signaled_.load();
 }
 
+void SingleConsumerEvent::AppendWaiter(impl::TaskContext& context) noexcept {
+  waiters_->Append(&context);
+}
+
+void SingleConsumerEvent::RemoveWaiter(impl::TaskContext& context) noexcept {
+  waiters_->Remove(context);
+}
+
+void SingleConsumerEvent::RethrowErrorResult() const {}
+
 bool SingleConsumerEvent::GetIsSignaled() noexcept {
   if (is_auto_reset_) {
     return is_signaled_.exchange(false);
@@ -97,7 +97,9 @@ BENCHMARK_CAPTURE(SingleConsumerEvent, Contended, kContended)
 BENCHMARK_CAPTURE(SingleConsumerEvent, Failed, kFailed)->Apply(&ThreadsArg);
 
 void SingleConsumerEventPingPong(benchmark::State& state) {
-  engine::RunStandalone(2, [&] {
+  // With more workers than tasks, the woken up task would land on an idle
+  // worker without the handoff to the waker's worker
+  engine::RunStandalone(state.range(0), [&] {
     OverAligned<engine::SingleConsumerEvent> ping;
     OverAligned<engine::SingleConsumerEvent> pong;
 
@@ -117,6 +119,6 @@ void SingleConsumerEventPingPong(benchmark::State& state) {
   });
 }
 
-BENCHMARK(SingleConsumerEventPingPong);
+BENCHMARK(SingleConsumerEventPingPong)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
 
 USERVER_NAMESPACE_END
@@ -1,9 +1,14 @@
 #include <benchmark/benchmark.h>
 
+#include <atomic>
+#include <vector>
+
 #include <engine/ev/thread_control.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 
 using namespace std::chrono_literals;
 
@@ -67,4 +72,50 @@ BENCHMARK_CAPTURE(unreached_task_deadline_benchmark, no_task_deadline, false);
 BENCHMARK_CAPTURE(unreached_task_deadline_benchmark, unreached_task_deadline,
                   true);
 
+// Waits with a timeout that is never reached, the common case for RPC
+// deadlines. Each pair of tasks ping-pongs, re-arming the timer at each step.
+void unreached_wait_deadline_benchmark(benchmark::State& state) {
+  const auto threads = state.range(0);
+  engine::RunStandalone(threads, [&] {
+    std::atomic<bool> is_running{true};
+    std::atomic<std::size_t> waits{0};
+
+    struct Pair {
+      engine::SingleConsumerEvent ping;
+      engine::SingleConsumerEvent pong;
+    };
+    std::vector<Pair> pairs(threads);
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(threads * 2);
+
+    for (auto& pair : pairs) {
+      tasks.push_back(engine::AsyncNoSpan([&] {
+        while (is_running) {
+          pair.ping.Send();
+          if (pair.pong.WaitForEventFor(20s)) ++waits;
+        }
+      }));
+      tasks.push_back(engine::AsyncNoSpan([&] {
+        while (is_running) {
+          if (pair.ping.WaitForEventFor(20s)) ++waits;
+          pair.pong.Send();
+        }
+      }));
+    }
+
+    for (auto _ : state) {
+      engine::SleepFor(1ms);
+    }
+
+    is_running = false;
+    for (auto& task : tasks) task.SyncCancel();
+    state.counters["waits"] = benchmark::Counter(
+        waits.load(), benchmark::Counter::kIsRate);
+  });
+}
+BENCHMARK(unreached_wait_deadline_benchmark)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->Unit(benchmark::kMillisecond);
+
 USERVER_NAMESPACE_END
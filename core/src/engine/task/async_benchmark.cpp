@@ -2,6 +2,7 @@
 
 #include <array>
 #include <thread>
+#include <vector>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/impl/task_local_storage.hpp>
@@ -35,6 +36,26 @@ void async_comparisons_coro(benchmark::State& state) {
 }
 BENCHMARK(async_comparisons_coro)->RangeMultiplier(2)->Range(1, 32);
 
+// One short-lived task per shard, dominated by task creation
+void async_fan_out(benchmark::State& state) {
+  constexpr std::size_t kShardsCount = 64;
+
+  engine::RunStandalone(state.range(0), [&] {
+    std::vector<engine::TaskWithResult<std::size_t>> tasks;
+    tasks.reserve(kShardsCount);
+
+    for (auto _ : state) {
+      for (std::size_t i = 0; i < kShardsCount; ++i) {
+        tasks.push_back(engine::AsyncNoSpan([i] { return i; }));
+      }
+      for (auto& task : tasks) benchmark::DoNotOptimize(task.Get());
+      tasks.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * kShardsCount);
+  });
+}
+BENCHMARK(async_fan_out)->RangeMultiplier(2)->Range(1, 32);
+
 void wrap_call_single(benchmark::State& state) {
   engine::RunStandalone([&] {
     for (auto _ : state) {
@@ -1,12 +1,9 @@
 #pragma once
 
-#include <functional>
-
 #include <boost/intrusive_ptr.hpp>
 
-#include <engine/ev/thread_control.hpp>
+#include <engine/task/timer_wheel.hpp>
 #include <userver/engine/deadline.hpp>
-#include <userver/utils/fast_pimpl.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -19,7 +16,7 @@ class TaskContext;
 class ContextTimer final {
  public:
   // calls on_timer_func() in event loop
-  using Func = std::function<void(TaskContext&)>;
+  using Func = TimerWheel::Func;
 
   ContextTimer();
 
@@ -31,25 +28,23 @@ class ContextTimer final {
 
   bool WasStarted() const noexcept;
 
-  /// Asynchronously starts the timer.
+  /// Starts the timer in the specified wheel.
   /// Prolongs lifetime of the context until Finalize().
-  void Start(boost::intrusive_ptr<TaskContext> context,
-             ev::ThreadControl thread_control, Func&& on_timer_func,
-             Deadline deadline);
+  void Start(boost::intrusive_ptr<TaskContext> context, TimerWheel& wheel,
+             Func&& on_timer_func, Deadline deadline);
 
-  /// Restarts a running timer with specified params. More efficient than
-  /// calling Stop() + Start().
+  /// Restarts a running timer with specified params. Cheap if the new
+  /// deadline is not earlier than the previous one.
   void Restart(Func&& on_timer_func, Deadline deadline);
 
-  /// Asynchronously stops the timer and destroys all held resources.
+  /// Stops the timer and destroys all held resources.
   /// Invalidates the Timer and makes it unable to be restarted,
   /// releases the context.
   /// Does nothing for a WasStarted() == false timer.
   void Finalize() noexcept;
 
  private:
-  class Impl;
-  utils::FastPimpl<Impl, 288, 16> impl_;
+  TimerWheel::Timer timer_;
 };
 
 }  // namespace engine::impl
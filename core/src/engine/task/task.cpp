@@ -182,7 +182,7 @@ TaskProcessor* GetTaskProcessorOptional() noexcept {
 }
 
 ev::ThreadControl& GetEventThread() {
-  return GetTaskProcessor().EventThreadPool().NextThread();
+  return GetTaskProcessor().NextEventThread();
 }
 
 void AccountSpuriousWakeup() {
@@ -196,6 +196,12 @@ size_t GetStackSize() {
       .GetStackSize();
 }
 
+Task::Priority GetPriority() { return GetCurrentTaskContext().GetPriority(); }
+
+void SetPriority(Task::Priority priority) {
+  GetCurrentTaskContext().SetPriority(priority);
+}
+
 }  // namespace current_task
 }  // namespace engine
 
@@ -20,6 +20,8 @@
 #include <engine/task/cxxabi_eh_globals.hpp>
 #include <engine/task/task_processor.hpp>
 #include <utils/impl/assert_extra.hpp>
+#include <utils/impl/cycle_clock.hpp>
+#include <utils/impl/small_object_pool.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -94,6 +96,11 @@ constexpr SleepState MakeNextEpochSleepState(SleepState::Epoch current) {
 auto* const kFinishedDetachedToken =
     reinterpret_cast<DetachedTasksSyncBlock::Token*>(1);
 
+Task::Priority GetInheritedPriority() noexcept {
+  auto* const parent = current_task::GetCurrentTaskContextUnchecked();
+  return parent ? parent->GetPriority() : Task::Priority::kNormal;
+}
+
 }  // namespace
 
 TaskContext::TaskContext(TaskProcessor& task_processor,
@@ -103,6 +110,7 @@ TaskContext::TaskContext(TaskProcessor& task_processor,
       task_processor_(task_processor),
       task_counter_token_(task_processor_.GetTaskCounter()),
       is_critical_(importance == Task::Importance::kCritical),
+      priority_(GetInheritedPriority()),
       payload_(std::move(payload)),
       state_(Task::State::kNew),
       detached_token_(nullptr),
@@ -129,6 +137,16 @@ TaskContext::~TaskContext() noexcept {
           detached_token_ == kFinishedDetachedToken);
 }
 
+static_assert(alignof(TaskContext) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+void* TaskContext::operator new(std::size_t size) {
+  return utils::impl::SmallObjectPool::Allocate(size);
+}
+
+void TaskContext::operator delete(void* ptr, std::size_t size) noexcept {
+  utils::impl::SmallObjectPool::Deallocate(ptr, size);
+}
+
 utils::impl::WrappedCallBase& TaskContext::GetPayload() noexcept {
   UASSERT(state_.load(std::memory_order_relaxed) == Task::State::kCompleted);
   UASSERT(payload_);
@@ -214,6 +232,12 @@ void TaskContext::WaitUntil(Deadline deadline) const {
 void TaskContext::DoStep() {
   if (IsFinished()) return;
 
+  step_started_cycles_ = utils::impl::CycleClock::Now();
+  if (scheduled_cycles_) {
+    runnable_cycles_ += step_started_cycles_ - scheduled_cycles_;
+    scheduled_cycles_ = 0;
+  }
+
   SleepState::Flags clear_flags{SleepFlags::kSleeping};
   if (!coro_) {
     coro_ = task_processor_.GetCoroutine();
@@ -233,6 +257,10 @@ void TaskContext::DoStep() {
       uncaught = std::current_exception();
     }
   }
+  run_cycles_ += utils::impl::CycleClock::Now() - step_started_cycles_;
+  step_started_cycles_ = 0;
+  ++context_switches_;
+
   if (uncaught) std::rethrow_exception(uncaught);
 
   switch (yield_reason_) {
@@ -355,7 +383,7 @@ void TaskContext::ArmTimer(Deadline deadline, Func&& func) {
     deadline_timer_.Restart(std::forward<Func>(func), deadline);
   } else {
     deadline_timer_.Start(boost::intrusive_ptr{this},
-                          task_processor_.EventThreadPool().NextThread(),
+                          task_processor_.NextTimerWheel(),
                           std::forward<Func>(func), deadline);
   }
 }
@@ -442,7 +470,7 @@ void TaskContext::Wakeup(WakeupSource source, SleepState::Epoch epoch) {
   }
 
   if (ShouldSchedule(prev_sleep_state.flags, source)) {
-    Schedule();
+    Schedule(source);
   }
 }
 
@@ -461,7 +489,7 @@ void TaskContext::Wakeup(WakeupSource source, TaskContext::NoEpoch) {
       sleep_state_.FetchOrFlags<std::memory_order_seq_cst>(
           static_cast<SleepFlags>(source));
   if (ShouldSchedule(prev_sleep_state.flags, source)) {
-    Schedule();
+    Schedule(source);
   }
 }
 
@@ -638,14 +666,32 @@ void TaskContext::SetState(Task::State new_state) {
   }
 }
 
-void TaskContext::Schedule() {
+void TaskContext::Schedule(WakeupSource source) {
   UASSERT(state_ != Task::State::kQueued);
   SetState(Task::State::kQueued);
   TraceStateTransition(Task::State::kQueued);
-  task_processor_.Schedule(this);
+  scheduled_cycles_ = utils::impl::CycleClock::Now();
+  if (source == WakeupSource::kWaitList) {
+    task_processor_.ScheduleHandoff(this);
+  } else {
+    task_processor_.Schedule(this);
+  }
   // NOTE: may be executed at this point
 }
 
+TaskContext::SchedulingStats TaskContext::GetSchedulingStats() const noexcept {
+  auto run_cycles = run_cycles_;
+  if (step_started_cycles_) {
+    run_cycles += utils::impl::CycleClock::Now() - step_started_cycles_;
+  }
+
+  SchedulingStats stats;
+  stats.run_time = utils::impl::CycleClock::ToDuration(run_cycles);
+  stats.runnable_time = utils::impl::CycleClock::ToDuration(runnable_cycles_);
+  stats.context_switches = context_switches_;
+  return stats;
+}
+
 void TaskContext::ProfilerStartExecution() {
   auto threshold_us = task_processor_.GetProfilerThreshold();
   if (threshold_us.count() > 0) {
@@ -83,6 +83,10 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
 
   ~TaskContext() noexcept;
 
+  // Tasks are created at a high rate, take them from a thread-local pool
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr, std::size_t size) noexcept;
+
   TaskContext(const TaskContext&) = delete;
   TaskContext(TaskContext&&) = delete;
   TaskContext& operator=(const TaskContext&) = delete;
@@ -100,6 +104,16 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
   // exceeding these limits causes task to become cancelled
   bool IsCritical() const;
 
+  // queue of the task processor this task goes to when woken up
+  Task::Priority GetPriority() const noexcept {
+    return priority_.load(std::memory_order_relaxed);
+  }
+
+  // should only be called from the task itself
+  void SetPriority(Task::Priority priority) noexcept {
+    priority_.store(priority, std::memory_order_relaxed);
+  }
+
   // whether task is allowed to be awaited from multiple coroutines
   // simultaneously
   bool IsSharedWaitAllowed() const;
@@ -172,6 +186,17 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
 
   void SetCancelDeadline(Deadline deadline);
 
+  struct SchedulingStats final {
+    // Time spent running, including the current step
+    std::chrono::nanoseconds run_time{};
+    // Time spent in the queue of the TaskProcessor
+    std::chrono::nanoseconds runnable_time{};
+    std::size_t context_switches{0};
+  };
+
+  // must only be called from this context or after the task has finished
+  SchedulingStats GetSchedulingStats() const noexcept;
+
   bool HasLocalStorage() const noexcept;
   task_local::Storage& GetLocalStorage() noexcept;
 
@@ -197,7 +222,8 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
   bool WasStartedAsCritical() const;
   void SetState(Task::State);
 
-  void Schedule();
+  // Tasks woken up through a WaitList are handed off to the current worker
+  void Schedule(WakeupSource source = WakeupSource::kNone);
   static bool ShouldSchedule(SleepState::Flags flags, WakeupSource source);
 
   void ProfilerStartExecution();
@@ -209,6 +235,7 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
   TaskProcessor& task_processor_;
   TaskCounter::Token task_counter_token_;
   const bool is_critical_;
+  std::atomic<Task::Priority> priority_;
   bool is_cancellable_{true};
   bool within_sleep_{false};
   EhGlobals eh_globals_;
@@ -229,6 +256,13 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
 
   size_t trace_csw_left_;
 
+  // In utils::impl::CycleClock cycles, 0 if not set
+  std::uint64_t scheduled_cycles_{0};
+  std::uint64_t step_started_cycles_{0};
+  std::uint64_t run_cycles_{0};
+  std::uint64_t runnable_cycles_{0};
+  std::size_t context_switches_{0};
+
   AtomicSleepState sleep_state_;
   WakeupSource wakeup_source_{WakeupSource::kNone};
 
@@ -93,4 +93,22 @@ UTEST(TaskContext, WaitListWakeupRace) {
             engine::impl::TaskContext::WakeupSource::kWaitList);
 }
 
+UTEST(TaskContext, SchedulingStats) {
+  const auto& context = engine::current_task::GetCurrentTaskContext();
+  const auto before = context.GetSchedulingStats();
+
+  constexpr std::size_t kYieldsCount = 10;
+  for (std::size_t i = 0; i < kYieldsCount; ++i) engine::Yield();
+
+  const auto spin_until =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds{5};
+  while (std::chrono::steady_clock::now() < spin_until) {
+  }
+
+  const auto after = context.GetSchedulingStats();
+  EXPECT_EQ(after.context_switches - before.context_switches, kYieldsCount);
+  EXPECT_GE(after.run_time - before.run_time, std::chrono::milliseconds{4});
+  EXPECT_GE(after.runnable_time, before.runnable_time);
+}
+
 USERVER_NAMESPACE_END
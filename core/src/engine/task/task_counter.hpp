@@ -1,10 +1,12 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <thread>
 
+#include <userver/engine/task/task.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/statistics/aggregated_values.hpp>
 
@@ -82,6 +84,14 @@ class TaskCounter final {
 
   size_t GetTasksNoOverloadSensor() const { return tasks_no_overload_sensor_; }
 
+  size_t GetTasksOverloadSensor(Task::Priority priority) const {
+    return tasks_overload_sensor_by_priority_[PriorityIndex(priority)];
+  }
+
+  size_t GetTasksNoOverloadSensor(Task::Priority priority) const {
+    return tasks_no_overload_sensor_by_priority_[PriorityIndex(priority)];
+  }
+
   size_t GetTaskSwitchFast() const { return tasks_switch_fast_; }
 
   size_t GetTaskSwitchSlow() const { return tasks_switch_slow_; }
@@ -94,9 +104,15 @@ class TaskCounter final {
 
   void AccountTaskOverload() noexcept { tasks_overload_++; }
 
-  void AccountTaskOverloadSensor() { tasks_overload_sensor_++; }
+  void AccountTaskOverloadSensor(Task::Priority priority) {
+    tasks_overload_sensor_++;
+    tasks_overload_sensor_by_priority_[PriorityIndex(priority)]++;
+  }
 
-  void AccountTaskNoOverloadSensor() { tasks_no_overload_sensor_++; }
+  void AccountTaskNoOverloadSensor(Task::Priority priority) {
+    tasks_no_overload_sensor_++;
+    tasks_no_overload_sensor_by_priority_[PriorityIndex(priority)]++;
+  }
 
   void AccountTaskSwitchFast() { tasks_switch_fast_++; }
 
@@ -113,6 +129,14 @@ class TaskCounter final {
   }
 
  private:
+  static constexpr std::size_t kPrioritiesCount = 2;
+
+  static std::size_t PriorityIndex(Task::Priority priority) noexcept {
+    const auto index = static_cast<std::size_t>(priority);
+    UASSERT(index < kPrioritiesCount);
+    return index;
+  }
+
   std::atomic<size_t> tasks_alive_{0};
   std::atomic<size_t> tasks_created_{0};
   std::atomic<size_t> tasks_running_{0};
@@ -125,6 +149,10 @@ class TaskCounter final {
 
   std::atomic<size_t> tasks_overload_sensor_{0};
   std::atomic<size_t> tasks_no_overload_sensor_{0};
+  std::array<std::atomic<size_t>, kPrioritiesCount>
+      tasks_overload_sensor_by_priority_{};
+  std::array<std::atomic<size_t>, kPrioritiesCount>
+      tasks_no_overload_sensor_by_priority_{};
 
   utils::statistics::AggregatedValues<25> task_processor_profiler_timings_;
 };
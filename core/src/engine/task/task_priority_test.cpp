@@ -0,0 +1,108 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <engine/task/task_processor.hpp>
+#include <engine/task/task_processor_config.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/engine/wait_all_checked.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kNormalPriorityWeight = 4;
+
+engine::TaskProcessorConfig MakeConfig(engine::TaskQueueType queue_type) {
+  engine::TaskProcessorConfig config;
+  config.name = "priorities";
+  config.thread_name = "prio-worker";
+  config.worker_threads = 1;
+  config.task_processor_queue = queue_type;
+  config.normal_priority_weight = kNormalPriorityWeight;
+  return config;
+}
+
+void CheckNormalTasksGoFirst(engine::TaskProcessor& task_processor) {
+  constexpr std::size_t kTasksCount = 32;
+
+  std::mutex mutex;
+  std::vector<engine::Task::Priority> order;
+  std::vector<engine::TaskWithResult<void>> tasks;
+
+  // Both kinds are queued before the only worker gets to any of them
+  engine::AsyncNoSpan(task_processor, [&] {
+    const auto spawn = [&](engine::Task::Priority priority) {
+      tasks.push_back(engine::AsyncNoSpan([&mutex, &order, priority] {
+        const std::lock_guard lock(mutex);
+        order.push_back(priority);
+      }));
+    };
+
+    engine::current_task::SetPriority(engine::Task::Priority::kBackground);
+    for (std::size_t i = 0; i < kTasksCount; ++i) {
+      spawn(engine::Task::Priority::kBackground);
+    }
+    engine::current_task::SetPriority(engine::Task::Priority::kNormal);
+    for (std::size_t i = 0; i < kTasksCount; ++i) {
+      spawn(engine::Task::Priority::kNormal);
+    }
+  }).Get();
+  engine::WaitAllChecked(tasks);
+
+  ASSERT_EQ(order.size(), kTasksCount * 2);
+  std::size_t background_among_first = 0;
+  for (std::size_t i = 0; i < kTasksCount; ++i) {
+    if (order[i] == engine::Task::Priority::kBackground) {
+      ++background_among_first;
+    }
+  }
+  // Background tasks are not starved, but do not go ahead of normal ones
+  EXPECT_GT(background_among_first, 0);
+  EXPECT_LE(background_among_first, kTasksCount / kNormalPriorityWeight + 1);
+}
+
+}  // namespace
+
+UTEST(TaskPriority, DefaultIsNormal) {
+  EXPECT_EQ(engine::current_task::GetPriority(),
+            engine::Task::Priority::kNormal);
+  EXPECT_EQ(engine::AsyncNoSpan([] {
+              return engine::current_task::GetPriority();
+            }).Get(),
+            engine::Task::Priority::kNormal);
+}
+
+UTEST(TaskPriority, Inherited) {
+  engine::current_task::SetPriority(engine::Task::Priority::kBackground);
+  EXPECT_EQ(engine::AsyncNoSpan([] {
+              return engine::AsyncNoSpan([] {
+                       return engine::current_task::GetPriority();
+                     }).Get();
+            }).Get(),
+            engine::Task::Priority::kBackground);
+
+  // The current task still runs fine at the background priority
+  engine::SleepFor(std::chrono::milliseconds{1});
+  engine::current_task::SetPriority(engine::Task::Priority::kNormal);
+}
+
+UTEST(TaskPriority, NormalTasksGoFirstGlobalQueue) {
+  engine::TaskProcessor task_processor(
+      MakeConfig(engine::TaskQueueType::kGlobalTaskQueue),
+      engine::current_task::GetTaskProcessor().GetTaskProcessorPools());
+  CheckNormalTasksGoFirst(task_processor);
+}
+
+UTEST(TaskPriority, NormalTasksGoFirstWorkStealingQueue) {
+  engine::TaskProcessor task_processor(
+      MakeConfig(engine::TaskQueueType::kWorkStealingTaskQueue),
+      engine::current_task::GetTaskProcessor().GetTaskProcessorPools());
+  CheckNormalTasksGoFirst(task_processor);
+}
+
+USERVER_NAMESPACE_END
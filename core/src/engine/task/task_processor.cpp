@@ -1,6 +1,7 @@
 #include "task_processor.hpp"
 
 #include <sys/types.h>
+#include <algorithm>
 #include <csignal>
 
 #include <fmt/format.h>
@@ -20,6 +21,10 @@ USERVER_NAMESPACE_BEGIN
 namespace engine {
 namespace {
 
+// The elastic pool grows by at most one worker per period, so only a sustained
+// queue pressure brings it to the maximum
+constexpr std::chrono::milliseconds kWorkersControlPeriod{10};
+
 void SetTaskQueueWaitTimepoint(impl::TaskContext* context) {
   static constexpr size_t kTaskTimestampInterval = 4;
   thread_local size_t task_count = 0;
@@ -51,6 +56,20 @@ void EmitMagicNanosleep() {
   nanosleep(&ts, nullptr);
 }
 
+std::variant<TaskQueue, WorkStealingTaskQueue> MakeTaskQueue(
+    const TaskProcessorConfig& config) {
+  switch (config.task_processor_queue) {
+    case TaskQueueType::kGlobalTaskQueue:
+      return std::variant<TaskQueue, WorkStealingTaskQueue>{
+          std::in_place_type<TaskQueue>, config};
+    case TaskQueueType::kWorkStealingTaskQueue:
+      return std::variant<TaskQueue, WorkStealingTaskQueue>{
+          std::in_place_type<WorkStealingTaskQueue>, config};
+  }
+
+  UINVARIANT(false, "Unexpected value of TaskQueueType");
+}
+
 void TaskProcessorThreadStartedHook() {
   utils::impl::AssertStaticRegistrationFinished();
   (void)utils::DefaultRandom();
@@ -70,32 +89,39 @@ TaskProcessor::TaskProcessor(TaskProcessorConfig config,
       pools_(std::move(pools)),
       is_shutting_down_(false),
       detached_contexts_(impl::DetachedTasksSyncBlock::StopMode::kCancel),
+      task_queue_(MakeTaskQueue(config_)),
       max_task_queue_wait_time_(std::chrono::microseconds(0)),
       max_task_queue_wait_length_(0),
+      min_worker_count_(std::min(
+          config_.min_worker_threads.value_or(config_.worker_threads),
+          config_.worker_threads)),
       task_trace_logger_{nullptr} {
   utils::impl::FinishStaticRegistration();
+  if (config_.numa_node) {
+    local_ev_threads_ =
+        pools_->EventThreadPool().GetNumaNodeThreads(*config_.numa_node);
+    if (local_ev_threads_.empty()) {
+      LOG_WARNING() << "No event threads on numa-node=" << *config_.numa_node
+                    << " for task_processor " << Name()
+                    << ", consider enabling numa_aware for the event pool";
+    }
+  }
+
   try {
     LOG_INFO() << "creating task_processor " << Name() << " "
                << "worker_threads=" << config_.worker_threads
+               << " min_worker_threads=" << min_worker_count_
                << " thread_name=" << config_.thread_name;
-    workers_.reserve(config_.worker_threads);
-    for (size_t i = 0; i < config_.worker_threads; ++i) {
-      workers_.emplace_back([this, i] {
-        switch (config_.os_scheduling) {
-          case OsScheduling::kNormal:
-            break;
-          case OsScheduling::kLowPriority:
-            utils::SetCurrentThreadLowPriorityScheduling();
-            break;
-          case OsScheduling::kIdle:
-            utils::SetCurrentThreadIdleScheduling();
-            break;
-        }
-
-        utils::SetCurrentThreadName(
-            fmt::format("{}_{}", config_.thread_name, i));
-        ProcessTasks();
-      });
+    UINVARIANT(!IsElastic() || std::holds_alternative<TaskQueue>(task_queue_),
+               "Elastic worker count requires global-task-queue");
+
+    const std::lock_guard lock(workers_mutex_);
+    workers_.resize(config_.worker_threads);
+    for (size_t i = 0; i < min_worker_count_; ++i) {
+      StartWorker(i);
+    }
+    if (IsElastic()) {
+      controller_ = std::thread([this] { ControlWorkers(); });
     }
   } catch (...) {
     Cleanup();
@@ -111,10 +137,25 @@ void TaskProcessor::Cleanup() noexcept {
   // Some tasks may be bound but not scheduled yet
   task_counter_.WaitForExhaustion(std::chrono::milliseconds(10));
 
-  task_queue_.enqueue(nullptr);
+  std::visit([](auto& queue) { queue.StopProcessing(); }, task_queue_);
 
-  for (auto& w : workers_) {
-    w.join();
+  if (controller_.joinable()) {
+    {
+      const std::lock_guard lock(workers_mutex_);
+      is_controller_stopped_ = true;
+    }
+    workers_cv_.notify_all();
+    controller_.join();
+  }
+
+  // Idle elastic workers may still retire, they do not touch workers_
+  std::vector<std::thread> workers;
+  {
+    const std::lock_guard lock(workers_mutex_);
+    workers.swap(workers_);
+  }
+  for (auto& w : workers) {
+    if (w.joinable()) w.join();
   }
 
   UASSERT(task_counter_.GetCurrentValue() == 0);
@@ -127,37 +168,77 @@ void TaskProcessor::InitiateShutdown() {
 
 void TaskProcessor::Schedule(impl::TaskContext* context) {
   UASSERT(context);
-  if (max_task_queue_wait_length_ && !context->IsCritical()) {
+  PrepareSchedule(*context);
+
+  std::visit([context](auto& queue) { queue.Push(context); }, task_queue_);
+  // NOTE: task may be executed at this point
+}
+
+void TaskProcessor::ScheduleHandoff(impl::TaskContext* context) {
+  UASSERT(context);
+  PrepareSchedule(*context);
+
+  if (auto* const queue = std::get_if<TaskQueue>(&task_queue_)) {
+    queue->PushNext(context);
+  } else {
+    // WorkStealingTaskQueue puts the tasks from its workers to a LIFO slot
+    // anyway
+    std::visit([context](auto& queue) { queue.Push(context); }, task_queue_);
+  }
+  // NOTE: task may be executed at this point
+}
+
+void TaskProcessor::PrepareSchedule(impl::TaskContext& context) {
+  if (max_task_queue_wait_length_ && !context.IsCritical()) {
     size_t queue_size = GetTaskQueueSize();
     if (queue_size >= max_task_queue_wait_length_) {
       LOG_LIMITED_WARNING()
           << "failed to enqueue task: task_queue_ size=" << queue_size << " >= "
           << "task_queue_size_threshold=" << max_task_queue_wait_length_
           << " task_processor=" << Name();
-      HandleOverload(*context);
+      HandleOverload(context);
     }
   }
   if (is_shutting_down_)
-    context->RequestCancel(TaskCancellationReason::kShutdown);
+    context.RequestCancel(TaskCancellationReason::kShutdown);
 
-  SetTaskQueueWaitTimepoint(context);
+  SetTaskQueueWaitTimepoint(&context);
 
   // having native support for intrusive ptrs in lockfree would've been great
   // but oh well
-  intrusive_ptr_add_ref(context);
-
-  task_queue_.enqueue(context);
-  // NOTE: task may be executed at this point
+  intrusive_ptr_add_ref(&context);
 }
 
 void TaskProcessor::Adopt(impl::TaskContext& context) {
   detached_contexts_.Add(context);
 }
 
+size_t TaskProcessor::GetTaskQueueSize() const {
+  return std::visit(
+      [](const auto& queue) { return queue.GetSizeApproximate(); },
+      task_queue_);
+}
+
 ev::ThreadPool& TaskProcessor::EventThreadPool() {
   return pools_->EventThreadPool();
 }
 
+ev::ThreadControl& TaskProcessor::NextEventThread() {
+  if (local_ev_threads_.empty()) return pools_->EventThreadPool().NextThread();
+  // just ignore counter_ overflow
+  const auto index = local_ev_threads_[next_local_ev_thread_idx_++ %
+                                       local_ev_threads_.size()];
+  return pools_->EventThreadPool().GetThread(index);
+}
+
+impl::TimerWheel& TaskProcessor::NextTimerWheel() {
+  if (local_ev_threads_.empty()) return pools_->NextTimerWheel();
+  // just ignore counter_ overflow
+  const auto index = local_ev_threads_[next_local_ev_thread_idx_++ %
+                                       local_ev_threads_.size()];
+  return pools_->GetTimerWheel(index);
+}
+
 impl::CountedCoroutinePtr TaskProcessor::GetCoroutine() {
   return {pools_->GetCoroPool().GetCoroutine(), *this};
 }
@@ -227,22 +308,95 @@ logging::LoggerPtr TaskProcessor::GetTaskTraceLogger() const {
   return task_trace_logger_;
 }
 
-impl::TaskContext* TaskProcessor::DequeueTask() {
-  impl::TaskContext* buf = nullptr;
+void TaskProcessor::StartWorker(std::size_t index) {
+  UASSERT(index < workers_.size());
+  UASSERT(!workers_[index].joinable());
+  workers_[index] = std::thread([this, index] {
+    switch (config_.os_scheduling) {
+      case OsScheduling::kNormal:
+        break;
+      case OsScheduling::kLowPriority:
+        utils::SetCurrentThreadLowPriorityScheduling();
+        break;
+      case OsScheduling::kIdle:
+        utils::SetCurrentThreadIdleScheduling();
+        break;
+    }
+    try {
+      utils::SetCurrentThreadAffinity(config_.cpu_affinity);
+    } catch (const std::exception& ex) {
+      // The CPU set may change after the config was checked
+      LOG_ERROR() << "Failed to pin the worker thread of "
+                  << config_.thread_name << ": " << ex;
+    }
+
+    utils::SetCurrentThreadName(
+        fmt::format("{}_{}", config_.thread_name, index));
+    ProcessTasks(index);
+  });
+  ++worker_count_;
+}
 
-  /* Current thread handles only a single TaskProcessor, so it's safe to store
-   * a token for the task processor in a thread-local variable.
-   */
-  thread_local moodycamel::ConsumerToken token(task_queue_);
+bool TaskProcessor::TryRetireWorker(std::size_t index) {
+  const std::lock_guard lock(workers_mutex_);
+  if (worker_count_ <= min_worker_count_) return false;
 
-  task_queue_.wait_dequeue(token, buf);
-  GetTaskCounter().AccountTaskSwitchSlow();
+  --worker_count_;
+  retired_workers_.push_back(index);
+  return true;
+}
+
+void TaskProcessor::ControlWorkers() noexcept {
+  utils::SetCurrentThreadName(fmt::format("{}_ctl", config_.thread_name));
+
+  auto last_dequeued = GetTaskCounter().GetTaskSwitchSlow();
+  std::unique_lock lock(workers_mutex_);
+  while (!is_controller_stopped_) {
+    workers_cv_.wait_for(lock, kWorkersControlPeriod);
+    if (is_controller_stopped_) break;
 
-  if (!buf) {
-    // return "stop" token back
-    task_queue_.enqueue(nullptr);
+    // Retired workers have already released the mutex and are about to exit
+    for (const auto index : retired_workers_) {
+      workers_[index].join();
+    }
+    retired_workers_.clear();
+
+    // Workers may be stuck in blocking calls and report no wait times at all
+    const auto dequeued = GetTaskCounter().GetTaskSwitchSlow();
+    const bool is_stalled =
+        dequeued == last_dequeued && GetTaskQueueSize() > 0;
+    last_dequeued = dequeued;
+
+    const bool should_grow = grow_requested_.exchange(false) || is_stalled;
+    if (!should_grow || worker_count_ >= workers_.size()) continue;
+
+    const auto free_slot =
+        std::find_if(workers_.begin(), workers_.end(),
+                     [](const std::thread& w) { return !w.joinable(); });
+    UASSERT(free_slot != workers_.end());
+    try {
+      StartWorker(free_slot - workers_.begin());
+      LOG_INFO() << "task_processor " << Name()
+                 << " worker_threads increased to " << worker_count_.load();
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "Failed to start a worker for task_processor " << Name()
+                  << ": " << ex;
+    }
   }
+}
 
+impl::TaskContext* TaskProcessor::DequeueTask(std::size_t worker_index) {
+  impl::TaskContext* buf = nullptr;
+  if (IsElastic()) {
+    auto& queue = std::get<TaskQueue>(task_queue_);
+    while (!queue.PopBlockingFor(config_.worker_idle_timeout, buf)) {
+      if (TryRetireWorker(worker_index)) return nullptr;
+    }
+  } else {
+    buf = std::visit([](auto& queue) { return queue.PopBlocking(); },
+                     task_queue_);
+  }
+  GetTaskCounter().AccountTaskSwitchSlow();
   return buf;
 }
 
@@ -252,12 +406,12 @@ void RegisterThreadStartedHook(std::function<void()> func) {
   ThreadStartedHooks().push_back(std::move(func));
 }
 
-void TaskProcessor::ProcessTasks() noexcept {
+void TaskProcessor::ProcessTasks(std::size_t worker_index) noexcept {
   TaskProcessorThreadStartedHook();
 
   while (true) {
     // wrapping instance referenced in EnqueueTask
-    boost::intrusive_ptr<impl::TaskContext> context(DequeueTask(),
+    boost::intrusive_ptr<impl::TaskContext> context(DequeueTask(worker_index),
                                                     /* add_ref =*/false);
     if (!context) break;
 
@@ -293,14 +447,22 @@ void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
         std::chrono::duration_cast<std::chrono::microseconds>(wait_time);
     LOG_TRACE() << "queue wait time = " << wait_time_us.count() << "us";
 
-    task_queue_wait_time_overloaded_.store(
-        max_wait_time.count() && wait_time >= max_wait_time,
-        std::memory_order_relaxed);
+    const auto priority = context.GetPriority();
+    // Background tasks are expected to wait longer, only the normal ones
+    // signal an overload
+    if (priority == Task::Priority::kNormal) {
+      task_queue_wait_time_overloaded_.store(
+          max_wait_time.count() && wait_time >= max_wait_time,
+          std::memory_order_relaxed);
+    }
 
     if (sensor_wait_time.count() && wait_time >= sensor_wait_time) {
-      GetTaskCounter().AccountTaskOverloadSensor();
+      GetTaskCounter().AccountTaskOverloadSensor(priority);
+      if (priority == Task::Priority::kNormal && IsElastic()) {
+        grow_requested_.store(true, std::memory_order_relaxed);
+      }
     } else {
-      GetTaskCounter().AccountTaskNoOverloadSensor();
+      GetTaskCounter().AccountTaskNoOverloadSensor(priority);
     }
   } else {
     // no info, let's pretend this task has the same queue wait time as the
@@ -5,16 +5,19 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <unordered_set>
+#include <variant>
 #include <vector>
 
-#include <moodycamel/blockingconcurrentqueue.h>
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
 #include <engine/task/counted_coroutine_ptr.hpp>
 #include <engine/task/task_counter.hpp>
 #include <engine/task/task_processor_config.hpp>
+#include <engine/task/task_queue.hpp>
+#include <engine/task/work_stealing_task_queue.hpp>
 #include <userver/engine/impl/detached_tasks_sync_block.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -24,9 +27,11 @@ namespace engine {
 namespace impl {
 class TaskContext;
 class TaskProcessorPools;
+class TimerWheel;
 }  // namespace impl
 
 namespace ev {
+class ThreadControl;
 class ThreadPool;
 }  // namespace ev
 
@@ -39,12 +44,22 @@ class TaskProcessor final {
 
   void Schedule(impl::TaskContext*);
 
+  /// Schedules a task woken up by the current one. The task may run next on
+  /// the current worker, avoiding a cross-thread handoff.
+  void ScheduleHandoff(impl::TaskContext*);
+
   void Adopt(impl::TaskContext& context);
 
   impl::CountedCoroutinePtr GetCoroutine();
 
   ev::ThreadPool& EventThreadPool();
 
+  /// Prefers the ev-threads of the same NUMA node, if configured
+  ev::ThreadControl& NextEventThread();
+
+  /// Prefers the ev-threads of the same NUMA node, if configured
+  impl::TimerWheel& NextTimerWheel();
+
   std::shared_ptr<impl::TaskProcessorPools> GetTaskProcessorPools() {
     return pools_;
   }
@@ -55,9 +70,14 @@ class TaskProcessor final {
 
   const impl::TaskCounter& GetTaskCounter() const { return task_counter_; }
 
-  size_t GetTaskQueueSize() const { return task_queue_.size_approx(); }
+  size_t GetTaskQueueSize() const;
 
-  size_t GetWorkerCount() const { return workers_.size(); }
+  /// Number of currently running workers
+  size_t GetWorkerCount() const { return worker_count_.load(); }
+
+  size_t GetMinWorkerCount() const { return min_worker_count_; }
+
+  size_t GetMaxWorkerCount() const { return config_.worker_threads; }
 
   void SetSettings(const TaskProcessorSettings& settings);
 
@@ -76,9 +96,22 @@ class TaskProcessor final {
  private:
   void Cleanup() noexcept;
 
-  impl::TaskContext* DequeueTask();
+  void PrepareSchedule(impl::TaskContext& context);
+
+  bool IsElastic() const { return min_worker_count_ < config_.worker_threads; }
 
-  void ProcessTasks() noexcept;
+  // Must be called with workers_mutex_ held
+  void StartWorker(std::size_t index);
+
+  // Returns true if the idle worker should exit
+  bool TryRetireWorker(std::size_t index);
+
+  void ControlWorkers() noexcept;
+
+  // Returns nullptr if the worker should exit
+  impl::TaskContext* DequeueTask(std::size_t worker_index);
+
+  void ProcessTasks(std::size_t worker_index) noexcept;
 
   void CheckWaitTime(impl::TaskContext& context);
 
@@ -93,7 +126,7 @@ class TaskProcessor final {
   std::atomic<bool> is_shutting_down_;
   impl::DetachedTasksSyncBlock detached_contexts_;
 
-  moodycamel::BlockingConcurrentQueue<impl::TaskContext*> task_queue_;
+  std::variant<TaskQueue, WorkStealingTaskQueue> task_queue_;
 
   std::atomic<std::chrono::microseconds> sensor_task_queue_wait_time_{};
   std::atomic<std::chrono::microseconds> max_task_queue_wait_time_{};
@@ -102,7 +135,21 @@ class TaskProcessor final {
       TaskProcessorSettings::OverloadAction::kIgnore};
   std::atomic<bool> task_queue_wait_time_overloaded_{false};
 
+  // Indices of the ev-threads on the NUMA node of the workers
+  std::vector<std::size_t> local_ev_threads_;
+  std::atomic<std::size_t> next_local_ev_thread_idx_{0};
+
+  const std::size_t min_worker_count_;
+  std::atomic<std::size_t> worker_count_{0};
+  std::atomic<bool> grow_requested_{false};
+
+  // Not joinable threads are free slots for elastic workers
+  std::mutex workers_mutex_;
+  std::condition_variable workers_cv_;
   std::vector<std::thread> workers_;
+  std::vector<std::size_t> retired_workers_;
+  bool is_controller_stopped_{false};
+  std::thread controller_;
   impl::TaskCounter task_counter_;
   std::atomic<bool> task_trace_logger_set_{false};
   logging::LoggerPtr task_trace_logger_{nullptr};
@@ -0,0 +1,128 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <vector>
+
+#include <engine/impl/standalone.hpp>
+#include <engine/task/task_processor.hpp>
+#include <engine/task/task_processor_config.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+template <typename Func>
+void RunOnTaskProcessor(std::size_t worker_threads,
+                        engine::TaskQueueType queue_type, Func&& func) {
+  engine::TaskProcessorConfig config;
+  config.name = "bench";
+  config.thread_name = "bench-worker";
+  config.worker_threads = worker_threads;
+  config.task_processor_queue = queue_type;
+
+  engine::TaskProcessor task_processor(
+      std::move(config), engine::impl::MakeTaskProcessorPools({}));
+  engine::impl::RunOnTaskProcessorSync(task_processor,
+                                       std::forward<Func>(func));
+}
+
+}  // namespace
+
+void task_processor_fan_out(benchmark::State& state,
+                            engine::TaskQueueType queue_type) {
+  constexpr std::size_t kTasksCount = 64;
+
+  RunOnTaskProcessor(state.range(0), queue_type, [&] {
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(kTasksCount);
+
+    for (auto _ : state) {
+      for (std::size_t i = 0; i < kTasksCount; ++i) {
+        tasks.push_back(engine::AsyncNoSpan([] {}));
+      }
+      for (auto& task : tasks) task.Wait();
+      tasks.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * kTasksCount);
+  });
+}
+BENCHMARK_CAPTURE(task_processor_fan_out, global_task_queue,
+                  engine::TaskQueueType::kGlobalTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+BENCHMARK_CAPTURE(task_processor_fan_out, work_stealing_task_queue,
+                  engine::TaskQueueType::kWorkStealingTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+
+void task_processor_ping_pong(benchmark::State& state,
+                              engine::TaskQueueType queue_type) {
+  RunOnTaskProcessor(state.range(0), queue_type, [&] {
+    engine::SingleConsumerEvent ping;
+    engine::SingleConsumerEvent pong;
+    std::atomic<bool> is_running{true};
+
+    auto ponger = engine::AsyncNoSpan([&] {
+      while (ping.WaitForEvent() && is_running) pong.Send();
+    });
+
+    for (auto _ : state) {
+      ping.Send();
+      [[maybe_unused]] const auto ok = pong.WaitForEvent();
+    }
+
+    is_running = false;
+    ping.Send();
+    ponger.Wait();
+  });
+}
+BENCHMARK_CAPTURE(task_processor_ping_pong, global_task_queue,
+                  engine::TaskQueueType::kGlobalTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+BENCHMARK_CAPTURE(task_processor_ping_pong, work_stealing_task_queue,
+                  engine::TaskQueueType::kWorkStealingTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+
+void task_processor_spawn_from_many_tasks(benchmark::State& state,
+                                          engine::TaskQueueType queue_type) {
+  RunOnTaskProcessor(state.range(0), queue_type, [&] {
+    const auto producers_count = static_cast<std::size_t>(state.range(0));
+    constexpr std::size_t kTasksPerProducer = 16;
+
+    std::vector<engine::TaskWithResult<void>> producers;
+    producers.reserve(producers_count);
+
+    for (auto _ : state) {
+      for (std::size_t i = 0; i < producers_count; ++i) {
+        producers.push_back(engine::AsyncNoSpan([] {
+          std::vector<engine::TaskWithResult<void>> tasks;
+          tasks.reserve(kTasksPerProducer);
+          for (std::size_t j = 0; j < kTasksPerProducer; ++j) {
+            tasks.push_back(engine::AsyncNoSpan([] {}));
+          }
+          for (auto& task : tasks) task.Wait();
+        }));
+      }
+      for (auto& producer : producers) producer.Wait();
+      producers.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * producers_count *
+                            kTasksPerProducer);
+  });
+}
+BENCHMARK_CAPTURE(task_processor_spawn_from_many_tasks, global_task_queue,
+                  engine::TaskQueueType::kGlobalTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+BENCHMARK_CAPTURE(task_processor_spawn_from_many_tasks,
+                  work_stealing_task_queue,
+                  engine::TaskQueueType::kWorkStealingTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+
+USERVER_NAMESPACE_END
@@ -8,6 +8,7 @@
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
+#include <utils/threads.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -27,6 +28,18 @@ OsScheduling Parse(const yaml_config::YamlConfig& value,
   UINVARIANT(false, "Unknown OS scheduling value: " + str);
 }
 
+TaskQueueType Parse(const yaml_config::YamlConfig& value,
+                    formats::parse::To<TaskQueueType>) {
+  const auto str = value.As<std::string>();
+  if (str == "global-task-queue") {
+    return TaskQueueType::kGlobalTaskQueue;
+  } else if (str == "work-stealing-task-queue") {
+    return TaskQueueType::kWorkStealingTaskQueue;
+  }
+
+  UINVARIANT(false, "Unknown task processor queue type: " + str);
+}
+
 TaskProcessorConfig Parse(const yaml_config::YamlConfig& value,
                           formats::parse::To<TaskProcessorConfig>) {
   TaskProcessorConfig config;
@@ -36,6 +49,44 @@ TaskProcessorConfig Parse(const yaml_config::YamlConfig& value,
   config.thread_name = value["thread_name"].As<std::string>();
   config.os_scheduling =
       value["os-scheduling"].As<OsScheduling>(OsScheduling::kNormal);
+  config.task_processor_queue =
+      value["task-processor-queue"].As<TaskQueueType>(
+          config.task_processor_queue);
+  config.normal_priority_weight =
+      value["normal-priority-weight"].As<std::size_t>(
+          config.normal_priority_weight);
+
+  config.min_worker_threads =
+      value["min-worker-threads"].As<std::optional<std::size_t>>();
+  config.worker_idle_timeout =
+      value["worker-idle-timeout"].As<std::chrono::milliseconds>(
+          config.worker_idle_timeout);
+  if (config.min_worker_threads) {
+    UINVARIANT(*config.min_worker_threads > 0,
+               "min-worker-threads must be positive");
+    UINVARIANT(*config.min_worker_threads <= config.worker_threads,
+               "min-worker-threads must not exceed worker_threads");
+    UINVARIANT(config.task_processor_queue == TaskQueueType::kGlobalTaskQueue,
+               "min-worker-threads requires global-task-queue");
+    UINVARIANT(config.worker_idle_timeout.count() > 0,
+               "worker-idle-timeout must be positive");
+  }
+
+  config.numa_node = value["numa-node"].As<std::optional<std::size_t>>();
+  const auto cpu_affinity =
+      value["cpu-affinity"].As<std::optional<std::string>>();
+  if (cpu_affinity) {
+    UINVARIANT(!config.numa_node,
+               "cpu-affinity and numa-node are mutually exclusive");
+    config.cpu_affinity = utils::ParseCpuList(*cpu_affinity);
+    utils::CheckCpusAllowed(config.cpu_affinity);
+  } else if (config.numa_node) {
+    config.cpu_affinity = utils::GetNumaNodeCpus(*config.numa_node);
+    if (config.cpu_affinity.empty()) {
+      LOG_WARNING() << "No CPUs found for numa-node=" << *config.numa_node
+                    << ", worker threads are not pinned";
+    }
+  }
 
   const auto task_trace = value["task-trace"];
   if (!task_trace.IsMissing()) {
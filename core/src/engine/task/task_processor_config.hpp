@@ -2,7 +2,9 @@
 
 #include <chrono>
 #include <cstddef>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include <userver/formats/json_fwd.hpp>
 #include <userver/yaml_config/fwd.hpp>
@@ -17,6 +19,11 @@ enum class OsScheduling {
   kIdle,
 };
 
+enum class TaskQueueType {
+  kGlobalTaskQueue,
+  kWorkStealingTaskQueue,
+};
+
 struct TaskProcessorConfig {
   std::string name;
 
@@ -24,6 +31,18 @@ struct TaskProcessorConfig {
   std::size_t worker_threads{6};
   std::string thread_name;
   OsScheduling os_scheduling{OsScheduling::kNormal};
+  TaskQueueType task_processor_queue{TaskQueueType::kGlobalTaskQueue};
+  std::size_t normal_priority_weight{8};
+
+  // Elastic mode: the number of workers varies between min_worker_threads and
+  // worker_threads depending on the queue pressure
+  std::optional<std::size_t> min_worker_threads;
+  std::chrono::milliseconds worker_idle_timeout{10000};
+
+  // CPUs to pin the workers to, empty for no pinning
+  std::vector<std::size_t> cpu_affinity;
+  // NUMA node to pin the workers to and to take the ev-threads from
+  std::optional<std::size_t> numa_node;
 
   std::size_t task_trace_every{1000};
   std::size_t task_trace_max_csw{0};
@@ -0,0 +1,85 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <engine/task/task_processor.hpp>
+#include <engine/task/task_processor_config.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/engine/wait_all_checked.hpp>
+
+using namespace std::chrono_literals;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kMinWorkers = 1;
+constexpr std::size_t kMaxWorkers = 4;
+
+engine::TaskProcessorConfig MakeConfig() {
+  engine::TaskProcessorConfig config;
+  config.name = "elastic";
+  config.thread_name = "elastic-worker";
+  config.worker_threads = kMaxWorkers;
+  config.min_worker_threads = kMinWorkers;
+  config.worker_idle_timeout = 50ms;
+  return config;
+}
+
+template <typename Predicate>
+bool WaitFor(Predicate predicate) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  while (!predicate()) {
+    if (deadline.IsReached()) return false;
+    engine::SleepFor(1ms);
+  }
+  return true;
+}
+
+}  // namespace
+
+UTEST(TaskProcessorElastic, StartsWithMinWorkers) {
+  engine::TaskProcessor task_processor(
+      MakeConfig(),
+      engine::current_task::GetTaskProcessor().GetTaskProcessorPools());
+  EXPECT_EQ(task_processor.GetWorkerCount(), kMinWorkers);
+  EXPECT_EQ(task_processor.GetMinWorkerCount(), kMinWorkers);
+  EXPECT_EQ(task_processor.GetMaxWorkerCount(), kMaxWorkers);
+}
+
+UTEST(TaskProcessorElastic, GrowsOnBlockedWorkersAndShrinksOnIdle) {
+  engine::TaskProcessor task_processor(
+      MakeConfig(),
+      engine::current_task::GetTaskProcessor().GetTaskProcessorPools());
+
+  std::atomic<bool> is_released{false};
+  std::atomic<std::size_t> blocked{0};
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::size_t i = 0; i < kMaxWorkers; ++i) {
+    tasks.push_back(engine::AsyncNoSpan(task_processor, [&] {
+      ++blocked;
+      // Blocks the worker thread, like the tasks of fs-task-processor do
+      while (!is_released) std::this_thread::sleep_for(1ms);
+    }));
+  }
+
+  // The queued tasks are not dequeued by the blocked workers, so the pool grows
+  EXPECT_TRUE(WaitFor([&] { return blocked == kMaxWorkers; }));
+  EXPECT_EQ(task_processor.GetWorkerCount(), kMaxWorkers);
+
+  is_released = true;
+  engine::WaitAllChecked(tasks);
+
+  EXPECT_TRUE(
+      WaitFor([&] { return task_processor.GetWorkerCount() == kMinWorkers; }));
+
+  // Still works after shrinking
+  EXPECT_EQ(engine::AsyncNoSpan(task_processor, [] { return 42; }).Get(), 42);
+}
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,7 @@
 #include <engine/task/task_processor_pools.hpp>
 
 #include <engine/task/task_context.hpp>
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -10,7 +11,23 @@ TaskProcessorPools::TaskProcessorPools(coro::PoolConfig coro_pool_config,
                                        ev::ThreadPoolConfig ev_pool_config)
     : coro_pool_(std::move(coro_pool_config), &TaskContext::CoroFunc),
       event_thread_pool_(std::move(ev_pool_config),
-                         ev::ThreadPool::kUseDefaultEvLoop) {}
+                         ev::ThreadPool::kUseDefaultEvLoop) {
+  timer_wheels_ = utils::GenerateFixedArray(
+      event_thread_pool_.GetSize(), [&](std::size_t index) {
+        return TimerWheel(event_thread_pool_.GetThread(index));
+      });
+}
+
+TimerWheel& TaskProcessorPools::GetTimerWheel(std::size_t index) {
+  UASSERT(index < timer_wheels_.size());
+  return timer_wheels_[index];
+}
+
+TimerWheel& TaskProcessorPools::NextTimerWheel() {
+  UASSERT(!timer_wheels_.empty());
+  // just ignore counter_ overflow
+  return timer_wheels_[next_timer_wheel_idx_++ % timer_wheels_.size()];
+}
 
 }  // namespace engine::impl
 
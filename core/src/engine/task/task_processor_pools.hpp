@@ -1,7 +1,11 @@
 #pragma once
 
+#include <atomic>
+
 #include <engine/coro/pool.hpp>
 #include <engine/ev/thread_pool.hpp>
+#include <engine/task/timer_wheel.hpp>
+#include <userver/utils/fixed_array.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -19,9 +23,17 @@ class TaskProcessorPools final {
   CoroPool& GetCoroPool() { return coro_pool_; }
   ev::ThreadPool& EventThreadPool() { return event_thread_pool_; }
 
+  // Timer wheels of the event threads, used in a round-robin fashion
+  TimerWheel& NextTimerWheel();
+
+  // Timer wheel of the event thread with the same index
+  TimerWheel& GetTimerWheel(std::size_t index);
+
  private:
   CoroPool coro_pool_;
   ev::ThreadPool event_thread_pool_;
+  utils::FixedArray<TimerWheel> timer_wheels_;
+  std::atomic<std::size_t> next_timer_wheel_idx_{0};
 };
 
 }  // namespace engine::impl
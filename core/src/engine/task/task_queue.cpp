@@ -0,0 +1,221 @@
+#include <engine/task/task_queue.hpp>
+
+#include <algorithm>
+#include <utility>
+
+#include <engine/task/task_context.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+namespace {
+
+/// Max consecutive pops from the next-to-run slot. Without this limit a pair of
+/// tasks waking each other up would starve the rest of the queue.
+constexpr std::size_t kMaxNextPopsInARow = 3;
+
+/// How long an idle worker lets the owner of a next-to-run slot pick up the
+/// task before stealing it. A ping-pong wakeup takes well below that.
+constexpr std::chrono::microseconds kNextStealDelay{3};
+
+}  // namespace
+
+struct TaskQueue::WorkerSlot final {
+  // A thread serves a single TaskProcessor, `owner` is set by its first pop
+  const TaskQueue* owner{nullptr};
+  NextSlot* next{nullptr};
+  std::size_t next_pops_in_a_row{0};
+};
+
+TaskQueue::TaskQueue(const TaskProcessorConfig& config)
+    : normal_priority_weight_(config.normal_priority_weight),
+      next_slots_(std::max<std::size_t>(config.worker_threads, 1)) {
+  UINVARIANT(normal_priority_weight_ > 0,
+             "normal-priority-weight must be positive");
+}
+
+void TaskQueue::Push(impl::TaskContext* context) {
+  UASSERT(context);
+  if (context->GetPriority() == Task::Priority::kBackground) {
+    background_queue_.enqueue(context);
+  } else {
+    normal_queue_.enqueue(context);
+  }
+  sema_.signal();
+}
+
+void TaskQueue::PushNext(impl::TaskContext* context) {
+  UASSERT(context);
+  auto& slot = GetWorkerSlot();
+  if (slot.owner != this ||
+      context->GetPriority() == Task::Priority::kBackground) {
+    Push(context);
+    return;
+  }
+
+  auto* const previous =
+      slot.next->context.exchange(context, std::memory_order_acq_rel);
+  // The semaphore already accounts for the previous task
+  if (previous) normal_queue_.enqueue(previous);
+  sema_.signal();
+}
+
+impl::TaskContext* TaskQueue::PopBlocking() {
+  impl::TaskContext* buf = nullptr;
+  if (TryPopNext(buf)) return buf;
+
+  while (true) {
+    while (!sema_.wait()) {
+    }
+    if (PopAcquired(buf)) return buf;
+  }
+}
+
+bool TaskQueue::PopBlockingFor(std::chrono::microseconds timeout,
+                               impl::TaskContext*& context) {
+  if (TryPopNext(context)) return true;
+
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (true) {
+    const auto left = std::chrono::duration_cast<std::chrono::microseconds>(
+        deadline - std::chrono::steady_clock::now());
+    if (left.count() <= 0 || !sema_.wait(left.count())) return false;
+    if (PopAcquired(context)) return true;
+  }
+}
+
+TaskQueue::WorkerSlot& TaskQueue::GetWorkerSlot() noexcept {
+  thread_local WorkerSlot slot;
+  return slot;
+}
+
+TaskQueue::WorkerSlot& TaskQueue::BindWorkerSlot() {
+  auto& slot = GetWorkerSlot();
+  if (slot.owner != this) {
+    // Elastic workers come and go, a slot may end up shared by two workers.
+    // That only costs some locality, any worker may take a task from any slot.
+    const auto index = bound_next_slots_.fetch_add(1) % next_slots_.size();
+    slot.owner = this;
+    slot.next = &next_slots_[index];
+    slot.next_pops_in_a_row = 0;
+  }
+  return slot;
+}
+
+bool TaskQueue::TryPopNext(impl::TaskContext*& context) {
+  auto& slot = BindWorkerSlot();
+  auto& next = slot.next->context;
+  if (!next.load(std::memory_order_relaxed)) {
+    slot.next_pops_in_a_row = 0;
+    return false;
+  }
+
+  if (slot.next_pops_in_a_row >= kMaxNextPopsInARow) {
+    // Let others run, the count of the task moves to the queue with it
+    slot.next_pops_in_a_row = 0;
+    auto* const previous = next.exchange(nullptr, std::memory_order_acq_rel);
+    if (previous) normal_queue_.enqueue(previous);
+    return false;
+  }
+
+  context = next.exchange(nullptr, std::memory_order_acq_rel);
+  if (!context) {
+    // Stolen by an idle worker
+    slot.next_pops_in_a_row = 0;
+    return false;
+  }
+
+  // All the counts are held by the idle workers looking for tasks, one of
+  // them has to give its count up
+  if (!sema_.tryWait()) excess_claims_.fetch_add(1);
+
+  ++slot.next_pops_in_a_row;
+  return true;
+}
+
+bool TaskQueue::PopAcquired(impl::TaskContext*& context) {
+  // The semaphore guarantees that the queues or the next-to-run slots hold an
+  // item for us, or that the item was taken without a count
+  impl::TaskContext* buf = nullptr;
+  while (!TryPop(buf) && !TryStealNext(buf)) {
+    if (TryDropExcessClaim()) return false;
+  }
+
+  if (!buf) {
+    // return "stop" token back
+    normal_queue_.enqueue(nullptr);
+    sema_.signal();
+  }
+
+  context = buf;
+  return true;
+}
+
+bool TaskQueue::TryPop(impl::TaskContext*& context) {
+  /* Current thread handles only a single TaskProcessor, so it's safe to store
+   * tokens for the task processor in thread-local variables.
+   */
+  thread_local moodycamel::ConsumerToken normal_token(normal_queue_);
+  thread_local moodycamel::ConsumerToken background_token(background_queue_);
+  thread_local std::size_t normal_pops_in_a_row = 0;
+
+  if (normal_pops_in_a_row >= normal_priority_weight_) {
+    normal_pops_in_a_row = 0;
+    if (background_queue_.try_dequeue(background_token, context)) return true;
+  }
+
+  if (normal_queue_.try_dequeue(normal_token, context)) {
+    ++normal_pops_in_a_row;
+    return true;
+  }
+
+  normal_pops_in_a_row = 0;
+  return background_queue_.try_dequeue(background_token, context);
+}
+
+void TaskQueue::StopProcessing() {
+  normal_queue_.enqueue(nullptr);
+  sema_.signal();
+}
+
+bool TaskQueue::TryStealNext(impl::TaskContext*& context) {
+  const auto& own_slot = GetWorkerSlot();
+  for (auto& slot : next_slots_) {
+    auto* const task = slot.context.load(std::memory_order_relaxed);
+    if (!task) continue;
+
+    if (&slot != own_slot.next) {
+      // The owner is likely to pick the task up right after the current one
+      const auto deadline = std::chrono::steady_clock::now() + kNextStealDelay;
+      while (slot.context.load(std::memory_order_relaxed) == task &&
+             std::chrono::steady_clock::now() < deadline) {
+      }
+    }
+
+    context = slot.context.exchange(nullptr, std::memory_order_acq_rel);
+    if (context) return true;
+  }
+  return false;
+}
+
+bool TaskQueue::TryDropExcessClaim() noexcept {
+  auto excess = excess_claims_.load(std::memory_order_relaxed);
+  while (excess > 0) {
+    if (excess_claims_.compare_exchange_weak(excess, excess - 1)) return true;
+  }
+  return false;
+}
+
+std::size_t TaskQueue::GetSizeApproximate() const noexcept {
+  std::size_t size =
+      normal_queue_.size_approx() + background_queue_.size_approx();
+  for (const auto& slot : next_slots_) {
+    if (slot.context.load(std::memory_order_relaxed)) ++size;
+  }
+  return size;
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include <moodycamel/concurrentqueue.h>
+#include <moodycamel/lightweightsemaphore.h>
+
+#include <engine/task/task_processor_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace impl {
+class TaskContext;
+}  // namespace impl
+
+/// Task queue shared by all the workers of a TaskProcessor. Every Push() and
+/// every PopBlocking() goes through a single MPMC queue per task priority.
+///
+/// While tasks of both priorities are pending, a worker dequeues up to
+/// `normal_priority_weight` normal priority tasks per background one.
+///
+/// A task woken up by a worker may be handed off to the next-to-run slot of
+/// that worker instead, see PushNext().
+class TaskQueue final {
+ public:
+  explicit TaskQueue(const TaskProcessorConfig& config);
+
+  void Push(impl::TaskContext* context);
+
+  /// Puts the task to the next-to-run slot of the current worker, so that it
+  /// runs right after the current task without a cross-thread handoff. The
+  /// previous occupant of the slot goes to the queue. Falls back to Push() if
+  /// not called from a worker or for background priority tasks.
+  ///
+  /// An idle worker is woken up as for Push(). It steals the task if the
+  /// current worker does not pick it up within a few microseconds, e.g.
+  /// because the current task keeps running or blocks the thread.
+  void PushNext(impl::TaskContext* context);
+
+  /// Returns nullptr if the queue was stopped
+  impl::TaskContext* PopBlocking();
+
+  /// Returns false if no task arrived within the timeout, otherwise sets
+  /// `context`, which is nullptr if the queue was stopped
+  bool PopBlockingFor(std::chrono::microseconds timeout,
+                      impl::TaskContext*& context);
+
+  void StopProcessing();
+
+  std::size_t GetSizeApproximate() const noexcept;
+
+ private:
+  struct alignas(64) NextSlot final {
+    std::atomic<impl::TaskContext*> context{nullptr};
+  };
+  struct WorkerSlot;
+
+  static WorkerSlot& GetWorkerSlot() noexcept;
+  WorkerSlot& BindWorkerSlot();
+
+  // Returns the task from the next-to-run slot of the current worker, if any
+  bool TryPopNext(impl::TaskContext*& context);
+
+  // Must be called after a successful wait on the semaphore. Returns false if
+  // the acquired count belonged to a task that its own worker has taken.
+  bool PopAcquired(impl::TaskContext*& context);
+
+  bool TryPop(impl::TaskContext*& context);
+  bool TryStealNext(impl::TaskContext*& context);
+  bool TryDropExcessClaim() noexcept;
+
+  const std::size_t normal_priority_weight_;
+  moodycamel::ConcurrentQueue<impl::TaskContext*> normal_queue_;
+  moodycamel::ConcurrentQueue<impl::TaskContext*> background_queue_;
+  std::vector<NextSlot> next_slots_;
+  std::atomic<std::size_t> bound_next_slots_{0};
+  // Counts the tasks in the queues and the next-to-run slots, and the "stop"
+  // token
+  moodycamel::LightweightSemaphore sema_;
+  // Semaphore counts acquired by the idle workers for the tasks that were
+  // taken from the next-to-run slots by their own workers without a count
+  std::atomic<std::size_t> excess_claims_{0};
+};
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,93 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST_MT(TaskQueue, WokenUpTaskRunsOnWakerThread, 4) {
+  constexpr std::size_t kIterations = 1000;
+
+  engine::SingleConsumerEvent ping;
+  engine::SingleConsumerEvent pong;
+  std::atomic<std::thread::id> waker_thread{};
+  std::size_t same_thread_wakeups = 0;
+
+  auto ponger = engine::AsyncNoSpan([&] {
+    for (std::size_t i = 0; i < kIterations; ++i) {
+      ASSERT_TRUE(ping.WaitForEventFor(utest::kMaxTestWaitTime));
+      if (waker_thread.load() == std::this_thread::get_id()) {
+        ++same_thread_wakeups;
+      }
+      waker_thread = std::this_thread::get_id();
+      pong.Send();
+    }
+  });
+
+  for (std::size_t i = 0; i < kIterations; ++i) {
+    waker_thread = std::this_thread::get_id();
+    ping.Send();
+    ASSERT_TRUE(pong.WaitForEventFor(utest::kMaxTestWaitTime));
+  }
+  ponger.Get();
+
+  // The handoff is skipped now and then to let the queued tasks run, but most
+  // of the wakeups should not migrate the task to another worker
+  EXPECT_GT(same_thread_wakeups, kIterations / 2);
+}
+
+UTEST(TaskQueue, HandoffDoesNotStarveOtherTasks) {
+  engine::SingleConsumerEvent ping;
+  engine::SingleConsumerEvent pong;
+  std::atomic<bool> is_other_done{false};
+
+  // A pair of tasks that wake each other up endlessly on the only worker
+  auto pinger = engine::AsyncNoSpan([&] {
+    while (!is_other_done) {
+      ping.Send();
+      if (!pong.WaitForEvent()) return;
+    }
+  });
+  auto ponger = engine::AsyncNoSpan([&] {
+    while (!is_other_done) {
+      if (!ping.WaitForEvent()) return;
+      pong.Send();
+    }
+  });
+
+  engine::AsyncNoSpan([&] { is_other_done = true; }).Get();
+
+  pinger.SyncCancel();
+  ponger.SyncCancel();
+}
+
+UTEST_MT(TaskQueue, HandoffToBlockedWorkerIsStolen, 2) {
+  engine::SingleConsumerEvent event;
+  std::atomic<bool> is_woken_up{false};
+
+  auto waiter = engine::AsyncNoSpan([&] {
+    ASSERT_TRUE(event.WaitForEventFor(utest::kMaxTestWaitTime));
+    is_woken_up = true;
+  });
+  // Lets the waiter go to sleep
+  engine::SleepFor(std::chrono::milliseconds{50});
+
+  event.Send();
+  // Blocks the worker without returning to the queue, the woken up task may
+  // only run on the other worker
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds{10};
+  while (!is_woken_up && std::chrono::steady_clock::now() < deadline) {
+  }
+  EXPECT_TRUE(is_woken_up);
+
+  waiter.Get();
+}
+
+USERVER_NAMESPACE_END
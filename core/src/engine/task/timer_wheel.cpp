@@ -0,0 +1,315 @@
+#include <engine/task/timer_wheel.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <engine/task/task_context.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+namespace {
+
+// We approach libev/OS timer resolution here
+using TickDuration = std::chrono::milliseconds;
+constexpr TickDuration kTick{1};
+
+constexpr std::uint64_t kNoTick = std::numeric_limits<std::uint64_t>::max();
+
+std::uint64_t RotateRight(std::uint64_t value, std::size_t shift) noexcept {
+  if (shift == 0) return value;
+  return (value >> shift) | (value << (64 - shift));
+}
+
+std::size_t CountTrailingZeros(std::uint64_t value) noexcept {
+  UASSERT(value != 0);
+  return __builtin_ctzll(value);
+}
+
+}  // namespace
+
+WheelTimer::~WheelTimer() { UASSERT(!is_linked_); }
+
+TimerWheel::TimerWheel(ev::ThreadControl thread_control)
+    : thread_control_(thread_control),
+      epoch_(Deadline::Clock::now()),
+      planned_tick_(kNoTick) {
+  timer_.data = this;
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+  ev_init(&timer_, OnTimer);
+  wakeup_.data = this;
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+  ev_async_init(&wakeup_, OnWakeup);
+
+  thread_control_.RunInEvLoopBlocking(
+      [this] { thread_control_.Start(wakeup_); });
+}
+
+TimerWheel::~TimerWheel() {
+  thread_control_.RunInEvLoopBlocking([this] {
+    thread_control_.Stop(timer_);
+    thread_control_.Stop(wakeup_);
+  });
+
+  // Timers of leaked tasks, their contexts are leaked as well
+  for (auto& level : slots_) {
+    for (auto& list : level) {
+      for (auto& timer : list) timer.is_linked_ = false;
+      list.clear();
+    }
+  }
+}
+
+void TimerWheel::Start(Timer& timer,
+                       boost::intrusive_ptr<TaskContext>&& context,
+                       Func&& on_timer_func, Deadline deadline) {
+  UASSERT(!timer.wheel_);
+  UASSERT(!timer.is_linked_);
+  // The timer is not linked yet, so the ev-thread can not see it
+  timer.wheel_ = this;
+  timer.context_ = std::move(context);
+  Arm(timer, std::move(on_timer_func), deadline);
+}
+
+void TimerWheel::Restart(Timer& timer, Func&& on_timer_func,
+                         Deadline deadline) {
+  UASSERT(timer.wheel_ == this);
+  Arm(timer, std::move(on_timer_func), deadline);
+}
+
+void TimerWheel::Finalize(Timer& timer) noexcept {
+  UASSERT(timer.wheel_ == this);
+  boost::intrusive_ptr<TaskContext> context;
+  Func on_timer_func;
+  {
+    const std::lock_guard lock(mutex_);
+    if (timer.is_linked_) Unlink(timer);
+    context = std::move(timer.context_);
+    on_timer_func = std::exchange(timer.on_timer_func_, nullptr);
+    timer.wheel_ = nullptr;
+  }
+  // The context and closures are released without the lock, the timer itself
+  // may be destroyed at this point
+}
+
+std::size_t TimerWheel::GetSizeApproximate() const noexcept {
+  return size_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t TimerWheel::DeadlineToTick(Deadline deadline) const noexcept {
+  UASSERT(deadline.IsReachable());
+  const auto time_left = deadline.TimeLeft();
+  if (time_left <= Deadline::Duration::zero()) return 0;
+  // Rounding up guarantees that the timer never fires before the deadline
+  return std::chrono::ceil<TickDuration>(Deadline::Clock::now() - epoch_ +
+                                            time_left) /
+         kTick;
+}
+
+std::uint64_t TimerWheel::NowTick() const noexcept {
+  return std::chrono::floor<TickDuration>(Deadline::Clock::now() - epoch_) /
+         kTick;
+}
+
+void TimerWheel::Arm(Timer& timer, Func&& on_timer_func, Deadline deadline) {
+  const auto deadline_tick = DeadlineToTick(deadline);
+  bool should_wakeup = false;
+  {
+    const std::lock_guard lock(mutex_);
+    timer.on_timer_func_ = std::move(on_timer_func);
+    // The slot of current_tick_ has already been processed
+    timer.deadline_tick_ = std::max(deadline_tick, current_tick_ + 1);
+
+    if (!timer.is_linked_) {
+      Link(timer, timer.deadline_tick_);
+    } else if (timer.deadline_tick_ < timer.expiry_tick_) {
+      Unlink(timer);
+      Link(timer, timer.deadline_tick_);
+    }
+    // Otherwise the timer is relinked on expiration
+
+    if (timer.expiry_tick_ < planned_tick_) {
+      planned_tick_ = timer.expiry_tick_;
+      should_wakeup = true;
+    }
+  }
+
+  if (should_wakeup) thread_control_.Send(wakeup_);
+}
+
+void TimerWheel::Link(Timer& timer, std::uint64_t tick) noexcept {
+  UASSERT(!timer.is_linked_);
+  UASSERT(tick >= current_tick_);
+
+  constexpr auto kMaxDelta = (std::uint64_t{1} << (kSlotBits * kLevels)) - 1;
+  // Far timers are relinked on expiration
+  tick = std::min(tick, current_tick_ + kMaxDelta);
+
+  const auto delta = tick - current_tick_;
+  std::size_t level = 0;
+  while (delta >> (kSlotBits * (level + 1))) ++level;
+  UASSERT(level < kLevels);
+
+  const auto slot = (tick >> (kSlotBits * level)) & (kSlots - 1);
+  slots_[level][slot].push_back(timer);
+  occupied_slots_[level] |= std::uint64_t{1} << slot;
+
+  timer.expiry_tick_ = tick;
+  timer.level_ = level;
+  timer.is_linked_ = true;
+  size_.store(size_.load(std::memory_order_relaxed) + 1,
+              std::memory_order_relaxed);
+}
+
+void TimerWheel::Unlink(Timer& timer) noexcept {
+  UASSERT(timer.is_linked_);
+  const auto level = timer.level_;
+  const auto slot = (timer.expiry_tick_ >> (kSlotBits * level)) & (kSlots - 1);
+  auto& list = slots_[level][slot];
+  list.erase(list.iterator_to(timer));
+  if (list.empty()) occupied_slots_[level] &= ~(std::uint64_t{1} << slot);
+
+  timer.is_linked_ = false;
+  size_.store(size_.load(std::memory_order_relaxed) - 1,
+              std::memory_order_relaxed);
+}
+
+void TimerWheel::Advance(std::uint64_t to_tick, TimerList& expired) noexcept {
+  while (current_tick_ < to_tick) {
+    if (size_.load(std::memory_order_relaxed) == 0) {
+      current_tick_ = to_tick;
+      break;
+    }
+
+    if (!occupied_slots_[0]) {
+      // Skip straight to the next cascade
+      const auto next_cascade_tick = (current_tick_ | (kSlots - 1)) + 1;
+      if (next_cascade_tick > to_tick) {
+        current_tick_ = to_tick;
+        break;
+      }
+      current_tick_ = next_cascade_tick - 1;
+    }
+
+    ++current_tick_;
+    for (std::size_t level = 1; level < kLevels; ++level) {
+      const auto level_mask = (std::uint64_t{1} << (kSlotBits * level)) - 1;
+      if (current_tick_ & level_mask) break;
+      Cascade(level);
+    }
+
+    const auto slot = current_tick_ & (kSlots - 1);
+    const auto slot_bit = std::uint64_t{1} << slot;
+    if (occupied_slots_[0] & slot_bit) {
+      auto& list = slots_[0][slot];
+      for (auto& timer : list) timer.is_linked_ = false;
+      size_.store(size_.load(std::memory_order_relaxed) - list.size(),
+                  std::memory_order_relaxed);
+      expired.splice(expired.end(), list);
+      occupied_slots_[0] &= ~slot_bit;
+    }
+  }
+}
+
+void TimerWheel::Cascade(std::size_t level) noexcept {
+  const auto slot = (current_tick_ >> (kSlotBits * level)) & (kSlots - 1);
+  const auto slot_bit = std::uint64_t{1} << slot;
+  if (!(occupied_slots_[level] & slot_bit)) return;
+
+  TimerList list;
+  list.swap(slots_[level][slot]);
+  occupied_slots_[level] &= ~slot_bit;
+  while (!list.empty()) {
+    auto& timer = list.front();
+    list.pop_front();
+    timer.is_linked_ = false;
+    size_.store(size_.load(std::memory_order_relaxed) - 1,
+                std::memory_order_relaxed);
+    Link(timer, timer.expiry_tick_);
+  }
+}
+
+std::uint64_t TimerWheel::NextTick() const noexcept {
+  if (size_.load(std::memory_order_relaxed) == 0) return kNoTick;
+
+  auto next_tick = kNoTick;
+  if (occupied_slots_[0]) {
+    const auto first_slot = (current_tick_ + 1) & (kSlots - 1);
+    next_tick = current_tick_ + 1 +
+                CountTrailingZeros(RotateRight(occupied_slots_[0], first_slot));
+  }
+  if (occupied_slots_[1] | occupied_slots_[2] | occupied_slots_[3]) {
+    next_tick = std::min(next_tick, (current_tick_ | (kSlots - 1)) + 1);
+  }
+  return next_tick;
+}
+
+void TimerWheel::OnTimer(struct ev_loop*, ev_timer* w, int) noexcept {
+  auto* self = static_cast<TimerWheel*>(w->data);
+  UASSERT(self != nullptr);
+  self->Process();
+}
+
+void TimerWheel::OnWakeup(struct ev_loop*, ev_async* w, int) noexcept {
+  auto* self = static_cast<TimerWheel*>(w->data);
+  UASSERT(self != nullptr);
+  self->Process();
+}
+
+void TimerWheel::Process() noexcept {
+  UASSERT(thread_control_.IsInEvThread());
+
+  std::uint64_t next_tick = kNoTick;
+  {
+    const std::lock_guard lock(mutex_);
+    TimerList expired;
+    Advance(NowTick(), expired);
+
+    while (!expired.empty()) {
+      auto& timer = expired.front();
+      expired.pop_front();
+
+      if (timer.deadline_tick_ > current_tick_) {
+        // The timer was re-armed to a later deadline
+        Link(timer, timer.deadline_tick_);
+      } else if (timer.on_timer_func_) {
+        firing_.emplace_back(timer.context_,
+                             std::exchange(timer.on_timer_func_, nullptr));
+      }
+    }
+
+    next_tick = NextTick();
+    planned_tick_ = next_tick;
+  }
+
+  for (auto& [context, on_timer_func] : firing_) {
+    try {
+      on_timer_func(*context);  // called in event loop
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "exception in on_timer_func: " << ex;
+    }
+  }
+  // may release the last reference to contexts
+  firing_.clear();
+
+  if (next_tick == kNoTick) {
+    thread_control_.Stop(timer_);
+    return;
+  }
+
+  using LibEvDuration = std::chrono::duration<double>;
+  const auto time_left = std::chrono::duration_cast<LibEvDuration>(
+      epoch_ + next_tick * kTick - Deadline::Clock::now());
+  // zero repeat would stop the timer
+  timer_.repeat = std::max(time_left.count(), 1e-6);
+  thread_control_.Again(timer_);
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <ev.h>
+#include <boost/intrusive/list.hpp>
+#include <boost/intrusive_ptr.hpp>
+
+#include <engine/ev/thread_control.hpp>
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+class TaskContext;
+class TimerWheel;
+
+/// A timer bound to a specific TaskContext. All the fields are guarded by the
+/// mutex of the wheel.
+class WheelTimer final : public boost::intrusive::list_base_hook<> {
+ public:
+  WheelTimer() = default;
+  ~WheelTimer();
+
+  WheelTimer(const WheelTimer&) = delete;
+  WheelTimer& operator=(const WheelTimer&) = delete;
+
+  TimerWheel* GetWheel() const noexcept { return wheel_; }
+
+ private:
+  friend class TimerWheel;
+
+  TimerWheel* wheel_{nullptr};
+  boost::intrusive_ptr<TaskContext> context_;
+  std::function<void(TaskContext&)> on_timer_func_;
+  std::uint64_t deadline_tick_{0};
+  // position in the wheel, may be earlier than deadline_tick_
+  std::uint64_t expiry_tick_{0};
+  std::uint8_t level_{0};
+  bool is_linked_{false};
+};
+
+/// @brief Hierarchical timing wheel driven by a single ev-thread.
+///
+/// Replaces a libev timer per task: a timer is linked into the wheel under a
+/// short critical section right in the thread that arms it, and the ev-loop
+/// is woken up only if the new expiry is earlier than the wheel's next
+/// planned tick.
+///
+/// Cancellation is lazy. Re-arming a linked timer to a later deadline only
+/// updates the deadline, the timer stays in its slot. When the slot expires,
+/// the timer is relinked if its deadline has not been reached yet. So a
+/// deadline that never fires costs neither a syscall nor a wheel operation in
+/// the common case of repeated waits with similar timeouts.
+class TimerWheel final {
+ public:
+  using Func = std::function<void(TaskContext&)>;
+
+  using Timer = WheelTimer;
+
+  explicit TimerWheel(ev::ThreadControl thread_control);
+  ~TimerWheel();
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  /// Arms the timer. Prolongs lifetime of the context until Finalize().
+  void Start(Timer& timer, boost::intrusive_ptr<TaskContext>&& context,
+             Func&& on_timer_func, Deadline deadline);
+
+  /// Re-arms a started timer with new params.
+  void Restart(Timer& timer, Func&& on_timer_func, Deadline deadline);
+
+  /// Unlinks the timer and releases the context and the function.
+  void Finalize(Timer& timer) noexcept;
+
+  /// Number of timers currently linked into the wheel
+  std::size_t GetSizeApproximate() const noexcept;
+
+ private:
+  using TimerList = boost::intrusive::list<Timer>;
+
+  static constexpr std::size_t kLevels = 4;
+  static constexpr std::size_t kSlotBits = 6;
+  static constexpr std::size_t kSlots = 1 << kSlotBits;
+
+  std::uint64_t DeadlineToTick(Deadline deadline) const noexcept;
+  std::uint64_t NowTick() const noexcept;
+
+  void Arm(Timer& timer, Func&& on_timer_func, Deadline deadline);
+  void Link(Timer& timer, std::uint64_t tick) noexcept;
+  void Unlink(Timer& timer) noexcept;
+  void Advance(std::uint64_t to_tick, TimerList& expired) noexcept;
+  void Cascade(std::size_t level) noexcept;
+  std::uint64_t NextTick() const noexcept;
+
+  static void OnTimer(struct ev_loop*, ev_timer* w, int) noexcept;
+  static void OnWakeup(struct ev_loop*, ev_async* w, int) noexcept;
+  void Process() noexcept;
+
+  ev::ThreadControl thread_control_;
+  const Deadline::TimePoint epoch_;
+
+  mutable std::mutex mutex_;
+  std::array<std::array<TimerList, kSlots>, kLevels> slots_;
+  std::array<std::uint64_t, kLevels> occupied_slots_{};
+  std::uint64_t current_tick_{0};
+  std::uint64_t planned_tick_;
+  std::atomic<std::size_t> size_{0};
+
+  // ev-thread only
+  std::vector<std::pair<boost::intrusive_ptr<TaskContext>, Func>> firing_;
+  ev_timer timer_{};
+  ev_async wakeup_{};
+};
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
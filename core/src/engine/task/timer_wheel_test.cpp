@@ -0,0 +1,99 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/engine/wait_all_checked.hpp>
+
+using namespace std::chrono_literals;
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST(TimerWheel, NeverFiresEarly) {
+  for (const auto duration : {1ms, 2ms, 5ms, 70ms}) {
+    const auto start = std::chrono::steady_clock::now();
+    engine::SleepFor(duration);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, duration);
+  }
+}
+
+UTEST(TimerWheel, EarlierTimerIsNotDelayed) {
+  // Arms a far timer first, so that the wheel plans a distant wakeup
+  auto long_sleeper = engine::AsyncNoSpan([] { engine::SleepFor(1h); });
+  engine::Yield();
+
+  const auto start = std::chrono::steady_clock::now();
+  engine::SleepFor(10ms);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+
+  long_sleeper.SyncCancel();
+}
+
+UTEST_MT(TimerWheel, ManyTimers, 4) {
+  constexpr std::size_t kTasksCount = 1000;
+
+  std::atomic<std::size_t> woken_up{0};
+  std::vector<engine::TaskWithResult<void>> tasks;
+  tasks.reserve(kTasksCount);
+  for (std::size_t i = 0; i < kTasksCount; ++i) {
+    // Spans several levels of the wheel
+    const auto duration = std::chrono::milliseconds{(i * 7) % 300};
+    tasks.push_back(engine::AsyncNoSpan([&woken_up, duration] {
+      const auto start = std::chrono::steady_clock::now();
+      engine::SleepFor(duration);
+      EXPECT_GE(std::chrono::steady_clock::now() - start, duration);
+      ++woken_up;
+    }));
+  }
+
+  engine::WaitAllChecked(tasks);
+  EXPECT_EQ(woken_up, kTasksCount);
+}
+
+UTEST(TimerWheel, RearmLaterAndEarlier) {
+  engine::SingleConsumerEvent event;
+
+  // The timer stays in its slot with a later deadline and must not fire early
+  EXPECT_FALSE(event.WaitForEventFor(5ms));
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(event.WaitForEventFor(50ms));
+  EXPECT_GE(std::chrono::steady_clock::now() - start, 50ms);
+
+  // The timer is relinked to an earlier slot
+  start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(event.WaitForEventFor(1ms));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 50ms);
+}
+
+UTEST(TimerWheel, UnreachedDeadlines) {
+  engine::SingleConsumerEvent ping;
+  engine::SingleConsumerEvent pong;
+
+  auto ponger = engine::AsyncNoSpan([&] {
+    for (std::size_t i = 0; i < 1000; ++i) {
+      ASSERT_TRUE(ping.WaitForEventFor(utest::kMaxTestWaitTime));
+      pong.Send();
+    }
+  });
+
+  for (std::size_t i = 0; i < 1000; ++i) {
+    ping.Send();
+    ASSERT_TRUE(pong.WaitForEventFor(utest::kMaxTestWaitTime));
+  }
+  ponger.Get();
+}
+
+UTEST(TimerWheel, CancelFarTimer) {
+  // Beyond the span of the wheel, gets relinked on expiration
+  auto task = engine::AsyncNoSpan([] { engine::InterruptibleSleepFor(24h); });
+  engine::SleepFor(2ms);
+  task.SyncCancel();
+  EXPECT_EQ(task.GetState(), engine::Task::State::kCancelled);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,369 @@
+#include <engine/task/work_stealing_task_queue.hpp>
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+#include <engine/task/task_context.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+namespace {
+
+/// How often a worker checks the global queue before its local queue, to
+/// prevent starvation of tasks scheduled from outside of the TaskProcessor.
+constexpr std::size_t kGlobalQueueCheckInterval = 61;
+
+/// Max consecutive pops from the LIFO slot. Without this limit a pair of
+/// tasks waking each other up would starve the rest of the local queue.
+constexpr std::size_t kMaxLifoPopsInARow = 3;
+
+/// Max tasks to move from the global queue to a local queue at once.
+constexpr std::size_t kGlobalQueueBatchSize = 32;
+
+/// Bounded queue of a single worker. Only the owning worker pushes, any
+/// worker pops. Head and tail grow monotonically, so there is no ABA on head.
+class LocalTaskQueue final {
+ public:
+  static constexpr std::size_t kCapacity = 256;
+
+  // Must only be called by the owning worker.
+  bool TryPush(impl::TaskContext* context) noexcept {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    const auto head = head_.load(std::memory_order_acquire);
+    if (tail - head >= kCapacity) return false;
+
+    buffer_[tail % kCapacity].store(context, std::memory_order_relaxed);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  impl::TaskContext* TryPop() noexcept {
+    auto head = head_.load(std::memory_order_acquire);
+    while (true) {
+      const auto tail = tail_.load(std::memory_order_acquire);
+      if (head >= tail) return nullptr;
+
+      // The slot may be overwritten by the owner only after the head moves
+      // past it, in which case the CAS below fails.
+      auto* const context =
+          buffer_[head % kCapacity].load(std::memory_order_relaxed);
+      if (head_.compare_exchange_weak(head, head + 1,
+                                      std::memory_order_acq_rel,
+                                      std::memory_order_acquire)) {
+        return context;
+      }
+    }
+  }
+
+  std::size_t GetSizeApproximate() const noexcept {
+    const auto head = head_.load(std::memory_order_relaxed);
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    return tail > head ? tail - head : 0;
+  }
+
+ private:
+  alignas(64) std::atomic<std::uint64_t> head_{0};
+  alignas(64) std::atomic<std::uint64_t> tail_{0};
+  std::array<std::atomic<impl::TaskContext*>, kCapacity> buffer_{};
+};
+
+}  // namespace
+
+class WorkStealingTaskQueue::Consumer final {
+ public:
+  Consumer(WorkStealingTaskQueue& queue, std::size_t consumer_index)
+      : owner(queue),
+        index(consumer_index),
+        global_token(queue.global_queue_),
+        background_token(queue.background_queue_) {}
+
+  WorkStealingTaskQueue& owner;
+  const std::size_t index;
+  moodycamel::ConsumerToken global_token;
+  moodycamel::ConsumerToken background_token;
+
+  alignas(64) std::atomic<impl::TaskContext*> lifo_slot{nullptr};
+  LocalTaskQueue local_queue;
+
+  // Accessed only by the owning worker
+  std::size_t pops{0};
+  std::size_t lifo_pops_in_a_row{0};
+  std::size_t normal_pops_in_a_row{0};
+  // The task that was popped last, it runs until the next PopBlocking()
+  const impl::TaskContext* running{nullptr};
+
+  alignas(64) std::atomic<bool> is_parked{false};
+  std::mutex mutex;
+  std::condition_variable cv;
+};
+
+WorkStealingTaskQueue::WorkStealingTaskQueue(const TaskProcessorConfig& config)
+    : normal_priority_weight_(config.normal_priority_weight) {
+  UINVARIANT(config.worker_threads > 0,
+             "Work stealing task queue requires at least one worker");
+  UINVARIANT(normal_priority_weight_ > 0,
+             "normal-priority-weight must be positive");
+  consumers_.reserve(config.worker_threads);
+  for (std::size_t i = 0; i < config.worker_threads; ++i) {
+    consumers_.push_back(std::make_unique<Consumer>(*this, i));
+  }
+}
+
+WorkStealingTaskQueue::~WorkStealingTaskQueue() = default;
+
+void WorkStealingTaskQueue::Push(impl::TaskContext* context) {
+  UASSERT(context);
+
+  if (context->GetPriority() == Task::Priority::kBackground) {
+    background_queue_.enqueue(context);
+    WakeUpOne();
+    return;
+  }
+
+  auto* const consumer = GetCurrentConsumer();
+  // A task rescheduled right after its own step (e.g. engine::Yield()) must
+  // let the other tasks run, it goes to the back of the global queue
+  if (consumer && consumer->running != context) {
+    auto* const previous =
+        consumer->lifo_slot.exchange(context, std::memory_order_acq_rel);
+    if (previous && !consumer->local_queue.TryPush(previous)) {
+      global_queue_.enqueue(previous);
+    }
+  } else {
+    global_queue_.enqueue(context);
+  }
+
+  // The current task may keep running for a long time, idle workers steal
+  // from the LIFO slot as well
+  WakeUpOne();
+}
+
+impl::TaskContext* WorkStealingTaskQueue::PopBlocking() {
+  auto* consumer = GetCurrentConsumer();
+  if (!consumer) consumer = &BindCurrentConsumer();
+  consumer->running = nullptr;
+
+  while (true) {
+    auto* const context = TryPop(*consumer);
+    if (context) {
+      consumer->running = context;
+      return context;
+    }
+
+    if (is_stopped_.load()) return nullptr;
+    Park(*consumer);
+  }
+}
+
+void WorkStealingTaskQueue::StopProcessing() {
+  is_stopped_ = true;
+  for (auto& consumer : consumers_) {
+    if (consumer->is_parked.exchange(false)) {
+      parked_consumers_.fetch_sub(1);
+    }
+    { const std::lock_guard lock(consumer->mutex); }
+    consumer->cv.notify_one();
+  }
+}
+
+std::size_t WorkStealingTaskQueue::GetSizeApproximate() const noexcept {
+  std::size_t size =
+      global_queue_.size_approx() + background_queue_.size_approx();
+  for (const auto& consumer : consumers_) {
+    size += consumer->local_queue.GetSizeApproximate();
+    if (consumer->lifo_slot.load(std::memory_order_relaxed)) ++size;
+  }
+  return size;
+}
+
+WorkStealingTaskQueue::Consumer*&
+WorkStealingTaskQueue::CurrentConsumer() noexcept {
+  // A thread belongs to a single TaskProcessor, `owner` check filters out the
+  // workers of other TaskProcessors.
+  thread_local Consumer* consumer = nullptr;
+  return consumer;
+}
+
+WorkStealingTaskQueue::Consumer* WorkStealingTaskQueue::GetCurrentConsumer()
+    const noexcept {
+  auto* const consumer = CurrentConsumer();
+  return (consumer && &consumer->owner == this) ? consumer : nullptr;
+}
+
+WorkStealingTaskQueue::Consumer& WorkStealingTaskQueue::BindCurrentConsumer() {
+  UASSERT(!CurrentConsumer());
+  const auto index = bound_consumers_.fetch_add(1);
+  UINVARIANT(index < consumers_.size(),
+             "More workers than expected pop from a work stealing task queue");
+  auto& consumer = *consumers_[index];
+  CurrentConsumer() = &consumer;
+  return consumer;
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryPop(Consumer& consumer) {
+  impl::TaskContext* context = nullptr;
+
+  if (consumer.normal_pops_in_a_row >= normal_priority_weight_) {
+    consumer.normal_pops_in_a_row = 0;
+    context = TryPopBackground(consumer);
+    if (context) return context;
+  }
+
+  context = TryPopNormal(consumer);
+  if (context) {
+    ++consumer.normal_pops_in_a_row;
+    return context;
+  }
+
+  consumer.normal_pops_in_a_row = 0;
+  return TryPopBackground(consumer);
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryPopNormal(Consumer& consumer) {
+  impl::TaskContext* context = nullptr;
+
+  if (++consumer.pops % kGlobalQueueCheckInterval == 0) {
+    context = TryPopGlobal(consumer);
+    if (context) return context;
+  }
+
+  if (consumer.lifo_pops_in_a_row < kMaxLifoPopsInARow) {
+    context = consumer.lifo_slot.exchange(nullptr, std::memory_order_acq_rel);
+    if (context) {
+      ++consumer.lifo_pops_in_a_row;
+      return context;
+    }
+  }
+  consumer.lifo_pops_in_a_row = 0;
+
+  context = consumer.local_queue.TryPop();
+  if (context) return context;
+
+  context = TryPopGlobal(consumer);
+  if (context) return context;
+
+  context = consumer.lifo_slot.exchange(nullptr, std::memory_order_acq_rel);
+  if (context) return context;
+
+  return TrySteal(consumer);
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryPopGlobal(Consumer& consumer) {
+  // Take a fair share of the global queue to amortize the dequeue cost
+  const auto batch_size =
+      std::min(kGlobalQueueBatchSize,
+               global_queue_.size_approx() / consumers_.size() + 1);
+
+  std::array<impl::TaskContext*, kGlobalQueueBatchSize> buffer{};
+  const auto count = global_queue_.try_dequeue_bulk(
+      consumer.global_token, buffer.data(), batch_size);
+  if (count == 0) return nullptr;
+
+  for (std::size_t i = 1; i < count; ++i) {
+    if (!consumer.local_queue.TryPush(buffer[i])) {
+      global_queue_.enqueue(buffer[i]);
+    }
+  }
+  if (count > 1) WakeUpOne();
+
+  return buffer[0];
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryPopBackground(
+    Consumer& consumer) {
+  impl::TaskContext* context = nullptr;
+  background_queue_.try_dequeue(consumer.background_token, context);
+  return context;
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TrySteal(Consumer& thief) {
+  const auto consumers_count = consumers_.size();
+  const auto start = thief.index + thief.pops;
+
+  for (std::size_t i = 0; i < consumers_count; ++i) {
+    auto& victim = *consumers_[(start + i) % consumers_count];
+    if (&victim == &thief) continue;
+
+    auto* const context = victim.local_queue.TryPop();
+    if (!context) continue;
+
+    // Steal half of the remaining tasks, so that the victim and the thief
+    // do not have to meet again soon
+    const auto to_steal = victim.local_queue.GetSizeApproximate() / 2;
+    for (std::size_t j = 0; j < to_steal; ++j) {
+      auto* const stolen = victim.local_queue.TryPop();
+      if (!stolen) break;
+      if (!thief.local_queue.TryPush(stolen)) {
+        global_queue_.enqueue(stolen);
+      }
+    }
+    return context;
+  }
+
+  // Last resort: the owner of the LIFO slot may be stuck in a long-running
+  // task, do not let the task wait for it
+  for (std::size_t i = 0; i < consumers_count; ++i) {
+    auto& victim = *consumers_[(start + i) % consumers_count];
+    if (&victim == &thief) continue;
+
+    if (!victim.lifo_slot.load(std::memory_order_relaxed)) continue;
+    auto* const context =
+        victim.lifo_slot.exchange(nullptr, std::memory_order_acq_rel);
+    if (context) return context;
+  }
+
+  return nullptr;
+}
+
+bool WorkStealingTaskQueue::HasTasks() const noexcept {
+  if (global_queue_.size_approx() != 0) return true;
+  if (background_queue_.size_approx() != 0) return true;
+  for (const auto& consumer : consumers_) {
+    if (consumer->local_queue.GetSizeApproximate() != 0) return true;
+    if (consumer->lifo_slot.load(std::memory_order_relaxed)) return true;
+  }
+  return false;
+}
+
+void WorkStealingTaskQueue::Park(Consumer& consumer) {
+  consumer.is_parked.store(true);
+  parked_consumers_.fetch_add(1);
+
+  // Pairs with the fence in WakeUpOne(): either we see the new task here, or
+  // the producer sees us parked.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if (HasTasks() || is_stopped_.load()) {
+    if (consumer.is_parked.exchange(false)) {
+      parked_consumers_.fetch_sub(1);
+    }
+    return;
+  }
+
+  std::unique_lock lock(consumer.mutex);
+  consumer.cv.wait(lock, [&consumer] { return !consumer.is_parked.load(); });
+}
+
+void WorkStealingTaskQueue::WakeUpOne() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (parked_consumers_.load(std::memory_order_relaxed) == 0) return;
+
+  for (auto& consumer : consumers_) {
+    if (consumer->is_parked.load(std::memory_order_relaxed) &&
+        consumer->is_parked.exchange(false)) {
+      parked_consumers_.fetch_sub(1);
+      { const std::lock_guard lock(consumer->mutex); }
+      consumer->cv.notify_one();
+      return;
+    }
+  }
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <moodycamel/concurrentqueue.h>
+
+#include <engine/task/task_processor_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace impl {
+class TaskContext;
+}  // namespace impl
+
+/// Task queue with a local LIFO slot and a bounded local queue per worker.
+///
+/// Tasks scheduled from a worker of the owning TaskProcessor go to the LIFO
+/// slot of that worker, so a task woken up by a coroutine is likely to run
+/// next on the same thread with hot caches. The previous occupant of the slot
+/// is moved to the local queue of the worker. Tasks scheduled from other
+/// threads, tasks rescheduled by their own worker (e.g. on engine::Yield())
+/// and tasks that do not fit into a local queue go to the global queue.
+/// Idle workers are woken up on every push, they steal half of the local
+/// queue of other workers, or the LIFO slot as the last resort.
+///
+/// Background priority tasks bypass all of the above and go to a separate
+/// shared queue, a worker takes one of them per `normal_priority_weight`
+/// normal priority tasks while both are pending.
+class WorkStealingTaskQueue final {
+ public:
+  explicit WorkStealingTaskQueue(const TaskProcessorConfig& config);
+  ~WorkStealingTaskQueue();
+
+  WorkStealingTaskQueue(WorkStealingTaskQueue&&) = delete;
+  WorkStealingTaskQueue& operator=(WorkStealingTaskQueue&&) = delete;
+
+  void Push(impl::TaskContext* context);
+
+  /// Must be called only from the worker threads of the TaskProcessor.
+  /// Returns nullptr if the queue was stopped.
+  impl::TaskContext* PopBlocking();
+
+  void StopProcessing();
+
+  std::size_t GetSizeApproximate() const noexcept;
+
+ private:
+  class Consumer;
+
+  static Consumer*& CurrentConsumer() noexcept;
+  Consumer* GetCurrentConsumer() const noexcept;
+  Consumer& BindCurrentConsumer();
+
+  impl::TaskContext* TryPop(Consumer& consumer);
+  impl::TaskContext* TryPopNormal(Consumer& consumer);
+  impl::TaskContext* TryPopBackground(Consumer& consumer);
+  impl::TaskContext* TryPopGlobal(Consumer& consumer);
+  impl::TaskContext* TrySteal(Consumer& thief);
+
+  bool HasTasks() const noexcept;
+  void Park(Consumer& consumer);
+  void WakeUpOne();
+
+  const std::size_t normal_priority_weight_;
+  moodycamel::ConcurrentQueue<impl::TaskContext*> global_queue_;
+  moodycamel::ConcurrentQueue<impl::TaskContext*> background_queue_;
+  std::vector<std::unique_ptr<Consumer>> consumers_;
+  std::atomic<std::size_t> bound_consumers_{0};
+  std::atomic<std::size_t> parked_consumers_{0};
+  std::atomic<bool> is_stopped_{false};
+};
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,148 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include <engine/task/task_processor.hpp>
+#include <engine/task/task_processor_config.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/engine/wait_all_checked.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+engine::TaskProcessorConfig MakeWorkStealingConfig(std::size_t threads) {
+  engine::TaskProcessorConfig config;
+  config.name = "work-stealing";
+  config.thread_name = "ws-worker";
+  config.worker_threads = threads;
+  config.task_processor_queue = engine::TaskQueueType::kWorkStealingTaskQueue;
+  return config;
+}
+
+std::shared_ptr<engine::impl::TaskProcessorPools> GetCurrentPools() {
+  return engine::current_task::GetTaskProcessor().GetTaskProcessorPools();
+}
+
+}  // namespace
+
+UTEST(WorkStealingTaskQueue, ManyYieldingTasks) {
+  constexpr std::size_t kTasksCount = 1000;
+  constexpr std::size_t kYieldsCount = 10;
+
+  engine::TaskProcessor task_processor(MakeWorkStealingConfig(4),
+                                       GetCurrentPools());
+
+  std::atomic<std::size_t> finished{0};
+  std::vector<engine::TaskWithResult<void>> tasks;
+  tasks.reserve(kTasksCount);
+  for (std::size_t i = 0; i < kTasksCount; ++i) {
+    tasks.push_back(engine::AsyncNoSpan(task_processor, [&finished] {
+      for (std::size_t j = 0; j < kYieldsCount; ++j) engine::Yield();
+      ++finished;
+    }));
+  }
+
+  engine::WaitAllChecked(tasks);
+  EXPECT_EQ(finished.load(), kTasksCount);
+}
+
+UTEST(WorkStealingTaskQueue, NestedAsync) {
+  constexpr std::size_t kTasksCount = 100;
+
+  engine::TaskProcessor task_processor(MakeWorkStealingConfig(2),
+                                       GetCurrentPools());
+
+  auto task = engine::AsyncNoSpan(task_processor, [] {
+    std::vector<engine::TaskWithResult<std::size_t>> children;
+    children.reserve(kTasksCount);
+    for (std::size_t i = 0; i < kTasksCount; ++i) {
+      children.push_back(engine::AsyncNoSpan([i] { return i; }));
+    }
+
+    std::size_t sum = 0;
+    for (auto& child : children) sum += child.Get();
+    return sum;
+  });
+
+  EXPECT_EQ(task.Get(), kTasksCount * (kTasksCount - 1) / 2);
+}
+
+UTEST(WorkStealingTaskQueue, PingPong) {
+  constexpr std::size_t kIterations = 10000;
+
+  engine::TaskProcessor task_processor(MakeWorkStealingConfig(4),
+                                       GetCurrentPools());
+
+  engine::SingleConsumerEvent ping;
+  engine::SingleConsumerEvent pong;
+
+  auto ponger = engine::AsyncNoSpan(task_processor, [&] {
+    for (std::size_t i = 0; i < kIterations; ++i) {
+      ASSERT_TRUE(ping.WaitForEvent());
+      pong.Send();
+    }
+  });
+
+  auto pinger = engine::AsyncNoSpan(task_processor, [&] {
+    for (std::size_t i = 0; i < kIterations; ++i) {
+      ping.Send();
+      ASSERT_TRUE(pong.WaitForEvent());
+    }
+  });
+
+  UEXPECT_NO_THROW(pinger.Get());
+  UEXPECT_NO_THROW(ponger.Get());
+}
+
+UTEST(WorkStealingTaskQueue, YieldLetsOthersRun) {
+  engine::TaskProcessor task_processor(MakeWorkStealingConfig(1),
+                                       GetCurrentPools());
+
+  auto task = engine::AsyncNoSpan(task_processor, [] {
+    std::atomic<bool> child_started{false};
+    auto child =
+        engine::AsyncNoSpan([&child_started] { child_started = true; });
+
+    std::size_t yields = 0;
+    while (!child_started) {
+      engine::Yield();
+      ++yields;
+    }
+    child.Get();
+    return yields;
+  });
+
+  // The yielding task must not go to the LIFO slot ahead of the child
+  EXPECT_LE(task.Get(), 2);
+}
+
+UTEST(WorkStealingTaskQueue, BusyWorkerLifoSlotIsStolen) {
+  engine::TaskProcessor task_processor(MakeWorkStealingConfig(2),
+                                       GetCurrentPools());
+
+  auto task = engine::AsyncNoSpan(task_processor, [] {
+    std::atomic<bool> child_started{false};
+    auto child =
+        engine::AsyncNoSpan([&child_started] { child_started = true; });
+
+    // Blocks the worker without yielding, the child may only run on the
+    // other worker
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while (!child_started && std::chrono::steady_clock::now() < deadline) {
+    }
+    const bool result = child_started;
+    child.Get();
+    return result;
+  });
+
+  EXPECT_TRUE(task.Get());
+}
+
+USERVER_NAMESPACE_END
@@ -3,9 +3,13 @@
 #include <array>
 #include <atomic>
 #include <chrono>
+#include <string>
 
+#include <userver/concurrent/mpsc_queue.hpp>
+#include <userver/concurrent/queue.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/future.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/engine/task/task.hpp>
@@ -247,4 +251,88 @@ UTEST(WaitAny, HeterogenousWait) {
   EXPECT_EQ(future.get(), kExpectedValue);
 }
 
+UTEST(WaitAny, Channels) {
+  /// [sample waitany channels]
+  auto numbers = concurrent::SpscQueue<int>::Create();
+  auto strings = concurrent::NonFifoMpscQueue<std::string>::Create();
+  engine::SingleConsumerEvent stop;
+
+  auto producer = engine::AsyncNoSpan(
+      [&stop, numbers_producer = numbers->GetProducer(),
+       strings_producer = strings->GetProducer()] {
+        ASSERT_TRUE(numbers_producer.Push(1));
+        ASSERT_TRUE(strings_producer.Push("a"));
+        stop.Send();
+      });
+
+  auto numbers_consumer = numbers->GetConsumer();
+  auto strings_consumer = strings->GetConsumer();
+  int number = 0;
+  std::string string;
+  std::size_t received = 0;
+  while (true) {
+    // The first ready one in the list is returned
+    const auto index = engine::WaitAnyFor(utest::kMaxTestWaitTime, stop,
+                                          numbers_consumer, strings_consumer);
+    ASSERT_TRUE(index);
+    if (*index == 0) break;
+    if (*index == 1 && numbers_consumer.PopNoblock(number)) ++received;
+    if (*index == 2 && strings_consumer.PopNoblock(string)) ++received;
+  }
+  /// [sample waitany channels]
+
+  producer.Get();
+  // Items pushed before the event are not lost
+  while (numbers_consumer.PopNoblock(number)) ++received;
+  while (strings_consumer.PopNoblock(string)) ++received;
+  EXPECT_EQ(received, 2);
+  EXPECT_EQ(number, 1);
+  EXPECT_EQ(string, "a");
+}
+
+UTEST(WaitAny, ChannelsWithFutureAndTimeout) {
+  auto queue = concurrent::MpscQueue<int>::Create();
+  auto producer = queue->GetProducer();
+  auto consumer = queue->GetConsumer();
+  engine::SingleConsumerEvent event;
+  engine::Promise<int> promise;
+  auto future = promise.get_future();
+
+  // Nothing is ready, the deadline acts as a timer
+  EXPECT_EQ(engine::WaitAnyFor(10ms, consumer, event, future), std::nullopt);
+
+  auto notifier = engine::AsyncNoSpan([&promise] {
+    engine::SleepFor(10ms);
+    promise.set_value(42);
+  });
+  EXPECT_EQ(engine::WaitAnyFor(utest::kMaxTestWaitTime, consumer, event,
+                               future),
+            2);
+  EXPECT_EQ(future.get(), 42);
+  notifier.Get();
+
+  ASSERT_TRUE(producer.Push(1));
+  EXPECT_EQ(engine::WaitAny(consumer, event), 0);
+  // Waiting does not consume the item
+  EXPECT_EQ(engine::WaitAny(consumer, event), 0);
+  int value = 0;
+  EXPECT_TRUE(consumer.PopNoblock(value));
+  EXPECT_EQ(value, 1);
+
+  // A dead producer makes the consumer ready, Pop would return false
+  {
+    [[maybe_unused]] auto moved_out = std::move(producer);
+  }
+  EXPECT_EQ(engine::WaitAny(consumer, event), 0);
+  EXPECT_FALSE(consumer.Pop(value));
+}
+
+UTEST(WaitAny, EventIsNotReset) {
+  engine::SingleConsumerEvent event;
+  event.Send();
+  EXPECT_EQ(engine::WaitAny(event), 0);
+  EXPECT_TRUE(event.WaitForEventFor(0ms));
+  EXPECT_EQ(engine::WaitAnyFor(1ms, event), std::nullopt);
+}
+
 USERVER_NAMESPACE_END
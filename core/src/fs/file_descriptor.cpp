@@ -0,0 +1,203 @@
+#include <userver/fs/file_descriptor.hpp>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <engine/ev/io_uring.hpp>
+#include <engine/ev/thread_control.hpp>
+#include <fs/file_io_uring.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fs {
+
+namespace {
+
+// A single io_uring read or write is limited by the 32-bit length
+constexpr std::size_t kMaxChunkSize = 1 << 30;
+
+// Wakes up the waiting task on completion. The ring holds a reference to the
+// operation until the completion is processed, so the task may not outlive
+// the operation even if the wait is interrupted.
+class FileOperation final : public engine::ev::IoUring::Operation {
+ public:
+  std::int32_t Wait() {
+    // The kernel may use the buffer of the task until the completion
+    engine::TaskCancellationBlocker blocker;
+    [[maybe_unused]] const bool completed = event_.WaitForEvent();
+    UASSERT(completed);
+    return result_;
+  }
+
+ protected:
+  void OnCompletion(std::int32_t result) noexcept override {
+    result_ = result;
+    event_.Send();
+  }
+
+ private:
+  engine::SingleConsumerEvent event_;
+  std::int32_t result_{0};
+};
+
+template <typename Submit>
+std::size_t RunFileOperation(const Submit& submit, const char* action) {
+  while (true) {
+    boost::intrusive_ptr<FileOperation> operation{new FileOperation()};
+    submit(operation);
+    const auto result = operation->Wait();
+    if (result >= 0) return static_cast<std::size_t>(result);
+    if (result == -EINTR || result == -EAGAIN) continue;
+
+    throw std::system_error(std::error_code(-result, std::system_category()),
+                            action);
+  }
+}
+
+template <typename Func>
+auto RunOnTaskProcessor(engine::TaskProcessor& async_tp, Func&& func) {
+  // The blocking task may use the buffer of the caller until it finishes
+  engine::TaskCancellationBlocker blocker;
+  return engine::AsyncNoSpan(async_tp, std::forward<Func>(func)).Get();
+}
+
+template <typename Syscall>
+std::size_t CheckedPositionalSyscall(const Syscall& syscall,
+                                     const char* action) {
+  while (true) {
+    const ::ssize_t result = syscall();
+    if (result >= 0) return static_cast<std::size_t>(result);
+    if (errno == EINTR || errno == EAGAIN) continue;
+
+    throw std::system_error(std::error_code(errno, std::system_category()),
+                            action);
+  }
+}
+
+}  // namespace
+
+namespace impl {
+
+engine::ev::IoUring* GetFileIoUring() {
+  auto* const io_uring = engine::current_task::GetEventThread().GetIoUring();
+  return io_uring && io_uring->SupportsFileIo() ? io_uring : nullptr;
+}
+
+}  // namespace impl
+
+FileDescriptor FileDescriptor::Open(engine::TaskProcessor& async_tp,
+                                    const std::string& path,
+                                    blocking::OpenMode flags,
+                                    boost::filesystem::perms perms) {
+  auto fd = RunOnTaskProcessor(async_tp, [&] {
+    return blocking::FileDescriptor::Open(path, flags, perms);
+  });
+  return FileDescriptor{async_tp, std::move(fd), impl::GetFileIoUring()};
+}
+
+FileDescriptor::FileDescriptor(engine::TaskProcessor& async_tp,
+                               blocking::FileDescriptor fd,
+                               engine::ev::IoUring* io_uring)
+    : async_tp_(&async_tp), fd_(std::move(fd)), io_uring_(io_uring) {}
+
+FileDescriptor::FileDescriptor(FileDescriptor&& other) noexcept = default;
+
+FileDescriptor& FileDescriptor::operator=(FileDescriptor&& other) noexcept =
+    default;
+
+FileDescriptor::~FileDescriptor() = default;
+
+bool FileDescriptor::IsOpen() const { return fd_.IsOpen(); }
+
+void FileDescriptor::Close() && { std::move(fd_).Close(); }
+
+void FileDescriptor::Write(std::string_view contents) {
+  while (!contents.empty()) {
+    const auto written = WriteSome(contents);
+    offset_ += written;
+    contents.remove_prefix(written);
+  }
+}
+
+std::size_t FileDescriptor::Read(char* buffer, std::size_t max_size) {
+  const auto read = ReadSome(buffer, max_size);
+  offset_ += read;
+  return read;
+}
+
+void FileDescriptor::FSync() {
+  UASSERT(IsOpen());
+  if (io_uring_) {
+    RunFileOperation(
+        [&](auto& operation) {
+          io_uring_->SubmitFSync(fd_.GetNative(), operation);
+        },
+        "calling io_uring fsync");
+    return;
+  }
+
+  RunOnTaskProcessor(*async_tp_, [this] { fd_.FSync(); });
+}
+
+std::size_t FileDescriptor::GetSize() const { return fd_.GetSize(); }
+
+std::size_t FileDescriptor::ReadSome(char* buffer, std::size_t max_size) {
+  UASSERT(IsOpen());
+  const auto size = std::min(max_size, kMaxChunkSize);
+  if (size == 0) return 0;
+
+  if (io_uring_) {
+    return RunFileOperation(
+        [&](auto& operation) {
+          io_uring_->SubmitRead(fd_.GetNative(), buffer,
+                                static_cast<std::uint32_t>(size), offset_,
+                                operation);
+        },
+        "calling io_uring read");
+  }
+
+  return RunOnTaskProcessor(*async_tp_, [&] {
+    return CheckedPositionalSyscall(
+        [&] { return ::pread(fd_.GetNative(), buffer, size, offset_); },
+        "calling ::pread");
+  });
+}
+
+std::size_t FileDescriptor::WriteSome(std::string_view contents) {
+  UASSERT(IsOpen());
+  const auto size = std::min(contents.size(), kMaxChunkSize);
+
+  if (io_uring_) {
+    return RunFileOperation(
+        [&](auto& operation) {
+          io_uring_->SubmitWrite(fd_.GetNative(), contents.data(),
+                                 static_cast<std::uint32_t>(size), offset_,
+                                 operation);
+        },
+        "calling io_uring write");
+  }
+
+  return RunOnTaskProcessor(*async_tp_, [&] {
+    return CheckedPositionalSyscall(
+        [&] {
+          return ::pwrite(fd_.GetNative(), contents.data(), size, offset_);
+        },
+        "calling ::pwrite");
+  });
+}
+
+}  // namespace fs
+
+USERVER_NAMESPACE_END
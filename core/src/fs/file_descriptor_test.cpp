@@ -0,0 +1,91 @@
+#include <userver/utest/utest.hpp>
+
+#include <string>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/temp_file.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/fs/file_descriptor.hpp>
+#include <userver/fs/read.hpp>
+#include <userver/fs/write.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr fs::blocking::OpenMode kWriteMode{
+    fs::blocking::OpenFlag::kWrite, fs::blocking::OpenFlag::kCreateIfNotExists,
+    fs::blocking::OpenFlag::kTruncate};
+
+void CheckChunkedReadWrite() {
+  const auto file = fs::blocking::TempFile::Create();
+  auto& async_tp = engine::current_task::GetTaskProcessor();
+
+  {
+    auto fd = fs::FileDescriptor::Open(async_tp, file.GetPath(), kWriteMode);
+    fd.Write("first ");
+    fd.Write("second ");
+    fd.Write("third");
+    fd.FSync();
+    std::move(fd).Close();
+  }
+  EXPECT_EQ(fs::blocking::ReadFileContents(file.GetPath()),
+            "first second third");
+
+  auto fd = fs::FileDescriptor::Open(async_tp, file.GetPath(),
+                                     fs::blocking::OpenFlag::kRead);
+  EXPECT_EQ(fd.GetSize(), 18U);
+
+  std::string chunk(6, '\0');
+  ASSERT_EQ(fd.Read(chunk.data(), chunk.size()), 6U);
+  EXPECT_EQ(chunk, "first ");
+  ASSERT_EQ(fd.Read(chunk.data(), chunk.size()), 6U);
+  EXPECT_EQ(chunk, "second");
+  ASSERT_EQ(fd.Read(chunk.data(), chunk.size()), 6U);
+  EXPECT_EQ(chunk, " third");
+  EXPECT_EQ(fd.Read(chunk.data(), chunk.size()), 0U);
+}
+
+void CheckWholeFile() {
+  const auto file = fs::blocking::TempFile::Create();
+  auto& async_tp = engine::current_task::GetTaskProcessor();
+
+  // Larger than a single read chunk of fs::ReadFileContents
+  const std::string contents(200 * 1024 + 17, 'x');
+  fs::RewriteFileContents(async_tp, file.GetPath(), contents);
+  EXPECT_EQ(fs::blocking::ReadFileContents(file.GetPath()), contents);
+  EXPECT_EQ(fs::ReadFileContents(async_tp, file.GetPath()), contents);
+
+  fs::RewriteFileContents(async_tp, file.GetPath(), "short");
+  EXPECT_EQ(fs::ReadFileContents(async_tp, file.GetPath()), "short");
+}
+
+}  // namespace
+
+UTEST(FileDescriptor, ReadWrite) { CheckChunkedReadWrite(); }
+
+UTEST(FileDescriptor, WholeFile) { CheckWholeFile(); }
+
+UTEST(FileDescriptor, OpenMissing) {
+  auto& async_tp = engine::current_task::GetTaskProcessor();
+  UEXPECT_THROW(fs::FileDescriptor::Open(async_tp, "/nonexistent/file",
+                                         fs::blocking::OpenFlag::kRead),
+                std::runtime_error);
+  UEXPECT_THROW(fs::ReadFileContents(async_tp, "/nonexistent/file"),
+                std::runtime_error);
+}
+
+TEST(FileDescriptor, IoUring) {
+  engine::TaskProcessorPoolsConfig config;
+  config.ev_io_uring_enabled = true;
+
+  // Falls back to async_tp if io_uring is not available in the environment
+  engine::RunStandalone(2, config, [] {
+    CheckChunkedReadWrite();
+    CheckWholeFile();
+  });
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,17 @@
+#pragma once
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+class IoUring;
+}  // namespace engine::ev
+
+namespace fs::impl {
+
+// Returns the io_uring of an event thread of the current task processor if it
+// supports file reads and writes, nullptr otherwise
+engine::ev::IoUring* GetFileIoUring();
+
+}  // namespace fs::impl
+
+USERVER_NAMESPACE_END
@@ -2,6 +2,9 @@
 
 #include <userver/engine/async.hpp>
 #include <userver/fs/blocking/read.hpp>
+#include <userver/fs/file_descriptor.hpp>
+
+#include <fs/file_io_uring.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -21,12 +24,30 @@ std::string GetRelative(std::string_view path, std::string_view dir) {
   return std::string{rel};
 }
 
+// The file may grow after the size is fetched, or may report no size at all
+constexpr std::size_t kReadChunkSize = 64 * 1024;
+
 }  // namespace
 
 std::string ReadFileContents(engine::TaskProcessor& async_tp,
                              const std::string& path) {
-  return engine::AsyncNoSpan(async_tp, &fs::blocking::ReadFileContents, path)
-      .Get();
+  if (!impl::GetFileIoUring()) {
+    return engine::AsyncNoSpan(async_tp, &fs::blocking::ReadFileContents, path)
+        .Get();
+  }
+
+  // Only the open goes to async_tp, the reads do not occupy its threads
+  auto fd = FileDescriptor::Open(async_tp, path, blocking::OpenFlag::kRead);
+  std::string contents(fd.GetSize(), '\0');
+  std::size_t size = 0;
+  while (true) {
+    if (size == contents.size()) contents.resize(size + kReadChunkSize);
+    const auto read = fd.Read(contents.data() + size, contents.size() - size);
+    if (read == 0) break;
+    size += read;
+  }
+  contents.resize(size);
+  return contents;
 }
 
 FileInfoWithDataMap ReadRecursiveFilesInfoWithData(
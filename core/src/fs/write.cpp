@@ -4,8 +4,11 @@
 
 #include <userver/engine/async.hpp>
 #include <userver/fs/blocking/write.hpp>
+#include <userver/fs/file_descriptor.hpp>
 #include <userver/utils/boost_uuid4.hpp>
 
+#include <fs/file_io_uring.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace fs {
@@ -25,9 +28,22 @@ void CreateDirectories(engine::TaskProcessor& async_tp, std::string_view path) {
 
 void RewriteFileContents(engine::TaskProcessor& async_tp,
                          const std::string& path, std::string_view contents) {
-  engine::AsyncNoSpan(async_tp, &fs::blocking::RewriteFileContents, path,
-                      contents)
-      .Get();
+  if (!impl::GetFileIoUring()) {
+    engine::AsyncNoSpan(async_tp, &fs::blocking::RewriteFileContents, path,
+                        contents)
+        .Get();
+    return;
+  }
+
+  // Only the open goes to async_tp, the write and the sync do not occupy its
+  // threads
+  constexpr blocking::OpenMode flags{blocking::OpenFlag::kWrite,
+                                     blocking::OpenFlag::kCreateIfNotExists,
+                                     blocking::OpenFlag::kTruncate};
+  auto fd = FileDescriptor::Open(async_tp, path, flags);
+  fd.Write(contents);
+  fd.FSync();
+  std::move(fd).Close();
 }
 
 void SyncDirectoryContents(engine::TaskProcessor& async_tp,
@@ -1,16 +1,98 @@
 #include <userver/rcu/rcu.hpp>
 
+#include <algorithm>
 #include <atomic>
+#include <thread>
+
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/impl/thread_shard.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace rcu::impl {
 
+namespace {
+
+struct alignas(utils::impl::kInterferenceSize) EpochReadersSlot final {
+  // Readers of the even and of the odd epochs
+  EpochReadersCounter readers[2]{0, 0};
+};
+
+std::size_t GetSlotsCount() {
+  return std::max(std::thread::hardware_concurrency(), 1U);
+}
+
+class EpochDomain final {
+ public:
+  EpochDomain() : slots_(GetSlotsCount()) {}
+
+  EpochReadersCounter& Lock() noexcept {
+    auto& slot = slots_[utils::impl::GetCurrentThreadIndex() % slots_.size()];
+
+    auto epoch = epoch_.load(std::memory_order_relaxed);
+    while (true) {
+      auto& counter = slot.readers[epoch & 1];
+      counter.fetch_add(1);
+      // Pairs with TryAdvance(): either the epoch is still the same and the
+      // advancer sees our increment, or we retry with the new epoch
+      const auto current_epoch = epoch_.load();
+      if (current_epoch == epoch) return counter;
+
+      counter.fetch_sub(1);
+      epoch = current_epoch;
+    }
+  }
+
+  std::uint64_t GetEpoch() const noexcept { return epoch_.load(); }
+
+  std::uint64_t TryAdvance() noexcept {
+    const auto epoch = epoch_.load();
+
+    // Readers of (epoch - 1) may still hold the values retired in it. New
+    // readers can't lock (epoch - 1) anymore, so once it is drained, it stays
+    // drained.
+    std::int64_t readers = 0;
+    for (const auto& slot : slots_) {
+      readers += slot.readers[(epoch - 1) & 1].load();
+    }
+    if (readers != 0) return epoch - 1;
+
+    auto expected = epoch;
+    // Someone else might have advanced the epoch, that's fine
+    epoch_.compare_exchange_strong(expected, epoch + 1);
+    return epoch;
+  }
+
+ private:
+  utils::FixedArray<EpochReadersSlot> slots_;
+  // Starts from 1, so that (epoch - 1) does not wrap around
+  alignas(utils::impl::kInterferenceSize) std::atomic<std::uint64_t> epoch_{1};
+};
+
+EpochDomain& GetEpochDomain() {
+  static EpochDomain domain;
+  return domain;
+}
+
+}  // namespace
+
 uint64_t GetNextEpoch() noexcept {
   static std::atomic<uint64_t> counter{1};  // 0 is the default value in data
   return counter++;
 }
 
+EpochReadersCounter& LockReclamationEpoch() noexcept {
+  return GetEpochDomain().Lock();
+}
+
+std::uint64_t GetReclamationEpoch() noexcept {
+  return GetEpochDomain().GetEpoch();
+}
+
+std::uint64_t TryAdvanceReclamationEpoch() noexcept {
+  return GetEpochDomain().TryAdvance();
+}
+
 }  // namespace rcu::impl
 
 USERVER_NAMESPACE_END
@@ -13,10 +13,17 @@
 
 USERVER_NAMESPACE_BEGIN
 
-template <int VariableCount>
+namespace {
+
+constexpr auto kHazardPointers = rcu::ReclamationPolicy::kHazardPointers;
+constexpr auto kEpoch = rcu::ReclamationPolicy::kEpoch;
+
+}  // namespace
+
+template <int VariableCount, rcu::ReclamationPolicy Policy>
 void rcu_read(benchmark::State& state) {
   engine::RunStandalone([&] {
-    rcu::Variable<std::uint64_t> vars[VariableCount];
+    rcu::Variable<std::uint64_t, Policy> vars[VariableCount];
     {
       std::uint64_t i = 0;
       for (auto& var : vars) {
@@ -33,14 +40,17 @@ void rcu_read(benchmark::State& state) {
     }
   });
 }
-BENCHMARK_TEMPLATE(rcu_read, 1);
-BENCHMARK_TEMPLATE(rcu_read, 2);
-BENCHMARK_TEMPLATE(rcu_read, 4);
-
-template <int VariableCount>
+BENCHMARK_TEMPLATE(rcu_read, 1, kHazardPointers);
+BENCHMARK_TEMPLATE(rcu_read, 2, kHazardPointers);
+BENCHMARK_TEMPLATE(rcu_read, 4, kHazardPointers);
+BENCHMARK_TEMPLATE(rcu_read, 1, kEpoch);
+BENCHMARK_TEMPLATE(rcu_read, 2, kEpoch);
+BENCHMARK_TEMPLATE(rcu_read, 4, kEpoch);
+
+template <int VariableCount, rcu::ReclamationPolicy Policy>
 void rcu_write(benchmark::State& state) {
   engine::RunStandalone([&] {
-    rcu::Variable<std::uint64_t> vars[VariableCount];
+    rcu::Variable<std::uint64_t, Policy> vars[VariableCount];
 
     std::uint64_t i = 0;
     for (auto _ : state) {
@@ -49,10 +59,14 @@ void rcu_write(benchmark::State& state) {
     }
   });
 }
-BENCHMARK_TEMPLATE(rcu_write, 1);
-BENCHMARK_TEMPLATE(rcu_write, 2);
-BENCHMARK_TEMPLATE(rcu_write, 4);
-
+BENCHMARK_TEMPLATE(rcu_write, 1, kHazardPointers);
+BENCHMARK_TEMPLATE(rcu_write, 2, kHazardPointers);
+BENCHMARK_TEMPLATE(rcu_write, 4, kHazardPointers);
+BENCHMARK_TEMPLATE(rcu_write, 1, kEpoch);
+BENCHMARK_TEMPLATE(rcu_write, 2, kEpoch);
+BENCHMARK_TEMPLATE(rcu_write, 4, kEpoch);
+
+template <rcu::ReclamationPolicy Policy>
 void rcu_contention(benchmark::State& state) {
   const std::size_t readers_count = state.range(0);
   const std::size_t writers_count = state.range(1);
@@ -63,14 +77,14 @@ void rcu_contention(benchmark::State& state) {
 
   engine::RunStandalone(thread_count, [&] {
     std::atomic<bool> run{true};
-    rcu::Variable<std::uint64_t> var{0};
+    rcu::Variable<std::uint64_t, Policy> var{0};
 
     std::vector<engine::TaskWithResult<void>> tasks;
     tasks.reserve(readers_count - 1 + writers_count);
 
     for (std::size_t j = 0; j < readers_count - 1; j++) {
       tasks.push_back(utils::Async("reader", [&] {
-        std::vector<rcu::ReadablePtr<std::uint64_t>> pointers;
+        std::vector<rcu::ReadablePtr<std::uint64_t, Policy>> pointers;
         pointers.reserve(kept_readable_pointers_count);
 
         while (run) {
@@ -94,7 +108,7 @@ void rcu_contention(benchmark::State& state) {
     }
 
     {
-      std::queue<rcu::ReadablePtr<std::uint64_t>> pointers;
+      std::queue<rcu::ReadablePtr<std::uint64_t, Policy>> pointers;
       for (std::size_t i = 0; i < kept_readable_pointers_count; i++) {
         pointers.push(var.Read());
       }
@@ -112,17 +126,22 @@ void rcu_contention(benchmark::State& state) {
     }
   });
 }
-BENCHMARK(rcu_contention)
+BENCHMARK_TEMPLATE(rcu_contention, kHazardPointers)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 16}, {0, 1}, {1, 4}})
+    ->Ranges({{2048, 2048}, {0, 1}, {1, 4}});
+BENCHMARK_TEMPLATE(rcu_contention, kEpoch)
     ->RangeMultiplier(2)
     ->Ranges({{1, 16}, {0, 1}, {1, 4}})
     ->Ranges({{2048, 2048}, {0, 1}, {1, 4}});
 
+template <rcu::ReclamationPolicy Policy>
 void rcu_of_shared_ptr(benchmark::State& state) {
   const std::size_t readers_count = state.range(0);
 
   engine::RunStandalone(readers_count, [&] {
     std::atomic<bool> run{true};
-    rcu::Variable<std::shared_ptr<std::uint64_t>> var{
+    rcu::Variable<std::shared_ptr<std::uint64_t>, Policy> var{
         std::make_shared<std::uint64_t>(42)};
 
     std::vector<engine::TaskWithResult<void>> tasks;
@@ -148,6 +167,9 @@ void rcu_of_shared_ptr(benchmark::State& state) {
     }
   });
 }
-BENCHMARK(rcu_of_shared_ptr)->RangeMultiplier(2)->Range(1, 32);
+BENCHMARK_TEMPLATE(rcu_of_shared_ptr, kHazardPointers)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+BENCHMARK_TEMPLATE(rcu_of_shared_ptr, kEpoch)->RangeMultiplier(2)->Range(1, 32);
 
 USERVER_NAMESPACE_END
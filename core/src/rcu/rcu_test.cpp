@@ -404,14 +404,13 @@ constexpr std::size_t kSleeperTask = 1;
 constexpr std::size_t kTotalTasks =
     kReadablePtrPingPongTasks + kReadingTasks + kWritingTasks + kSleeperTask;
 
-}  // namespace
-
-UTEST_MT(Rcu, TortureTest, kTotalTasks) {
-  rcu::Variable<CleaningUpInt> data{1};
+template <rcu::ReclamationPolicy Policy>
+void RunTortureTest() {
+  rcu::Variable<CleaningUpInt, Policy> data{1};
   std::atomic<bool> keep_running{true};
 
   engine::Mutex ping_pong_mutex;
-  rcu::ReadablePtr<CleaningUpInt> ptr = data.Read();
+  rcu::ReadablePtr<CleaningUpInt, Policy> ptr = data.Read();
 
   std::vector<engine::TaskWithResult<void>> tasks;
 
@@ -448,6 +447,16 @@ UTEST_MT(Rcu, TortureTest, kTotalTasks) {
   keep_running = false;
 }
 
+}  // namespace
+
+UTEST_MT(Rcu, TortureTest, kTotalTasks) {
+  RunTortureTest<rcu::ReclamationPolicy::kHazardPointers>();
+}
+
+UTEST_MT(Rcu, EpochTortureTest, kTotalTasks) {
+  RunTortureTest<rcu::ReclamationPolicy::kEpoch>();
+}
+
 UTEST(Rcu, WritablePtrUnlocksInCommit) {
   rcu::Variable<int> var{1};
 
@@ -568,4 +577,79 @@ UTEST_MT(Rcu, Core, 3) {
   }
 }
 
+UTEST(Rcu, SampleEpochReclamation) {
+  /// [Sample rcu::Variable epoch reclamation]
+  // Reads are much cheaper than with the default hazard pointers, but the
+  // old values are destroyed only after all the readers that started before
+  // the Commit() are gone
+  rcu::Variable<std::string, rcu::ReclamationPolicy::kEpoch> config{"old"};
+
+  auto reader = config.Read();
+  config.Assign("new");
+
+  EXPECT_EQ(*reader, "old");
+  EXPECT_EQ(config.ReadCopy(), "new");
+  /// [Sample rcu::Variable epoch reclamation]
+}
+
+UTEST(Rcu, EpochLifetime) {
+  using Counted = Counted<struct EpochLifetimeTag>;
+
+  {
+    rcu::Variable<Counted, rcu::ReclamationPolicy::kEpoch> ptr;
+    EXPECT_EQ(1, Counted::counter);
+
+    {
+      auto reader = ptr.Read();
+      auto reader_copy = reader;
+
+      auto writer = ptr.StartWrite();
+      writer->value = 10;
+      writer.Commit();
+      engine::Yield();
+      EXPECT_EQ(2, Counted::counter);
+
+      ptr.Cleanup();
+      engine::Yield();
+      EXPECT_EQ(2, Counted::counter);
+      EXPECT_EQ(1, reader_copy->value);
+    }
+
+    // The old value is destroyed in background once the readers are gone
+    ptr.Cleanup();
+    engine::Yield();
+    EXPECT_EQ(1, Counted::counter);
+    EXPECT_EQ(10, ptr.ReadCopy().value);
+
+    ptr.Emplace();
+    engine::Yield();
+    EXPECT_EQ(1, Counted::counter);
+  }
+  EXPECT_EQ(0, Counted::counter);
+}
+
+UTEST_MT(Rcu, EpochReadersMigrate, 4) {
+  rcu::Variable<CleaningUpInt, rcu::ReclamationPolicy::kEpoch> data{1};
+  std::atomic<bool> keep_running{true};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (int i = 0; i < 8; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      while (keep_running) {
+        // The task may be resumed on another thread while holding the epoch
+        const auto reader = data.Read();
+        engine::Yield();
+        ASSERT_GT(reader->value, 0);
+      }
+    }));
+  }
+
+  for (std::uint64_t i = 2; i < 1000; ++i) {
+    data.Assign(CleaningUpInt{i});
+  }
+
+  keep_running = false;
+  for (auto& task : tasks) task.Get();
+}
+
 USERVER_NAMESPACE_END
@@ -127,12 +127,55 @@ properties:
                         defaultDescription: 32 * 1024
                     requests_queue_size_threshold:
                         type: integer
-                        description: drop requests from handlers that allow trottling if there's more pending requests than allowed by this value
+                        description: drop requests from handlers that allow trottling if there's more pending requests than allowed by this value; also limits the pipelined HTTP/1.1 requests processed concurrently
                         defaultDescription: 100
                     keepalive_timeout:
                         type: integer
                         description: timeout in seconds to drop connection if there's not data received from it
                         defaultDescription: 600
+                    http2_enabled:
+                        type: boolean
+                        description: accept HTTP/2 connections with prior knowledge (h2c) or negotiated by ALPN over TLS in addition to HTTP/1.x
+                        defaultDescription: false
+                    http2_max_concurrent_streams:
+                        type: integer
+                        description: max concurrent HTTP/2 streams per connection, advertised in SETTINGS_MAX_CONCURRENT_STREAMS
+                        defaultDescription: requests_queue_size_threshold
+                    pipeline_max_buffered_bytes:
+                        type: integer
+                        description: stop reading pipelined HTTP/1.1 requests while the ready responses waiting to be sent in order take more bytes than this value
+                        defaultDescription: 1024 * 1024
+            tls:
+                type: object
+                description: TLS termination options, plain TCP is used if not set
+                additionalProperties: false
+                properties:
+                    cert:
+                        type: string
+                        description: path to the PEM file with the server certificate followed by the intermediate certificates
+                    private_key:
+                        type: string
+                        description: path to the PEM file with the private key
+                    session_cache_size:
+                        type: integer
+                        description: max TLS sessions count in the server side session cache, 0 disables the cache
+                        defaultDescription: 20480
+                    session_timeout:
+                        type: string
+                        description: lifetime of the cached TLS sessions and of the session tickets
+                        defaultDescription: 300s
+                    session_tickets:
+                        type: boolean
+                        description: whether to issue TLS session tickets
+                        defaultDescription: true
+                    reload_interval:
+                        type: string
+                        description: how often to check the certificate and the key files for changes, 0 disables the reload
+                        defaultDescription: 1m
+                    fs_task_processor:
+                        type: string
+                        description: task processor to read the certificate and the key files on reload
+                        defaultDescription: fs-task-processor
             shards:
                 type: integer
                 description: how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing
@@ -171,12 +214,55 @@ properties:
                         defaultDescription: 32 * 1024
                     requests_queue_size_threshold:
                         type: integer
-                        description: drop requests from handlers that allow trottling if there's more pending requests than allowed by this value
+                        description: drop requests from handlers that allow trottling if there's more pending requests than allowed by this value; also limits the pipelined HTTP/1.1 requests processed concurrently
                         defaultDescription: 100
                     keepalive_timeout:
                         type: integer
                         description: timeout in seconds to drop connection if there's not data received from it
                         defaultDescription: 600
+                    http2_enabled:
+                        type: boolean
+                        description: accept HTTP/2 connections with prior knowledge (h2c) or negotiated by ALPN over TLS in addition to HTTP/1.x
+                        defaultDescription: false
+                    http2_max_concurrent_streams:
+                        type: integer
+                        description: max concurrent HTTP/2 streams per connection, advertised in SETTINGS_MAX_CONCURRENT_STREAMS
+                        defaultDescription: requests_queue_size_threshold
+                    pipeline_max_buffered_bytes:
+                        type: integer
+                        description: stop reading pipelined HTTP/1.1 requests while the ready responses waiting to be sent in order take more bytes than this value
+                        defaultDescription: 1024 * 1024
+            tls:
+                type: object
+                description: TLS termination options, plain TCP is used if not set
+                additionalProperties: false
+                properties:
+                    cert:
+                        type: string
+                        description: path to the PEM file with the server certificate followed by the intermediate certificates
+                    private_key:
+                        type: string
+                        description: path to the PEM file with the private key
+                    session_cache_size:
+                        type: integer
+                        description: max TLS sessions count in the server side session cache, 0 disables the cache
+                        defaultDescription: 20480
+                    session_timeout:
+                        type: string
+                        description: lifetime of the cached TLS sessions and of the session tickets
+                        defaultDescription: 300s
+                    session_tickets:
+                        type: boolean
+                        description: whether to issue TLS session tickets
+                        defaultDescription: true
+                    reload_interval:
+                        type: string
+                        description: how often to check the certificate and the key files for changes, 0 disables the reload
+                        defaultDescription: 1m
+                    fs_task_processor:
+                        type: string
+                        description: task processor to read the certificate and the key files on reload
+                        defaultDescription: fs-task-processor
             handler-defaults:
                 type: object
                 description: handler defaults options
@@ -56,6 +56,38 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["timings"] = stats.timings;
 }
 
+void HttpHandlerTaskStatistics::Account(
+    const HttpHandlerStatisticsEntry& stats) noexcept {
+  run_time_.GetCurrentCounter().Account(stats.task_run_time.count());
+  runnable_time_.GetCurrentCounter().Account(stats.task_runnable_time.count());
+  context_switches_.GetCurrentCounter().Account(stats.task_context_switches);
+}
+
+HttpHandlerTaskStatisticsSnapshot::HttpHandlerTaskStatisticsSnapshot(
+    const HttpHandlerTaskStatistics& stats)
+    : run_time(stats.GetRunTime()),
+      runnable_time(stats.GetRunnableTime()),
+      context_switches(stats.GetContextSwitches()) {}
+
+void HttpHandlerTaskStatisticsSnapshot::Add(
+    const HttpHandlerTaskStatisticsSnapshot& other) {
+  run_time.Add(other.run_time);
+  runnable_time.Add(other.runnable_time);
+  context_switches.Add(other.context_switches);
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const HttpHandlerTaskStatistics& stats) {
+  writer = HttpHandlerTaskStatisticsSnapshot{stats};
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const HttpHandlerTaskStatisticsSnapshot& stats) {
+  writer["task-run-time"] = stats.run_time;
+  writer["task-runnable-time"] = stats.runnable_time;
+  writer["task-context-switches"] = stats.context_switches;
+}
+
 void HttpRequestMethodStatistics::Account(
     const HttpRequestStatisticsEntry& stats) noexcept {
   timings_.GetCurrentCounter().Account(stats.timing.count());
@@ -90,6 +122,8 @@ HttpHandlerStatisticsScope::HttpHandlerStatisticsScope(
     : stats_(stats),
       method_(method),
       start_time_(std::chrono::steady_clock::now()),
+      start_task_stats_(engine::current_task::GetCurrentTaskContext()
+                            .GetSchedulingStats()),
       response_(response) {
   stats_.ForMethodAndTotal(method, [&](HttpHandlerMethodStatistics& stats) {
     stats.IncrementInFlight();
@@ -98,6 +132,8 @@ HttpHandlerStatisticsScope::HttpHandlerStatisticsScope(
 
 HttpHandlerStatisticsScope::~HttpHandlerStatisticsScope() {
   const auto finish_time = std::chrono::steady_clock::now();
+  const auto finish_task_stats =
+      engine::current_task::GetCurrentTaskContext().GetSchedulingStats();
   const auto* const data = request::kTaskInheritedData.GetOptional();
 
   HttpHandlerStatisticsEntry stats;
@@ -106,6 +142,13 @@ HttpHandlerStatisticsScope::~HttpHandlerStatisticsScope() {
       finish_time - start_time_);
   stats.deadline = data ? data->deadline : engine::Deadline{};
   stats.cancellation = engine::current_task::CancellationReason();
+  stats.task_run_time = std::chrono::duration_cast<std::chrono::microseconds>(
+      finish_task_stats.run_time - start_task_stats_.run_time);
+  stats.task_runnable_time =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          finish_task_stats.runnable_time - start_task_stats_.runnable_time);
+  stats.task_context_switches = finish_task_stats.context_switches -
+                                start_task_stats_.context_switches;
   stats_.Account(method_, stats);
 
   stats_.ForMethodAndTotal(method_, [&](HttpHandlerMethodStatistics& stats) {
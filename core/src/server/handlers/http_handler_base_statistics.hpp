@@ -4,6 +4,7 @@
 #include <chrono>
 #include <type_traits>
 
+#include <engine/task/task_context.hpp>
 #include <server/http/handler_methods.hpp>
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/task/cancel.hpp>
@@ -13,6 +14,7 @@
 #include <userver/utils/statistics/aggregated_values.hpp>
 #include <userver/utils/statistics/percentile.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
+#include <userver/utils/statistics/sharded_counter.hpp>
 #include <utils/statistics/http_codes.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -26,6 +28,12 @@ struct HttpHandlerStatisticsEntry final {
   engine::Deadline deadline{};
   engine::TaskCancellationReason cancellation{
       engine::TaskCancellationReason::kNone};
+
+  // Of the task that handled the request. Run time is the wall time the task
+  // spent on a worker thread, including the time the thread was preempted.
+  std::chrono::microseconds task_run_time{};
+  std::chrono::microseconds task_runnable_time{};
+  std::size_t task_context_switches{0};
 };
 
 class HttpHandlerMethodStatistics final {
@@ -40,30 +48,32 @@ class HttpHandlerMethodStatistics final {
 
   Percentile GetTimings() const { return timings_.GetStatsForPeriod(); }
 
-  size_t GetInFlight() const noexcept { return in_flight_; }
+  size_t GetInFlight() const noexcept { return in_flight_.Load(); }
 
-  void IncrementInFlight() noexcept { in_flight_++; }
+  void IncrementInFlight() noexcept { ++in_flight_; }
 
-  void DecrementInFlight() noexcept { in_flight_--; }
+  void DecrementInFlight() noexcept { --in_flight_; }
 
   void IncrementTooManyRequestsInFlight() noexcept {
-    too_many_requests_in_flight_++;
+    ++too_many_requests_in_flight_;
   }
 
   size_t GetTooManyRequestsInFlight() const noexcept {
-    return too_many_requests_in_flight_;
+    return too_many_requests_in_flight_.Load();
   }
 
-  void IncrementRateLimitReached() noexcept { rate_limit_reached_++; }
+  void IncrementRateLimitReached() noexcept { ++rate_limit_reached_; }
 
-  size_t GetRateLimitReached() const noexcept { return rate_limit_reached_; }
+  size_t GetRateLimitReached() const noexcept {
+    return rate_limit_reached_.Load();
+  }
 
   std::uint64_t GetDeadlineReceived() const noexcept {
-    return deadline_received_.load();
+    return deadline_received_.Load();
   }
 
   std::uint64_t GetCancelledByDeadline() const noexcept {
-    return cancelled_by_deadline_.load();
+    return cancelled_by_deadline_.Load();
   }
 
  private:
@@ -73,11 +83,12 @@ class HttpHandlerMethodStatistics final {
 
   RecentPeriod timings_;
   utils::statistics::HttpCodes reply_codes_;
-  std::atomic<std::size_t> in_flight_{0};
-  std::atomic<std::uint64_t> too_many_requests_in_flight_{0};
-  std::atomic<std::uint64_t> rate_limit_reached_{0};
-  std::atomic<std::uint64_t> deadline_received_{0};
-  std::atomic<std::uint64_t> cancelled_by_deadline_{0};
+  // Updated by every request of the handler, so sharded to avoid contention
+  utils::statistics::ShardedCounter<std::size_t> in_flight_;
+  utils::statistics::ShardedCounter<std::uint64_t> too_many_requests_in_flight_;
+  utils::statistics::ShardedCounter<std::uint64_t> rate_limit_reached_;
+  utils::statistics::ShardedCounter<std::uint64_t> deadline_received_;
+  utils::statistics::ShardedCounter<std::uint64_t> cancelled_by_deadline_;
 };
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -103,6 +114,60 @@ struct HttpHandlerStatisticsSnapshot final {
 void DumpMetric(utils::statistics::Writer& writer,
                 const HttpHandlerStatisticsSnapshot& stats);
 
+// Scheduling statistics of the tasks that handled the requests. Kept per
+// handler rather than per method to keep the memory footprint small.
+class HttpHandlerTaskStatistics final {
+ public:
+  void Account(const HttpHandlerStatisticsEntry& stats) noexcept;
+
+  /// In microseconds: exact up to 128us, then 256us buckets up to ~33ms
+  using TimePercentile =
+      utils::statistics::Percentile<128, unsigned int, 128, 256>;
+
+  /// Exact up to 64, then 16 wide buckets up to 1024
+  using CountPercentile =
+      utils::statistics::Percentile<64, unsigned int, 60, 16>;
+
+  TimePercentile GetRunTime() const { return run_time_.GetStatsForPeriod(); }
+
+  TimePercentile GetRunnableTime() const {
+    return runnable_time_.GetStatsForPeriod();
+  }
+
+  CountPercentile GetContextSwitches() const {
+    return context_switches_.GetStatsForPeriod();
+  }
+
+ private:
+  template <typename Percentile>
+  using RecentPeriod =
+      utils::statistics::RecentPeriod<Percentile, Percentile,
+                                      utils::datetime::SteadyClock>;
+
+  RecentPeriod<TimePercentile> run_time_;
+  RecentPeriod<TimePercentile> runnable_time_;
+  RecentPeriod<CountPercentile> context_switches_;
+};
+
+struct HttpHandlerTaskStatisticsSnapshot final {
+  HttpHandlerTaskStatisticsSnapshot() = default;
+
+  explicit HttpHandlerTaskStatisticsSnapshot(
+      const HttpHandlerTaskStatistics& stats);
+
+  void Add(const HttpHandlerTaskStatisticsSnapshot& other);
+
+  HttpHandlerTaskStatistics::TimePercentile run_time;
+  HttpHandlerTaskStatistics::TimePercentile runnable_time;
+  HttpHandlerTaskStatistics::CountPercentile context_switches;
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const HttpHandlerTaskStatistics& stats);
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const HttpHandlerTaskStatisticsSnapshot& stats);
+
 // Statistics for a single request from the overall server or the external
 // client perspective. Includes the time spent in queue.
 struct HttpRequestStatisticsEntry final {
@@ -163,7 +228,21 @@ class ByMethodStatistics {
 };
 
 class HttpHandlerStatistics final
-    : public ByMethodStatistics<HttpHandlerMethodStatistics> {};
+    : public ByMethodStatistics<HttpHandlerMethodStatistics> {
+ public:
+  void Account(http::HttpMethod method,
+               const HttpHandlerStatisticsEntry& entry) noexcept {
+    ByMethodStatistics::Account(method, entry);
+    task_.Account(entry);
+  }
+
+  const HttpHandlerTaskStatistics& GetTaskStatistics() const noexcept {
+    return task_;
+  }
+
+ private:
+  HttpHandlerTaskStatistics task_;
+};
 
 class HttpRequestStatistics final
     : public ByMethodStatistics<HttpRequestMethodStatistics> {};
@@ -180,6 +259,7 @@ class HttpHandlerStatisticsScope final {
   HttpHandlerStatistics& stats_;
   const http::HttpMethod method_;
   const std::chrono::steady_clock::time_point start_time_;
+  const engine::impl::TaskContext::SchedulingStats start_task_stats_;
   server::http::HttpResponse& response_;
 };
 
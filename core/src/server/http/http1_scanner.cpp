@@ -0,0 +1,231 @@
+#include "http1_scanner.hpp"
+
+#include <array>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <userver/utils/str_icase.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+namespace {
+
+constexpr bool IsControlChar(unsigned char c) noexcept {
+  return (c < 0x20 && c != '\t') || c == 0x7f;
+}
+
+// tchar from RFC 7230, section 3.2.6
+constexpr auto kTokenChars = [] {
+  std::array<bool, 256> result{};
+  for (int c = '0'; c <= '9'; ++c) result[c] = true;
+  for (int c = 'a'; c <= 'z'; ++c) result[c] = true;
+  for (int c = 'A'; c <= 'Z'; ++c) result[c] = true;
+  for (const char c : std::string_view{"!#$%&'*+-.^_`|~"}) {
+    result[static_cast<unsigned char>(c)] = true;
+  }
+  return result;
+}();
+
+bool IsToken(std::string_view data) noexcept {
+  if (data.empty()) return false;
+  for (const char c : data) {
+    if (!kTokenChars[static_cast<unsigned char>(c)]) return false;
+  }
+  return true;
+}
+
+constexpr bool IsDigit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+std::string_view TrimWhitespace(std::string_view data) noexcept {
+  while (!data.empty() && (data.front() == ' ' || data.front() == '\t')) {
+    data.remove_prefix(1);
+  }
+  while (!data.empty() && (data.back() == ' ' || data.back() == '\t')) {
+    data.remove_suffix(1);
+  }
+  return data;
+}
+
+#if defined(__AVX2__)
+constexpr std::size_t kVectorSize = 32;
+
+// Bit mask of the control characters except the horizontal tab
+inline unsigned ControlCharMask(const char* data) noexcept {
+  const auto chunk =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+  const auto is_ctl = _mm256_cmpeq_epi8(
+      _mm256_min_epu8(chunk, _mm256_set1_epi8(0x1f)), chunk);
+  const auto is_tab = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\t'));
+  const auto is_del = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(0x7f));
+  return static_cast<unsigned>(_mm256_movemask_epi8(
+      _mm256_or_si256(_mm256_andnot_si256(is_tab, is_ctl), is_del)));
+}
+#elif defined(__SSE2__)
+constexpr std::size_t kVectorSize = 16;
+
+// Bit mask of the control characters except the horizontal tab
+inline unsigned ControlCharMask(const char* data) noexcept {
+  const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  const auto is_ctl =
+      _mm_cmpeq_epi8(_mm_min_epu8(chunk, _mm_set1_epi8(0x1f)), chunk);
+  const auto is_tab = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t'));
+  const auto is_del = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(0x7f));
+  return static_cast<unsigned>(_mm_movemask_epi8(
+      _mm_or_si128(_mm_andnot_si128(is_tab, is_ctl), is_del)));
+}
+#endif
+
+}  // namespace
+
+const char* FindControlChar(const char* begin, const char* end) noexcept {
+#if defined(__AVX2__) || defined(__SSE2__)
+  while (static_cast<std::size_t>(end - begin) >= kVectorSize) {
+    if (const auto mask = ControlCharMask(begin)) {
+      return begin + __builtin_ctz(mask);
+    }
+    begin += kVectorSize;
+  }
+#endif
+  return FindControlCharScalar(begin, end);
+}
+
+const char* FindControlCharScalar(const char* begin,
+                                  const char* end) noexcept {
+  for (; begin != end; ++begin) {
+    if (IsControlChar(static_cast<unsigned char>(*begin))) return begin;
+  }
+  return end;
+}
+
+std::optional<RequestLine> ParseRequestLine(std::string_view line) {
+  RequestLine result;
+
+  const auto method_end = line.find(' ');
+  if (method_end == std::string_view::npos) return std::nullopt;
+  result.method = line.substr(0, method_end);
+  if (!IsToken(result.method)) return std::nullopt;
+  line.remove_prefix(method_end + 1);
+
+  const auto url_end = line.find(' ');
+  if (url_end == 0 || url_end == std::string_view::npos) return std::nullopt;
+  result.url = line.substr(0, url_end);
+  if (result.url.find('\t') != std::string_view::npos) return std::nullopt;
+  line.remove_prefix(url_end + 1);
+
+  constexpr std::string_view kVersionPrefix = "HTTP/";
+  if (line.size() != kVersionPrefix.size() + 3 ||
+      line.substr(0, kVersionPrefix.size()) != kVersionPrefix) {
+    return std::nullopt;
+  }
+  line.remove_prefix(kVersionPrefix.size());
+  if (!IsDigit(line[0]) || line[1] != '.' || !IsDigit(line[2])) {
+    return std::nullopt;
+  }
+  result.http_major = line[0] - '0';
+  result.http_minor = line[2] - '0';
+
+  return result;
+}
+
+std::optional<HeaderLine> ParseHeaderLine(std::string_view line) {
+  const auto colon = line.find(':');
+  if (colon == std::string_view::npos) return std::nullopt;
+
+  HeaderLine result{line.substr(0, colon),
+                    TrimWhitespace(line.substr(colon + 1))};
+  // Whitespace between the name and the colon is forbidden
+  if (!IsToken(result.name)) return std::nullopt;
+  return result;
+}
+
+std::optional<std::uint64_t> ParseChunkSize(std::string_view line) {
+  // Larger chunks would not fit into max_request_size anyway
+  constexpr std::size_t kMaxDigits = 15;
+
+  std::uint64_t size = 0;
+  std::size_t digits = 0;
+  for (; digits < line.size(); ++digits) {
+    const char c = line[digits];
+    std::uint64_t digit = 0;
+    if (IsDigit(c)) {
+      digit = c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+      digit = c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+      digit = c - 'A' + 10;
+    } else {
+      break;
+    }
+    size = size * 16 + digit;
+  }
+  if (digits == 0 || digits > kMaxDigits) return std::nullopt;
+
+  const auto extensions = TrimWhitespace(line.substr(digits));
+  if (!extensions.empty() && extensions.front() != ';') return std::nullopt;
+  return size;
+}
+
+std::optional<std::uint64_t> ParseContentLength(std::string_view value) {
+  constexpr std::size_t kMaxDigits = 18;
+  if (value.empty() || value.size() > kMaxDigits) return std::nullopt;
+
+  std::uint64_t result = 0;
+  for (const char c : value) {
+    if (!IsDigit(c)) return std::nullopt;
+    result = result * 10 + (c - '0');
+  }
+  return result;
+}
+
+HttpMethod ParseMethod(std::string_view method) {
+  switch (method.size()) {
+    case 3:
+      if (method == "GET") return HttpMethod::kGet;
+      if (method == "PUT") return HttpMethod::kPut;
+      break;
+    case 4:
+      if (method == "POST") return HttpMethod::kPost;
+      if (method == "HEAD") return HttpMethod::kHead;
+      break;
+    case 5:
+      if (method == "PATCH") return HttpMethod::kPatch;
+      break;
+    case 6:
+      if (method == "DELETE") return HttpMethod::kDelete;
+      break;
+    case 7:
+      if (method == "OPTIONS") return HttpMethod::kOptions;
+      if (method == "CONNECT") return HttpMethod::kConnect;
+      break;
+  }
+  return HttpMethod::kUnknown;
+}
+
+bool HasToken(std::string_view value, std::string_view token) {
+  while (!value.empty()) {
+    const auto comma = value.find(',');
+    if (utils::StrIcaseEqual{}(TrimWhitespace(value.substr(0, comma)),
+                               token)) {
+      return true;
+    }
+    if (comma == std::string_view::npos) break;
+    value.remove_prefix(comma + 1);
+  }
+  return false;
+}
+
+bool EndsWithToken(std::string_view value, std::string_view token) {
+  const auto comma = value.rfind(',');
+  if (comma != std::string_view::npos) value.remove_prefix(comma + 1);
+  return utils::StrIcaseEqual{}(TrimWhitespace(value), token);
+}
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include <userver/server/http/http_method.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+/// Returns the first control character of the data except the horizontal
+/// tab, or `end` if there are none. For valid HTTP/1 data it is the line end.
+///
+/// Uses AVX2 or SSE2 when the build target supports them.
+const char* FindControlChar(const char* begin, const char* end) noexcept;
+
+/// Non-vectorized FindControlChar, for the data tails and for testing
+const char* FindControlCharScalar(const char* begin, const char* end) noexcept;
+
+struct RequestLine {
+  std::string_view method;
+  std::string_view url;
+  unsigned short http_major{0};
+  unsigned short http_minor{0};
+};
+
+/// Parses `method SP request-target SP HTTP-version` without the line end.
+/// The result refers to the line data.
+std::optional<RequestLine> ParseRequestLine(std::string_view line);
+
+struct HeaderLine {
+  std::string_view name;
+  std::string_view value;
+};
+
+/// Parses `field-name ":" OWS field-value OWS` without the line end.
+/// The result refers to the line data.
+std::optional<HeaderLine> ParseHeaderLine(std::string_view line);
+
+/// Parses the chunk size line of the chunked transfer coding, the chunk
+/// extensions are ignored
+std::optional<std::uint64_t> ParseChunkSize(std::string_view line);
+
+std::optional<std::uint64_t> ParseContentLength(std::string_view value);
+
+HttpMethod ParseMethod(std::string_view method);
+
+/// Checks whether a comma separated header value contains the token,
+/// case insensitive
+bool HasToken(std::string_view value, std::string_view token);
+
+/// Checks whether the last token of a comma separated header value is the
+/// token, case insensitive
+bool EndsWithToken(std::string_view value, std::string_view token);
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
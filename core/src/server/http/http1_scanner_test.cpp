@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+
+#include <server/http/http1_scanner.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace impl = server::http::impl;
+
+TEST(Http1Scanner, FindControlChar) {
+  std::minstd_rand rng(42);
+  for (int i = 0; i < 10000; ++i) {
+    std::string data(rng() % 100, 'a');
+    for (auto& c : data) {
+      const auto kind = rng() % 40;
+      if (kind == 0) {
+        c = static_cast<char>(rng() % 256);
+      } else if (kind == 1) {
+        c = '\t';
+      } else {
+        c = static_cast<char>(' ' + rng() % 95);
+      }
+    }
+
+    const char* const end = data.data() + data.size();
+    for (std::size_t offset = 0; offset <= data.size(); offset += 7) {
+      const char* const begin = data.data() + offset;
+      ASSERT_EQ(impl::FindControlChar(begin, end),
+                impl::FindControlCharScalar(begin, end))
+          << data;
+    }
+  }
+
+  const std::string line = std::string(40, 'x') + "\t\x7f\r\n";
+  EXPECT_EQ(impl::FindControlChar(line.data(), line.data() + line.size()),
+            line.data() + 41);
+}
+
+TEST(Http1Scanner, RequestLine) {
+  const auto request_line = impl::ParseRequestLine("GET /a?b=c HTTP/1.0");
+  ASSERT_TRUE(request_line);
+  EXPECT_EQ(request_line->method, "GET");
+  EXPECT_EQ(request_line->url, "/a?b=c");
+  EXPECT_EQ(request_line->http_major, 1);
+  EXPECT_EQ(request_line->http_minor, 0);
+
+  EXPECT_FALSE(impl::ParseRequestLine("GET  HTTP/1.1"));
+  EXPECT_FALSE(impl::ParseRequestLine(" / HTTP/1.1"));
+  EXPECT_FALSE(impl::ParseRequestLine("GET / HTTP/1.10"));
+  EXPECT_FALSE(impl::ParseRequestLine("GET / http/1.1"));
+  EXPECT_FALSE(impl::ParseRequestLine("GET /"));
+}
+
+TEST(Http1Scanner, HeaderLine) {
+  const auto header = impl::ParseHeaderLine("X-Name: \t value  with spaces \t");
+  ASSERT_TRUE(header);
+  EXPECT_EQ(header->name, "X-Name");
+  EXPECT_EQ(header->value, "value  with spaces");
+
+  EXPECT_EQ(impl::ParseHeaderLine("X-Empty:")->value, "");
+  EXPECT_FALSE(impl::ParseHeaderLine("X-Name : value"));
+  EXPECT_FALSE(impl::ParseHeaderLine(": value"));
+  EXPECT_FALSE(impl::ParseHeaderLine("no colon"));
+}
+
+TEST(Http1Scanner, Sizes) {
+  EXPECT_EQ(impl::ParseChunkSize("1aF"), 0x1af);
+  EXPECT_EQ(impl::ParseChunkSize("10 ;name=value"), 16);
+  EXPECT_FALSE(impl::ParseChunkSize(""));
+  EXPECT_FALSE(impl::ParseChunkSize("10x"));
+  EXPECT_FALSE(impl::ParseChunkSize("1234567890abcdef"));
+
+  EXPECT_EQ(impl::ParseContentLength("0"), 0);
+  EXPECT_EQ(impl::ParseContentLength("1048576"), 1048576);
+  EXPECT_FALSE(impl::ParseContentLength(""));
+  EXPECT_FALSE(impl::ParseContentLength("-1"));
+  EXPECT_FALSE(impl::ParseContentLength("1 2"));
+}
+
+TEST(Http1Scanner, Tokens) {
+  EXPECT_TRUE(impl::HasToken("keep-alive, Upgrade", "upgrade"));
+  EXPECT_FALSE(impl::HasToken("keep-alive", "close"));
+  EXPECT_TRUE(impl::EndsWithToken("gzip, Chunked ", "chunked"));
+  EXPECT_FALSE(impl::EndsWithToken("chunked, gzip", "chunked"));
+
+  EXPECT_EQ(impl::ParseMethod("OPTIONS"), server::http::HttpMethod::kOptions);
+  EXPECT_EQ(impl::ParseMethod("get"), server::http::HttpMethod::kUnknown);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,396 @@
+#include "http2_session.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <nghttp2/nghttp2.h>
+
+#include <userver/logging/log.hpp>
+#include <userver/server/http/http_method.hpp>
+#include <userver/server/http/http_response.hpp>
+#include <userver/server/request/request_base.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+constexpr std::string_view kClientPreface{NGHTTP2_CLIENT_MAGIC,
+                                          NGHTTP2_CLIENT_MAGIC_LEN};
+
+constexpr std::string_view kCookieHeader = "cookie";
+constexpr std::string_view kHostHeader = "host";
+
+std::string_view ToStringView(const std::uint8_t* data, size_t size) {
+  return {reinterpret_cast<const char*>(data), size};
+}
+
+nghttp2_nv MakeNv(const std::string& name, const std::string& value) {
+  nghttp2_nv nv{};
+  // nghttp2 copies the header, so the const_cast is safe
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  nv.name = reinterpret_cast<std::uint8_t*>(const_cast<char*>(name.data()));
+  nv.namelen = name.size();
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  nv.value = reinterpret_cast<std::uint8_t*>(const_cast<char*>(value.data()));
+  nv.valuelen = value.size();
+  nv.flags = NGHTTP2_NV_FLAG_NONE;
+  return nv;
+}
+
+HttpMethod ParseMethod(std::string_view method) {
+  try {
+    return HttpMethodFromString(method);
+  } catch (const std::exception&) {
+    return HttpMethod::kUnknown;
+  }
+}
+
+bool IsRequestHeaders(const nghttp2_frame& frame) {
+  return frame.hd.type == NGHTTP2_HEADERS &&
+         frame.headers.cat == NGHTTP2_HCAT_REQUEST;
+}
+
+}  // namespace
+
+struct Http2Session::Stream {
+  Stream(const HttpRequestConstructor::Config& config,
+         const HandlerInfoIndex& handler_info_index,
+         request::ResponseDataAccounter& data_accounter) {
+    constructor.emplace(config, handler_info_index, data_accounter);
+  }
+
+  // Empty once the request is passed to the handler
+  std::optional<HttpRequestConstructor> constructor;
+  std::string method;
+  std::string authority;
+  // HTTP/2 allows splitting the cookie header into multiple fields
+  std::string cookie;
+  bool url_parsed{false};
+
+  // Keeps the response data alive until the body is sent
+  std::shared_ptr<request::RequestBase> request;
+  std::string_view body;
+};
+
+struct Http2Session::Callbacks {
+  static Http2Session& Self(void* user_data) {
+    UASSERT(user_data);
+    return *static_cast<Http2Session*>(user_data);
+  }
+
+  static int OnBeginHeaders(nghttp2_session*, const nghttp2_frame* frame,
+                            void* user_data) {
+    if (!IsRequestHeaders(*frame)) return 0;
+
+    auto& self = Self(user_data);
+    try {
+      self.streams_.emplace(
+          frame->hd.stream_id,
+          std::make_unique<Stream>(self.request_constructor_config_,
+                                   self.handler_info_index_,
+                                   self.data_accounter_));
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "can't create HTTP/2 stream: " << ex;
+      return NGHTTP2_ERR_CALLBACK_FAILURE;
+    }
+    ++self.stats_.parsing_request_count;
+    return 0;
+  }
+
+  static int OnHeader(nghttp2_session*, const nghttp2_frame* frame,
+                      const std::uint8_t* name, size_t namelen,
+                      const std::uint8_t* value, size_t valuelen,
+                      std::uint8_t /*flags*/, void* user_data) {
+    // Trailers are ignored
+    if (!IsRequestHeaders(*frame)) return 0;
+
+    auto& self = Self(user_data);
+    auto* stream = self.FindStream(frame->hd.stream_id);
+    if (!stream || !stream->constructor) return 0;
+
+    try {
+      self.OnHeaderImpl(*stream, ToStringView(name, namelen),
+                        ToStringView(value, valuelen));
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << "can't append header: " << ex;
+      self.FinalizeRequest(frame->hd.stream_id, *stream);
+    }
+    return 0;
+  }
+
+  static int OnDataChunk(nghttp2_session*, std::uint8_t /*flags*/,
+                         std::int32_t stream_id, const std::uint8_t* data,
+                         size_t len, void* user_data) {
+    auto& self = Self(user_data);
+    auto* stream = self.FindStream(stream_id);
+    if (!stream || !stream->constructor) return 0;
+
+    try {
+      stream->constructor->AppendBody(reinterpret_cast<const char*>(data),
+                                      len);
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << "can't append body: " << ex;
+      self.FinalizeRequest(stream_id, *stream);
+    }
+    return 0;
+  }
+
+  static int OnFrameRecv(nghttp2_session*, const nghttp2_frame* frame,
+                         void* user_data) {
+    if (frame->hd.type != NGHTTP2_HEADERS && frame->hd.type != NGHTTP2_DATA) {
+      return 0;
+    }
+
+    auto& self = Self(user_data);
+    auto* stream = self.FindStream(frame->hd.stream_id);
+    if (!stream || !stream->constructor) return 0;
+
+    if (IsRequestHeaders(*frame)) {
+      self.OnHeadersComplete(frame->hd.stream_id, *stream);
+    }
+    if (stream->constructor && (frame->hd.flags & NGHTTP2_FLAG_END_STREAM)) {
+      self.FinalizeRequest(frame->hd.stream_id, *stream);
+    }
+    return 0;
+  }
+
+  static int OnStreamClose(nghttp2_session*, std::int32_t stream_id,
+                           std::uint32_t error_code, void* user_data) {
+    auto& self = Self(user_data);
+    const auto it = self.streams_.find(stream_id);
+    if (it == self.streams_.end()) return 0;
+
+    if (it->second->constructor) {
+      --self.stats_.parsing_request_count;
+    }
+    if (error_code != NGHTTP2_NO_ERROR) {
+      LOG_DEBUG() << "HTTP/2 stream " << stream_id
+                  << " closed with error code " << error_code;
+    }
+    self.streams_.erase(it);
+    return 0;
+  }
+
+  static ssize_t ReadResponseBody(nghttp2_session*, std::int32_t stream_id,
+                                  std::uint8_t* buf, size_t length,
+                                  std::uint32_t* data_flags,
+                                  nghttp2_data_source*, void* user_data) {
+    auto* stream = Self(user_data).FindStream(stream_id);
+    if (!stream) return NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE;
+
+    auto& body = stream->body;
+    const auto size = std::min(length, body.size());
+    std::memcpy(buf, body.data(), size);
+    body.remove_prefix(size);
+    if (body.empty()) *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+    return static_cast<ssize_t>(size);
+  }
+};
+
+Http2Session::Http2Session(const HandlerInfoIndex& handler_info_index,
+                           const request::HttpRequestConfig& request_config,
+                           const Settings& settings,
+                           OnNewRequestCb&& on_new_request_cb,
+                           net::ParserStats& stats,
+                           request::ResponseDataAccounter& data_accounter)
+    : handler_info_index_(handler_info_index),
+      request_constructor_config_{request_config},
+      on_new_request_cb_(std::move(on_new_request_cb)),
+      stats_(stats),
+      data_accounter_(data_accounter) {
+  nghttp2_session_callbacks* callbacks = nullptr;
+  if (nghttp2_session_callbacks_new(&callbacks) != 0) {
+    throw std::runtime_error("can't allocate HTTP/2 session callbacks");
+  }
+  nghttp2_session_callbacks_set_on_begin_headers_callback(
+      callbacks, &Callbacks::OnBeginHeaders);
+  nghttp2_session_callbacks_set_on_header_callback(callbacks,
+                                                   &Callbacks::OnHeader);
+  nghttp2_session_callbacks_set_on_data_chunk_recv_callback(
+      callbacks, &Callbacks::OnDataChunk);
+  nghttp2_session_callbacks_set_on_frame_recv_callback(
+      callbacks, &Callbacks::OnFrameRecv);
+  nghttp2_session_callbacks_set_on_stream_close_callback(
+      callbacks, &Callbacks::OnStreamClose);
+
+  const int rv = nghttp2_session_server_new(&session_, callbacks, this);
+  nghttp2_session_callbacks_del(callbacks);
+  if (rv != 0) {
+    throw std::runtime_error(std::string{"can't create HTTP/2 session: "} +
+                             nghttp2_strerror(rv));
+  }
+
+  const nghttp2_settings_entry entries[] = {
+      {NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS,
+       settings.max_concurrent_streams},
+  };
+  nghttp2_submit_settings(session_, NGHTTP2_FLAG_NONE, entries,
+                          std::size(entries));
+}
+
+Http2Session::~Http2Session() {
+  nghttp2_session_del(session_);
+  for (const auto& [stream_id, stream] : streams_) {
+    if (stream->constructor) --stats_.parsing_request_count;
+  }
+}
+
+Http2Session::PrefaceMatch Http2Session::MatchPreface(std::string_view data) {
+  const auto size = std::min(data.size(), kClientPreface.size());
+  if (data.substr(0, size) != kClientPreface.substr(0, size)) {
+    return PrefaceMatch::kMismatch;
+  }
+  return size == kClientPreface.size() ? PrefaceMatch::kMatch
+                                       : PrefaceMatch::kPartial;
+}
+
+bool Http2Session::Parse(const char* data, size_t size) {
+  const auto rv = nghttp2_session_mem_recv(
+      session_, reinterpret_cast<const std::uint8_t*>(data), size);
+  if (rv < 0) {
+    LOG_WARNING() << "HTTP/2 session error: "
+                  << nghttp2_strerror(static_cast<int>(rv));
+    return false;
+  }
+  return true;
+}
+
+void Http2Session::SubmitResponse(
+    std::int32_t stream_id, std::shared_ptr<request::RequestBase> request,
+    impl::Http2ResponseData response) {
+  auto* stream = FindStream(stream_id);
+  if (!stream) {
+    LOG_DEBUG() << "HTTP/2 stream " << stream_id
+                << " was closed by peer before the response";
+    return;
+  }
+
+  std::vector<nghttp2_nv> headers;
+  headers.reserve(response.headers.size());
+  for (const auto& [name, value] : response.headers) {
+    headers.push_back(MakeNv(name, value));
+  }
+
+  nghttp2_data_provider body_provider{};
+  body_provider.read_callback = &Callbacks::ReadResponseBody;
+  stream->request = std::move(request);
+  stream->body = response.body;
+
+  const int rv = nghttp2_submit_response(
+      session_, stream_id, headers.data(), headers.size(),
+      response.body.empty() ? nullptr : &body_provider);
+  if (rv != 0) {
+    LOG_WARNING() << "can't submit HTTP/2 response: " << nghttp2_strerror(rv);
+    nghttp2_submit_rst_stream(session_, NGHTTP2_FLAG_NONE, stream_id,
+                              NGHTTP2_INTERNAL_ERROR);
+  }
+}
+
+void Http2Session::CollectOutput(std::string& output) {
+  while (true) {
+    const std::uint8_t* data = nullptr;
+    const auto size = nghttp2_session_mem_send(session_, &data);
+    if (size < 0) {
+      throw std::runtime_error(
+          std::string{"HTTP/2 session error: "} +
+          nghttp2_strerror(static_cast<int>(size)));
+    }
+    if (size == 0) break;
+    output.append(reinterpret_cast<const char*>(data), size);
+  }
+}
+
+bool Http2Session::IsAlive() const {
+  return nghttp2_session_want_read(session_) ||
+         nghttp2_session_want_write(session_);
+}
+
+Http2Session::Stream* Http2Session::FindStream(std::int32_t stream_id) {
+  const auto it = streams_.find(stream_id);
+  return it == streams_.end() ? nullptr : it->second.get();
+}
+
+void Http2Session::OnHeaderImpl(Stream& stream, std::string_view name,
+                                std::string_view value) {
+  auto& constructor = *stream.constructor;
+  if (!name.empty() && name[0] == ':') {
+    if (name == ":method") {
+      stream.method = value;
+    } else if (name == ":path") {
+      constructor.AppendUrl(value.data(), value.size());
+    } else if (name == ":authority") {
+      stream.authority = value;
+    }
+    return;
+  }
+
+  if (!stream.url_parsed) ParseUrl(stream);
+
+  if (name == kCookieHeader) {
+    if (!stream.cookie.empty()) stream.cookie += "; ";
+    stream.cookie += value;
+    return;
+  }
+  constructor.AppendHeaderField(name.data(), name.size());
+  constructor.AppendHeaderValue(value.data(), value.size());
+}
+
+void Http2Session::OnHeadersComplete(std::int32_t stream_id,
+                                     Stream& stream) {
+  try {
+    if (!stream.url_parsed) ParseUrl(stream);
+
+    auto& constructor = *stream.constructor;
+    if (!stream.cookie.empty()) {
+      constructor.AppendHeaderField(kCookieHeader.data(), kCookieHeader.size());
+      constructor.AppendHeaderValue(stream.cookie.data(), stream.cookie.size());
+    }
+    constructor.AppendHeaderField("", 0);
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't complete headers: " << ex;
+    FinalizeRequest(stream_id, stream);
+  }
+}
+
+void Http2Session::ParseUrl(Stream& stream) {
+  stream.url_parsed = true;
+
+  auto& constructor = *stream.constructor;
+  constructor.SetMethod(ParseMethod(stream.method));
+  constructor.SetHttpMajor(2);
+  constructor.SetHttpMinor(0);
+  constructor.ParseUrl();
+
+  // For compatibility with HTTP/1.1 handlers, see RFC 9113 8.3.1
+  if (!stream.authority.empty()) {
+    constructor.AppendHeaderField(kHostHeader.data(), kHostHeader.size());
+    constructor.AppendHeaderValue(stream.authority.data(),
+                                  stream.authority.size());
+  }
+}
+
+void Http2Session::FinalizeRequest(std::int32_t stream_id, Stream& stream) {
+  UASSERT(stream.constructor);
+  stream.constructor->SetIsFinal(false);
+  auto request = stream.constructor->Finalize();
+  stream.constructor.reset();
+  --stats_.parsing_request_count;
+
+  if (request) {
+    on_new_request_cb_(stream_id, std::move(request));
+  } else {
+    LOG_ERROR() << "request is null after Finalize()";
+    nghttp2_submit_rst_stream(session_, NGHTTP2_FLAG_NONE, stream_id,
+                              NGHTTP2_INTERNAL_ERROR);
+  }
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
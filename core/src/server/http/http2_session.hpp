@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <server/net/stats.hpp>
+#include <server/request/request_parser.hpp>
+
+#include <userver/server/http/http_response.hpp>
+#include <userver/server/request/request_config.hpp>
+
+#include "http_request_constructor.hpp"
+
+struct nghttp2_session;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// Server side of an HTTP/2 connection: decodes frames and HPACK headers of
+/// the client streams into requests and encodes responses into frames.
+///
+/// Not thread-safe, the owner must serialize all the calls.
+class Http2Session final : public request::RequestParser {
+ public:
+  using OnNewRequestCb = std::function<void(
+      std::int32_t stream_id, std::shared_ptr<request::RequestBase>&&)>;
+
+  enum class PrefaceMatch { kMatch, kPartial, kMismatch };
+
+  struct Settings {
+    std::uint32_t max_concurrent_streams{100};
+  };
+
+  Http2Session(const HandlerInfoIndex& handler_info_index,
+               const request::HttpRequestConfig& request_config,
+               const Settings& settings, OnNewRequestCb&& on_new_request_cb,
+               net::ParserStats& stats,
+               request::ResponseDataAccounter& data_accounter);
+  ~Http2Session() override;
+
+  /// Checks whether the connection data starts with the HTTP/2 client
+  /// connection preface (prior knowledge h2c)
+  static PrefaceMatch MatchPreface(std::string_view data);
+
+  /// Processes the data received from the peer, returns false on a
+  /// connection error
+  bool Parse(const char* data, size_t size) override;
+
+  /// Sends the response of the stream. The request is kept alive until the
+  /// stream is closed, as the response body is sent from its data.
+  void SubmitResponse(std::int32_t stream_id,
+                      std::shared_ptr<request::RequestBase> request,
+                      impl::Http2ResponseData response);
+
+  /// Appends the frames that are ready to be sent to the peer
+  void CollectOutput(std::string& output);
+
+  /// Whether the session still expects to read or write any frames
+  bool IsAlive() const;
+
+ private:
+  struct Stream;
+
+  // nghttp2 callbacks
+  struct Callbacks;
+
+  Stream* FindStream(std::int32_t stream_id);
+  void OnHeaderImpl(Stream& stream, std::string_view name,
+                    std::string_view value);
+  void OnHeadersComplete(std::int32_t stream_id, Stream& stream);
+  void ParseUrl(Stream& stream);
+  void FinalizeRequest(std::int32_t stream_id, Stream& stream);
+
+  const HandlerInfoIndex& handler_info_index_;
+  const HttpRequestConstructor::Config request_constructor_config_;
+  OnNewRequestCb on_new_request_cb_;
+  net::ParserStats& stats_;
+  request::ResponseDataAccounter& data_accounter_;
+
+  nghttp2_session* session_{nullptr};
+  std::unordered_map<std::int32_t, std::unique_ptr<Stream>> streams_;
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
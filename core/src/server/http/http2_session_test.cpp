@@ -0,0 +1,303 @@
+#include <userver/utest/utest.hpp>
+
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <nghttp2/nghttp2.h>
+
+#include <userver/server/http/http_request.hpp>
+
+#include <server/http/http2_session.hpp>
+#include <server/http/http_request_impl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using RequestBasePtr = std::shared_ptr<server::request::RequestBase>;
+
+struct Response {
+  std::map<std::string, std::string> headers;
+  std::string body;
+  bool is_closed{false};
+};
+
+// Minimal nghttp2 client to encode requests and decode responses
+class TestClient final {
+ public:
+  TestClient() {
+    nghttp2_session_callbacks* callbacks = nullptr;
+    nghttp2_session_callbacks_new(&callbacks);
+    nghttp2_session_callbacks_set_on_header_callback(callbacks, &OnHeader);
+    nghttp2_session_callbacks_set_on_data_chunk_recv_callback(callbacks,
+                                                              &OnDataChunk);
+    nghttp2_session_callbacks_set_on_stream_close_callback(callbacks,
+                                                           &OnStreamClose);
+    nghttp2_session_client_new(&session_, callbacks, this);
+    nghttp2_session_callbacks_del(callbacks);
+    nghttp2_submit_settings(session_, NGHTTP2_FLAG_NONE, nullptr, 0);
+  }
+
+  ~TestClient() { nghttp2_session_del(session_); }
+
+  std::int32_t SubmitRequest(
+      const std::vector<std::pair<std::string, std::string>>& headers,
+      std::string body = {}) {
+    std::vector<nghttp2_nv> nva;
+    for (const auto& [name, value] : headers) {
+      nghttp2_nv nv{};
+      nv.name = reinterpret_cast<std::uint8_t*>(const_cast<char*>(name.data()));
+      nv.namelen = name.size();
+      nv.value =
+          reinterpret_cast<std::uint8_t*>(const_cast<char*>(value.data()));
+      nv.valuelen = value.size();
+      nva.push_back(nv);
+    }
+
+    body_ = std::move(body);
+    nghttp2_data_provider provider{};
+    provider.read_callback = &ReadBody;
+    return nghttp2_submit_request(session_, nullptr, nva.data(), nva.size(),
+                                  body_.empty() ? nullptr : &provider, this);
+  }
+
+  std::string CollectOutput() {
+    std::string output;
+    const std::uint8_t* data = nullptr;
+    while (const auto size = nghttp2_session_mem_send(session_, &data)) {
+      EXPECT_GT(size, 0);
+      if (size < 0) break;
+      output.append(reinterpret_cast<const char*>(data), size);
+    }
+    return output;
+  }
+
+  void Receive(const std::string& data) {
+    EXPECT_EQ(nghttp2_session_mem_recv(
+                  session_, reinterpret_cast<const std::uint8_t*>(data.data()),
+                  data.size()),
+              static_cast<ssize_t>(data.size()));
+  }
+
+  Response& GetResponse(std::int32_t stream_id) {
+    return responses_[stream_id];
+  }
+
+ private:
+  static TestClient& Self(void* user_data) {
+    return *static_cast<TestClient*>(user_data);
+  }
+
+  static int OnHeader(nghttp2_session*, const nghttp2_frame* frame,
+                      const std::uint8_t* name, size_t namelen,
+                      const std::uint8_t* value, size_t valuelen,
+                      std::uint8_t /*flags*/, void* user_data) {
+    Self(user_data).responses_[frame->hd.stream_id].headers.emplace(
+        std::string(reinterpret_cast<const char*>(name), namelen),
+        std::string(reinterpret_cast<const char*>(value), valuelen));
+    return 0;
+  }
+
+  static int OnDataChunk(nghttp2_session*, std::uint8_t /*flags*/,
+                         std::int32_t stream_id, const std::uint8_t* data,
+                         size_t len, void* user_data) {
+    Self(user_data).responses_[stream_id].body.append(
+        reinterpret_cast<const char*>(data), len);
+    return 0;
+  }
+
+  static int OnStreamClose(nghttp2_session*, std::int32_t stream_id,
+                           std::uint32_t /*error_code*/, void* user_data) {
+    Self(user_data).responses_[stream_id].is_closed = true;
+    return 0;
+  }
+
+  static ssize_t ReadBody(nghttp2_session*, std::int32_t /*stream_id*/,
+                          std::uint8_t* buf, size_t length,
+                          std::uint32_t* data_flags, nghttp2_data_source*,
+                          void* user_data) {
+    auto& body = Self(user_data).body_;
+    const auto size = std::min(length, body.size());
+    std::memcpy(buf, body.data(), size);
+    body.erase(0, size);
+    if (body.empty()) *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+    return static_cast<ssize_t>(size);
+  }
+
+  nghttp2_session* session_{nullptr};
+  std::string body_;
+  std::map<std::int32_t, Response> responses_;
+};
+
+server::http::Http2Session CreateTestSession(
+    server::http::Http2Session::OnNewRequestCb&& cb) {
+  static const server::http::HandlerInfoIndex kTestHandlerInfoIndex;
+  static constexpr server::request::HttpRequestConfig kTestRequestConfig{
+      /*.max_url_size = */ 8192,
+      /*.max_request_size = */ 1024 * 1024,
+      /*.max_headers_size = */ 65536,
+      /*.parse_args_from_body = */ false,
+      /*.testing_mode = */ true,  // non default value
+      /*.decompress_request = */ false,
+  };
+  static server::net::ParserStats test_stats;
+  static server::request::ResponseDataAccounter test_accounter;
+  return server::http::Http2Session(kTestHandlerInfoIndex, kTestRequestConfig,
+                                    {}, std::move(cb), test_stats,
+                                    test_accounter);
+}
+
+}  // namespace
+
+TEST(Http2Session, MatchPreface) {
+  using PrefaceMatch = server::http::Http2Session::PrefaceMatch;
+  using server::http::Http2Session;
+
+  const std::string preface{NGHTTP2_CLIENT_MAGIC, NGHTTP2_CLIENT_MAGIC_LEN};
+  EXPECT_EQ(Http2Session::MatchPreface(preface), PrefaceMatch::kMatch);
+  EXPECT_EQ(Http2Session::MatchPreface(preface + "frames"),
+            PrefaceMatch::kMatch);
+  EXPECT_EQ(Http2Session::MatchPreface("PRI * HTTP/2"), PrefaceMatch::kPartial);
+  EXPECT_EQ(Http2Session::MatchPreface("P"), PrefaceMatch::kPartial);
+  EXPECT_EQ(Http2Session::MatchPreface("POST / HTTP/1.1\r\n"),
+            PrefaceMatch::kMismatch);
+  EXPECT_EQ(Http2Session::MatchPreface("GET / HTTP/1.1\r\n"),
+            PrefaceMatch::kMismatch);
+}
+
+UTEST(Http2Session, Requests) {
+  std::vector<std::pair<std::int32_t, RequestBasePtr>> requests;
+  auto session =
+      CreateTestSession([&requests](std::int32_t stream_id,
+                                    RequestBasePtr&& request) {
+        requests.emplace_back(stream_id, std::move(request));
+      });
+
+  TestClient client;
+  const auto get_id = client.SubmitRequest({{":method", "GET"},
+                                            {":scheme", "http"},
+                                            {":authority", "example.com"},
+                                            {":path", "/get?arg=value"},
+                                            {"cookie", "a=1"},
+                                            {"x-header", "header value"},
+                                            {"cookie", "b=2"}});
+  const auto post_id = client.SubmitRequest({{":method", "POST"},
+                                             {":scheme", "http"},
+                                             {":authority", "example.com"},
+                                             {":path", "/post"}},
+                                            "request body");
+  ASSERT_GT(get_id, 0);
+  ASSERT_GT(post_id, 0);
+
+  const auto data = client.CollectOutput();
+  EXPECT_EQ(server::http::Http2Session::MatchPreface(data),
+            server::http::Http2Session::PrefaceMatch::kMatch);
+  ASSERT_TRUE(session.Parse(data.data(), data.size()));
+  ASSERT_EQ(requests.size(), 2);
+
+  {
+    EXPECT_EQ(requests[0].first, get_id);
+    auto& impl =
+        dynamic_cast<server::http::HttpRequestImpl&>(*requests[0].second);
+    const server::http::HttpRequest request(impl);
+    EXPECT_EQ(request.GetMethod(), server::http::HttpMethod::kGet);
+    EXPECT_EQ(request.GetHttpMajor(), 2);
+    EXPECT_EQ(request.GetRequestPath(), "/get");
+    EXPECT_EQ(request.GetArg("arg"), "value");
+    EXPECT_EQ(request.GetHost(), "example.com");
+    EXPECT_EQ(request.GetHeader("X-Header"), "header value");
+    EXPECT_EQ(request.GetCookie("a"), "1");
+    EXPECT_EQ(request.GetCookie("b"), "2");
+    EXPECT_TRUE(request.RequestBody().empty());
+  }
+  {
+    EXPECT_EQ(requests[1].first, post_id);
+    auto& impl =
+        dynamic_cast<server::http::HttpRequestImpl&>(*requests[1].second);
+    const server::http::HttpRequest request(impl);
+    EXPECT_EQ(request.GetMethod(), server::http::HttpMethod::kPost);
+    EXPECT_EQ(request.GetRequestPath(), "/post");
+    EXPECT_EQ(request.RequestBody(), "request body");
+  }
+}
+
+UTEST(Http2Session, Responses) {
+  std::vector<std::pair<std::int32_t, RequestBasePtr>> requests;
+  auto session =
+      CreateTestSession([&requests](std::int32_t stream_id,
+                                    RequestBasePtr&& request) {
+        requests.emplace_back(stream_id, std::move(request));
+      });
+
+  TestClient client;
+  for (int i = 0; i < 2; ++i) {
+    client.SubmitRequest({{":method", "GET"},
+                          {":scheme", "http"},
+                          {":authority", "example.com"},
+                          {":path", "/"}});
+  }
+  auto data = client.CollectOutput();
+  ASSERT_TRUE(session.Parse(data.data(), data.size()));
+  ASSERT_EQ(requests.size(), 2);
+
+  // Responses are sent in the order of readiness, not in the request order
+  const std::string body = "response body";
+  server::http::impl::Http2ResponseData response_data;
+  response_data.headers = {{":status", "200"}, {"x-header", "value"}};
+  response_data.body = body;
+  session.SubmitResponse(requests[1].first, requests[1].second,
+                         std::move(response_data));
+
+  std::string output;
+  session.CollectOutput(output);
+  client.Receive(output);
+
+  const auto& second = client.GetResponse(requests[1].first);
+  EXPECT_TRUE(second.is_closed);
+  EXPECT_EQ(second.headers.at(":status"), "200");
+  EXPECT_EQ(second.headers.at("x-header"), "value");
+  EXPECT_EQ(second.body, body);
+  EXPECT_FALSE(client.GetResponse(requests[0].first).is_closed);
+
+  server::http::impl::Http2ResponseData empty_response;
+  empty_response.headers = {{":status", "204"}};
+  session.SubmitResponse(requests[0].first, requests[0].second,
+                         std::move(empty_response));
+
+  output.clear();
+  session.CollectOutput(output);
+  client.Receive(output);
+
+  const auto& first = client.GetResponse(requests[0].first);
+  EXPECT_TRUE(first.is_closed);
+  EXPECT_EQ(first.headers.at(":status"), "204");
+  EXPECT_TRUE(first.body.empty());
+  EXPECT_TRUE(session.IsAlive());
+}
+
+UTEST(Http2Session, MalformedFrames) {
+  const auto no_requests = [](std::int32_t, RequestBasePtr&&) {
+    ADD_FAILURE() << "no requests expected";
+  };
+  const std::string preface{NGHTTP2_CLIENT_MAGIC, NGHTTP2_CLIENT_MAGIC_LEN};
+
+  {
+    auto session = CreateTestSession(no_requests);
+    const std::string data = "PRI * HTTP/2.0\r\n\r\nXX\r\n\r\n";
+    EXPECT_FALSE(session.Parse(data.data(), data.size()));
+  }
+  {
+    // Protocol errors are reported to the peer with GOAWAY
+    auto session = CreateTestSession(no_requests);
+    const auto data = preface + "definitely not an HTTP/2 frame";
+    EXPECT_TRUE(session.Parse(data.data(), data.size()));
+    std::string output;
+    session.CollectOutput(output);
+    EXPECT_FALSE(output.empty());
+    EXPECT_FALSE(session.IsAlive());
+  }
+}
+
+USERVER_NAMESPACE_END
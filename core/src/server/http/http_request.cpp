@@ -151,6 +151,10 @@ void HttpRequest::SetResponseStatus(HttpStatus status) const {
 
 bool HttpRequest::IsBodyCompressed() const { return impl_.IsBodyCompressed(); }
 
+std::pmr::memory_resource& HttpRequest::GetMemoryResource() const {
+  return impl_.GetArena();
+}
+
 }  // namespace server::http
 
 USERVER_NAMESPACE_END
@@ -159,6 +159,21 @@ void HttpRequestConstructor::AppendHeaderValue(const char* data, size_t size) {
   header_value_.append(data, size);
 }
 
+void HttpRequestConstructor::AppendHeader(std::string_view name,
+                                          std::string_view value) {
+  UASSERT(!header_field_flag_);
+
+  AccountHeadersSize(name.size() + value.size());
+  AccountRequestSize(name.size() + value.size());
+
+  auto [it, is_inserted] =
+      request_->headers_.try_emplace(std::string{name}, value);
+  if (!is_inserted) {
+    it->second += ',';
+    it->second += value;
+  }
+}
+
 void HttpRequestConstructor::AppendBody(const char* data, size_t size) {
   AccountRequestSize(size);
   request_->request_body_.append(data, size);
@@ -240,8 +255,12 @@ void HttpRequestConstructor::ParseArgs(const http_parser_url& url) {
 }
 
 void HttpRequestConstructor::ParseArgs(const char* data, size_t size) {
-  return USERVER_NAMESPACE::http::parser::ParseArgs(
-      std::string_view(data, size), request_->request_args_);
+  USERVER_NAMESPACE::http::parser::ParseAndConsumeArgs(
+      std::string_view(data, size),
+      [&args = request_->request_args_](std::string&& key,
+                                        std::string&& value) {
+        args[std::move(key)].push_back(std::move(value));
+      });
 }
 
 void HttpRequestConstructor::AddHeader() {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <string_view>
 
 #include <http_parser.h>
 
@@ -50,6 +51,9 @@ class HttpRequestConstructor final : public request::RequestConstructor {
   void ParseUrl();
   void AppendHeaderField(const char* data, size_t size);
   void AppendHeaderValue(const char* data, size_t size);
+  // Adds a whole header at once, must not be mixed with AppendHeaderField()
+  // and AppendHeaderValue()
+  void AppendHeader(std::string_view name, std::string_view value);
   void AppendBody(const char* data, size_t size);
 
   void SetIsFinal(bool is_final);
@@ -1,5 +1,9 @@
 #include <benchmark/benchmark.h>
 
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include <server/http/http_request_constructor.hpp>
 #include <utils/gbench_auxilary.hpp>
 
@@ -16,9 +20,37 @@ void http_request_constructor_url_decode(benchmark::State& state) {
   for (auto _ : state)
     benchmark::DoNotOptimize(USERVER_NAMESPACE::http::parser::UrlDecode(input));
 }
+
+void http_request_constructor_append_headers(benchmark::State& state) {
+  const server::http::HandlerInfoIndex handler_info_index;
+  server::request::ResponseDataAccounter data_accounter;
+  std::vector<std::string> names;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    names.push_back("X-Test-Header-" + std::to_string(i));
+  }
+  const std::string_view value = "some reasonably long header value";
+  const bool is_whole_header = state.range(1);
+
+  for (auto _ : state) {
+    server::http::HttpRequestConstructor constructor(
+        {}, handler_info_index, data_accounter);
+    for (const auto& name : names) {
+      if (is_whole_header) {
+        constructor.AppendHeader(name, value);
+      } else {
+        constructor.AppendHeaderField(name.data(), name.size());
+        constructor.AppendHeaderValue(value.data(), value.size());
+      }
+    }
+    if (!is_whole_header) constructor.AppendHeaderField("", 0);
+    benchmark::DoNotOptimize(constructor);
+  }
+}
 }  // namespace
 BENCHMARK(http_request_constructor_url_decode)
     ->RangeMultiplier(2)
     ->Range(1, 1024);
+BENCHMARK(http_request_constructor_append_headers)
+    ->ArgsProduct({{1, 8, 32}, {false, true}});
 
 USERVER_NAMESPACE_END
@@ -170,10 +170,11 @@ engine::TaskWithResult<void> HttpRequestHandler::StartRequestTask(
     http_response.SetStreamBody();
   }
 
-  auto payload = [request = std::move(request), handler] {
+  auto& arena = http_request.GetArena();
+  auto payload = [request = std::move(request), handler, &arena] {
     request->SetTaskStartTime();
 
-    request::RequestContext context;
+    request::RequestContext context{arena};
     handler->HandleRequest(*request, context);
 
     const auto now = std::chrono::steady_clock::now();
@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -14,6 +15,8 @@
 #include <userver/server/request/request_base.hpp>
 #include <userver/utils/datetime/wall_coarse_clock.hpp>
 
+#include "request_arena.hpp"
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server {
@@ -115,9 +118,15 @@ class HttpRequestImpl final : public request::RequestBase {
 
   void SetHttpHandlerStatistics(handlers::HttpRequestStatistics&);
 
+  /// Memory of the request that is released when the request is destroyed
+  std::pmr::memory_resource& GetArena() const { return arena_; }
+
   friend class HttpRequestConstructor;
 
  private:
+  // Must outlive the members that allocate from it
+  mutable RequestArena arena_;
+
   // method_ = (orig_method_ == kHead ? kGet : orig_method_)
   HttpMethod method_{HttpMethod::kUnknown};
   HttpMethod orig_method_{HttpMethod::kUnknown};
@@ -127,10 +136,13 @@ class HttpRequestImpl final : public request::RequestBase {
   std::string request_path_;
   std::string request_body_;
   std::string path_suffix_;
-  std::unordered_map<std::string, std::vector<std::string>> request_args_;
+  // The pmr containers allocate their nodes and arrays from the arena. The
+  // strings in them are returned by reference from HttpRequest, so their
+  // buffers are still allocated by std::allocator.
+  std::pmr::unordered_map<std::string, std::vector<std::string>> request_args_;
   std::unordered_map<std::string, std::vector<FormDataArg>> form_data_args_;
-  std::vector<std::string> path_args_;
-  std::unordered_map<std::string, size_t> path_args_by_name_index_;
+  std::pmr::vector<std::string> path_args_;
+  std::pmr::unordered_map<std::string, size_t> path_args_by_name_index_;
   HttpRequest::HeadersMap headers_;
   HttpRequest::CookiesMap cookies_;
   bool is_final_{false};
@@ -1,9 +1,14 @@
 #include "http_request_parser.hpp"
 
+#include <algorithm>
+
 #include <userver/logging/log.hpp>
 #include <userver/server/http/http_method.hpp>
 #include <userver/server/request/request_base.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/str_icase.hpp>
+
+#include "http1_scanner.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
@@ -11,43 +16,16 @@ namespace server::http {
 
 namespace {
 
-HttpMethod ConvertHttpMethod(http_method method) {
-  switch (method) {
-    case HTTP_DELETE:
-      return HttpMethod::kDelete;
-    case HTTP_GET:
-      return HttpMethod::kGet;
-    case HTTP_HEAD:
-      return HttpMethod::kHead;
-    case HTTP_POST:
-      return HttpMethod::kPost;
-    case HTTP_PUT:
-      return HttpMethod::kPut;
-    case HTTP_CONNECT:
-      return HttpMethod::kConnect;
-    case HTTP_PATCH:
-      return HttpMethod::kPatch;
-    case HTTP_OPTIONS:
-      return HttpMethod::kOptions;
-    default:
-      return HttpMethod::kUnknown;
-  }
+// Method, version and separators of the request line
+constexpr std::size_t kRequestLineOverhead = 64;
+
+bool IsHeader(std::string_view name, std::string_view expected) {
+  return name.size() == expected.size() &&
+         utils::StrIcaseEqual{}(name, expected);
 }
 
 }  // namespace
 
-const http_parser_settings HttpRequestParser::parser_settings = []() {
-  http_parser_settings settings{};
-  settings.on_message_begin = HttpRequestParser::OnMessageBegin;
-  settings.on_url = HttpRequestParser::OnUrl;
-  settings.on_header_field = HttpRequestParser::OnHeaderField;
-  settings.on_header_value = HttpRequestParser::OnHeaderValue;
-  settings.on_headers_complete = HttpRequestParser::OnHeadersComplete;
-  settings.on_body = HttpRequestParser::OnBody;
-  settings.on_message_complete = HttpRequestParser::OnMessageComplete;
-  return settings;
-}();
-
 HttpRequestParser::HttpRequestParser(
     const HandlerInfoIndex& handler_info_index,
     const request::HttpRequestConfig& request_config,
@@ -57,182 +35,291 @@ HttpRequestParser::HttpRequestParser(
       request_constructor_config_{request_config},
       on_new_request_cb_(std::move(on_new_request_cb)),
       stats_(stats),
-      data_accounter_(data_accounter) {
-  http_parser_init(&parser_, HTTP_REQUEST);
-  parser_.data = this;
-}
+      data_accounter_(data_accounter) {}
 
 bool HttpRequestParser::Parse(const char* data, size_t size) {
-  size_t parsed = http_parser_execute(&parser_, &parser_settings, data, size);
-  if (parsed != size) {
-    LOG_WARNING() << "parsed=" << parsed << " size=" << size
-                  << " error_description="
-                  << http_errno_description(HTTP_PARSER_ERRNO(&parser_));
-    FinalizeRequest();
-    return false;
-  }
-  if (parser_.upgrade) {
-    LOG_WARNING() << "upgrade detected";
-    FinalizeRequest();
-    return false;
+  std::string_view input{data, size};
+  while (!input.empty()) {
+    if (state_ == State::kBody || state_ == State::kChunkData) {
+      const auto body_size = static_cast<std::size_t>(
+          std::min<std::uint64_t>(body_bytes_left_, input.size()));
+      if (!OnBody(input.substr(0, body_size))) return false;
+      input.remove_prefix(body_size);
+      body_bytes_left_ -= body_size;
+
+      if (body_bytes_left_ == 0) {
+        if (state_ == State::kChunkData) {
+          state_ = State::kChunkDataEnd;
+        } else if (!OnMessageComplete()) {
+          return false;
+        }
+      }
+      continue;
+    }
+
+    std::string_view line;
+    switch (ReadLine(input, line)) {
+      case LineStatus::kIncomplete:
+        return true;
+      case LineStatus::kError:
+        return OnError("malformed or too long line");
+      case LineStatus::kComplete:
+        break;
+    }
+
+    const bool is_ok = OnLine(line);
+    partial_line_.clear();
+    if (!is_ok) return false;
   }
   return true;
 }
 
-int HttpRequestParser::OnMessageBegin(http_parser* p) {
-  auto* http_request_parser = static_cast<HttpRequestParser*>(p->data);
-  UASSERT(http_request_parser != nullptr);
-  return http_request_parser->OnMessageBeginImpl(p);
-}
+HttpRequestParser::LineStatus HttpRequestParser::ReadLine(
+    std::string_view& data, std::string_view& line) {
+  UASSERT(!data.empty());
+  if (!partial_line_.empty() && partial_line_.back() == '\r') {
+    // CR was the last byte of the previous data
+    if (data.front() != '\n') return LineStatus::kError;
+    partial_line_.pop_back();
+    data.remove_prefix(1);
+    line = partial_line_;
+    return LineStatus::kComplete;
+  }
 
-int HttpRequestParser::OnHeadersComplete(http_parser* p) {
-  auto* http_request_parser = static_cast<HttpRequestParser*>(p->data);
-  UASSERT(http_request_parser != nullptr);
-  return http_request_parser->OnHeadersCompleteImpl(p);
-}
+  const char* const begin = data.data();
+  const char* const end = begin + data.size();
+  const char* const line_end = impl::FindControlChar(begin, end);
+  if (line_end == end) return SavePartialLine(data);
 
-int HttpRequestParser::OnMessageComplete(http_parser* p) {
-  auto* http_request_parser = static_cast<HttpRequestParser*>(p->data);
-  UASSERT(http_request_parser != nullptr);
-  return http_request_parser->OnMessageCompleteImpl(p);
-}
+  std::size_t line_end_size = 1;
+  if (*line_end == '\r') {
+    if (line_end + 1 == end) return SavePartialLine(data);
+    if (line_end[1] != '\n') return LineStatus::kError;
+    line_end_size = 2;
+  } else if (*line_end != '\n') {
+    return LineStatus::kError;
+  }
 
-int HttpRequestParser::OnUrl(http_parser* p, const char* data, size_t size) {
-  auto* http_request_parser = static_cast<HttpRequestParser*>(p->data);
-  UASSERT(http_request_parser != nullptr);
-  return http_request_parser->OnUrlImpl(p, data, size);
+  const auto line_size = static_cast<std::size_t>(line_end - begin);
+  if (partial_line_.empty()) {
+    line = data.substr(0, line_size);
+  } else {
+    partial_line_.append(begin, line_size);
+    line = partial_line_;
+  }
+  data.remove_prefix(line_size + line_end_size);
+  return LineStatus::kComplete;
 }
 
-int HttpRequestParser::OnHeaderField(http_parser* p, const char* data,
-                                     size_t size) {
-  auto* http_request_parser = static_cast<HttpRequestParser*>(p->data);
-  UASSERT(http_request_parser != nullptr);
-  return http_request_parser->OnHeaderFieldImpl(p, data, size);
-}
+HttpRequestParser::LineStatus HttpRequestParser::SavePartialLine(
+    std::string_view data) {
+  partial_line_.append(data);
+
+  if (state_ == State::kRequestLine) {
+    if (partial_line_.size() <=
+        request_constructor_config_.max_url_size + kRequestLineOverhead) {
+      return LineStatus::kIncomplete;
+    }
+
+    // Sets the status to be reported to the client
+    CreateRequestConstructor();
+    try {
+      request_constructor_->AppendUrl(partial_line_.data(),
+                                      partial_line_.size());
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << "can't append url: " << ex;
+    }
+    return LineStatus::kError;
+  }
 
-int HttpRequestParser::OnHeaderValue(http_parser* p, const char* data,
-                                     size_t size) {
-  auto* http_request_parser = static_cast<HttpRequestParser*>(p->data);
-  UASSERT(http_request_parser != nullptr);
-  return http_request_parser->OnHeaderValueImpl(p, data, size);
+  return partial_line_.size() <= request_constructor_config_.max_request_size
+             ? LineStatus::kIncomplete
+             : LineStatus::kError;
 }
 
-int HttpRequestParser::OnBody(http_parser* p, const char* data, size_t size) {
-  auto* http_request_parser = static_cast<HttpRequestParser*>(p->data);
-  UASSERT(http_request_parser != nullptr);
-  return http_request_parser->OnBodyImpl(p, data, size);
+bool HttpRequestParser::OnLine(std::string_view line) {
+  switch (state_) {
+    case State::kRequestLine:
+      return OnRequestLine(line);
+    case State::kHeaders:
+      return OnHeaderLine(line);
+    case State::kChunkSize:
+      return OnChunkSizeLine(line);
+    case State::kChunkDataEnd:
+      if (!line.empty()) return OnError("no CRLF after chunk data");
+      state_ = State::kChunkSize;
+      return true;
+    case State::kTrailers:
+      return OnTrailerLine(line);
+    case State::kBody:
+    case State::kChunkData:
+      break;
+  }
+  UINVARIANT(false, "Unexpected parser state");
 }
 
-int HttpRequestParser::OnMessageBeginImpl(http_parser*) {
-  LOG_TRACE() << "message begin";
+bool HttpRequestParser::OnRequestLine(std::string_view line) {
+  // RFC 7230, section 3.5: empty lines before the request line are ignored
+  if (line.empty()) return true;
+
+  LOG_TRACE() << "request line: '" << line << '\'';
   CreateRequestConstructor();
-  return 0;
-}
 
-int HttpRequestParser::OnUrlImpl(http_parser* p, const char* data,
-                                 size_t size) {
-  UASSERT(request_constructor_);
-  LOG_TRACE() << "url: '" << std::string_view(data, size) << '\'';
-  request_constructor_->SetMethod(
-      ConvertHttpMethod(static_cast<http_method>(p->method)));
+  const auto request_line = impl::ParseRequestLine(line);
+  if (!request_line) return OnError("malformed request line");
+
+  method_ = impl::ParseMethod(request_line->method);
+  http_major_ = request_line->http_major;
+  http_minor_ = request_line->http_minor;
+  request_constructor_->SetMethod(method_);
+  request_constructor_->SetHttpMajor(http_major_);
+  request_constructor_->SetHttpMinor(http_minor_);
+
   try {
-    request_constructor_->AppendUrl(data, size);
+    request_constructor_->AppendUrl(request_line->url.data(),
+                                    request_line->url.size());
+    request_constructor_->ParseUrl();
   } catch (const std::exception& ex) {
-    LOG_WARNING() << "can't append url: " << ex;
-    return -1;
+    LOG_WARNING() << "can't parse url: " << ex;
+    return OnError("bad url");
   }
-  return 0;
+
+  state_ = State::kHeaders;
+  return true;
 }
 
-int HttpRequestParser::OnHeaderFieldImpl(http_parser* p, const char* data,
-                                         size_t size) {
+bool HttpRequestParser::OnHeaderLine(std::string_view line) {
   UASSERT(request_constructor_);
-  LOG_TRACE() << "header field: '" << std::string_view(data, size) << "'";
-  if (!CheckUrlComplete(p)) return -1;
+  if (line.empty()) return OnHeadersComplete();
+
+  const auto header = impl::ParseHeaderLine(line);
+  if (!header) return OnError("malformed header");
+  LOG_TRACE() << "header: '" << header->name << "': '" << header->value
+              << '\'';
+
+  auto& info = message_info_;
+  if (IsHeader(header->name, "Content-Length")) {
+    const auto content_length = impl::ParseContentLength(header->value);
+    if (!content_length ||
+        (info.content_length && *info.content_length != *content_length)) {
+      return OnError("bad Content-Length");
+    }
+    info.content_length = content_length;
+  } else if (IsHeader(header->name, "Transfer-Encoding")) {
+    info.has_transfer_encoding = true;
+    info.is_chunked = impl::EndsWithToken(header->value, "chunked");
+  } else if (IsHeader(header->name, "Connection")) {
+    info.connection_close |= impl::HasToken(header->value, "close");
+    info.connection_keep_alive |= impl::HasToken(header->value, "keep-alive");
+    info.connection_upgrade |= impl::HasToken(header->value, "upgrade");
+  } else if (IsHeader(header->name, "Upgrade")) {
+    info.has_upgrade = true;
+  }
+
   try {
-    request_constructor_->AppendHeaderField(data, size);
+    request_constructor_->AppendHeader(header->name, header->value);
   } catch (const std::exception& ex) {
-    LOG_WARNING() << "can't append header field: " << ex;
-    return -1;
+    LOG_WARNING() << "can't append header: " << ex;
+    return OnError("bad header");
   }
-  return 0;
+  return true;
 }
 
-int HttpRequestParser::OnHeaderValueImpl(http_parser* p, const char* data,
-                                         size_t size) {
-  UASSERT(request_constructor_);
-  if (!CheckUrlComplete(p)) return -1;
-  LOG_TRACE() << "header value: '" << std::string_view(data, size) << '\'';
-  try {
-    request_constructor_->AppendHeaderValue(data, size);
-  } catch (const std::exception& ex) {
-    LOG_WARNING() << "can't append header value: " << ex;
-    return -1;
+bool HttpRequestParser::OnHeadersComplete() {
+  LOG_TRACE() << "headers complete";
+  const auto& info = message_info_;
+
+  const bool is_keep_alive =
+      (http_major_ > 1 || (http_major_ == 1 && http_minor_ >= 1))
+          ? !info.connection_close
+          : info.connection_keep_alive;
+  request_constructor_->SetIsFinal(!is_keep_alive);
+
+  if (method_ == HttpMethod::kConnect ||
+      (info.has_upgrade && info.connection_upgrade)) {
+    LOG_WARNING() << "upgrade detected";
+    FinalizeRequest();
+    return false;
+  }
+
+  if (info.has_transfer_encoding) {
+    // RFC 7230, section 3.3.3: the request length can not be determined
+    if (!info.is_chunked || info.content_length) {
+      return OnError("bad Transfer-Encoding");
+    }
+    state_ = State::kChunkSize;
+    return true;
+  }
+
+  if (info.content_length.value_or(0) > 0) {
+    body_bytes_left_ = *info.content_length;
+    state_ = State::kBody;
+    return true;
+  }
+
+  return OnMessageComplete();
+}
+
+bool HttpRequestParser::OnChunkSizeLine(std::string_view line) {
+  const auto chunk_size = impl::ParseChunkSize(line);
+  if (!chunk_size) return OnError("bad chunk size");
+
+  if (*chunk_size == 0) {
+    state_ = State::kTrailers;
+  } else {
+    body_bytes_left_ = *chunk_size;
+    state_ = State::kChunkData;
   }
-  return 0;
+  return true;
 }
 
-int HttpRequestParser::OnHeadersCompleteImpl(http_parser* p) {
+bool HttpRequestParser::OnTrailerLine(std::string_view line) {
   UASSERT(request_constructor_);
-  if (!CheckUrlComplete(p)) return -1;
+  if (line.empty()) return OnMessageComplete();
+
+  const auto header = impl::ParseHeaderLine(line);
+  if (!header) return OnError("malformed trailer");
   try {
-    request_constructor_->AppendHeaderField("", 0);
+    request_constructor_->AppendHeader(header->name, header->value);
   } catch (const std::exception& ex) {
-    LOG_WARNING() << "can't append header value: " << ex;
-    return -1;
+    LOG_WARNING() << "can't append trailer: " << ex;
+    return OnError("bad trailer");
   }
-  LOG_TRACE() << "headers complete";
-  return 0;
+  return true;
 }
 
-int HttpRequestParser::OnBodyImpl(http_parser* p, const char* data,
-                                  size_t size) {
+bool HttpRequestParser::OnBody(std::string_view data) {
   UASSERT(request_constructor_);
-  if (!CheckUrlComplete(p)) return -1;
-  LOG_TRACE() << "body: '" << std::string_view(data, size) << "'";
+  LOG_TRACE() << "body: '" << data << '\'';
   try {
-    request_constructor_->AppendBody(data, size);
+    request_constructor_->AppendBody(data.data(), data.size());
   } catch (const std::exception& ex) {
     LOG_WARNING() << "can't append body: " << ex;
-    return -1;
+    return OnError("bad body");
   }
-  return 0;
+  return true;
 }
 
-int HttpRequestParser::OnMessageCompleteImpl(http_parser* p) {
-  UASSERT(request_constructor_);
-  if (p->upgrade) {
-    LOG_WARNING() << "upgrade detected";
-    return -1;  // error
-  }
-  request_constructor_->SetIsFinal(!http_should_keep_alive(p));
-  if (!CheckUrlComplete(p)) return -1;
+bool HttpRequestParser::OnMessageComplete() {
   LOG_TRACE() << "message complete";
-  if (!FinalizeRequest()) return -1;
-  return 0;
+  state_ = State::kRequestLine;
+  return FinalizeRequest();
+}
+
+bool HttpRequestParser::OnError(std::string_view reason) {
+  LOG_WARNING() << "failed to parse HTTP request: " << reason;
+  FinalizeRequest();
+  return false;
 }
 
 void HttpRequestParser::CreateRequestConstructor() {
   ++stats_.parsing_request_count;
   request_constructor_.emplace(request_constructor_config_, handler_info_index_,
                                data_accounter_);
-  url_complete_ = false;
-}
-
-bool HttpRequestParser::CheckUrlComplete(http_parser* p) {
-  if (url_complete_) return true;
-  url_complete_ = true;
-  request_constructor_->SetMethod(
-      ConvertHttpMethod(static_cast<http_method>(p->method)));
-  request_constructor_->SetHttpMajor(p->http_major);
-  request_constructor_->SetHttpMinor(p->http_minor);
-  try {
-    request_constructor_->ParseUrl();
-  } catch (const std::exception& ex) {
-    LOG_WARNING() << "can't parse url: " << ex;
-    return false;
-  }
-  return true;
+  message_info_ = {};
+  http_major_ = 0;
+  http_minor_ = 0;
+  method_ = HttpMethod::kUnknown;
 }
 
 bool HttpRequestParser::FinalizeRequest() {
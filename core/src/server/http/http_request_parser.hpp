@@ -1,11 +1,11 @@
 #pragma once
 
-#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
-
-#include <http_parser.h>
+#include <string>
+#include <string_view>
 
 #include <server/net/stats.hpp>
 #include <server/request/request_parser.hpp>
@@ -18,6 +18,9 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::http {
 
+/// HTTP/1.x request parser. Complete lines are parsed in place from the
+/// received data, only the beginning of a line that is split between the
+/// reads is copied.
 class HttpRequestParser final : public request::RequestParser {
  public:
   using OnNewRequestCb =
@@ -34,40 +37,63 @@ class HttpRequestParser final : public request::RequestParser {
   bool Parse(const char* data, size_t size) override;
 
  private:
-  static int OnMessageBegin(http_parser* p);
-  static int OnUrl(http_parser* p, const char* data, size_t size);
-  static int OnHeaderField(http_parser* p, const char* data, size_t size);
-  static int OnHeaderValue(http_parser* p, const char* data, size_t size);
-  static int OnHeadersComplete(http_parser* p);
-  static int OnBody(http_parser* p, const char* data, size_t size);
-  static int OnMessageComplete(http_parser* p);
-
-  int OnMessageBeginImpl(http_parser* p);
-  int OnUrlImpl(http_parser* p, const char* data, size_t size);
-  int OnHeaderFieldImpl(http_parser* p, const char* data, size_t size);
-  int OnHeaderValueImpl(http_parser* p, const char* data, size_t size);
-  int OnHeadersCompleteImpl(http_parser* p);
-  int OnBodyImpl(http_parser* p, const char* data, size_t size);
-  int OnMessageCompleteImpl(http_parser* p);
+  enum class State {
+    kRequestLine,
+    kHeaders,
+    kBody,
+    kChunkSize,
+    kChunkData,
+    kChunkDataEnd,
+    kTrailers,
+  };
+
+  enum class LineStatus { kComplete, kIncomplete, kError };
+
+  // Headers that affect the message framing
+  struct MessageInfo {
+    std::optional<std::uint64_t> content_length;
+    bool has_transfer_encoding{false};
+    bool is_chunked{false};
+    bool has_upgrade{false};
+    bool connection_close{false};
+    bool connection_keep_alive{false};
+    bool connection_upgrade{false};
+  };
+
+  LineStatus ReadLine(std::string_view& data, std::string_view& line);
+  LineStatus SavePartialLine(std::string_view data);
+
+  // All the handlers return false if the parsing must be stopped
+  bool OnLine(std::string_view line);
+  bool OnRequestLine(std::string_view line);
+  bool OnHeaderLine(std::string_view line);
+  bool OnHeadersComplete();
+  bool OnChunkSizeLine(std::string_view line);
+  bool OnTrailerLine(std::string_view line);
+  bool OnBody(std::string_view data);
+  bool OnMessageComplete();
+  bool OnError(std::string_view reason);
 
   void CreateRequestConstructor();
 
-  bool CheckUrlComplete(http_parser* p);
-
   bool FinalizeRequest();
   bool FinalizeRequestImpl();
 
   const HandlerInfoIndex& handler_info_index_;
   const HttpRequestConstructor::Config request_constructor_config_;
 
-  bool url_complete_ = false;
-
   OnNewRequestCb on_new_request_cb_;
 
-  http_parser parser_{};
+  State state_{State::kRequestLine};
+  // Beginning of a line that is not complete in the previously parsed data
+  std::string partial_line_;
+  MessageInfo message_info_;
+  unsigned short http_major_{0};
+  unsigned short http_minor_{0};
+  HttpMethod method_{HttpMethod::kUnknown};
+  std::uint64_t body_bytes_left_{0};
   std::optional<HttpRequestConstructor> request_constructor_;
 
-  static const http_parser_settings parser_settings;
   net::ParserStats& stats_;
   request::ResponseDataAccounter& data_accounter_;
 };
@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <fmt/format.h>
+
+#include <server/http/http1_scanner.hpp>
+#include <server/http/http_request_parser.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string MakeRequests(std::size_t requests_count,
+                         std::size_t headers_count) {
+  std::string requests;
+  for (std::size_t i = 0; i < requests_count; ++i) {
+    requests += "POST /v1/handler?arg=value HTTP/1.1\r\nHost: localhost\r\n";
+    for (std::size_t header = 0; header < headers_count; ++header) {
+      requests += fmt::format(
+          "X-Test-Header-{}: some reasonably long header value {}\r\n", header,
+          header);
+    }
+    requests += "Content-Length: 4\r\n\r\nbody";
+  }
+  return requests;
+}
+
+void http_request_parser_parse(benchmark::State& state) {
+  constexpr std::size_t kPipelinedRequests = 16;
+  const server::http::HandlerInfoIndex handler_info_index;
+  server::request::HttpRequestConfig request_config;
+  // Do not skip the args parsing for the requests without a handler
+  request_config.testing_mode = true;
+  server::net::ParserStats stats;
+  server::request::ResponseDataAccounter data_accounter;
+  server::http::HttpRequestParser parser(
+      handler_info_index, request_config,
+      [](std::shared_ptr<server::request::RequestBase>&& request) {
+        benchmark::DoNotOptimize(request);
+      },
+      stats, data_accounter);
+
+  const auto requests = MakeRequests(kPipelinedRequests, state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(parser.Parse(requests.data(), requests.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * requests.size());
+  state.SetItemsProcessed(state.iterations() * kPipelinedRequests);
+}
+
+void http_request_parser_find_line_end(benchmark::State& state) {
+  const std::string line = std::string(state.range(0), 'x') + "\r\n";
+  const bool is_vectorized = state.range(1);
+  for (auto _ : state) {
+    const char* const end = line.data() + line.size();
+    benchmark::DoNotOptimize(
+        is_vectorized ? server::http::impl::FindControlChar(line.data(), end)
+                      : server::http::impl::FindControlCharScalar(
+                            line.data(), end));
+  }
+  state.SetBytesProcessed(state.iterations() * line.size());
+}
+
+}  // namespace
+
+BENCHMARK(http_request_parser_parse)->RangeMultiplier(4)->Range(1, 64);
+
+BENCHMARK(http_request_parser_find_line_end)
+    ->ArgsProduct({{16, 64, 256, 1024}, {false, true}});
+
+USERVER_NAMESPACE_END
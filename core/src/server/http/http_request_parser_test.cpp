@@ -0,0 +1,164 @@
+#include <userver/utest/utest.hpp>
+
+#include <string>
+#include <vector>
+
+#include <userver/server/http/http_request.hpp>
+
+#include <server/http/http_request_impl.hpp>
+#include <server/http/http_request_parser.hpp>
+
+#include "create_parser_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using RequestBasePtr = std::shared_ptr<server::request::RequestBase>;
+
+struct ParsedRequest {
+  server::http::HttpMethod method;
+  std::string path;
+  std::string body;
+  std::string header;
+  bool is_final;
+};
+
+class ParsedRequests final {
+ public:
+  server::http::HttpRequestParser::OnNewRequestCb GetCallback() {
+    return [this](RequestBasePtr&& request) {
+      auto& impl = dynamic_cast<server::http::HttpRequestImpl&>(*request);
+      const server::http::HttpRequest http_request(impl);
+      requests_.push_back({http_request.GetMethod(),
+                           http_request.GetRequestPath(),
+                           http_request.RequestBody(),
+                           http_request.GetHeader("X-Header"), impl.IsFinal()});
+    };
+  }
+
+  const std::vector<ParsedRequest>& Get() const { return requests_; }
+
+ private:
+  std::vector<ParsedRequest> requests_;
+};
+
+const std::string kPipelinedRequests =
+    "GET /get HTTP/1.1\r\n"
+    "Host: localhost\r\n"
+    "X-Header: first\r\n"
+    "\r\n"
+    "POST /post HTTP/1.1\r\n"
+    "Content-Length: 11\r\n"
+    "x-header:   second \t\r\n"
+    "X-HEADER: third\r\n"
+    "\r\n"
+    "hello world"
+    "POST /chunked HTTP/1.1\n"
+    "Transfer-Encoding: chunked\n"
+    "Connection: close\n"
+    "\n"
+    "5;ext=value\r\n"
+    "hello\r\n"
+    "6\r\n"
+    " world\r\n"
+    "0\r\n"
+    "X-Header: trailer\r\n"
+    "\r\n";
+
+void CheckPipelinedRequests(const std::vector<ParsedRequest>& requests) {
+  ASSERT_EQ(requests.size(), 3);
+
+  EXPECT_EQ(requests[0].method, server::http::HttpMethod::kGet);
+  EXPECT_EQ(requests[0].path, "/get");
+  EXPECT_EQ(requests[0].header, "first");
+  EXPECT_EQ(requests[0].body, "");
+  EXPECT_FALSE(requests[0].is_final);
+
+  EXPECT_EQ(requests[1].method, server::http::HttpMethod::kPost);
+  EXPECT_EQ(requests[1].path, "/post");
+  EXPECT_EQ(requests[1].header, "second,third");
+  EXPECT_EQ(requests[1].body, "hello world");
+  EXPECT_FALSE(requests[1].is_final);
+
+  EXPECT_EQ(requests[2].path, "/chunked");
+  EXPECT_EQ(requests[2].header, "trailer");
+  EXPECT_EQ(requests[2].body, "hello world");
+  EXPECT_TRUE(requests[2].is_final);
+}
+
+}  // namespace
+
+UTEST(HttpRequestParser, Pipelined) {
+  ParsedRequests requests;
+  auto parser = server::CreateTestParser(requests.GetCallback());
+  EXPECT_TRUE(
+      parser.Parse(kPipelinedRequests.data(), kPipelinedRequests.size()));
+  CheckPipelinedRequests(requests.Get());
+}
+
+UTEST(HttpRequestParser, SplitData) {
+  for (std::size_t split = 1; split < kPipelinedRequests.size(); ++split) {
+    ParsedRequests requests;
+    auto parser = server::CreateTestParser(requests.GetCallback());
+    EXPECT_TRUE(parser.Parse(kPipelinedRequests.data(), split));
+    EXPECT_TRUE(parser.Parse(kPipelinedRequests.data() + split,
+                             kPipelinedRequests.size() - split));
+    CheckPipelinedRequests(requests.Get());
+  }
+
+  ParsedRequests requests;
+  auto parser = server::CreateTestParser(requests.GetCallback());
+  for (const char c : kPipelinedRequests) {
+    EXPECT_TRUE(parser.Parse(&c, 1));
+  }
+  CheckPipelinedRequests(requests.Get());
+}
+
+UTEST(HttpRequestParser, KeepAlive) {
+  const auto is_final = [](const std::string& request) {
+    ParsedRequests requests;
+    auto parser = server::CreateTestParser(requests.GetCallback());
+    EXPECT_TRUE(parser.Parse(request.data(), request.size()));
+    EXPECT_EQ(requests.Get().size(), 1);
+    return !requests.Get().empty() && requests.Get().front().is_final;
+  };
+
+  EXPECT_FALSE(is_final("GET / HTTP/1.1\r\n\r\n"));
+  EXPECT_TRUE(is_final("GET / HTTP/1.1\r\nConnection: Close\r\n\r\n"));
+  EXPECT_TRUE(is_final("GET / HTTP/1.0\r\n\r\n"));
+  EXPECT_FALSE(is_final("GET / HTTP/1.0\r\nConnection: keep-alive\r\n\r\n"));
+}
+
+UTEST(HttpRequestParser, Malformed) {
+  for (const std::string request : {
+           "GET / HTTP/1.1\r\nX-Header: a\x01"
+           "b\r\n\r\n",
+           "GET / HTTP/1.1\r\nX-Header : value\r\n\r\n",
+           "GET / HTTP/1.1\rX-Header: value\r\n\r\n",
+           "GET / HTTP/1.1\r\nNo colon\r\n\r\n",
+           "GET / HTTP/11\r\n\r\n",
+           "GET / HTTP/1.1\r\nContent-Length: 1\r\nContent-Length: 2\r\n\r\n",
+           "POST / HTTP/1.1\r\nContent-Length: 1\r\n"
+           "Transfer-Encoding: chunked\r\n\r\n",
+           "POST / HTTP/1.1\r\nTransfer-Encoding: gzip\r\n\r\n",
+           "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\nx\r\n",
+       }) {
+    ParsedRequests requests;
+    auto parser = server::CreateTestParser(requests.GetCallback());
+    EXPECT_FALSE(parser.Parse(request.data(), request.size())) << request;
+    // The request is still passed on to respond to the client
+    EXPECT_EQ(requests.Get().size(), 1) << request;
+  }
+}
+
+UTEST(HttpRequestParser, Upgrade) {
+  const std::string request =
+      "GET / HTTP/1.1\r\nConnection: Upgrade\r\nUpgrade: websocket\r\n\r\n";
+  ParsedRequests requests;
+  auto parser = server::CreateTestParser(requests.GetCallback());
+  EXPECT_FALSE(parser.Parse(request.data(), request.size()));
+  EXPECT_EQ(requests.Get().size(), 1);
+}
+
+USERVER_NAMESPACE_END
@@ -1,12 +1,13 @@
 #include <userver/server/http/http_response.hpp>
 
+#include <algorithm>
 #include <array>
 
 #include <cctz/time_zone.h>
 #include <fmt/compile.h>
 
 #include <userver/engine/deadline.hpp>
-#include <userver/engine/io/socket.hpp>
+#include <userver/engine/io/common.hpp>
 #include <userver/hostinfo/blocking/get_hostname.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/http/content_type.hpp>
@@ -66,6 +67,25 @@ void CheckHeaderValue(std::string_view value) {
   }
 }
 
+// Connection-specific headers are forbidden in HTTP/2, see RFC 9113 8.2.2
+bool IsConnectionSpecificHeader(std::string_view name) {
+  constexpr std::array<std::string_view, 5> kHeaders{
+      http::headers::kConnection, "Keep-Alive", "Proxy-Connection",
+      http::headers::kTransferEncoding, "Upgrade"};
+  return std::any_of(kHeaders.begin(), kHeaders.end(),
+                     [name](std::string_view header) {
+                       return utils::StrIcaseEqual{}(name, header);
+                     });
+}
+
+std::string ToHttp2HeaderName(std::string_view name) {
+  std::string result{name};
+  std::transform(result.begin(), result.end(), result.begin(), [](char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+  });
+  return result;
+}
+
 bool IsBodyForbiddenForStatus(server::http::HttpStatus status) {
   return status == server::http::HttpStatus::kNoContent ||
          status == server::http::HttpStatus::kNotModified ||
@@ -102,6 +122,63 @@ void HttpResponse::SetSendFailed(
   request::ResponseBase::SetSendFailed(failure_time);
 }
 
+impl::Http2ResponseData HttpResponse::PrepareHttp2Response() {
+  if (IsBodyStreamed()) {
+    std::string body;
+    std::string body_part;
+    while (body_stream_->Pop(body_part)) body.append(body_part);
+    body_stream_producer_.reset();
+    body_stream_.reset();
+    SetData(std::move(body));
+  }
+
+  impl::Http2ResponseData result;
+  auto& headers = result.headers;
+  headers.reserve(headers_.size() + cookies_.size() + 4);
+  headers.emplace_back(":status", fmt::format(FMT_COMPILE("{}"),
+                                              static_cast<int>(status_)));
+
+  headers_.erase(USERVER_NAMESPACE::http::headers::kContentLength);
+  const auto end = headers_.cend();
+  if (headers_.find(USERVER_NAMESPACE::http::headers::kDate) == end) {
+    std::string date;
+    AppendCachedDate(date);
+    headers.emplace_back("date", std::move(date));
+  }
+  if (headers_.find(USERVER_NAMESPACE::http::headers::kContentType) == end) {
+    headers.emplace_back("content-type", kDefaultContentTypeString);
+  }
+  for (const auto& [name, value] : headers_) {
+    if (IsConnectionSpecificHeader(name)) continue;
+    headers.emplace_back(ToHttp2HeaderName(name), value);
+  }
+  for (const auto& cookie : cookies_) {
+    std::string value;
+    cookie.second.AppendToString(value);
+    headers.emplace_back("set-cookie", std::move(value));
+  }
+
+  const bool is_body_forbidden = IsBodyForbiddenForStatus(status_);
+  if (!is_body_forbidden) {
+    headers.emplace_back("content-length",
+                         fmt::format(FMT_COMPILE("{}"), GetData().size()));
+    if (request_.GetOrigMethod() != HttpMethod::kHead) {
+      result.body = GetData();
+    }
+  } else if (!GetData().empty()) {
+    LOG_LIMITED_WARNING()
+        << "Non-empty body provided for response with HTTP code "
+        << static_cast<int>(status_)
+        << " which does not allow one, it will be dropped";
+  }
+  return result;
+}
+
+void HttpResponse::SetHttp2Sent(size_t bytes_sent) {
+  SetSentTime(std::chrono::steady_clock::now());
+  SetSent(bytes_sent);
+}
+
 void HttpResponse::SetHeader(std::string name, std::string value) {
   CheckHeaderName(name);
   CheckHeaderValue(value);
@@ -167,7 +244,7 @@ void HttpResponse::SetHeadersEnd() { headers_end_.Send(); }
 
 bool HttpResponse::WaitForHeadersEnd() { return headers_end_.WaitForEvent(); }
 
-void HttpResponse::SendResponse(engine::io::Socket& socket) {
+void HttpResponse::SendResponse(engine::io::RwBase& socket) {
   // According to https://www.chromium.org/spdy/spdy-whitepaper/
   // "typical header sizes of 700-800 bytes is common"
   // Adjusting it to 1KiB to fit jemalloc size class
@@ -215,7 +292,7 @@ void HttpResponse::SendResponse(engine::io::Socket& socket) {
     SetBodyNotstreamed(socket, header);
 }
 
-void HttpResponse::SetBodyNotstreamed(engine::io::Socket& socket,
+void HttpResponse::SetBodyNotstreamed(engine::io::RwBase& socket,
                                       std::string& header) {
   const bool is_body_forbidden = IsBodyForbiddenForStatus(status_);
   const bool is_head_request = request_.GetOrigMethod() == HttpMethod::kHead;
@@ -236,25 +313,25 @@ void HttpResponse::SetBodyNotstreamed(engine::io::Socket& socket,
 
   ssize_t sent_bytes = 0;
   if (!is_head_request && !is_body_forbidden) {
-    sent_bytes = socket.SendAll(
+    sent_bytes = socket.WriteAll(
         {{header.data(), header.size()}, {data.data(), data.size()}},
         engine::Deadline{});
   } else {
     sent_bytes =
-        socket.SendAll(header.data(), header.size(), engine::Deadline{});
+        socket.WriteAll(header.data(), header.size(), engine::Deadline{});
   }
 
   SetSentTime(std::chrono::steady_clock::now());
   SetSent(sent_bytes);
 }
 
-void HttpResponse::SetBodyStreamed(engine::io::Socket& socket,
+void HttpResponse::SetBodyStreamed(engine::io::RwBase& socket,
                                    std::string& header) {
   impl::OutputHeader(
       header, USERVER_NAMESPACE::http::headers::kTransferEncoding, "chunked");
 
   // send HTTP headers
-  size_t sent_bytes = socket.SendAll(header.data(), header.size(), {});
+  size_t sent_bytes = socket.WriteAll(header.data(), header.size(), {});
 
   std::string().swap(header);  // free memory before time consuming operation
 
@@ -268,14 +345,14 @@ void HttpResponse::SetBodyStreamed(engine::io::Socket& socket,
     }
 
     auto size = fmt::format("\r\n{:x}\r\n", body_part.size());
-    sent_bytes += socket.SendAll(
+    sent_bytes += socket.WriteAll(
         {{size.data(), size.size()}, {body_part.data(), body_part.size()}},
         engine::Deadline{});
   }
 
   const constexpr std::string_view terminating_chunk{"\r\n0\r\n\r\n"};
   sent_bytes +=
-      socket.SendAll(terminating_chunk.data(), terminating_chunk.size(), {});
+      socket.WriteAll(terminating_chunk.data(), terminating_chunk.size(), {});
 
   // TODO: exceptions?
   body_stream_producer_.reset();
@@ -45,6 +45,21 @@ UTEST(HttpResponse, Smoke) {
             fmt::format("\r\n\r\n{}", kBody));
 }
 
+UTEST(HttpResponse, DataAccounterParent) {
+  server::request::ResponseDataAccounter accounter;
+  server::request::ResponseDataAccounter connection_accounter{accounter};
+  {
+    server::http::HttpRequestImpl request{connection_accounter};
+    server::http::HttpResponse response{request, connection_accounter};
+    response.SetData("test data");
+
+    EXPECT_EQ(connection_accounter.GetCurrentLevel(), 9);
+    EXPECT_EQ(accounter.GetCurrentLevel(), 9);
+  }
+  EXPECT_EQ(connection_accounter.GetCurrentLevel(), 0);
+  EXPECT_EQ(accounter.GetCurrentLevel(), 0);
+}
+
 class HttpResponseBody : public testing::TestWithParam<int> {};
 
 UTEST_P(HttpResponseBody, ForbiddenBody) {
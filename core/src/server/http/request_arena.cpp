@@ -0,0 +1,52 @@
+#include "request_arena.hpp"
+
+#include <algorithm>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+constexpr std::size_t kMinInitialSize = 1024;
+constexpr std::size_t kMaxInitialSize = 64 * 1024;
+
+// Exponential moving average of the arena usage, each request has 1/8 weight
+constexpr std::size_t kSmoothingShift = 3;
+
+// Kept per thread, so that the arena destruction does not write to a cache
+// line shared by all the threads
+thread_local std::size_t initial_size_hint = kMinInitialSize * 4;
+
+}  // namespace
+
+RequestArena::RequestArena() : resource_(GetInitialSizeHint()) {}
+
+RequestArena::~RequestArena() {
+  const auto used =
+      std::clamp(allocated_bytes_, kMinInitialSize, kMaxInitialSize);
+  initial_size_hint = initial_size_hint -
+                      (initial_size_hint >> kSmoothingShift) +
+                      (used >> kSmoothingShift);
+}
+
+std::size_t RequestArena::GetInitialSizeHint() noexcept {
+  return initial_size_hint;
+}
+
+void* RequestArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+  auto* result = resource_.allocate(bytes, alignment);
+  allocated_bytes_ += bytes;
+  return result;
+}
+
+void RequestArena::do_deallocate(void*, std::size_t, std::size_t) {}
+
+bool RequestArena::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
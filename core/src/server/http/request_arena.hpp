@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// Monotonic memory resource that lives as long as the request. Deallocation
+/// is a no-op, the memory is released all at once on destruction.
+///
+/// The first block is sized by the usage of the arenas recently destroyed on
+/// the same thread, so a typical request makes a single upstream allocation.
+///
+/// Not thread-safe.
+class RequestArena final : public std::pmr::memory_resource {
+ public:
+  RequestArena();
+  ~RequestArena() override;
+
+  RequestArena(RequestArena&&) = delete;
+  RequestArena& operator=(RequestArena&&) = delete;
+
+  /// Bytes requested from the arena so far
+  std::size_t GetAllocatedBytes() const noexcept { return allocated_bytes_; }
+
+  /// Size of the first block of a new arena on the current thread
+  static std::size_t GetInitialSizeHint() noexcept;
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void* p, std::size_t bytes,
+                     std::size_t alignment) override;
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override;
+
+  std::size_t allocated_bytes_{0};
+  std::pmr::monotonic_buffer_resource resource_;
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
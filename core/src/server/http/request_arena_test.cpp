@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <server/http/request_arena.hpp>
+#include <userver/server/request/request_context.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using server::http::RequestArena;
+
+TEST(RequestArena, Allocate) {
+  RequestArena arena;
+  std::pmr::vector<std::pmr::string> strings{&arena};
+  for (int i = 0; i < 100; ++i) {
+    strings.emplace_back("long enough to not fit into the small string buffer");
+  }
+
+  EXPECT_EQ(strings.size(), 100);
+  EXPECT_EQ(strings.back(),
+            "long enough to not fit into the small string buffer");
+  EXPECT_GE(arena.GetAllocatedBytes(), 100 * strings.back().size());
+  EXPECT_TRUE(arena.is_equal(arena));
+  EXPECT_FALSE(arena.is_equal(*std::pmr::new_delete_resource()));
+}
+
+TEST(RequestArena, InitialSizeHint) {
+  constexpr std::size_t kUsage = 16 * 1024;
+
+  for (int i = 0; i < 100; ++i) {
+    RequestArena arena;
+    [[maybe_unused]] auto* data = arena.allocate(kUsage);
+  }
+  const auto hint = RequestArena::GetInitialSizeHint();
+  EXPECT_GT(hint, kUsage * 3 / 4);
+  EXPECT_LE(hint, kUsage);
+
+  for (int i = 0; i < 100; ++i) {
+    RequestArena arena;
+  }
+  EXPECT_LT(RequestArena::GetInitialSizeHint(), kUsage / 4);
+}
+
+TEST(RequestArena, RequestContext) {
+  RequestArena arena;
+  {
+    server::request::RequestContext context{arena};
+    context.SetData("first", 1);
+    context.SetData("second", std::string{"value"});
+    EXPECT_EQ(context.GetData<int>("first"), 1);
+    EXPECT_EQ(context.GetData<std::string>("second"), "value");
+    context.EraseData("first");
+    EXPECT_EQ(context.GetDataOptional<int>("first"), nullptr);
+  }
+  EXPECT_GT(arena.GetAllocatedBytes(), 0);
+}
+
+USERVER_NAMESPACE_END
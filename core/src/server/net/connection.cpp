@@ -2,19 +2,24 @@
 
 #include <algorithm>
 #include <array>
+#include <mutex>
 #include <stdexcept>
 #include <system_error>
+#include <utility>
 #include <vector>
 
+#include <server/http/http2_session.hpp>
 #include <server/http/http_request_parser.hpp>
 #include <server/http/request_handler_base.hpp>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/exception.hpp>
 #include <userver/engine/io/exception.hpp>
+#include <userver/engine/io/tls_wrapper.hpp>
 #include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/server/http/http_response.hpp>
 #include <userver/server/request/request_config.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/scope_guard.hpp>
@@ -29,10 +34,12 @@ std::shared_ptr<Connection> Connection::Create(
     engine::io::Socket peer_socket,
     const http::RequestHandlerBase& request_handler,
     std::shared_ptr<Stats> stats,
-    request::ResponseDataAccounter& data_accounter) {
+    request::ResponseDataAccounter& data_accounter,
+    std::optional<engine::io::TlsServerContext> tls_context) {
   return std::make_shared<Connection>(
       task_processor, config, handler_defaults_config, std::move(peer_socket),
-      request_handler, std::move(stats), data_accounter, EmplaceEnabler{});
+      request_handler, std::move(stats), data_accounter,
+      std::move(tls_context), EmplaceEnabler{});
 }
 
 Connection::Connection(
@@ -41,7 +48,8 @@ Connection::Connection(
     engine::io::Socket peer_socket,
     const http::RequestHandlerBase& request_handler,
     std::shared_ptr<Stats> stats,
-    request::ResponseDataAccounter& data_accounter, EmplaceEnabler)
+    request::ResponseDataAccounter& data_accounter,
+    std::optional<engine::io::TlsServerContext> tls_context, EmplaceEnabler)
     : task_processor_(task_processor),
       config_(config),
       handler_defaults_config_(handler_defaults_config),
@@ -49,10 +57,14 @@ Connection::Connection(
       request_handler_(request_handler),
       stats_(std::move(stats)),
       data_accounter_(data_accounter),
-      remote_address_(peer_socket_.Getpeername().PrimaryAddressString()),
+      pipeline_data_accounter_(data_accounter_),
+      fd_(peer_socket_.Fd()),
+      peer_name_(peer_socket_.Getpeername()),
+      remote_address_(peer_name_.PrimaryAddressString()),
+      tls_context_(std::move(tls_context)),
       request_tasks_(Queue::Create()) {
-  LOG_DEBUG() << "Incoming connection from " << peer_socket_.Getpeername()
-              << ", fd " << Fd();
+  LOG_DEBUG() << "Incoming " << (tls_context_ ? "TLS " : "")
+              << "connection from " << peer_name_ << ", fd " << Fd();
 
   ++stats_->active_connections;
   ++stats_->connections_created;
@@ -101,7 +113,7 @@ void Connection::Start() {
 
 void Connection::Stop() { response_sender_task_.RequestCancel(); }
 
-int Connection::Fd() const { return peer_socket_.Fd(); }
+int Connection::Fd() const { return fd_; }
 
 void Connection::Shutdown() noexcept {
   UASSERT(response_sender_task_.IsValid());
@@ -110,6 +122,9 @@ void Connection::Shutdown() noexcept {
                  "requests) for fd "
               << Fd();
 
+  // Sends close_notify, so the client may resume the TLS session later
+  peer_stream_ = &peer_socket_;
+  tls_stream_.reset();
   peer_socket_.Close();  // should not throw
 
   --stats_->active_connections;
@@ -140,6 +155,8 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
   });
 
   try {
+    if (tls_context_ && !StartTls()) return;
+
     request_tasks_->SetSoftMaxSize(config_.requests_queue_size_threshold);
 
     http::HttpRequestParser request_parser(
@@ -149,17 +166,20 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
             is_accepting_requests_ = false;
           }
         },
-        stats_->parser_stats, data_accounter_);
+        stats_->parser_stats, pipeline_data_accounter_);
 
     std::vector<char> buf(config_.in_buffer_size);
     std::size_t last_bytes_read = 0;
+    // HTTP/2 with prior knowledge is detected by the connection preface
+    bool is_protocol_detected = !config_.http2_enabled;
+    std::string partial_preface;
     while (is_accepting_requests_) {
       auto deadline = engine::Deadline::FromDuration(config_.keepalive_timeout);
 
       bool is_readable = true;
       // If we didn't fill the buffer in the previous loop iteration we almost
       // certainly will hit EWOULDBLOCK on the subsequent recv syscall from
-      // peer_socket_.RecvSome, which will fall back to event-loop waiting
+      // peer_stream_->ReadSome, which will fall back to event-loop waiting
       // for socket to become readable, and then issue another recv syscall,
       // effectively doing
       // 1. recv (returns -1)
@@ -168,14 +188,14 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
       //
       // So instead we just do 2. and 3., shaving off a whole recv syscall
       if (last_bytes_read != buf.size()) {
-        is_readable = peer_socket_.WaitReadable(deadline);
+        is_readable = peer_stream_->WaitReadable(deadline);
       }
 
       last_bytes_read =
-          is_readable ? peer_socket_.RecvSome(buf.data(), buf.size(), deadline)
+          is_readable ? peer_stream_->ReadSome(buf.data(), buf.size(), deadline)
                       : 0;
       if (!last_bytes_read) {
-        LOG_TRACE() << "Peer " << peer_socket_.Getpeername() << " on fd "
+        LOG_TRACE() << "Peer " << peer_name_ << " on fd "
                     << Fd() << " closed connection or the connection timed out";
 
         // RFC7230 does not specify rules for connections half-closed from
@@ -188,10 +208,30 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
         return;
       }
       LOG_TRACE() << "Received " << last_bytes_read << " byte(s) from "
-                  << peer_socket_.Getpeername() << " on fd " << Fd();
+                  << peer_name_ << " on fd " << Fd();
+
+      std::string_view data{buf.data(), last_bytes_read};
+      if (!is_protocol_detected) {
+        if (!partial_preface.empty()) {
+          partial_preface.append(data);
+          data = partial_preface;
+        }
+
+        const auto preface_match = http::Http2Session::MatchPreface(data);
+        if (preface_match == http::Http2Session::PrefaceMatch::kPartial) {
+          if (partial_preface.empty()) partial_preface.assign(data);
+          continue;
+        }
+        is_protocol_detected = true;
+
+        if (preface_match == http::Http2Session::PrefaceMatch::kMatch) {
+          if (!ListenForHttp2Requests(producer, buf, data)) return;
+          break;
+        }
+      }
 
-      if (!request_parser.Parse(buf.data(), last_bytes_read)) {
-        LOG_DEBUG() << "Malformed request from " << peer_socket_.Getpeername()
+      if (!request_parser.Parse(data.data(), data.size())) {
+        LOG_DEBUG() << "Malformed request from " << peer_name_
                     << " on fd " << Fd();
 
         // Stop accepting new requests, send previous answers.
@@ -214,15 +254,34 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
             ? logging::Level::kWarning
             : logging::Level::kError;
     LOG(log_level) << "I/O error while receiving from peer "
-                   << peer_socket_.Getpeername() << " on fd " << Fd() << ": "
+                   << peer_name_ << " on fd " << Fd() << ": "
                    << ex;
   } catch (const std::exception& ex) {
     LOG_ERROR() << "Error while receiving from peer "
-                << peer_socket_.Getpeername() << " on fd " << Fd() << ": "
+                << peer_name_ << " on fd " << Fd() << ": "
                 << ex;
   }
 }
 
+bool Connection::StartTls() {
+  const auto deadline =
+      engine::Deadline::FromDuration(config_.keepalive_timeout);
+  try {
+    auto tls = engine::io::TlsWrapper::StartTlsServer(
+        std::move(peer_socket_), *tls_context_, deadline);
+    LOG_TRACE() << "TLS session with " << peer_name_ << " on fd " << Fd()
+                << " established, reused=" << tls.IsSessionReused()
+                << ", alpn='" << tls.GetAlpnProtocol() << '\'';
+    tls_stream_ = std::make_unique<TlsStream>(std::move(tls));
+    peer_stream_ = tls_stream_.get();
+    return true;
+  } catch (const engine::io::TlsException& ex) {
+    LOG_WARNING() << "TLS handshake with " << peer_name_ << " on fd " << Fd()
+                  << " failed: " << ex;
+    return false;
+  }
+}
+
 bool Connection::NewRequest(std::shared_ptr<request::RequestBase>&& request_ptr,
                             Queue::Producer& producer) {
   if (!is_accepting_requests_) {
@@ -237,16 +296,123 @@ bool Connection::NewRequest(std::shared_ptr<request::RequestBase>&& request_ptr,
     is_accepting_requests_ = false;
   }
 
+  if (!WaitForPipelinedResponses()) return false;
+
   ++stats_->active_request_count;
   return producer.Push(
       {request_ptr, request_handler_.StartRequestTask(request_ptr)});
 }
 
+bool Connection::WaitForPipelinedResponses() {
+  // Handlers of the pipelined requests run concurrently, but the responses
+  // are sent in the request order. Do not start new requests while the
+  // responses that wait for a slow one take too much memory.
+  while (pipeline_data_accounter_.GetCurrentLevel() >
+             config_.pipeline_max_buffered_bytes &&
+         !IsRequestTasksEmpty()) {
+    if (!response_sent_event_.WaitForEvent()) return false;
+  }
+  return true;
+}
+
+bool Connection::ListenForHttp2Requests(Queue::Producer& producer,
+                                        std::vector<char>& buf,
+                                        std::string_view initial_data) {
+  using RequestBasePtr = std::shared_ptr<request::RequestBase>;
+
+  LOG_TRACE() << "HTTP/2 connection preface received from "
+              << peer_name_ << " on fd " << Fd();
+
+  std::vector<std::pair<std::int32_t, RequestBasePtr>> new_requests;
+  http::Http2Session::Settings settings;
+  settings.max_concurrent_streams =
+      static_cast<std::uint32_t>(config_.http2_max_concurrent_streams);
+  http2_session_ = std::make_unique<http::Http2Session>(
+      request_handler_.GetHandlerInfoIndex(), handler_defaults_config_,
+      settings,
+      [&new_requests](std::int32_t stream_id, RequestBasePtr&& request_ptr) {
+        new_requests.emplace_back(stream_id, std::move(request_ptr));
+      },
+      stats_->parser_stats, data_accounter_);
+  is_http2_ = true;
+
+  std::string_view data = initial_data;
+  while (true) {
+    bool is_parsed = false;
+    bool is_alive = false;
+    {
+      std::unique_lock lock(http2_mutex_);
+      is_parsed = http2_session_->Parse(data.data(), data.size());
+      FlushHttp2Output(lock);
+      is_alive = http2_session_->IsAlive() && !is_http2_output_failed_;
+    }
+
+    // Pushing may wait for the queue, so it is done without the lock to let
+    // the stream tasks send their responses
+    for (auto& [stream_id, request_ptr] : new_requests) {
+      if (!NewHttp2Request(stream_id, std::move(request_ptr), producer)) {
+        return true;
+      }
+    }
+    new_requests.clear();
+
+    if (!is_parsed) {
+      LOG_DEBUG() << "Malformed HTTP/2 frames from "
+                  << peer_name_ << " on fd " << Fd();
+      return true;
+    }
+    if (!is_alive) return true;
+
+    auto deadline = engine::Deadline::FromDuration(config_.keepalive_timeout);
+    const auto bytes_read =
+        peer_stream_->ReadSome(buf.data(), buf.size(), deadline);
+    if (!bytes_read) {
+      LOG_TRACE() << "Peer " << peer_name_ << " on fd "
+                  << Fd() << " closed HTTP/2 connection";
+      return false;
+    }
+    data = std::string_view{buf.data(), bytes_read};
+  }
+}
+
+bool Connection::NewHttp2Request(
+    std::int32_t stream_id, std::shared_ptr<request::RequestBase>&& request_ptr,
+    Queue::Producer& producer) {
+  auto request_task = request_handler_.StartRequestTask(request_ptr);
+
+  // The stream task waits for the handler and sends the response as soon as
+  // it is ready, so a slow stream does not delay the others
+  auto stream_task = engine::AsyncNoSpan(
+      task_processor_,
+      [this, stream_id](QueueItem item) {
+        const bool is_processed = HandleQueueItem(item);
+
+        engine::TaskCancellationBlocker block_cancel;
+        SendHttp2Response(stream_id, std::move(item.first), is_processed);
+      },
+      QueueItem{request_ptr, std::move(request_task)});
+
+  ++stats_->active_request_count;
+  return producer.Push({std::move(request_ptr), std::move(stream_task)});
+}
+
 void Connection::ProcessResponses(Queue::Consumer& consumer) noexcept {
   try {
     QueueItem item;
     while (consumer.Pop(item)) {
-      HandleQueueItem(item);
+      if (is_http2_) {
+        // The response is sent by the stream task
+        auto stream_task = std::move(item.second);
+        item.first.reset();
+        try {
+          stream_task.Get();
+        } catch (const engine::WaitInterruptedException&) {
+          stream_task.SyncCancel();
+        }
+        continue;
+      }
+
+      if (!HandleQueueItem(item)) is_response_chain_valid_ = false;
 
       // now we must complete processing
       engine::TaskCancellationBlocker block_cancel;
@@ -257,13 +423,14 @@ void Connection::ProcessResponses(Queue::Consumer& consumer) noexcept {
       SendResponse(*item.first);
       item.first.reset();
       item.second = {};
+      response_sent_event_.Send();
     }
   } catch (const std::exception& e) {
     LOG_ERROR() << "Exception for fd " << Fd() << ": " << e;
   }
 }
 
-void Connection::HandleQueueItem(QueueItem& item) {
+bool Connection::HandleQueueItem(QueueItem& item) {
   auto& request = *item.first;
 
   if (engine::current_task::IsCancelRequested()) {
@@ -272,8 +439,7 @@ void Connection::HandleQueueItem(QueueItem& item) {
     auto request_task = std::move(item.second);
     request_task.SyncCancel();
     LOG_DEBUG() << "Request processing interrupted";
-    is_response_chain_valid_ = false;
-    return;  // avoids throwing and catching exception down below
+    return false;  // avoids throwing and catching exception down below
   }
 
   try {
@@ -293,21 +459,22 @@ void Connection::HandleQueueItem(QueueItem& item) {
     }
   } catch (const engine::WaitInterruptedException&) {
     LOG_DEBUG() << "Request processing interrupted";
-    is_response_chain_valid_ = false;
+    return false;
   } catch (const std::exception& e) {
     LOG_WARNING() << "Request failed with unhandled exception: " << e;
     request.MarkAsInternalServerError();
   }
+  return true;
 }
 
 void Connection::SendResponse(request::RequestBase& request) {
   auto& response = request.GetResponse();
   UASSERT(!response.IsSent());
   request.SetStartSendResponseTime();
-  if (is_response_chain_valid_ && peer_socket_) {
+  if (is_response_chain_valid_ && peer_stream_->IsValid()) {
     try {
       // Might be a stream reading or a fully constructed response
-      response.SendResponse(peer_socket_);
+      response.SendResponse(*peer_stream_);
     } catch (const engine::io::IoSystemError& ex) {
       // working with raw values because std::errc compares error_category
       // default_error_category() fixed only in GCC 9.1 (PR libstdc++/60555)
@@ -323,6 +490,10 @@ void Connection::SendResponse(request::RequestBase& request) {
   } else {
     response.SetSendFailed(std::chrono::steady_clock::now());
   }
+  FinishRequest(request);
+}
+
+void Connection::FinishRequest(request::RequestBase& request) {
   request.SetFinishSendResponseTime();
   --stats_->active_request_count;
   ++stats_->requests_processed_count;
@@ -331,6 +502,81 @@ void Connection::SendResponse(request::RequestBase& request) {
                           request_handler_.LoggerAccessTskv(), remote_address_);
 }
 
+void Connection::SendHttp2Response(
+    std::int32_t stream_id, std::shared_ptr<request::RequestBase> request_ptr,
+    bool is_processed) {
+  auto& request = *request_ptr;
+  auto& response = static_cast<http::HttpResponse&>(request.GetResponse());
+  UASSERT(!response.IsSent());
+  request.SetStartSendResponseTime();
+  if (is_processed && peer_stream_->IsValid()) {
+    try {
+      auto response_data = response.PrepareHttp2Response();
+      std::size_t bytes_sent = response_data.body.size();
+      for (const auto& [name, value] : response_data.headers) {
+        bytes_sent += name.size() + value.size();
+      }
+
+      {
+        std::unique_lock lock(http2_mutex_);
+        http2_session_->SubmitResponse(stream_id, std::move(request_ptr),
+                                       std::move(response_data));
+        FlushHttp2Output(lock);
+      }
+      response.SetHttp2Sent(bytes_sent);
+    } catch (const engine::io::IoSystemError& ex) {
+      // working with raw values because std::errc compares error_category
+      // default_error_category() fixed only in GCC 9.1 (PR libstdc++/60555)
+      auto log_level =
+          ex.Code().value() == static_cast<int>(std::errc::broken_pipe)
+              ? logging::Level::kWarning
+              : logging::Level::kError;
+      LOG(log_level) << "I/O error while sending data: " << ex;
+      response.SetSendFailed(std::chrono::steady_clock::now());
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "Error while sending data: " << ex;
+      response.SetSendFailed(std::chrono::steady_clock::now());
+    }
+  } else {
+    response.SetSendFailed(std::chrono::steady_clock::now());
+  }
+  FinishRequest(request);
+}
+
+void Connection::FlushHttp2Output(std::unique_lock<engine::Mutex>& lock) {
+  UASSERT(lock.owns_lock());
+  if (is_http2_output_failed_) return;
+  http2_session_->CollectOutput(http2_output_);
+
+  // The frames must be written in the order they were collected, so the task
+  // that is already writing writes the output of the others too. Neither the
+  // session nor the other tasks wait for a slow peer.
+  if (is_http2_output_writing_) return;
+  is_http2_output_writing_ = true;
+
+  std::string output;
+  while (!http2_output_.empty()) {
+    output.clear();
+    output.swap(http2_output_);
+    lock.unlock();
+    try {
+      const auto deadline =
+          engine::Deadline::FromDuration(config_.keepalive_timeout);
+      [[maybe_unused]] const auto sent_bytes =
+          peer_stream_->WriteAll(output.data(), output.size(), deadline);
+    } catch (const std::exception&) {
+      lock.lock();
+      // A frame might be written partially, the connection is unusable
+      is_http2_output_failed_ = true;
+      is_http2_output_writing_ = false;
+      http2_output_.clear();
+      throw;
+    }
+    lock.lock();
+  }
+  is_http2_output_writing_ = false;
+}
+
 }  // namespace server::net
 
 USERVER_NAMESPACE_END
@@ -1,16 +1,26 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include <server/http/http2_session.hpp>
 #include <server/http/request_handler_base.hpp>
 #include <server/net/connection_config.hpp>
 #include <server/net/stats.hpp>
+#include <server/net/tls_stream.hpp>
 #include <server/request/request_parser.hpp>
 
 #include <userver/concurrent/queue.hpp>
 #include <userver/engine/io/socket.hpp>
+#include <userver/engine/io/sockaddr.hpp>
+#include <userver/engine/io/tls_wrapper.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/task/task.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
@@ -36,7 +46,8 @@ class Connection final : public std::enable_shared_from_this<Connection> {
       engine::io::Socket peer_socket,
       const http::RequestHandlerBase& request_handler,
       std::shared_ptr<Stats> stats,
-      request::ResponseDataAccounter& data_accounter);
+      request::ResponseDataAccounter& data_accounter,
+      std::optional<engine::io::TlsServerContext> tls_context = {});
 
   // Use Create instead of this constructor
   Connection(engine::TaskProcessor& task_processor,
@@ -45,7 +56,9 @@ class Connection final : public std::enable_shared_from_this<Connection> {
              engine::io::Socket peer_socket,
              const http::RequestHandlerBase& request_handler,
              std::shared_ptr<Stats> stats,
-             request::ResponseDataAccounter& data_accounter, EmplaceEnabler);
+             request::ResponseDataAccounter& data_accounter,
+             std::optional<engine::io::TlsServerContext> tls_context,
+             EmplaceEnabler);
 
   void SetCloseCb(CloseCb close_cb);
 
@@ -65,12 +78,31 @@ class Connection final : public std::enable_shared_from_this<Connection> {
   bool IsRequestTasksEmpty() const noexcept;
 
   void ListenForRequests(Queue::Producer) noexcept;
+  // Returns false if the TLS handshake has failed
+  bool StartTls();
   bool NewRequest(std::shared_ptr<request::RequestBase>&& request_ptr,
                   Queue::Producer&);
+  // Returns false if the wait was interrupted
+  bool WaitForPipelinedResponses();
+
+  // Returns false if the connection was closed by peer
+  bool ListenForHttp2Requests(Queue::Producer&, std::vector<char>& buf,
+                              std::string_view initial_data);
+  bool NewHttp2Request(std::int32_t stream_id,
+                       std::shared_ptr<request::RequestBase>&& request_ptr,
+                       Queue::Producer&);
 
   void ProcessResponses(Queue::Consumer&) noexcept;
-  void HandleQueueItem(QueueItem& item);
+  // Returns false if the request processing was interrupted
+  bool HandleQueueItem(QueueItem& item);
   void SendResponse(request::RequestBase& request);
+  void FinishRequest(request::RequestBase& request);
+
+  void SendHttp2Response(std::int32_t stream_id,
+                         std::shared_ptr<request::RequestBase> request_ptr,
+                         bool is_processed);
+  // Must be called with http2_mutex_ locked, unlocks it while writing
+  void FlushHttp2Output(std::unique_lock<engine::Mutex>& lock);
 
   engine::TaskProcessor& task_processor_;
   const ConnectionConfig& config_;
@@ -79,16 +111,38 @@ class Connection final : public std::enable_shared_from_this<Connection> {
   const http::RequestHandlerBase& request_handler_;
   const std::shared_ptr<Stats> stats_;
   request::ResponseDataAccounter& data_accounter_;
+  // Accounts the data of HTTP/1.x responses of this connection
+  request::ResponseDataAccounter pipeline_data_accounter_;
+  // The socket is moved into the TLS session, so its data is kept here
+  const int fd_;
+  const engine::io::Sockaddr peer_name_;
   const std::string remote_address_;
 
+  // Set up by the socket listener before the first request is queued
+  std::optional<engine::io::TlsServerContext> tls_context_;
+  std::unique_ptr<TlsStream> tls_stream_;
+  engine::io::RwBase* peer_stream_{&peer_socket_};
+
   std::shared_ptr<Queue> request_tasks_;
   engine::SingleConsumerEvent response_sender_launched_event_;
   engine::SingleConsumerEvent response_sender_assigned_event_;
   engine::Task response_sender_task_;
+  engine::SingleConsumerEvent response_sent_event_;
 
   bool is_accepting_requests_{true};
   bool is_response_chain_valid_{true};
   CloseCb close_cb_;
+
+  // Set before the first request of an HTTP/2 connection is queued. HTTP/2
+  // responses are sent by the stream tasks out of order.
+  bool is_http2_{false};
+  engine::Mutex http2_mutex_;
+  std::unique_ptr<http::Http2Session> http2_session_;
+  // Frames collected from the session and not written yet. Guarded by
+  // http2_mutex_, written without it by one task at a time.
+  std::string http2_output_;
+  bool is_http2_output_writing_{false};
+  bool is_http2_output_failed_{false};
 };
 
 }  // namespace server::net
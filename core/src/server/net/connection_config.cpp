@@ -18,6 +18,13 @@ ConnectionConfig Parse(const yaml_config::YamlConfig& value,
   config.keepalive_timeout =
       value["keepalive_timeout"].As<std::chrono::seconds>(
           config.keepalive_timeout);
+  config.http2_enabled = value["http2_enabled"].As<bool>(config.http2_enabled);
+  config.http2_max_concurrent_streams =
+      value["http2_max_concurrent_streams"].As<size_t>(
+          config.requests_queue_size_threshold);
+  config.pipeline_max_buffered_bytes =
+      value["pipeline_max_buffered_bytes"].As<size_t>(
+          config.pipeline_max_buffered_bytes);
 
   return config;
 }
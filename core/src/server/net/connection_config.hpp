@@ -13,6 +13,9 @@ struct ConnectionConfig {
   size_t in_buffer_size = 32 * 1024;
   size_t requests_queue_size_threshold = 100;
   std::chrono::seconds keepalive_timeout{10 * 60};
+  bool http2_enabled = false;
+  size_t http2_max_concurrent_streams = requests_queue_size_threshold;
+  size_t pipeline_max_buffered_bytes = 1024 * 1024;
 };
 
 ConnectionConfig Parse(const yaml_config::YamlConfig& value,
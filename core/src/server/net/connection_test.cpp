@@ -1,13 +1,23 @@
 #include <server/net/connection.hpp>
 
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include <fmt/format.h>
 
+#include <engine/io/tls_wrapper_test.hpp>
 #include <server/handlers/http_handler_base_statistics.hpp>
 #include <server/http/http_request_impl.hpp>
 #include <server/http/request_handler_base.hpp>
 #include <server/net/create_socket.hpp>
 #include <userver/clients/http/client.hpp>
+#include <userver/crypto/certificate.hpp>
+#include <userver/crypto/private_key.hpp>
 #include <userver/engine/io/sockaddr.hpp>
+#include <userver/engine/io/tls_wrapper.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
 
 #include <userver/utest/http_client.hpp>
@@ -23,7 +33,10 @@ constexpr auto kAcceptTimeout = utest::kMaxTestWaitTime;
 
 class TestHttprequestHandler : public server::http::RequestHandlerBase {
  public:
-  enum class Behaviors { kNoop, kHang };
+  enum class Behaviors { kNoop, kHang, kEchoPath, kThrottle };
+
+  // Requests to this path wait for `slow_request_release` in kEchoPath mode
+  static constexpr std::string_view kSlowPath = "/slow";
 
   explicit TestHttprequestHandler(Behaviors behavior = Behaviors::kNoop)
       : behavior_(behavior) {}
@@ -45,6 +58,25 @@ class TestHttprequestHandler : public server::http::RequestHandlerBase {
           ASSERT_TRUE(engine::current_task::IsCancelRequested());
           ++asyncs_finished;
         });
+      case Behaviors::kThrottle:
+        // Same check as in server::http::HttpRequestHandler
+        if (http_request.GetHttpResponse().IsLimitReached()) {
+          http_request.SetResponseStatus(
+              server::http::HttpStatus::kTooManyRequests);
+        }
+        return engine::AsyncNoSpan([this]() { ++asyncs_finished; });
+      case Behaviors::kEchoPath:
+        return engine::AsyncNoSpan([this, request]() {
+          ++asyncs_started;
+          auto& http_request =
+              dynamic_cast<server::http::HttpRequestImpl&>(*request);
+          const auto& path = http_request.GetRequestPath();
+          if (path == kSlowPath) {
+            EXPECT_TRUE(slow_request_release.WaitForEvent());
+          }
+          http_request.GetHttpResponse().SetData("body" + path);
+          ++asyncs_finished;
+        });
     }
 
     UINVARIANT(false, "Unexpected behavior");
@@ -61,8 +93,12 @@ class TestHttprequestHandler : public server::http::RequestHandlerBase {
     return no_logger_;
   };
 
+  // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+  mutable std::atomic<std::size_t> asyncs_started{0};
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
   mutable std::atomic<std::size_t> asyncs_finished{0};
+  // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+  mutable engine::SingleConsumerEvent slow_request_release;
 
  private:
   const Behaviors behavior_;
@@ -282,6 +318,193 @@ UTEST(ServerNetConnection, KeepAlive) {
   EXPECT_EQ(handler.asyncs_finished, 2);
 }
 
+UTEST(ServerNetConnection, ResponseSizeLimit) {
+  net::ListenerConfig config = CreateConfig();
+  auto request_socket = net::CreateSocket(config);
+
+  auto http_client_ptr = utest::CreateHttpClient();
+  http_client_ptr->SetMaxHostConnections(1);
+
+  auto request = CreateRequest(*http_client_ptr, request_socket,
+                               ConnectionHeader::kKeepAlive);
+
+  auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+  ASSERT_TRUE(peer.IsValid());
+  auto stats = std::make_shared<net::Stats>();
+  server::request::ResponseDataAccounter data_accounter;
+  // The limit of the server wide accounter applies to the responses that are
+  // accounted in the per connection one
+  data_accounter.SetMaxLevel(0);
+  TestHttprequestHandler handler{TestHttprequestHandler::Behaviors::kThrottle};
+
+  auto connection_ptr = net::Connection::Create(
+      engine::current_task::GetTaskProcessor(), config.connection_config,
+      config.handler_defaults, std::move(peer), handler, stats, data_accounter);
+
+  connection_ptr->Start();
+  EXPECT_EQ(request.Get()->status_code(), 429);
+
+  data_accounter.SetMaxLevel(1024);
+  request = CreateRequest(*http_client_ptr, request_socket,
+                          ConnectionHeader::kKeepAlive);
+  EXPECT_EQ(request.Get()->status_code(), 404);
+  EXPECT_EQ(handler.asyncs_finished, 2);
+}
+
+UTEST(ServerNetConnection, Http2PriorKnowledge) {
+  net::ListenerConfig config = CreateConfig();
+  config.connection_config.http2_enabled = true;
+  auto request_socket = net::CreateSocket(config);
+
+  auto http_client_ptr = utest::CreateHttpClient();
+  http_client_ptr->SetMaxHostConnections(1);
+
+  const auto create_request = [&] {
+    return http_client_ptr->CreateRequest()
+        ->get(HttpConnectionUriFromSocket(request_socket))
+        ->http_version(clients::http::HttpVersion::k2PriorKnowledge)
+        ->retry(1)
+        ->timeout(utest::kMaxTestWaitTime)
+        ->async_perform();
+  };
+  std::vector<clients::http::ResponseFuture> requests;
+  requests.push_back(create_request());
+
+  auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+  ASSERT_TRUE(peer.IsValid());
+  auto stats = std::make_shared<net::Stats>();
+  server::request::ResponseDataAccounter data_accounter;
+  TestHttprequestHandler handler;
+
+  auto connection_ptr = net::Connection::Create(
+      engine::current_task::GetTaskProcessor(), config.connection_config,
+      config.handler_defaults, std::move(peer), handler, stats, data_accounter);
+
+  connection_ptr->Start();
+  EXPECT_EQ(requests.front().Get()->status_code(), 404);
+  EXPECT_EQ(handler.asyncs_finished, 1);
+
+  // Streams of the same connection
+  requests.clear();
+  for (int i = 0; i < 3; ++i) requests.push_back(create_request());
+  for (auto& request : requests) {
+    EXPECT_EQ(request.Get()->status_code(), 404);
+  }
+  EXPECT_EQ(handler.asyncs_finished, 4);
+}
+
+UTEST(ServerNetConnection, TlsAlpnHttp2) {
+  net::ListenerConfig config = CreateConfig();
+  config.connection_config.http2_enabled = true;
+  auto request_socket = net::CreateSocket(config);
+
+  const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+  const auto addr = request_socket.Getsockname();
+  engine::io::Socket client{addr.Domain(), engine::io::SocketType::kStream};
+  client.Connect(addr, deadline);
+
+  auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+  ASSERT_TRUE(peer.IsValid());
+  auto stats = std::make_shared<net::Stats>();
+  server::request::ResponseDataAccounter data_accounter;
+  TestHttprequestHandler handler;
+
+  engine::io::TlsServerContext::Settings settings;
+  settings.alpn_protocols = {"h2", "http/1.1"};
+  const engine::io::TlsServerContext tls_context{
+      crypto::Certificate::LoadFromString(engine::io::tls_test::cert),
+      crypto::PrivateKey::LoadFromString(engine::io::tls_test::key),
+      settings};
+
+  auto connection_ptr = net::Connection::Create(
+      engine::current_task::GetTaskProcessor(), config.connection_config,
+      config.handler_defaults, std::move(peer), handler, stats, data_accounter,
+      tls_context);
+  connection_ptr->Start();
+
+  engine::io::tls_test::RawTlsClient tls_client{std::move(client),
+                                                "\x02h2\x08http/1.1"};
+  tls_client.Handshake(deadline);
+  EXPECT_EQ(tls_client.GetAlpnProtocol(), "h2");
+
+  // The connection preface followed by an empty SETTINGS frame
+  constexpr std::string_view kPreface{
+      "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"
+      "\0\0\0\x04\0\0\0\0\0",
+      33};
+  tls_client.SendAll(kPreface, deadline);
+
+  // The server preface is a SETTINGS frame, so the connection is served as
+  // HTTP/2 through the TLS stream
+  const auto frame_header = tls_client.RecvAll(9, deadline);
+  EXPECT_EQ(frame_header[3], '\x04');
+  EXPECT_EQ(frame_header[4] & 1, 0);  // not an ACK
+}
+
+UTEST(ServerNetConnection, Pipelining) {
+  net::ListenerConfig config = CreateConfig();
+  // A new request waits while any response waits to be sent
+  config.connection_config.pipeline_max_buffered_bytes = 0;
+  auto request_socket = net::CreateSocket(config);
+
+  const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+  const auto addr = request_socket.Getsockname();
+  engine::io::Socket client{addr.Domain(), engine::io::SocketType::kStream};
+  client.Connect(addr, deadline);
+
+  auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+  ASSERT_TRUE(peer.IsValid());
+  auto stats = std::make_shared<net::Stats>();
+  server::request::ResponseDataAccounter data_accounter;
+  TestHttprequestHandler handler{TestHttprequestHandler::Behaviors::kEchoPath};
+
+  auto connection_ptr = net::Connection::Create(
+      engine::current_task::GetTaskProcessor(), config.connection_config,
+      config.handler_defaults, std::move(peer), handler, stats, data_accounter);
+  connection_ptr->Start();
+
+  const auto send_request = [&](std::string_view path) {
+    const auto request =
+        fmt::format("GET {} HTTP/1.1\r\nHost: localhost\r\n\r\n", path);
+    ASSERT_EQ(client.SendAll(request.data(), request.size(), deadline),
+              request.size());
+  };
+
+  // The response to the fast request is buffered until the slow one is sent
+  send_request(TestHttprequestHandler::kSlowPath);
+  send_request("/fast");
+  while (handler.asyncs_finished < 1) engine::Yield();
+
+  // The buffered response exceeds the limit, the reader stops
+  send_request("/last");
+  engine::SleepFor(std::chrono::milliseconds{100});
+  EXPECT_EQ(handler.asyncs_started, 2);
+
+  handler.slow_request_release.Send();
+
+  constexpr std::string_view kLastBody = "body/last";
+  std::string responses;
+  std::vector<char> buffer(4096);
+  while (responses.find(kLastBody) == std::string::npos) {
+    const auto bytes_read =
+        client.RecvSome(buffer.data(), buffer.size(), deadline);
+    ASSERT_NE(bytes_read, 0);
+    responses.append(buffer.data(), bytes_read);
+  }
+
+  // Responses are sent in the request order
+  const auto slow_pos = responses.find("body/slow");
+  const auto fast_pos = responses.find("body/fast");
+  ASSERT_NE(slow_pos, std::string::npos);
+  ASSERT_NE(fast_pos, std::string::npos);
+  EXPECT_LT(slow_pos, fast_pos);
+  EXPECT_LT(fast_pos, responses.find(kLastBody));
+
+  EXPECT_EQ(handler.asyncs_started, 3);
+  EXPECT_EQ(handler.asyncs_finished, 3);
+  EXPECT_EQ(stats->requests_processed_count, 3);
+}
+
 UTEST(ServerNetConnection, CancelMultipleInFlight) {
   constexpr std::size_t kInFlightRequests = 10;
   constexpr std::size_t kMaxAttempts = 10;
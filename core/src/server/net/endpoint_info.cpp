@@ -1,12 +1,22 @@
 #include "endpoint_info.hpp"
 
+#include <userver/utils/assert.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
 EndpointInfo::EndpointInfo(const ListenerConfig& listener_config,
-                           http::HttpRequestHandler& request_handler)
-    : listener_config(listener_config), request_handler(request_handler) {}
+                           http::HttpRequestHandler& request_handler,
+                           engine::TaskProcessor* fs_task_processor)
+    : listener_config(listener_config), request_handler(request_handler) {
+  if (listener_config.tls) {
+    UASSERT(fs_task_processor);
+    tls_context_holder = std::make_unique<TlsContextHolder>(
+        *listener_config.tls, listener_config.connection_config.http2_enabled,
+        *fs_task_processor);
+  }
+}
 
 std::string EndpointInfo::GetDescription() const {
   if (listener_config.unix_socket_path.empty())
@@ -15,6 +25,12 @@ std::string EndpointInfo::GetDescription() const {
     return "unix_socket_path=" + listener_config.unix_socket_path;
 }
 
+std::optional<engine::io::TlsServerContext> EndpointInfo::GetTlsContext()
+    const {
+  if (!tls_context_holder) return std::nullopt;
+  return tls_context_holder->GetContext();
+}
+
 }  // namespace server::net
 
 USERVER_NAMESPACE_END
@@ -1,23 +1,33 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
+#include <optional>
 
 #include <server/http/http_request_handler.hpp>
 #include <server/net/connection.hpp>
 #include <server/net/listener_config.hpp>
+#include <server/net/tls_context_holder.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
 struct EndpointInfo {
-  EndpointInfo(const ListenerConfig&, http::HttpRequestHandler&);
+  /// `fs_task_processor` is required if the listener terminates TLS
+  EndpointInfo(const ListenerConfig&, http::HttpRequestHandler&,
+               engine::TaskProcessor* fs_task_processor);
 
   std::string GetDescription() const;
 
+  std::optional<engine::io::TlsServerContext> GetTlsContext() const;
+
   const ListenerConfig& listener_config;
   http::HttpRequestHandler& request_handler;
   Connection::Type connection_type{Connection::Type::kRequest};
+  // nullptr if the listener does not terminate TLS
+  std::unique_ptr<TlsContextHolder> tls_context_holder;
 
   std::atomic<size_t> connection_count{0};
 };
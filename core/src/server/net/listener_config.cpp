@@ -9,6 +9,27 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+TlsConfig Parse(const yaml_config::YamlConfig& value,
+                formats::parse::To<TlsConfig>) {
+  TlsConfig config;
+
+  config.cert_path = value["cert"].As<std::string>();
+  config.private_key_path = value["private_key"].As<std::string>();
+  config.session_cache_size =
+      value["session_cache_size"].As<size_t>(config.session_cache_size);
+  config.session_timeout = value["session_timeout"].As<std::chrono::seconds>(
+      config.session_timeout);
+  config.session_tickets =
+      value["session_tickets"].As<bool>(config.session_tickets);
+  config.reload_interval =
+      value["reload_interval"].As<std::chrono::milliseconds>(
+          config.reload_interval);
+  config.fs_task_processor =
+      value["fs_task_processor"].As<std::string>(config.fs_task_processor);
+
+  return config;
+}
+
 ListenerConfig Parse(const yaml_config::YamlConfig& value,
                      formats::parse::To<ListenerConfig>) {
   ListenerConfig config;
@@ -23,6 +44,7 @@ ListenerConfig Parse(const yaml_config::YamlConfig& value,
   config.shards = value["shards"].As<std::optional<size_t>>(config.shards);
   config.task_processor = value["task_processor"].As<std::string>();
   config.backlog = value["backlog"].As<int>(config.backlog);
+  config.tls = value["tls"].As<std::optional<TlsConfig>>();
 
   if (config.port != 0 && !config.unix_socket_path.empty())
     throw std::runtime_error(
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <string>
 
 #include <userver/server/request/request_config.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
@@ -12,6 +15,21 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+struct TlsConfig {
+  std::string cert_path;
+  std::string private_key_path;
+  size_t session_cache_size = 20 * 1024;
+  std::chrono::seconds session_timeout{300};
+  bool session_tickets = true;
+  // 0 disables the reload
+  std::chrono::milliseconds reload_interval{std::chrono::minutes{1}};
+  // reads the files on reload
+  std::string fs_task_processor{"fs-task-processor"};
+};
+
+TlsConfig Parse(const yaml_config::YamlConfig& value,
+                formats::parse::To<TlsConfig>);
+
 struct ListenerConfig {
   ConnectionConfig connection_config;
   request::HttpRequestConfig handler_defaults;
@@ -21,6 +39,7 @@ struct ListenerConfig {
   size_t max_connections = 32768;
   std::optional<size_t> shards;
   std::string task_processor;
+  std::optional<TlsConfig> tls;
 };
 
 ListenerConfig Parse(const yaml_config::YamlConfig& value,
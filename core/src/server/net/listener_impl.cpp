@@ -93,7 +93,8 @@ void ListenerImpl::SetupConnection(engine::io::Socket peer_socket) {
   auto connection_ptr = Connection::Create(
       task_processor_, endpoint_info_->listener_config.connection_config,
       endpoint_info_->listener_config.handler_defaults, std::move(peer_socket),
-      endpoint_info_->request_handler, stats_, data_accounter_);
+      endpoint_info_->request_handler, stats_, data_accounter_,
+      endpoint_info_->GetTlsContext());
   connection_ptr->SetCloseCb([endpoint_info = endpoint_info_]() {
     --endpoint_info->connection_count;
   });
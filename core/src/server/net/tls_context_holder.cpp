@@ -0,0 +1,133 @@
+#include "tls_context_holder.hpp"
+
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include <userver/crypto/certificate.hpp>
+#include <userver/crypto/private_key.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/read.hpp>
+#include <userver/logging/log.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::net {
+
+namespace {
+
+constexpr std::string_view kHttp2Protocol = "h2";
+constexpr std::string_view kHttp1Protocol = "http/1.1";
+
+// The certificate file may contain the intermediate certificates after the
+// server one
+std::vector<crypto::Certificate> LoadCertificates(std::string_view pem) {
+  constexpr std::string_view kCertificateEnd = "-----END CERTIFICATE-----";
+
+  std::vector<crypto::Certificate> certificates;
+  auto end = pem.find(kCertificateEnd);
+  while (end != std::string_view::npos) {
+    end += kCertificateEnd.size();
+    certificates.push_back(
+        crypto::Certificate::LoadFromString(pem.substr(0, end)));
+    pem.remove_prefix(end);
+    end = pem.find(kCertificateEnd);
+  }
+
+  if (certificates.empty()) {
+    throw std::runtime_error("No certificates found");
+  }
+  return certificates;
+}
+
+struct ParsedCredentials {
+  crypto::Certificate cert;
+  crypto::PrivateKey private_key;
+  std::vector<crypto::Certificate> intermediate_certs;
+};
+
+ParsedCredentials ParseCredentials(const std::string& cert_pem,
+                                   const std::string& private_key_pem) {
+  auto certificates = LoadCertificates(cert_pem);
+  ParsedCredentials result{
+      std::move(certificates.front()),
+      crypto::PrivateKey::LoadFromString(private_key_pem),
+      {},
+  };
+  certificates.erase(certificates.begin());
+  result.intermediate_certs = std::move(certificates);
+  return result;
+}
+
+engine::io::TlsServerContext::Settings MakeSettings(const TlsConfig& config,
+                                                    bool http2_enabled) {
+  engine::io::TlsServerContext::Settings settings;
+  settings.session_cache_size = config.session_cache_size;
+  settings.session_timeout = config.session_timeout;
+  settings.session_tickets = config.session_tickets;
+  if (http2_enabled) settings.alpn_protocols.emplace_back(kHttp2Protocol);
+  settings.alpn_protocols.emplace_back(kHttp1Protocol);
+  return settings;
+}
+
+engine::io::TlsServerContext MakeContext(const std::string& cert_pem,
+                                         const std::string& private_key_pem,
+                                         const TlsConfig& config,
+                                         bool http2_enabled) {
+  const auto parsed = ParseCredentials(cert_pem, private_key_pem);
+  return engine::io::TlsServerContext(parsed.cert, parsed.private_key,
+                                      MakeSettings(config, http2_enabled),
+                                      parsed.intermediate_certs);
+}
+
+}  // namespace
+
+TlsContextHolder::TlsContextHolder(const TlsConfig& config, bool http2_enabled,
+                                   engine::TaskProcessor& fs_task_processor)
+    : config_(config),
+      fs_task_processor_(fs_task_processor),
+      // The files are small and the component is being loaded, so they are
+      // read synchronously
+      credentials_{fs::blocking::ReadFileContents(config_.cert_path),
+                   fs::blocking::ReadFileContents(config_.private_key_path)},
+      context_(MakeContext(credentials_.cert, credentials_.private_key,
+                           config, http2_enabled)) {
+  if (config_.reload_interval.count() > 0) {
+    reload_task_.Start("tls-context-reloader", config_.reload_interval,
+                       [this] { Reload(); });
+  }
+}
+
+engine::io::TlsServerContext TlsContextHolder::GetContext() const {
+  return context_.ReadCopy();
+}
+
+void TlsContextHolder::Reload() {
+  try {
+    auto credentials = ReadCredentials();
+    if (credentials.cert == credentials_.cert &&
+        credentials.private_key == credentials_.private_key) {
+      return;
+    }
+
+    const auto parsed =
+        ParseCredentials(credentials.cert, credentials.private_key);
+    auto context = context_.ReadCopy().WithCertificate(
+        parsed.cert, parsed.private_key, parsed.intermediate_certs);
+    context_.Assign(std::move(context));
+    credentials_ = std::move(credentials);
+    LOG_INFO() << "Reloaded TLS certificate from " << config_.cert_path;
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to reload TLS certificate from "
+                << config_.cert_path << ", keeping the previous one: " << ex;
+  }
+}
+
+TlsContextHolder::Credentials TlsContextHolder::ReadCredentials() const {
+  return {fs::ReadFileContents(fs_task_processor_, config_.cert_path),
+          fs::ReadFileContents(fs_task_processor_, config_.private_key_path)};
+}
+
+}  // namespace server::net
+
+USERVER_NAMESPACE_END
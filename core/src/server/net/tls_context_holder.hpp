@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+
+#include <userver/engine/io/tls_wrapper.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/utils/periodic_task.hpp>
+
+#include "listener_config.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::net {
+
+/// Server TLS context of a listener, periodically reloads the certificate and
+/// the private key if their files were changed. The session tickets remain
+/// valid after the reload.
+///
+/// The files are read synchronously on construction and on
+/// `fs_task_processor` on reload.
+class TlsContextHolder final {
+ public:
+  TlsContextHolder(const TlsConfig& config, bool http2_enabled,
+                   engine::TaskProcessor& fs_task_processor);
+
+  engine::io::TlsServerContext GetContext() const;
+
+  void Reload();
+
+ private:
+  struct Credentials {
+    std::string cert;
+    std::string private_key;
+  };
+
+  Credentials ReadCredentials() const;
+
+  const TlsConfig& config_;
+  engine::TaskProcessor& fs_task_processor_;
+  // only accessed from the reload task after the construction
+  Credentials credentials_;
+  rcu::Variable<engine::io::TlsServerContext> context_;
+  utils::PeriodicTask reload_task_;
+};
+
+}  // namespace server::net
+
+USERVER_NAMESPACE_END
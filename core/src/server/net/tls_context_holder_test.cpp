@@ -0,0 +1,87 @@
+#include <server/net/tls_context_holder.hpp>
+
+#include <chrono>
+#include <string>
+#include <utility>
+
+#include <engine/io/tls_wrapper_test.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/tls_wrapper.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/internal/net/net_listener.hpp>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace io = engine::io;
+using engine::Deadline;
+
+struct HandshakeResult {
+  io::tls_test::SslSession session;
+  std::string peer_subject;
+};
+
+HandshakeResult Handshake(const server::net::TlsContextHolder& holder,
+                          SSL_SESSION* session, Deadline deadline) {
+  internal::net::TcpListener tcp_listener;
+  auto [server, client] = tcp_listener.MakeSocketPair(deadline);
+
+  auto server_task = engine::AsyncNoSpan(
+      [deadline, &holder](auto&& server) {
+        auto tls_server = io::TlsWrapper::StartTlsServer(
+            std::forward<decltype(server)>(server), holder.GetContext(),
+            deadline);
+        EXPECT_EQ(tls_server.GetAlpnProtocol(), "h2");
+        EXPECT_EQ(1, tls_server.SendAll("1", 1, deadline));
+      },
+      std::move(server));
+
+  io::tls_test::RawTlsClient tls_client{std::move(client), "\x02h2", session};
+  tls_client.Handshake(deadline);
+  EXPECT_EQ(tls_client.IsSessionReused(), session != nullptr);
+  EXPECT_EQ(tls_client.RecvAll(1, deadline), "1");
+  server_task.Get();
+
+  return {tls_client.GetSession(), tls_client.GetPeerSubject()};
+}
+
+}  // namespace
+
+UTEST_MT(TlsContextHolder, ReloadKeepsSessionTickets, 2) {
+  const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+  const auto dir = fs::blocking::TempDirectory::Create();
+
+  server::net::TlsConfig config;
+  config.cert_path = dir.GetPath() + "/cert.pem";
+  config.private_key_path = dir.GetPath() + "/key.pem";
+  config.reload_interval = std::chrono::milliseconds{0};
+  fs::blocking::RewriteFileContents(config.cert_path, io::tls_test::cert);
+  fs::blocking::RewriteFileContents(config.private_key_path,
+                                    io::tls_test::key);
+
+  server::net::TlsContextHolder holder{
+      config, /*http2_enabled=*/true,
+      engine::current_task::GetTaskProcessor()};
+  const auto initial = Handshake(holder, nullptr, deadline);
+  ASSERT_TRUE(initial.session);
+
+  fs::blocking::RewriteFileContents(config.cert_path,
+                                    io::tls_test::other_cert);
+  fs::blocking::RewriteFileContents(config.private_key_path,
+                                    io::tls_test::other_key);
+  holder.Reload();
+
+  // The ticket issued before the reload is still accepted
+  static_cast<void>(Handshake(holder, initial.session.get(), deadline));
+
+  const auto reloaded = Handshake(holder, nullptr, deadline);
+  EXPECT_NE(reloaded.peer_subject, initial.peer_subject);
+  EXPECT_FALSE(reloaded.peer_subject.empty());
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,136 @@
+#include "tls_stream.hpp"
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include <userver/engine/io/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::net {
+
+namespace {
+
+// Max plaintext size of a TLS record
+constexpr size_t kMaxRecordSize = 16 * 1024;
+
+}  // namespace
+
+TlsStream::TlsStream(engine::io::TlsWrapper&& tls) : tls_(std::move(tls)) {}
+
+bool TlsStream::IsValid() const {
+  std::lock_guard lock(mutex_);
+  return tls_.IsValid();
+}
+
+bool TlsStream::WaitReadable(engine::Deadline deadline) {
+  {
+    std::lock_guard lock(mutex_);
+    try {
+      // The data may be already read from the socket and buffered by TLS
+      return tls_.WaitReadable(engine::Deadline::Passed());
+    } catch (const engine::io::IoTimeout&) {
+      // nothing to read yet
+    }
+  }
+  return tls_.WaitSocketReadable(deadline);
+}
+
+size_t TlsStream::ReadSome(void* buf, size_t len, engine::Deadline deadline) {
+  while (true) {
+    {
+      std::lock_guard lock(mutex_);
+      try {
+        return tls_.RecvSome(buf, len, engine::Deadline::Passed());
+      } catch (const engine::io::IoTimeout&) {
+        // no complete record yet
+      }
+    }
+
+    // Waiting without the lock to let the writer send the data meanwhile
+    if (!tls_.WaitSocketReadable(deadline)) {
+      if (engine::current_task::ShouldCancel()) {
+        throw engine::io::IoCancelled() << "TlsStream::ReadSome";
+      }
+      throw engine::io::IoTimeout() << "TlsStream::ReadSome";
+    }
+  }
+}
+
+size_t TlsStream::ReadAll(void* buf, size_t len, engine::Deadline deadline) {
+  auto* const begin = static_cast<char*>(buf);
+  size_t bytes_read = 0;
+  while (bytes_read < len) {
+    const auto chunk_size =
+        ReadSome(begin + bytes_read, len - bytes_read, deadline);
+    if (!chunk_size) break;
+    bytes_read += chunk_size;
+  }
+  return bytes_read;
+}
+
+bool TlsStream::WaitWriteable(engine::Deadline deadline) {
+  return tls_.WaitSocketWriteable(deadline);
+}
+
+size_t TlsStream::WriteAll(const void* buf, size_t len,
+                           engine::Deadline deadline) {
+  std::lock_guard write_lock(write_mutex_);
+
+  const auto* const begin = static_cast<const char*>(buf);
+  size_t bytes_sent = 0;
+  while (bytes_sent < len) {
+    std::optional<size_t> chunk_size;
+    {
+      std::lock_guard lock(mutex_);
+      chunk_size = tls_.TrySendSome(begin + bytes_sent, len - bytes_sent);
+    }
+    if (chunk_size) {
+      if (!*chunk_size) break;
+      bytes_sent += *chunk_size;
+      continue;
+    }
+
+    // Waiting without the lock to let the reader receive the data meanwhile.
+    // The unsent record is retried with the same arguments on wakeup.
+    if (!tls_.WaitSocketWriteable(deadline)) {
+      if (engine::current_task::ShouldCancel()) {
+        throw engine::io::IoCancelled(bytes_sent) << "TlsStream::WriteAll";
+      }
+      throw engine::io::IoTimeout(bytes_sent) << "TlsStream::WriteAll";
+    }
+  }
+  return bytes_sent;
+}
+
+size_t TlsStream::WriteAll(std::initializer_list<engine::io::IoData> list,
+                           engine::Deadline deadline) {
+  size_t total_size = 0;
+  for (const auto& io_data : list) total_size += io_data.len;
+
+  // Each write produces at least one record, so small buffers are coalesced
+  // to avoid sending the extra records
+  if (list.size() > 1 && total_size <= kMaxRecordSize) {
+    std::string buffer;
+    buffer.reserve(total_size);
+    for (const auto& io_data : list) {
+      buffer.append(static_cast<const char*>(io_data.data), io_data.len);
+    }
+    return WriteAll(buffer.data(), buffer.size(), deadline);
+  }
+
+  size_t bytes_sent = 0;
+  for (const auto& io_data : list) {
+    const auto sent = WriteAll(io_data.data, io_data.len, deadline);
+    bytes_sent += sent;
+    if (sent != io_data.len) break;
+  }
+  return bytes_sent;
+}
+
+}  // namespace server::net
+
+USERVER_NAMESPACE_END
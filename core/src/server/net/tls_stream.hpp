@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+
+#include <userver/engine/io/common.hpp>
+#include <userver/engine/io/tls_wrapper.hpp>
+#include <userver/engine/mutex.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::net {
+
+/// TLS stream of a connection that is read and written concurrently by
+/// different tasks. The TLS session calls are serialized, the waiting for
+/// the socket is done without the lock, so a reader waiting for the incoming
+/// data does not block the writer and vice versa.
+class TlsStream final : public engine::io::RwBase {
+ public:
+  explicit TlsStream(engine::io::TlsWrapper&& tls);
+
+  bool IsValid() const override;
+
+  [[nodiscard]] bool WaitReadable(engine::Deadline deadline) override;
+
+  [[nodiscard]] size_t ReadSome(void* buf, size_t len,
+                                engine::Deadline deadline) override;
+
+  [[nodiscard]] size_t ReadAll(void* buf, size_t len,
+                               engine::Deadline deadline) override;
+
+  [[nodiscard]] bool WaitWriteable(engine::Deadline deadline) override;
+
+  [[nodiscard]] size_t WriteAll(const void* buf, size_t len,
+                                engine::Deadline deadline) override;
+
+  [[nodiscard]] size_t WriteAll(std::initializer_list<engine::io::IoData> list,
+                                engine::Deadline deadline) override;
+
+ private:
+  // protects the TLS session
+  mutable engine::Mutex mutex_;
+  // serializes the writers, a partially sent record must be completed first
+  engine::Mutex write_mutex_;
+  engine::io::TlsWrapper tls_;
+};
+
+}  // namespace server::net
+
+USERVER_NAMESPACE_END
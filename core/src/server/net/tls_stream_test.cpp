@@ -0,0 +1,62 @@
+#include <server/net/tls_stream.hpp>
+
+#include <chrono>
+#include <string>
+#include <utility>
+
+#include <engine/io/tls_wrapper_test.hpp>
+#include <userver/crypto/certificate.hpp>
+#include <userver/crypto/private_key.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/internal/net/net_listener.hpp>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace io = engine::io;
+using engine::Deadline;
+
+UTEST_MT(TlsStream, ReadWhileWriterWaits, 3) {
+  // Does not fit into the socket buffers
+  constexpr std::size_t kDataSize = 16 * 1024 * 1024;
+  const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  internal::net::TcpListener tcp_listener;
+  auto [server, client] = tcp_listener.MakeSocketPair(deadline);
+
+  auto handshake_task = engine::AsyncNoSpan(
+      [deadline](auto&& server) {
+        return io::TlsWrapper::StartTlsServer(
+            std::forward<decltype(server)>(server),
+            crypto::Certificate::LoadFromString(io::tls_test::cert),
+            crypto::PrivateKey::LoadFromString(io::tls_test::key), deadline);
+      },
+      std::move(server));
+  io::tls_test::RawTlsClient tls_client{std::move(client)};
+  tls_client.Handshake(deadline);
+  server::net::TlsStream stream{handshake_task.Get()};
+
+  const std::string data(kDataSize, 'x');
+  auto writer = engine::AsyncNoSpan([&] {
+    EXPECT_EQ(stream.WriteAll(data.data(), data.size(), deadline),
+              data.size());
+  });
+  // Let the writer fill the socket buffers
+  engine::SleepFor(std::chrono::milliseconds{50});
+
+  auto reader = engine::AsyncNoSpan([&] {
+    char c = 0;
+    EXPECT_EQ(stream.ReadSome(&c, 1, deadline), 1);
+    EXPECT_EQ(c, '1');
+  });
+  tls_client.SendAll("1", deadline);
+  // The data is received while the writer waits for the client to read
+  reader.Get();
+
+  EXPECT_EQ(tls_client.RecvAll(data.size(), deadline), data);
+  writer.Get();
+}
+
+USERVER_NAMESPACE_END
@@ -10,6 +10,8 @@ namespace server::request {
 
 class RequestContext::Impl final {
  public:
+  explicit Impl(std::pmr::memory_resource* resource) : named_datum_(resource) {}
+
   utils::AnyMovable& SetUserAnyData(utils::AnyMovable&& data);
   utils::AnyMovable& GetUserAnyData();
   utils::AnyMovable* GetUserAnyDataOptional();
@@ -22,7 +24,7 @@ class RequestContext::Impl final {
 
  private:
   utils::AnyMovable user_data_;
-  std::unordered_map<std::string, utils::AnyMovable> named_datum_;
+  std::pmr::unordered_map<std::string, utils::AnyMovable> named_datum_;
 };
 
 utils::AnyMovable& RequestContext::Impl::SetUserAnyData(
@@ -78,7 +80,11 @@ void RequestContext::Impl::EraseAnyData(const std::string& name) {
   named_datum_.erase(it);
 }
 
-RequestContext::RequestContext() = default;
+RequestContext::RequestContext()
+    : impl_(std::pmr::get_default_resource()) {}
+
+RequestContext::RequestContext(std::pmr::memory_resource& resource)
+    : impl_(&resource) {}
 
 RequestContext::~RequestContext() = default;
 
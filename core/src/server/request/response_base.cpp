@@ -16,8 +16,12 @@ std::chrono::milliseconds ToMsFromStart(
 
 }  // namespace
 
+ResponseDataAccounter::ResponseDataAccounter(ResponseDataAccounter& parent)
+    : parent_(&parent) {}
+
 void ResponseDataAccounter::StartRequest(
     size_t size, std::chrono::steady_clock::time_point create_time) {
+  if (parent_) parent_->StartRequest(size, create_time);
   count_++;
   current_ += size;
   auto ms = ToMsFromStart(create_time);
@@ -30,6 +34,16 @@ void ResponseDataAccounter::StopRequest(
   auto ms = ToMsFromStart(create_time);
   time_sum_ -= ms.count();
   count_--;
+  if (parent_) parent_->StopRequest(size, create_time);
+}
+
+bool ResponseDataAccounter::IsLimitReached() const {
+  // The limit is usually set on the server wide accounter only
+  for (const auto* accounter = this; accounter;
+       accounter = accounter->parent_) {
+    if (accounter->GetCurrentLevel() >= accounter->GetMaxLevel()) return true;
+  }
+  return false;
 }
 
 std::chrono::milliseconds ResponseDataAccounter::GetAvgRequestTime() const {
@@ -64,7 +78,7 @@ void ResponseBase::SetReady(std::chrono::steady_clock::time_point now) {
 }
 
 bool ResponseBase::IsLimitReached() const {
-  return accounter_.GetCurrentLevel() >= accounter_.GetMaxLevel();
+  return accounter_.IsLimitReached();
 }
 
 void ResponseBase::SetSendFailed(
@@ -143,8 +143,14 @@ void ServerImpl::InitPortInfo(
       component_context, config.logger_access, config.logger_access_tskv,
       is_monitor, config.server_name);
 
+  engine::TaskProcessor* fs_task_processor = nullptr;
+  if (listener_config.tls) {
+    fs_task_processor = &component_context.GetTaskProcessor(
+        listener_config.tls->fs_task_processor);
+  }
+
   info.endpoint_info_ = std::make_shared<net::EndpointInfo>(
-      listener_config, *info.request_handler_);
+      listener_config, *info.request_handler_, fs_task_processor);
 
   const auto& event_thread_pool = task_processor.EventThreadPool();
   size_t listener_shards = listener_config.shards ? *listener_config.shards
@@ -226,12 +232,16 @@ void Server::WriteTotalHandlerStatistics(
           .GetHandlers();
 
   handlers::HttpHandlerStatisticsSnapshot total;
+  handlers::HttpHandlerTaskStatisticsSnapshot task_total;
   for (const auto handler_ptr : handlers) {
-    const auto& statistics = handler_ptr->GetHandlerStatistics().GetTotal();
-    total.Add(handlers::HttpHandlerStatisticsSnapshot{statistics});
+    const auto& statistics = handler_ptr->GetHandlerStatistics();
+    total.Add(handlers::HttpHandlerStatisticsSnapshot{statistics.GetTotal()});
+    task_total.Add(handlers::HttpHandlerTaskStatisticsSnapshot{
+        statistics.GetTaskStatistics()});
   }
 
   writer = total;
+  writer = task_total;
 }
 
 net::Stats Server::GetServerStats() const { return pimpl->GetServerStats(); }
@@ -0,0 +1,65 @@
+#include <utils/impl/cycle_clock.hpp>
+
+#include <atomic>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+namespace {
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// The longer the interval, the more precise the ratio
+constexpr std::chrono::seconds kCalibrationInterval{1};
+
+struct CalibrationPoint final {
+  CalibrationPoint()
+      : cycles(CycleClock::Now()), time(std::chrono::steady_clock::now()) {}
+
+  std::uint64_t cycles;
+  std::chrono::steady_clock::time_point time;
+};
+
+// Initialized on startup
+const CalibrationPoint kStartPoint;
+
+std::atomic<double> calibrated_ns_per_cycle{0.0};
+
+double GetNsPerCycle() noexcept {
+  const auto calibrated =
+      calibrated_ns_per_cycle.load(std::memory_order_relaxed);
+  if (calibrated > 0) return calibrated;
+
+  const CalibrationPoint now;
+  const auto elapsed = now.time - kStartPoint.time;
+  const auto cycles = now.cycles - kStartPoint.cycles;
+  if (cycles == 0) return 1.0;
+
+  const auto ns_per_cycle =
+      static_cast<double>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+              .count()) /
+      static_cast<double>(cycles);
+  if (elapsed >= kCalibrationInterval) {
+    calibrated_ns_per_cycle.store(ns_per_cycle, std::memory_order_relaxed);
+  }
+  return ns_per_cycle;
+}
+
+#endif
+
+}  // namespace
+
+std::chrono::nanoseconds CycleClock::ToDuration(std::uint64_t cycles) noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  return std::chrono::nanoseconds{
+      static_cast<std::int64_t>(static_cast<double>(cycles) * GetNsPerCycle())};
+#else
+  return std::chrono::nanoseconds{cycles};
+#endif
+}
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,127 @@
+#include <utils/impl/small_object_pool.hpp>
+
+#include <array>
+#include <new>
+
+// Sanitizers should see every allocation and deallocation
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(memory_sanitizer)
+#define USERVER_IMPL_SMALL_OBJECT_POOL_DISABLED
+#endif
+#endif
+#if defined(__SANITIZE_ADDRESS__)
+#define USERVER_IMPL_SMALL_OBJECT_POOL_DISABLED
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+namespace {
+
+constexpr std::size_t kSizeClassesCount =
+    SmallObjectPool::kMaxBlockSize / SmallObjectPool::kGranularity;
+
+// Upper bound of the memory cached by a single free list
+constexpr std::size_t kMaxCachedBytesPerClass = 64 * 1024;
+
+constexpr std::size_t SizeClassIndex(std::size_t size) noexcept {
+  return size == 0 ? 0 : (size - 1) / SmallObjectPool::kGranularity;
+}
+
+constexpr std::size_t BlockSize(std::size_t index) noexcept {
+  return (index + 1) * SmallObjectPool::kGranularity;
+}
+
+struct FreeBlock final {
+  FreeBlock* next;
+};
+
+struct FreeList final {
+  FreeBlock* head{nullptr};
+  std::size_t size{0};
+};
+
+class ThreadCache final {
+ public:
+  ThreadCache() noexcept { is_alive_ = true; }
+
+  ~ThreadCache() {
+    is_alive_ = false;
+    for (auto& list : lists_) {
+      while (list.head) {
+        auto* const next = list.head->next;
+        ::operator delete(list.head);
+        list.head = next;
+      }
+    }
+  }
+
+  ThreadCache(const ThreadCache&) = delete;
+  ThreadCache& operator=(const ThreadCache&) = delete;
+
+  // Other thread_local destructors may free blocks after the cache is gone,
+  // is_alive_ is trivially destructible and remains readable
+  static bool IsAlive() noexcept { return is_alive_; }
+
+  void* TryPop(std::size_t index) noexcept {
+    auto& list = lists_[index];
+    auto* const block = list.head;
+    if (!block) return nullptr;
+    list.head = block->next;
+    --list.size;
+    return block;
+  }
+
+  bool TryPush(std::size_t index, void* ptr) noexcept {
+    auto& list = lists_[index];
+    if (list.size * BlockSize(index) >= kMaxCachedBytesPerClass) return false;
+    list.head = new (ptr) FreeBlock{list.head};
+    ++list.size;
+    return true;
+  }
+
+ private:
+  static thread_local bool is_alive_;
+
+  std::array<FreeList, kSizeClassesCount> lists_{};
+};
+
+thread_local bool ThreadCache::is_alive_ = false;
+
+ThreadCache* GetThreadCache() noexcept {
+  thread_local ThreadCache cache;
+  return ThreadCache::IsAlive() ? &cache : nullptr;
+}
+
+}  // namespace
+
+void* SmallObjectPool::Allocate(std::size_t size) {
+#ifndef USERVER_IMPL_SMALL_OBJECT_POOL_DISABLED
+  if (size <= kMaxBlockSize) {
+    const auto index = SizeClassIndex(size);
+    if (auto* const cache = GetThreadCache()) {
+      if (auto* const ptr = cache->TryPop(index)) return ptr;
+    }
+    // Round up, so that the block fits any object of its size class later
+    return ::operator new(BlockSize(index));
+  }
+#endif
+  return ::operator new(size);
+}
+
+void SmallObjectPool::Deallocate(void* ptr, std::size_t size) noexcept {
+  if (!ptr) return;
+#ifndef USERVER_IMPL_SMALL_OBJECT_POOL_DISABLED
+  if (size <= kMaxBlockSize) {
+    const auto index = SizeClassIndex(size);
+    auto* const cache = GetThreadCache();
+    if (cache && cache->TryPush(index, ptr)) return;
+  }
+#endif
+  ::operator delete(ptr);
+}
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
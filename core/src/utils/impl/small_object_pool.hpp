@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+/// @brief Thread-local free lists of small memory blocks.
+///
+/// Blocks are grouped into size classes of kGranularity steps up to
+/// kMaxBlockSize. A freed block goes to the free list of the calling thread,
+/// so a block may be allocated in one thread and reused in another one, no
+/// synchronization is needed on any path. Each free list is bounded, the
+/// excess is returned to the global allocator. Larger sizes go straight to the
+/// global allocator.
+///
+/// Intended for objects with short lifetimes that are created at a high rate,
+/// e.g. engine::impl::TaskContext and the payloads of tasks.
+class SmallObjectPool final {
+ public:
+  static constexpr std::size_t kGranularity = 64;
+  static constexpr std::size_t kMaxBlockSize = 1024;
+
+  /// Returns memory with the default new alignment
+  static void* Allocate(std::size_t size);
+
+  /// @p size must be the same as passed to Allocate()
+  static void Deallocate(void* ptr, std::size_t size) noexcept;
+};
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
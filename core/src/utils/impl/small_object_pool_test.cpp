@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <utils/impl/small_object_pool.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using utils::impl::SmallObjectPool;
+
+TEST(SmallObjectPool, Sizes) {
+  for (std::size_t size = 1; size <= SmallObjectPool::kMaxBlockSize * 2;
+       size += 17) {
+    auto* const ptr = SmallObjectPool::Allocate(size);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) %
+                  __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+              0);
+    std::memset(ptr, 0xAA, size);
+    SmallObjectPool::Deallocate(ptr, size);
+  }
+}
+
+TEST(SmallObjectPool, ManyBlocks) {
+  constexpr std::size_t kBlocksCount = 10000;
+
+  std::vector<void*> blocks;
+  blocks.reserve(kBlocksCount);
+  for (std::size_t i = 0; i < kBlocksCount; ++i) {
+    blocks.push_back(SmallObjectPool::Allocate(i % 300 + 1));
+    std::memset(blocks.back(), static_cast<int>(i), i % 300 + 1);
+  }
+  for (std::size_t i = 0; i < kBlocksCount; ++i) {
+    SmallObjectPool::Deallocate(blocks[i], i % 300 + 1);
+  }
+}
+
+TEST(SmallObjectPool, CrossThread) {
+  constexpr std::size_t kBlocksCount = 1000;
+  constexpr std::size_t kBlockSize = 200;
+
+  std::vector<void*> blocks;
+  std::thread([&] {
+    for (std::size_t i = 0; i < kBlocksCount; ++i) {
+      blocks.push_back(SmallObjectPool::Allocate(kBlockSize));
+    }
+  }).join();
+
+  // Freed blocks are cached in this thread
+  for (auto* block : blocks) SmallObjectPool::Deallocate(block, kBlockSize);
+
+  std::thread([&] {
+    for (auto*& block : blocks) {
+      block = SmallObjectPool::Allocate(kBlockSize);
+      std::memset(block, 0, kBlockSize);
+    }
+    for (auto* block : blocks) SmallObjectPool::Deallocate(block, kBlockSize);
+  }).join();
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,18 @@
+#include <userver/utils/impl/thread_shard.hpp>
+
+#include <atomic>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+std::size_t GetCurrentThreadIndex() noexcept {
+  static std::atomic<std::size_t> next_thread_index{0};
+  thread_local const std::size_t thread_index =
+      next_thread_index.fetch_add(1, std::memory_order_relaxed);
+  return thread_index;
+}
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #include <userver/utils/impl/wrapped_call_base.hpp>
 
+#include <utils/impl/small_object_pool.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace utils::impl {
@@ -8,6 +10,25 @@ WrappedCallBase::WrappedCallBase() noexcept = default;
 
 WrappedCallBase::~WrappedCallBase() = default;
 
+void* WrappedCallBase::operator new(std::size_t size) {
+  return SmallObjectPool::Allocate(size);
+}
+
+void WrappedCallBase::operator delete(void* ptr, std::size_t size) noexcept {
+  SmallObjectPool::Deallocate(ptr, size);
+}
+
+// Over-aligned payloads are rare, they bypass the pool
+void* WrappedCallBase::operator new(std::size_t size,
+                                    std::align_val_t alignment) {
+  return ::operator new(size, alignment);
+}
+
+void WrappedCallBase::operator delete(void* ptr, std::size_t size,
+                                      std::align_val_t alignment) noexcept {
+  ::operator delete(ptr, size, alignment);
+}
+
 }  // namespace utils::impl
 
 USERVER_NAMESPACE_END
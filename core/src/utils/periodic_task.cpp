@@ -116,6 +116,9 @@ bool PeriodicTask::IsRunning() const { return task_.IsValid(); }
 void PeriodicTask::Run() {
   {
     auto settings = settings_.Read();
+    if (settings->flags & Flags::kBackground) {
+      engine::current_task::SetPriority(engine::Task::Priority::kBackground);
+    }
     if (!(settings->flags & Flags::kNow))
       engine::InterruptibleSleepFor(MutatePeriod(settings->period));
   }
@@ -47,6 +47,17 @@ TEST(MinMaxAvg, Add) {
   CheckCurrent(mma, 0, 4, 2);
 }
 
+TEST(MinMaxAvg, AddEmpty) {
+  auto mma = GetFilledMma<1, 2>();
+  mma.Add(utils::statistics::MinMaxAvg<int>{});
+  CheckCurrent(mma, 1, 2, 1);
+
+  utils::statistics::MinMaxAvg<int> empty;
+  empty.Add(utils::statistics::MinMaxAvg<int>{});
+  empty.Add(GetFilledMma<3, 5>());
+  CheckCurrent(empty, 3, 5, 4);
+}
+
 TEST(MinMaxAvg, Reset) {
   auto mma = GetFilledMma<1>();
   CheckCurrent(mma, 1, 1, 1);
@@ -0,0 +1,26 @@
+#include <userver/utils/statistics/sharded_counter.hpp>
+
+#include <algorithm>
+#include <thread>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+
+namespace {
+
+// Each shard takes a cache line, so the memory usage of a counter is bounded
+// even on machines with lots of cores
+constexpr std::size_t kMaxShardsCount = 32;
+
+}  // namespace
+
+std::size_t GetShardsCount() noexcept {
+  static const std::size_t shards_count = std::clamp<std::size_t>(
+      std::thread::hardware_concurrency(), 1, kMaxShardsCount);
+  return shards_count;
+}
+
+}  // namespace utils::statistics::impl
+
+USERVER_NAMESPACE_END
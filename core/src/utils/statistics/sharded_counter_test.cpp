@@ -0,0 +1,109 @@
+#include <userver/utest/utest.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
+#include <userver/utils/statistics/sharded_counter.hpp>
+#include <userver/utils/statistics/sharded_min_max_avg.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kThreadsCount = 4;
+constexpr int kIterations = 10000;
+
+template <typename Func>
+void RunInThreads(const Func& func) {
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < kThreadsCount; ++i) threads.emplace_back(func);
+  for (auto& thread : threads) thread.join();
+}
+
+}  // namespace
+
+TEST(ShardedCounter, Basic) {
+  utils::statistics::ShardedCounter<std::uint64_t> counter;
+  EXPECT_EQ(counter.Load(), 0U);
+
+  ++counter;
+  counter += 5;
+  --counter;
+  EXPECT_EQ(counter.Load(), 5U);
+
+  const utils::statistics::ShardedCounter<std::uint64_t> copy{counter};
+  EXPECT_EQ(copy.Load(), 5U);
+}
+
+TEST(ShardedCounter, IncrementDecrementOnDifferentThreads) {
+  utils::statistics::ShardedCounter<std::size_t> counter;
+
+  std::thread([&] {
+    for (int i = 0; i < kIterations; ++i) ++counter;
+  }).join();
+  std::thread([&] {
+    for (int i = 0; i < kIterations - 1; ++i) --counter;
+  }).join();
+
+  EXPECT_EQ(counter.Load(), 1U);
+}
+
+TEST(ShardedCounter, Concurrent) {
+  utils::statistics::ShardedCounter<std::int64_t> counter;
+
+  RunInThreads([&] {
+    for (int i = 0; i < kIterations; ++i) counter += 2;
+  });
+
+  EXPECT_EQ(counter.Load(), 2 * kIterations * std::int64_t{kThreadsCount});
+}
+
+TEST(ShardedMinMaxAvg, Basic) {
+  utils::statistics::ShardedMinMaxAvg<int> mma;
+  auto current = mma.GetCurrent();
+  EXPECT_EQ(current.minimum, 0);
+  EXPECT_EQ(current.maximum, 0);
+  EXPECT_EQ(current.average, 0);
+
+  mma.Account(3);
+  mma.Account(5);
+  current = mma.GetCurrent();
+  EXPECT_EQ(current.minimum, 3);
+  EXPECT_EQ(current.maximum, 5);
+  EXPECT_EQ(current.average, 4);
+
+  mma.Reset();
+  EXPECT_EQ(mma.GetCurrent().maximum, 0);
+}
+
+TEST(ShardedMinMaxAvg, Concurrent) {
+  utils::statistics::ShardedMinMaxAvg<std::int64_t> mma;
+
+  RunInThreads([&] {
+    for (int i = 1; i <= kIterations; ++i) mma.Account(i);
+  });
+
+  const auto current = mma.GetCurrent();
+  EXPECT_EQ(current.minimum, 1);
+  EXPECT_EQ(current.maximum, kIterations);
+  EXPECT_EQ(current.average, (kIterations + 1) / 2);
+}
+
+TEST(ShardedMinMaxAvg, RecentPeriod) {
+  utils::statistics::RecentPeriod<utils::statistics::ShardedMinMaxAvg<int>,
+                                  utils::statistics::MinMaxAvg<int>>
+      period;
+  period.GetCurrentCounter().Account(2);
+  period.GetCurrentCounter().Account(4);
+
+  const auto value =
+      formats::json::ValueBuilder(period.GetStatsForPeriod()).ExtractValue();
+  EXPECT_EQ(value["min"].As<int>(-1), 2);
+  EXPECT_EQ(value["max"].As<int>(-1), 4);
+  EXPECT_EQ(value["avg"].As<int>(-1), 3);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,136 @@
+#include <userver/utils/task_group.hpp>
+
+#include <algorithm>
+
+#include <userver/engine/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+namespace impl {
+
+TaskGroupBase::TaskGroupBase(std::size_t count)
+    : completed_(count, kNotCompleted) {}
+
+TaskGroupBase::~TaskGroupBase() {
+  UASSERT_MSG(tasks_.empty(), "CancelAndWait() was not called");
+}
+
+void TaskGroupBase::Start(std::string name, std::size_t max_concurrency) {
+  UINVARIANT(max_concurrency > 0, "max_concurrency must be positive");
+
+  const auto tasks_count = std::min(GetCount(), max_concurrency);
+  tasks_.reserve(tasks_count);
+  try {
+    for (std::size_t i = 0; i < tasks_count; ++i) {
+      // A task cancelled before the start would leave its jobs unclaimed
+      tasks_.push_back(utils::CriticalAsync(name, [this] { Work(); }));
+    }
+  } catch (...) {
+    CancelAndWait();
+    throw;
+  }
+}
+
+std::optional<std::size_t> TaskGroupBase::WaitNextCompleted() {
+  if (read_count_ == GetCount()) return std::nullopt;
+
+  while (true) {
+    if (is_failed_.load()) Fail();
+
+    const auto index = completed_[read_count_].load(std::memory_order_acquire);
+    if (index != kNotCompleted) {
+      ++read_count_;
+      return index;
+    }
+
+    if (!event_.WaitForEvent()) {
+      CancelAndWait();
+      throw engine::WaitInterruptedException(
+          engine::current_task::CancellationReason());
+    }
+  }
+}
+
+void TaskGroupBase::CancelAndWait() noexcept {
+  for (auto& task : tasks_) task.RequestCancel();
+  for (auto& task : tasks_) task.SyncCancel();
+  tasks_.clear();
+}
+
+void TaskGroupBase::Work() noexcept {
+  // The tasks are critical, so cancellation by CancelAndWait() is only
+  // noticed by polling
+  while (!is_failed_.load() && !engine::current_task::ShouldCancel()) {
+    const auto index = next_index_.fetch_add(1);
+    if (index >= GetCount()) return;
+
+    try {
+      RunJob(index);
+    } catch (...) {
+      if (!is_failed_.exchange(true)) {
+        // Read by the owner only after the tasks are finished
+        exception_ = std::current_exception();
+      }
+      event_.Send();
+      return;
+    }
+
+    // The result of an interrupted job may be incomplete, and nobody waits
+    // for it anymore
+    if (engine::current_task::ShouldCancel()) return;
+
+    const auto position = completed_count_.fetch_add(1);
+    completed_[position].store(index, std::memory_order_release);
+    event_.Send();
+  }
+}
+
+void TaskGroupBase::Fail() {
+  CancelAndWait();
+  UASSERT(exception_);
+  std::rethrow_exception(exception_);
+}
+
+}  // namespace impl
+
+namespace {
+
+class ParallelForGroup final : private impl::TaskGroupBase {
+ public:
+  ParallelForGroup(std::string name, std::size_t count,
+                   std::size_t max_concurrency,
+                   std::function<void(std::size_t)> func)
+      : impl::TaskGroupBase(count), func_(std::move(func)) {
+    Start(std::move(name), max_concurrency);
+  }
+
+  ~ParallelForGroup() { CancelAndWait(); }
+
+  void WaitAll() {
+    while (WaitNextCompleted()) {
+    }
+  }
+
+ private:
+  void RunJob(std::size_t index) override { func_(index); }
+
+  const std::function<void(std::size_t)> func_;
+};
+
+}  // namespace
+
+void ParallelFor(std::string name, std::size_t count,
+                 std::size_t max_concurrency,
+                 std::function<void(std::size_t)> func) {
+  ParallelForGroup group(std::move(name), count, max_concurrency,
+                         std::move(func));
+  group.WaitAll();
+}
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <shared_mutex>
+#include <vector>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/semaphore.hpp>
+#include <userver/engine/wait_all_checked.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/task_group.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kJobsCount = 256;
+constexpr std::size_t kWorkerThreads = 4;
+
+std::size_t Job(std::size_t index) {
+  std::size_t result = index;
+  for (std::size_t i = 0; i < 100; ++i) {
+    benchmark::DoNotOptimize(result += i);
+  }
+  return result;
+}
+
+}  // namespace
+
+// The manual pattern: a task per job, the limit is enforced by a semaphore
+void task_group_manual(benchmark::State& state) {
+  engine::RunStandalone(kWorkerThreads, [&] {
+    const auto max_concurrency = static_cast<std::size_t>(state.range(0));
+    engine::Semaphore semaphore{max_concurrency};
+    std::vector<engine::TaskWithResult<std::size_t>> tasks;
+    tasks.reserve(kJobsCount);
+
+    for (auto _ : state) {
+      for (std::size_t i = 0; i < kJobsCount; ++i) {
+        tasks.push_back(utils::Async("job", [&semaphore, i] {
+          const std::shared_lock lock(semaphore);
+          return Job(i);
+        }));
+      }
+      engine::WaitAllChecked(tasks);
+      for (auto& task : tasks) benchmark::DoNotOptimize(task.Get());
+      tasks.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * kJobsCount);
+  });
+}
+BENCHMARK(task_group_manual)->RangeMultiplier(4)->Range(1, 256);
+
+void task_group_get_all(benchmark::State& state) {
+  engine::RunStandalone(kWorkerThreads, [&] {
+    const auto max_concurrency = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+      utils::TaskGroup<std::size_t> group("job", kJobsCount, max_concurrency,
+                                          &Job);
+      benchmark::DoNotOptimize(group.GetAll());
+    }
+    state.SetItemsProcessed(state.iterations() * kJobsCount);
+  });
+}
+BENCHMARK(task_group_get_all)->RangeMultiplier(4)->Range(1, 256);
+
+void task_group_parallel_for(benchmark::State& state) {
+  engine::RunStandalone(kWorkerThreads, [&] {
+    const auto max_concurrency = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+      utils::ParallelFor("job", kJobsCount, max_concurrency,
+                         [](std::size_t index) {
+                           benchmark::DoNotOptimize(Job(index));
+                         });
+    }
+    state.SetItemsProcessed(state.iterations() * kJobsCount);
+  });
+}
+BENCHMARK(task_group_parallel_for)->RangeMultiplier(4)->Range(1, 256);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,132 @@
+#include <userver/utils/task_group.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class ConcurrencyTracker final {
+ public:
+  void Enter() {
+    const auto current = ++current_;
+    auto max = max_.load();
+    while (current > max && !max_.compare_exchange_weak(max, current)) {
+    }
+  }
+
+  void Leave() { --current_; }
+
+  std::size_t GetMax() const { return max_.load(); }
+
+ private:
+  std::atomic<std::size_t> current_{0};
+  std::atomic<std::size_t> max_{0};
+};
+
+}  // namespace
+
+UTEST(TaskGroup, Sample) {
+  /// [Sample TaskGroup]
+  const std::vector<std::string> keys{"a", "b", "c", "d", "e"};
+
+  // At most 2 requests run at once, only 2 tasks are started
+  utils::TaskGroup<std::string> group(
+      "fetch", keys.size(), 2, [&keys](std::size_t index) {
+        return keys[index] + keys[index];
+      });
+
+  std::size_t received = 0;
+  while (auto result = group.Next()) {
+    auto& [index, value] = *result;
+    EXPECT_EQ(value, keys[index] + keys[index]);
+    ++received;
+  }
+  /// [Sample TaskGroup]
+
+  EXPECT_EQ(received, keys.size());
+}
+
+UTEST_MT(TaskGroup, GetAllOrderedByIndex, 4) {
+  constexpr std::size_t kCount = 100;
+
+  utils::TaskGroup<std::size_t> group(
+      "square", kCount, 8, [](std::size_t index) {
+        if (index % 3 == 0) engine::Yield();
+        return index * index;
+      });
+
+  const auto results = group.GetAll();
+  ASSERT_EQ(results.size(), kCount);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    EXPECT_EQ(results[i], i * i);
+  }
+}
+
+UTEST_MT(TaskGroup, ConcurrencyLimit, 4) {
+  constexpr std::size_t kCount = 50;
+  constexpr std::size_t kMaxConcurrency = 3;
+
+  ConcurrencyTracker tracker;
+  utils::ParallelFor("limited", kCount, kMaxConcurrency, [&](std::size_t) {
+    tracker.Enter();
+    engine::SleepFor(std::chrono::microseconds{100});
+    tracker.Leave();
+  });
+
+  EXPECT_LE(tracker.GetMax(), kMaxConcurrency);
+  EXPECT_GE(tracker.GetMax(), 1);
+}
+
+UTEST_MT(TaskGroup, FirstErrorCancelsSiblings, 4) {
+  constexpr std::size_t kCount = 1000;
+
+  std::atomic<std::size_t> started{0};
+  std::atomic<std::size_t> cancelled{0};
+  UEXPECT_THROW_MSG(
+      utils::ParallelFor("failing", kCount, 4,
+                         [&](std::size_t index) {
+                           ++started;
+                           if (index == 0) throw std::runtime_error("first");
+                           engine::InterruptibleSleepFor(
+                               utest::kMaxTestWaitTime);
+                           if (engine::current_task::ShouldCancel()) {
+                             ++cancelled;
+                           }
+                         }),
+      std::runtime_error, "first");
+
+  // The rest of the indices are not even started
+  EXPECT_LT(started.load(), kCount);
+  EXPECT_EQ(cancelled.load() + 1, started.load());
+}
+
+UTEST(TaskGroup, DestructionCancels) {
+  std::atomic<std::size_t> finished{0};
+  {
+    utils::TaskGroup<int> group("endless", 10, 2, [&](std::size_t) {
+      engine::InterruptibleSleepFor(utest::kMaxTestWaitTime);
+      ++finished;
+      return 0;
+    });
+    engine::Yield();
+  }
+  EXPECT_LE(finished.load(), 2);
+}
+
+UTEST(TaskGroup, Empty) {
+  utils::TaskGroup<int> group("empty", 0, 4, [](std::size_t) { return 0; });
+  EXPECT_FALSE(group.Next());
+  EXPECT_TRUE(group.GetAll().empty());
+
+  utils::ParallelFor("empty", 0, 4, [](std::size_t) { FAIL(); });
+}
+
+USERVER_NAMESPACE_END
@@ -12,6 +12,12 @@
 #endif
 
 #include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
 
 #include <fmt/format.h>
 
@@ -53,6 +59,24 @@ LowPriorityParams QueryLowPriorityParams() {
   return result;
 }
 
+std::size_t ParseCpuNumber(std::string_view number, std::string_view list) {
+  std::size_t result = 0;
+  const auto* const end = number.data() + number.size();
+  const auto [ptr, ec] = std::from_chars(number.data(), end, result);
+  if (number.empty() || ec != std::errc{} || ptr != end) {
+    throw std::runtime_error(fmt::format("Invalid CPU list '{}'", list));
+  }
+  return result;
+}
+
+// Returns an empty string if the file does not exist
+std::string ReadSysfsLine(const std::string& path) {
+  std::ifstream file(path);
+  std::string line;
+  if (file) std::getline(file, line);
+  return line;
+}
+
 }  // namespace
 
 bool IsMainThread() {
@@ -88,6 +112,103 @@ void SetCurrentThreadLowPriorityScheduling() {
       "setting thread scheduling parameters");
 }
 
+std::vector<std::size_t> ParseCpuList(std::string_view cpu_list) {
+  std::vector<std::size_t> cpus;
+  auto rest = cpu_list;
+  while (!rest.empty()) {
+    const auto comma_pos = rest.find(',');
+    auto range = rest.substr(0, comma_pos);
+    rest = (comma_pos == std::string_view::npos) ? std::string_view{}
+                                                 : rest.substr(comma_pos + 1);
+
+    const auto dash_pos = range.find('-');
+    const auto first = ParseCpuNumber(range.substr(0, dash_pos), cpu_list);
+    const auto last =
+        (dash_pos == std::string_view::npos)
+            ? first
+            : ParseCpuNumber(range.substr(dash_pos + 1), cpu_list);
+    if (last < first) {
+      throw std::runtime_error(fmt::format("Invalid CPU list '{}'", cpu_list));
+    }
+    for (auto cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+  }
+
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return cpus;
+}
+
+std::size_t GetNumaNodesCount() {
+  const auto online = ReadSysfsLine("/sys/devices/system/node/online");
+  if (online.empty()) return 1;
+  return ParseCpuList(online).back() + 1;
+}
+
+std::vector<std::size_t> GetNumaNodeCpus(std::size_t numa_node) {
+  const auto cpu_list = ReadSysfsLine(
+      fmt::format("/sys/devices/system/node/node{}/cpulist", numa_node));
+  if (cpu_list.empty()) return {};
+  auto cpus = ParseCpuList(cpu_list);
+
+  const auto allowed = GetAllowedCpus();
+  if (allowed.empty()) return cpus;
+  std::vector<std::size_t> result;
+  std::set_intersection(cpus.begin(), cpus.end(), allowed.begin(),
+                        allowed.end(), std::back_inserter(result));
+  return result;
+}
+
+std::vector<std::size_t> GetAllowedCpus() {
+  std::vector<std::size_t> cpus;
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  // The mask of the main thread, the calling thread may be pinned already
+  if (::sched_getaffinity(::getpid(), sizeof(cpu_set), &cpu_set) != 0) {
+    return cpus;
+  }
+  for (std::size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &cpu_set)) cpus.push_back(cpu);
+  }
+#endif
+  return cpus;
+}
+
+void CheckCpusAllowed(const std::vector<std::size_t>& cpus) {
+  const auto allowed = GetAllowedCpus();
+  if (allowed.empty()) return;
+  for (const auto cpu : cpus) {
+    if (!std::binary_search(allowed.begin(), allowed.end(), cpu)) {
+      throw std::runtime_error(fmt::format(
+          "CPU {} is offline or not allowed for the process", cpu));
+    }
+  }
+}
+
+void SetCurrentThreadAffinity(const std::vector<std::size_t>& cpus) {
+#ifdef __linux__
+  if (cpus.empty()) return;
+
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const auto cpu : cpus) {
+    if (cpu >= CPU_SETSIZE) {
+      throw std::runtime_error(fmt::format("CPU {} is out of range", cpu));
+    }
+    CPU_SET(cpu, &cpu_set);
+  }
+
+  const auto res =
+      ::pthread_setaffinity_np(::pthread_self(), sizeof(cpu_set), &cpu_set);
+  if (res != 0) {
+    throw std::system_error(res, std::system_category(),
+                            "Error while setting thread CPU affinity");
+  }
+#else
+  (void)cpus;
+#endif
+}
+
 }  // namespace utils
 
 USERVER_NAMESPACE_END
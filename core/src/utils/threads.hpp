@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace utils {
@@ -10,6 +14,27 @@ void SetCurrentThreadIdleScheduling();
 
 void SetCurrentThreadLowPriorityScheduling();
 
+/// Parses a CPU list in the kernel format, e.g. "0-3,8,10-11"
+std::vector<std::size_t> ParseCpuList(std::string_view cpu_list);
+
+/// Returns the number of NUMA nodes, 1 if the information is unavailable
+std::size_t GetNumaNodesCount();
+
+/// Returns CPUs of a NUMA node that the process is allowed to run on, empty if
+/// the information is unavailable
+std::vector<std::size_t> GetNumaNodeCpus(std::size_t numa_node);
+
+/// Returns online CPUs that the process is allowed to run on, empty if the
+/// information is unavailable
+std::vector<std::size_t> GetAllowedCpus();
+
+/// Throws std::runtime_error if some of the CPUs are offline or not allowed
+/// for the process, does nothing if the information is unavailable
+void CheckCpusAllowed(const std::vector<std::size_t>& cpus);
+
+/// Pins the current thread to the CPUs, does nothing on non-Linux platforms
+void SetCurrentThreadAffinity(const std::vector<std::size_t>& cpus);
+
 }  // namespace utils
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include <utils/threads.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(ParseCpuList, Basic) {
+  using Cpus = std::vector<std::size_t>;
+  EXPECT_EQ(utils::ParseCpuList("0"), (Cpus{0}));
+  EXPECT_EQ(utils::ParseCpuList("0-3"), (Cpus{0, 1, 2, 3}));
+  EXPECT_EQ(utils::ParseCpuList("0-1,8,10-11"), (Cpus{0, 1, 8, 10, 11}));
+  EXPECT_EQ(utils::ParseCpuList("3,1-2,2"), (Cpus{1, 2, 3}));
+  EXPECT_EQ(utils::ParseCpuList(""), Cpus{});
+}
+
+TEST(ParseCpuList, Invalid) {
+  EXPECT_THROW(utils::ParseCpuList("a"), std::runtime_error);
+  EXPECT_THROW(utils::ParseCpuList("1-"), std::runtime_error);
+  EXPECT_THROW(utils::ParseCpuList("3-1"), std::runtime_error);
+  EXPECT_THROW(utils::ParseCpuList("1,,2"), std::runtime_error);
+  EXPECT_THROW(utils::ParseCpuList("-1"), std::runtime_error);
+}
+
+TEST(NumaNodes, AtLeastOne) {
+  EXPECT_GE(utils::GetNumaNodesCount(), 1);
+}
+
+TEST(CheckCpusAllowed, Basic) {
+  const auto allowed = utils::GetAllowedCpus();
+  EXPECT_NO_THROW(utils::CheckCpusAllowed(allowed));
+  EXPECT_NO_THROW(utils::CheckCpusAllowed({}));
+#ifdef __linux__
+  ASSERT_FALSE(allowed.empty());
+  EXPECT_THROW(utils::CheckCpusAllowed({allowed.back() + 1}),
+               std::runtime_error);
+#endif
+}
+
+USERVER_NAMESPACE_END
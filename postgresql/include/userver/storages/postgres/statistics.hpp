@@ -12,6 +12,7 @@
 #include <userver/utils/statistics/percentile.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
 #include <userver/utils/statistics/relaxed_counter.hpp>
+#include <userver/utils/statistics/sharded_min_max_avg.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -100,10 +101,11 @@ struct InstanceTopologyStatistics {
 
 /// @brief Template instance statistics storage
 template <typename Counter, typename PercentileAccumulator,
-          typename MmaAccumulator>
+          typename MmaAccumulator,
+          typename ConnectionMmaAccumulator = MmaAccumulator>
 struct InstanceStatisticsTemplate {
   /// Connection statistics
-  ConnectionStatistics<Counter, MmaAccumulator> connection;
+  ConnectionStatistics<Counter, ConnectionMmaAccumulator> connection;
   /// Transaction statistics
   TransactionStatistics<Counter, PercentileAccumulator> transaction;
   /// Topology statistics
@@ -120,12 +122,18 @@ struct InstanceStatisticsTemplate {
 
 using Percentile = USERVER_NAMESPACE::utils::statistics::Percentile<2048>;
 using MinMaxAvg = USERVER_NAMESPACE::utils::statistics::MinMaxAvg<uint32_t>;
+using ShardedMinMaxAvg =
+    USERVER_NAMESPACE::utils::statistics::ShardedMinMaxAvg<uint32_t>;
+// Connection statistics are accounted by every task that returns a connection
+// to the pool, so the min-max-avg accumulators are sharded there
 using InstanceStatistics = InstanceStatisticsTemplate<
     USERVER_NAMESPACE::utils::statistics::RelaxedCounter<uint32_t>,
     USERVER_NAMESPACE::utils::statistics::RecentPeriod<Percentile, Percentile,
                                                        detail::SteadyClock>,
     USERVER_NAMESPACE::utils::statistics::RecentPeriod<MinMaxAvg, MinMaxAvg,
-                                                       detail::SteadyClock>>;
+                                                       detail::SteadyClock>,
+    USERVER_NAMESPACE::utils::statistics::RecentPeriod<
+        ShardedMinMaxAvg, MinMaxAvg, detail::SteadyClock>>;
 
 using InstanceStatisticsNonatomicBase =
     InstanceStatisticsTemplate<uint32_t, Percentile, MinMaxAvg>;
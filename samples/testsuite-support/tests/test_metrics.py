@@ -47,6 +47,9 @@ async def test_engine_metrics(service_client, monitor_client):
     assert 'http.handler.rate-limit-reached' in metrics_dict
     assert 'http.handler.deadline-received' in metrics_dict
     assert 'http.handler.timings' in metrics_dict
+    assert 'http.handler.task-run-time' in metrics_dict
+    assert 'http.handler.task-runnable-time' in metrics_dict
+    assert 'http.handler.task-context-switches' in metrics_dict
     assert 'http.handler.reply-codes' in metrics_dict
 
     for key, value in metrics_dict.items():